@@ -67,6 +67,7 @@ apt-get install -y \
     libjsonrpccpp-dev \
     libminiupnpc-dev \
     libevent-dev \
+    libzstd-dev \
     libprotobuf-dev \
     libcurl4-openssl-dev \
     protobuf-compiler
@@ -99,6 +100,7 @@ brew install \
     libjson-rpc-cpp \
     miniupnpc \
     libevent \
+    zstd \
     protobuf
 
 # install developement deps
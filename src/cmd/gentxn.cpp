@@ -18,9 +18,11 @@
  */
 
 #include <boost/filesystem.hpp>
+#include <atomic>
+#include <chrono>
 #include <climits>
-#include <fstream>
 #include <string>
+#include <thread>
 #include <vector>
 #include "libCrypto/Schnorr.h"
 #include "libCrypto/Sha2.h"
@@ -29,10 +31,14 @@
 #include "libData/AccountData/Transaction.h"
 #include "libMessage/Messenger.h"
 #include "libUtils/Logger.h"
+#include "libUtils/TxnCorpus.h"
 
 using KeyPairAddress = std::tuple<PrivKey, PubKey, Address>;
 using NonceRange = std::tuple<std::size_t, std::size_t>;
 
+// Number of consecutive nonces a worker signs before taking more work
+const std::size_t CHUNK_SIZE = 10000;
+
 std::vector<KeyPairAddress> get_genesis_keypair_and_address() {
   std::vector<KeyPairAddress> result;
 
@@ -49,67 +55,46 @@ std::vector<KeyPairAddress> get_genesis_keypair_and_address() {
   return result;
 }
 
-void gen_txn_file(const std::string& prefix, const KeyPairAddress& from,
-                  const Address& toAddr, const NonceRange& nonce_range) {
+bool serialize_txn(const KeyPairAddress& from, const Address& toAddr,
+                   std::size_t nonce, std::vector<unsigned char>& txnBuff) {
   const auto& privKey = std::get<0>(from);
   const auto& pubKey = std::get<1>(from);
+
+  Transaction txn{0,      nonce,
+                  toAddr, std::make_pair(privKey, pubKey),
+                  nonce,  PRECISION_MIN_VALUE,
+                  1,      {},
+                  {}};
+  txnBuff.clear();
+  return Messenger::SetTransaction(txnBuff, 0, txn);
+}
+
+bool gen_txn_range(TxnCorpus& corpus, const KeyPairAddress& from,
+                   const Address& toAddr, const NonceRange& nonce_range) {
   const auto& address = std::get<2>(from);
 
   const auto& begin = std::get<0>(nonce_range);
   const auto& end = std::get<1>(nonce_range);
 
-  std::ostringstream oss;
-  oss << prefix << "/" << address.hex() << "_" << begin << ".zil";
-  // TODO: use address_being_end.zil as the following
-  // oss << prefix << "/" << address.hex() << "_" << begin << "_" << end <<
-  // ".zil";
-
-  std::string txn_filename(oss.str());
-  std::ofstream txn_file(txn_filename, std::fstream::binary);
-
   std::vector<unsigned char> txnBuff;
-  std::vector<uint32_t> txnOffsets;
 
   for (auto nonce = begin; nonce < end; nonce++) {
-    Transaction txn{0,      nonce,
-                    toAddr, std::make_pair(privKey, pubKey),
-                    nonce,  PRECISION_MIN_VALUE,
-                    1,      {},
-                    {}};
-    txnOffsets.push_back(txnBuff.size());
-    if (!Messenger::SetTransaction(txnBuff, txnBuff.size(), txn)) {
-      std::cout << "Messenger::SetTransaction failed." << std::endl;
-      return;
+    if (!serialize_txn(from, toAddr, nonce, txnBuff)) {
+      std::cerr << "Messenger::SetTransaction failed." << std::endl;
+      return false;
+    }
+    if (!corpus.Put(address, nonce, txnBuff.data(), txnBuff.size())) {
+      std::cerr << "Failed to store txn " << nonce << " of " << address.hex()
+                << std::endl;
+      return false;
     }
   }
 
-  // The number of txn offset is number of transaction + 1.
-  // So it is easiler to get the transaction size when read out.
-  txnOffsets.push_back(txnBuff.size());
-
-  std::vector<unsigned char> txnOffsetBuff;
-  if (!Messenger::SetTransactionFileOffset(txnOffsetBuff, 0, txnOffsets)) {
-    std::cout << "Messenger::SetTransactionFileOffset failed." << std::endl;
-    return;
-  }
-
-  std::vector<unsigned char> buf;
-  SerializableDataBlock::SetNumber<uint32_t>(buf, 0, txnOffsetBuff.size(),
-                                             sizeof(uint32_t));
-  buf.insert(buf.end(), txnOffsetBuff.begin(), txnOffsetBuff.end());
-  buf.insert(buf.end(), txnBuff.begin(), txnBuff.end());
-
-  txn_file.write(reinterpret_cast<char*>(buf.data()), buf.size());
-
-  if (txn_file) {
-    std::cout << "Write to file " << txn_filename << "\n";
-  } else {
-    std::cerr << "Error writing to file " << txn_filename << "\n";
-  }
+  return true;
 }
 
 void usage(const std::string& prog) {
-  std::cout << "Usage: " << prog << " [BEGIN [END]]\n";
+  std::cout << "Usage: " << prog << " [BEGIN [END [THREADS]]]\n";
   std::cout << "\n";
   std::cout << "Description:\n";
   std::cout
@@ -120,6 +105,10 @@ void usage(const std::string& prog) {
          "to one random wallet\n";
   std::cout << "\tThe batch size is decided by NUM_TXN_TO_SEND_PER_ACCOUNT "
                "(constants.xml)\n";
+  std::cout << "\tAll transactions are written to one corpus file in TXN_PATH "
+               "(constants.xml)\n";
+  std::cout << "\tTHREADS signing threads are used (default to the number of "
+               "cores)\n";
 }
 
 int main(int argc, char** argv) {
@@ -127,6 +116,7 @@ int main(int argc, char** argv) {
 
   const unsigned long delta = 10000;
   unsigned long begin = 0, end = delta;
+  unsigned long numThreads = std::thread::hardware_concurrency();
 
   if (argc > 1) {
     begin = strtoul(argv[1], nullptr, 10);
@@ -139,11 +129,20 @@ int main(int argc, char** argv) {
     end = strtoul(argv[2], nullptr, 10);
   }
 
-  if (begin == ULONG_MAX || end == ULONG_MAX || begin > end) {
+  if (argc > 3) {
+    numThreads = strtoul(argv[3], nullptr, 10);
+  }
+
+  if (begin == ULONG_MAX || end == ULONG_MAX || begin > end ||
+      numThreads == ULONG_MAX) {
     usage(prog);
     return 1;
   }
 
+  if (numThreads == 0) {
+    numThreads = 1;
+  }
+
   auto receiver = Schnorr::GetInstance().GenKeyPair();
   auto toAddr = Account::GetAddressFromPublicKey(receiver.second);
 
@@ -164,14 +163,79 @@ int main(int argc, char** argv) {
   std::cout << "Destionation directory (TXN_PATH): " << txn_path << "\n";
   std::cout << "Batch size (NUM_TXN_TO_SEND_PER_ACCOUNT): " << batch_size
             << "\n";
+  std::cout << "Threads: " << numThreads << "\n";
 
-  for (auto batch = begin; batch < end; batch++) {
-    auto begin_nonce = batch * batch_size + 1;
-    auto end_nonce = (batch + 1) * batch_size + 1;
-    auto nonce_range = std::make_tuple(begin_nonce, end_nonce);
+  const std::size_t begin_nonce = begin * batch_size + 1;
+  const std::size_t end_nonce = end * batch_size + 1;
 
-    for (auto& from : fromAccounts) {
-      gen_txn_file(txn_path, from, toAddr, nonce_range);
-    }
+  if (fromAccounts.empty() || begin_nonce == end_nonce) {
+    std::cout << "Nothing to generate\n";
+    return 0;
   }
+
+  // Every slot must fit the largest txn. Only the varint nonce changes the
+  // size, so sizing for the highest nonce covers the whole range.
+  std::vector<unsigned char> txnBuff;
+  if (!serialize_txn(fromAccounts.front(), toAddr, end_nonce - 1, txnBuff)) {
+    std::cerr << "Messenger::SetTransaction failed." << std::endl;
+    return 1;
+  }
+
+  std::vector<TxnCorpus::Range> ranges;
+  for (const auto& from : fromAccounts) {
+    ranges.push_back({std::get<2>(from), begin_nonce, end_nonce - begin_nonce});
+  }
+
+  TxnCorpus corpus;
+  const std::string corpus_path = TxnCorpus::GetDefaultPath();
+  if (!corpus.Create(corpus_path, txnBuff.size(), ranges)) {
+    std::cerr << "Failed to create " << corpus_path << "\n";
+    return 1;
+  }
+
+  // Slots are at fixed offsets, so workers fill disjoint chunks of the
+  // mapping with no coordination beyond taking the next chunk
+  const std::size_t chunks_per_account =
+      (end_nonce - begin_nonce + CHUNK_SIZE - 1) / CHUNK_SIZE;
+  const std::size_t num_chunks = chunks_per_account * fromAccounts.size();
+  std::atomic<std::size_t> next_chunk{0};
+  std::atomic<bool> failed{false};
+
+  auto startTime = std::chrono::steady_clock::now();
+
+  std::vector<std::thread> workers;
+  for (unsigned long i = 0; i < numThreads; i++) {
+    workers.emplace_back([&]() {
+      for (std::size_t chunk = next_chunk++; chunk < num_chunks && !failed;
+           chunk = next_chunk++) {
+        const auto& from = fromAccounts[chunk / chunks_per_account];
+        const std::size_t first =
+            begin_nonce + (chunk % chunks_per_account) * CHUNK_SIZE;
+        const std::size_t last = std::min(first + CHUNK_SIZE, end_nonce);
+        if (!gen_txn_range(corpus, from, toAddr,
+                           std::make_tuple(first, last))) {
+          failed = true;
+        }
+      }
+    });
+  }
+
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  corpus.Close();
+
+  if (failed) {
+    std::cerr << "Error writing to file " << corpus_path << "\n";
+    return 1;
+  }
+
+  double seconds = std::chrono::duration_cast<std::chrono::duration<double>>(
+                       std::chrono::steady_clock::now() - startTime)
+                       .count();
+  std::size_t num_txns = ranges.size() * (end_nonce - begin_nonce);
+  std::cout << "Write " << num_txns << " txns to file " << corpus_path
+            << " in " << seconds << " s (" << num_txns / seconds
+            << " txns/s)\n";
 }
@@ -114,9 +114,13 @@ int main(int argc, const char* argv[]) {
                  const Peer& from) mutable -> vector<Peer> {
     return zilliqa.RetrieveBroadcastList(msg_type, ins_type, from);
   };
+  auto originator_list_retriever = [&zilliqa]() mutable -> vector<PubKey> {
+    return zilliqa.RetrieveBroadcastOriginators();
+  };
 
   P2PComm::GetInstance().StartMessagePump(my_network_info.m_listenPortHost,
-                                          dispatcher, broadcast_list_retriever);
+                                          dispatcher, broadcast_list_retriever,
+                                          originator_list_retriever);
 
   return 0;
 }
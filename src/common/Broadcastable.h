@@ -47,6 +47,12 @@ class Broadcastable {
     return peers;
   }
 
+  /// Returns the keys of the nodes whose tree broadcasts this node relays,
+  /// i.e., the members of the committees this node knows of.
+  virtual std::vector<PubKey> GetBroadcastOriginators() {
+    return PeerStore::GetStore().GetAllKeys();
+  }
+
   /// Virtual destructor.
   virtual ~Broadcastable() {}
 };
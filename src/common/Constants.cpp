@@ -217,12 +217,74 @@ const unsigned int POWPACKETSUBMISSION_WINDOW_IN_SECONDS{
     ReadFromConstantsFile("POWPACKETSUBMISSION_WINDOW_IN_SECONDS")};
 const unsigned int LOOKUP_DELAY_SEND_TXNPACKET_IN_MS{
     ReadFromConstantsFile("LOOKUP_DELAY_SEND_TXNPACKET_IN_MS")};
+const unsigned int TXN_INGRESS_QUEUE_SIZE{
+    ReadFromConstantsFile("TXN_INGRESS_QUEUE_SIZE")};
+const unsigned int TXN_INGRESS_SENDER_MAX_TXNS{
+    ReadFromConstantsFile("TXN_INGRESS_SENDER_MAX_TXNS")};
+const unsigned int TXN_INGRESS_SENDER_MAX_BYTES{
+    ReadFromConstantsFile("TXN_INGRESS_SENDER_MAX_BYTES")};
 const unsigned int DELAY_FIRSTXNEPOCH_IN_MS{
     ReadFromConstantsFile("DELAY_FIRSTXNEPOCH_IN_MS")};
 const unsigned int TXN_MISORDER_TOLERANCE_IN_PERCENT{
     ReadFromConstantsFile("TXN_MISORDER_TOLERANCE_IN_PERCENT")};
 const unsigned int SYS_TIMESTAMP_VARIANCE_IN_SECONDS{
     ReadFromConstantsFile("SYS_TIMESTAMP_VARIANCE_IN_SECONDS")};
+const unsigned int SYNC_VERIFY_THREADS{
+    ReadFromConstantsFile("SYNC_VERIFY_THREADS")};
+const unsigned int MICROBLOCK_VERIFY_THREADS{
+    ReadFromConstantsFile("MICROBLOCK_VERIFY_THREADS")};
+const unsigned int TXBLOCK_SYNC_WINDOW_SIZE{
+    ReadFromConstantsFile("TXBLOCK_SYNC_WINDOW_SIZE")};
+const unsigned int TXBLOCK_SYNC_MAX_INFLIGHT{
+    ReadFromConstantsFile("TXBLOCK_SYNC_MAX_INFLIGHT")};
+const unsigned int TXBLOCK_SYNC_TIMEOUT_IN_SECONDS{
+    ReadFromConstantsFile("TXBLOCK_SYNC_TIMEOUT_IN_SECONDS")};
+const unsigned int LEVELDB_BLOCK_CACHE_SIZE_MB{
+    ReadFromConstantsFile("LEVELDB_BLOCK_CACHE_SIZE_MB")};
+const unsigned int LEVELDB_WRITE_BUFFER_SIZE_MB{
+    ReadFromConstantsFile("LEVELDB_WRITE_BUFFER_SIZE_MB")};
+const unsigned int LEVELDB_BLOOM_FILTER_BITS{
+    ReadFromConstantsFile("LEVELDB_BLOOM_FILTER_BITS")};
+const unsigned int TXBODY_FILTER_SIZE_MB{
+    ReadFromConstantsFile("TXBODY_FILTER_SIZE_MB")};
+const unsigned int PROCESSED_TXN_MEMORY_EPOCHS{
+    ReadFromConstantsFile("PROCESSED_TXN_MEMORY_EPOCHS")};
+const unsigned int PROCESSED_TXN_DISK_EPOCHS{
+    ReadFromConstantsFile("PROCESSED_TXN_DISK_EPOCHS")};
+const unsigned int POW_CPU_MINING_THREADS{
+    ReadFromConstantsFile("POW_CPU_MINING_THREADS")};
+const unsigned int POW_VERIFY_THREADS{
+    ReadFromConstantsFile("POW_VERIFY_THREADS")};
+const unsigned int RPC_RESPONSE_CACHE_SIZE_MB{
+    ReadFromConstantsFile("RPC_RESPONSE_CACHE_SIZE_MB")};
+const unsigned int RPC_HTTP_THREADS{ReadFromConstantsFile("RPC_HTTP_THREADS")};
+const unsigned int RPC_BATCH_THREADS{
+    ReadFromConstantsFile("RPC_BATCH_THREADS")};
+const unsigned int RPC_BATCH_MAX_SIZE{
+    ReadFromConstantsFile("RPC_BATCH_MAX_SIZE")};
+const unsigned int SUBSCRIPTION_QUEUE_SIZE{
+    ReadFromConstantsFile("SUBSCRIPTION_QUEUE_SIZE")};
+const unsigned int SUBSCRIPTION_MAX_CLIENTS{
+    ReadFromConstantsFile("SUBSCRIPTION_MAX_CLIENTS")};
+const unsigned int SUBSCRIPTION_REQUEST_TIMEOUT_IN_SECONDS{
+    ReadFromConstantsFile("SUBSCRIPTION_REQUEST_TIMEOUT_IN_SECONDS")};
+const unsigned int METRICS_PORT{ReadFromConstantsFile("METRICS_PORT")};
+const unsigned int P2P_COMPRESSION_THRESHOLD{
+    ReadFromConstantsFile("P2P_COMPRESSION_THRESHOLD")};
+const unsigned int P2P_COMPRESSION_LEVEL{
+    ReadFromConstantsFile("P2P_COMPRESSION_LEVEL")};
+const unsigned int P2P_MAX_DECOMPRESSED_SIZE_MB{
+    ReadFromConstantsFile("P2P_MAX_DECOMPRESSED_SIZE_MB")};
+const unsigned int P2P_MAX_COMPRESSION_RATIO{
+    ReadFromConstantsFile("P2P_MAX_COMPRESSION_RATIO")};
+const unsigned int P2P_BROADCAST_TREE_FANOUT{
+    ReadFromConstantsFile("P2P_BROADCAST_TREE_FANOUT")};
+const unsigned int P2P_CHUNKED_BROADCAST_THRESHOLD{
+    ReadFromConstantsFile("P2P_CHUNKED_BROADCAST_THRESHOLD")};
+const unsigned int P2P_CHUNK_DATA_SHARDS{
+    ReadFromConstantsFile("P2P_CHUNK_DATA_SHARDS")};
+const unsigned int P2P_CHUNK_PARITY_SHARDS{
+    ReadFromConstantsFile("P2P_CHUNK_PARITY_SHARDS")};
 
 #ifdef FALLBACK_TEST
 const unsigned int FALLBACK_TEST_EPOCH{
@@ -253,6 +315,12 @@ const bool ARCHIVAL_NODE{ReadFromOptionsFile("ARCHIVAL_NODE") == "true"};
 const bool SEND_RESPONSE_FOR_LAZY_PUSH{
     ReadFromOptionsFile("SEND_RESPONSE_FOR_LAZY_PUSH") == "true"};
 const bool ENABLE_FALLBACK{ReadFromOptionsFile("ENABLE_FALLBACK") == "true"};
+const bool UNIFIED_BLOCK_STORAGE{ReadFromOptionsFile("UNIFIED_BLOCK_STORAGE") ==
+                                 "true"};
+const bool POW_PIN_MINING_THREADS{
+    ReadFromOptionsFile("POW_PIN_MINING_THREADS") == "true"};
+const bool POW_EPOCH_CONTEXT_CACHE{
+    ReadFromOptionsFile("POW_EPOCH_CONTEXT_CACHE") == "true"};
 
 // gas
 const unsigned int MICROBLOCK_GAS_LIMIT{
@@ -65,6 +65,7 @@ const unsigned int PORT_SIZE = 4;
 
 const unsigned int NUM_PEERS_TO_SEND_IN_A_SHARD = 20;
 const unsigned int SERVER_PORT = 4201;
+const unsigned int SUBSCRIPTION_PORT = 4202;
 
 // Number of initial ds epoch number, including genesis epoch
 const unsigned int INIT_DS_EPOCH_NUM = 2;
@@ -77,6 +78,7 @@ enum MetaType : unsigned char {
   DSINCOMPLETED,
   LATESTACTIVEDSBLOCKNUM,
   WAKEUPFORUPGRADE,
+  DSCOMMCHECKPOINT,
 };
 
 // Sync Type
@@ -97,6 +99,7 @@ const std::string RAND2_GENESIS =
 const std::string REMOTE_TEST_DIR = "zilliqa-test";
 const std::string PERSISTENCE_PATH = "persistence";
 const std::string TX_BODY_SUBDIR = "txBodies";
+const std::string ETHASH_CACHE_PATH = "ethashCache";
 
 const std::string DS_KICKOUT_MSG = "KICKED OUT FROM DS";
 const std::string DS_LEADER_MSG = "DS LEADER NOW";
@@ -186,9 +189,41 @@ extern const unsigned int SIMULATED_NETWORK_DELAY_IN_MS;
 extern const unsigned int POW_PACKET_SENDERS;
 extern const unsigned int POWPACKETSUBMISSION_WINDOW_IN_SECONDS;
 extern const unsigned int LOOKUP_DELAY_SEND_TXNPACKET_IN_MS;
+extern const unsigned int TXN_INGRESS_QUEUE_SIZE;
+extern const unsigned int TXN_INGRESS_SENDER_MAX_TXNS;
+extern const unsigned int TXN_INGRESS_SENDER_MAX_BYTES;
 extern const unsigned int DELAY_FIRSTXNEPOCH_IN_MS;
 extern const unsigned int TXN_MISORDER_TOLERANCE_IN_PERCENT;
 extern const unsigned int SYS_TIMESTAMP_VARIANCE_IN_SECONDS;
+extern const unsigned int SYNC_VERIFY_THREADS;
+extern const unsigned int MICROBLOCK_VERIFY_THREADS;
+extern const unsigned int TXBLOCK_SYNC_WINDOW_SIZE;
+extern const unsigned int TXBLOCK_SYNC_MAX_INFLIGHT;
+extern const unsigned int TXBLOCK_SYNC_TIMEOUT_IN_SECONDS;
+extern const unsigned int LEVELDB_BLOCK_CACHE_SIZE_MB;
+extern const unsigned int LEVELDB_WRITE_BUFFER_SIZE_MB;
+extern const unsigned int LEVELDB_BLOOM_FILTER_BITS;
+extern const unsigned int TXBODY_FILTER_SIZE_MB;
+extern const unsigned int PROCESSED_TXN_MEMORY_EPOCHS;
+extern const unsigned int PROCESSED_TXN_DISK_EPOCHS;
+extern const unsigned int POW_CPU_MINING_THREADS;
+extern const unsigned int POW_VERIFY_THREADS;
+extern const unsigned int RPC_RESPONSE_CACHE_SIZE_MB;
+extern const unsigned int RPC_HTTP_THREADS;
+extern const unsigned int RPC_BATCH_THREADS;
+extern const unsigned int RPC_BATCH_MAX_SIZE;
+extern const unsigned int SUBSCRIPTION_QUEUE_SIZE;
+extern const unsigned int SUBSCRIPTION_MAX_CLIENTS;
+extern const unsigned int SUBSCRIPTION_REQUEST_TIMEOUT_IN_SECONDS;
+extern const unsigned int METRICS_PORT;
+extern const unsigned int P2P_COMPRESSION_THRESHOLD;
+extern const unsigned int P2P_COMPRESSION_LEVEL;
+extern const unsigned int P2P_MAX_DECOMPRESSED_SIZE_MB;
+extern const unsigned int P2P_MAX_COMPRESSION_RATIO;
+extern const unsigned int P2P_BROADCAST_TREE_FANOUT;
+extern const unsigned int P2P_CHUNKED_BROADCAST_THRESHOLD;
+extern const unsigned int P2P_CHUNK_DATA_SHARDS;
+extern const unsigned int P2P_CHUNK_PARITY_SHARDS;
 
 // gas
 extern const unsigned int MICROBLOCK_GAS_LIMIT;
@@ -228,6 +263,9 @@ extern const std::string UPGRADE_HOST_ACCOUNT;
 extern const std::string UPGRADE_HOST_REPO;
 extern const bool SEND_RESPONSE_FOR_LAZY_PUSH;
 extern const bool ENABLE_FALLBACK;
+extern const bool UNIFIED_BLOCK_STORAGE;
+extern const bool POW_PIN_MINING_THREADS;
+extern const bool POW_EPOCH_CONTEXT_CACHE;
 
 extern const std::vector<std::string> GENESIS_WALLETS;
 extern const std::vector<std::string> GENESIS_KEYS;
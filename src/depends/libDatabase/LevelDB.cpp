@@ -14,9 +14,12 @@
 * and which include a reference to GPLv3 in their program files.
 **/
 
+#include <algorithm>
 #include <string>
 
 #include <boost/filesystem.hpp>
+#include <leveldb/cache.h>
+#include <leveldb/filter_policy.h>
 
 #include "LevelDB.h"
 #include "common/Constants.h"
@@ -26,6 +29,156 @@
 
 using namespace std;
 
+namespace
+{
+/// Iterator over the keys of one column of a shared database, with the column
+/// prefix stripped from the keys.
+class ColumnIterator : public leveldb::Iterator
+{
+    std::unique_ptr<leveldb::Iterator> m_it;
+    const string m_prefix;
+
+public:
+    ColumnIterator(leveldb::Iterator* it, const string & prefix)
+        : m_it(it), m_prefix(prefix)
+    {
+    }
+
+    bool Valid() const override
+    {
+        return m_it->Valid() && m_it->key().starts_with(m_prefix);
+    }
+
+    void SeekToFirst() override { m_it->Seek(m_prefix); }
+
+    void SeekToLast() override
+    {
+        // Prefixes end with a separator, so bumping it gives the first key
+        // past the column
+        string end = m_prefix;
+        end.back()++;
+        m_it->Seek(end);
+        if (m_it->Valid())
+        {
+            m_it->Prev();
+        }
+        else
+        {
+            m_it->SeekToLast();
+        }
+    }
+
+    void Seek(const leveldb::Slice & target) override
+    {
+        m_it->Seek(m_prefix + target.ToString());
+    }
+
+    void Next() override { m_it->Next(); }
+
+    void Prev() override { m_it->Prev(); }
+
+    leveldb::Slice key() const override
+    {
+        leveldb::Slice key = m_it->key();
+        key.remove_prefix(m_prefix.size());
+        return key;
+    }
+
+    leveldb::Slice value() const override { return m_it->value(); }
+
+    leveldb::Status status() const override { return m_it->status(); }
+};
+}
+
+leveldb::Options LevelDB::GetOptions()
+{
+    // Shared by every database in the process and never freed, as they must
+    // outlive all databases using them
+    static leveldb::Cache* blockCache =
+        leveldb::NewLRUCache((size_t)LEVELDB_BLOCK_CACHE_SIZE_MB << 20);
+    static const leveldb::FilterPolicy* filterPolicy =
+        (LEVELDB_BLOOM_FILTER_BITS > 0) ? leveldb::NewBloomFilterPolicy(LEVELDB_BLOOM_FILTER_BITS)
+                                        : nullptr;
+
+    leveldb::Options options;
+    options.max_open_files = 256;
+    options.create_if_missing = true;
+    options.block_cache = blockCache;
+    options.filter_policy = filterPolicy;
+    options.write_buffer_size = (size_t)LEVELDB_WRITE_BUFFER_SIZE_MB << 20;
+    return options;
+}
+
+shared_ptr<leveldb::DB> LevelDB::OpenSharedDB(const string & dbName)
+{
+    if (!(boost::filesystem::exists("./" + PERSISTENCE_PATH)))
+    {
+        boost::filesystem::create_directories("./" + PERSISTENCE_PATH);
+    }
+
+    leveldb::DB* db = nullptr;
+    leveldb::Status status = leveldb::DB::Open(GetOptions(), "./" + PERSISTENCE_PATH + "/" + dbName, &db);
+    if(!status.ok())
+    {
+        LOG_GENERAL(WARNING, "LevelDB status is not OK.");
+    }
+
+    return shared_ptr<leveldb::DB>(db);
+}
+
+LevelDB::LevelDB(const shared_ptr<leveldb::DB> & sharedDB, const string & dbName,
+                 const string & column)
+{
+    this->m_dbName = dbName;
+    this->m_db = sharedDB;
+    this->m_keyPrefix = column + "/";
+}
+
+string LevelDB::ColumnKey(const leveldb::Slice & key) const
+{
+    return m_keyPrefix + key.ToString();
+}
+
+leveldb::Iterator* LevelDB::NewIterator() const
+{
+    leveldb::Iterator* it = m_db->NewIterator(leveldb::ReadOptions());
+    if (m_keyPrefix.empty())
+    {
+        return it;
+    }
+    return new ColumnIterator(it, m_keyPrefix);
+}
+
+void LevelDB::BatchPut(leveldb::WriteBatch & batch, const boost::multiprecision::uint256_t & blockNum,
+                       const vector<unsigned char> & body) const
+{
+    batch.Put(ColumnKey(blockNum.convert_to<string>()),
+              leveldb::Slice((const char*)body.data(), body.size()));
+}
+
+void LevelDB::BatchPut(leveldb::WriteBatch & batch, const dev::h256 & key,
+                       const vector<unsigned char> & body) const
+{
+    batch.Put(ColumnKey(key.hex()), leveldb::Slice((const char*)body.data(), body.size()));
+}
+
+void LevelDB::BatchPut(leveldb::WriteBatch & batch, const string & key,
+                       const vector<unsigned char> & body) const
+{
+    batch.Put(ColumnKey(key), leveldb::Slice((const char*)body.data(), body.size()));
+}
+
+int LevelDB::CommitBatch(leveldb::WriteBatch & batch)
+{
+    leveldb::Status s = m_db->Write(leveldb::WriteOptions(), &batch);
+    if (!s.ok())
+    {
+        return -1;
+    }
+
+    return 0;
+}
+
 LevelDB::LevelDB(const string & dbName, const string & subdirectory)
 {
     this->m_subdirectory = subdirectory;
@@ -36,9 +189,7 @@ LevelDB::LevelDB(const string & dbName, const string & subdirectory)
         boost::filesystem::create_directories("./" + PERSISTENCE_PATH);
     }
 
-    leveldb::Options options;
-    options.max_open_files = 256;
-    options.create_if_missing = true;
+    leveldb::Options options = GetOptions();
 
     leveldb::DB* db;
     leveldb::Status status;
@@ -90,7 +241,7 @@ string LevelDB::GetDBName()
 string LevelDB::Lookup(const std::string & key) const
 {
     string value;
-    leveldb::Status s = m_db->Get(leveldb::ReadOptions(), key, &value);
+    leveldb::Status s = m_db->Get(leveldb::ReadOptions(), ColumnKey(key), &value);
     if (!s.ok())
     {
         // TODO
@@ -103,7 +254,7 @@ string LevelDB::Lookup(const std::string & key) const
 string LevelDB::Lookup(const boost::multiprecision::uint256_t & blockNum) const
 {
     string value;
-    leveldb::Status s = m_db->Get(leveldb::ReadOptions(), blockNum.convert_to<string>(), &value);
+    leveldb::Status s = m_db->Get(leveldb::ReadOptions(), ColumnKey(blockNum.convert_to<string>()), &value);
 
     if (!s.ok())
     {
@@ -117,7 +268,7 @@ string LevelDB::Lookup(const boost::multiprecision::uint256_t & blockNum) const
 string LevelDB::Lookup(const dev::h256 & key) const
 {
     string value;
-    leveldb::Status s = m_db->Get(leveldb::ReadOptions(), leveldb::Slice(key.hex()), &value);
+    leveldb::Status s = m_db->Get(leveldb::ReadOptions(), ColumnKey(key.hex()), &value);
     if (!s.ok())
     {
         // TODO
@@ -130,7 +281,7 @@ string LevelDB::Lookup(const dev::h256 & key) const
 string LevelDB::Lookup(const dev::bytesConstRef & key) const
 {
     string value;
-    leveldb::Status s = m_db->Get(leveldb::ReadOptions(), ldb::Slice((char const*)key.data(), 32), 
+    leveldb::Status s = m_db->Get(leveldb::ReadOptions(), ColumnKey(ldb::Slice((char const*)key.data(), 32)), 
                                   &value);
     if (!s.ok())
     {
@@ -141,6 +292,38 @@ string LevelDB::Lookup(const dev::bytesConstRef & key) const
     return value;
 }
 
+vector<string> LevelDB::BatchLookup(const vector<dev::h256> & keys) const
+{
+    vector<string> values(keys.size());
+    if (keys.empty())
+    {
+        return values;
+    }
+
+    // Read in key order so that keys sharing a table block hit the block cache
+    vector<pair<string, size_t>> columnKeys;
+    columnKeys.reserve(keys.size());
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        columnKeys.emplace_back(ColumnKey(keys[i].hex()), i);
+    }
+    sort(columnKeys.begin(), columnKeys.end());
+
+    leveldb::ReadOptions options;
+    options.snapshot = m_db->GetSnapshot();
+    for (const auto & columnKey : columnKeys)
+    {
+        leveldb::Status s = m_db->Get(options, columnKey.first, &values[columnKey.second]);
+        if (!s.ok())
+        {
+            values[columnKey.second].clear();
+        }
+    }
+    m_db->ReleaseSnapshot(options.snapshot);
+
+    return values;
+}
+
 std::shared_ptr<leveldb::DB> LevelDB::GetDB()
 {
     return this->m_db;
@@ -155,7 +338,7 @@ int LevelDB::Insert(const boost::multiprecision::uint256_t & blockNum,
                     const vector<unsigned char> & body)
 {
     leveldb::Status s = m_db->Put(leveldb::WriteOptions(), 
-                                  leveldb::Slice(blockNum.convert_to<string>()), 
+                                  ColumnKey(blockNum.convert_to<string>()), 
                                   leveldb::Slice(vector_ref<const unsigned char>(&body[0], 
                                                                                  body.size())));
 
@@ -171,7 +354,7 @@ int LevelDB::Insert(const boost::multiprecision::uint256_t & blockNum,
                     const std::string & body)
 {
     leveldb::Status s = m_db->Put(leveldb::WriteOptions(), 
-                                  leveldb::Slice(blockNum.convert_to<string>()), 
+                                  ColumnKey(blockNum.convert_to<string>()), 
                                   leveldb::Slice(body.c_str(), body.size()));
 
     if (!s.ok())
@@ -189,7 +372,7 @@ int LevelDB::Insert(const string & key, const vector<unsigned char> & body)
 
 int LevelDB::Insert(const leveldb::Slice & key, dev::bytesConstRef value)
 {
-    leveldb::Status s = m_db->Put(leveldb::WriteOptions(), key, ldb::Slice(value));
+    leveldb::Status s = m_db->Put(leveldb::WriteOptions(), ColumnKey(key), ldb::Slice(value));
     if (!s.ok())
     {
         return -1;
@@ -201,7 +384,7 @@ int LevelDB::Insert(const leveldb::Slice & key, dev::bytesConstRef value)
 int LevelDB::Insert(const dev::h256 & key, const string & value)
 {
     leveldb::Status s = m_db->Put(leveldb::WriteOptions(), 
-                                  ldb::Slice((char const*)key.data(), key.size), 
+                                  ColumnKey(ldb::Slice((char const*)key.data(), key.size)), 
                                   ldb::Slice(value.data(), value.size()));
     if (!s.ok())
     {
@@ -213,7 +396,7 @@ int LevelDB::Insert(const dev::h256 & key, const string & value)
 
 int LevelDB::Insert(const dev::h256 & key, const vector<unsigned char> & body)
 {
-    leveldb::Status s = m_db->Put(leveldb::WriteOptions(), leveldb::Slice(key.hex()), 
+    leveldb::Status s = m_db->Put(leveldb::WriteOptions(), ColumnKey(key.hex()), 
                                   leveldb::Slice(vector_ref<const unsigned char>(&body[0], 
                                                                                  body.size())));
     if (!s.ok())
@@ -226,7 +409,7 @@ int LevelDB::Insert(const dev::h256 & key, const vector<unsigned char> & body)
 
 int LevelDB::Insert(const leveldb::Slice & key, const leveldb::Slice & value)
 {
-    leveldb::Status s = m_db->Put(leveldb::WriteOptions(), key, value);
+    leveldb::Status s = m_db->Put(leveldb::WriteOptions(), ColumnKey(key), value);
     if (!s.ok())
     {
         return -1;
@@ -244,7 +427,7 @@ int LevelDB::BatchInsert(std::unordered_map<dev::h256, std::pair<std::string, un
     {
         if (i.second.second)
         {
-            batch.Put(leveldb::Slice(i.first.hex()), 
+            batch.Put(ColumnKey(i.first.hex()), 
                       leveldb::Slice(i.second.first.data(), i.second.first.size()));
         }
     }
@@ -255,7 +438,7 @@ int LevelDB::BatchInsert(std::unordered_map<dev::h256, std::pair<std::string, un
         {
             dev::bytes b = i.first.asBytes();
             b.push_back(255);   // for aux
-            batch.Put(dev::bytesConstRef(&b), dev::bytesConstRef(&i.second.first));
+            batch.Put(ColumnKey(dev::bytesConstRef(&b)), dev::bytesConstRef(&i.second.first));
         }
     }
 
@@ -289,7 +472,7 @@ bool LevelDB::Exists(const std::string & key) const
 
 int LevelDB::DeleteKey(const dev::h256 & key)
 {
-    leveldb::Status s = m_db->Delete(leveldb::WriteOptions(), ldb::Slice(key.hex()));
+    leveldb::Status s = m_db->Delete(leveldb::WriteOptions(), ColumnKey(key.hex()));
     if (!s.ok())
     {
         return -1;
@@ -300,7 +483,7 @@ int LevelDB::DeleteKey(const dev::h256 & key)
 
 int LevelDB::DeleteKey(const boost::multiprecision::uint256_t & blockNum)
 {
-    leveldb::Status s = m_db->Delete(leveldb::WriteOptions(), ldb::Slice(blockNum.convert_to<string>()));
+    leveldb::Status s = m_db->Delete(leveldb::WriteOptions(), ColumnKey(blockNum.convert_to<string>()));
     if (!s.ok())
     {
         return -1;
@@ -311,7 +494,7 @@ int LevelDB::DeleteKey(const boost::multiprecision::uint256_t & blockNum)
 
 int LevelDB::DeleteKey(const std::string & key)
 {
-    leveldb::Status s = m_db->Delete(leveldb::WriteOptions(), ldb::Slice(key));
+    leveldb::Status s = m_db->Delete(leveldb::WriteOptions(), ColumnKey(key));
     if(!s.ok())
     {
         return -1;
@@ -320,9 +503,24 @@ int LevelDB::DeleteKey(const std::string & key)
     return 0;
 }
 
+int LevelDB::DeleteColumn()
+{
+    leveldb::WriteBatch batch;
+    std::unique_ptr<leveldb::Iterator> it(NewIterator());
+    for (it->SeekToFirst(); it->Valid(); it->Next())
+    {
+        batch.Delete(ColumnKey(it->key()));
+    }
+    return CommitBatch(batch);
+}
+
 int LevelDB::DeleteDB()
 {
-    if (LOOKUP_NODE_MODE)
+    if (!m_keyPrefix.empty())
+    {
+        return DeleteColumn();
+    }
+    else if (LOOKUP_NODE_MODE)
     {
         return DeleteDBForLookupNode();
     }
@@ -334,7 +532,11 @@ int LevelDB::DeleteDB()
 
 bool LevelDB::ResetDB()
 {
-    if (LOOKUP_NODE_MODE)
+    if (!m_keyPrefix.empty())
+    {
+        return DeleteColumn() == 0;
+    }
+    else if (LOOKUP_NODE_MODE)
     {
         return ResetDBForLookupNode();
     }
@@ -370,13 +572,9 @@ bool LevelDB::ResetDBForNormalNode()
     {
         boost::filesystem::remove_all("./" + PERSISTENCE_PATH + "/" + this->m_dbName);
 
-        leveldb::Options options;
-        options.max_open_files = 256;
-        options.create_if_missing = true;
-
         leveldb::DB* db;
 
-        leveldb::Status status = leveldb::DB::Open(options, "./" + PERSISTENCE_PATH + "/" + this->m_dbName, &db);
+        leveldb::Status status = leveldb::DB::Open(GetOptions(), "./" + PERSISTENCE_PATH + "/" + this->m_dbName, &db);
         if(!status.ok())
         {
             // throw exception();
@@ -414,13 +612,9 @@ bool LevelDB::ResetDBForLookupNode()
     {
         boost::filesystem::remove_all("./" + PERSISTENCE_PATH + "/" + this->m_dbName);
 
-        leveldb::Options options;
-        options.max_open_files = 256;
-        options.create_if_missing = true;
-
         leveldb::DB* db;
 
-        leveldb::Status status = leveldb::DB::Open(options, "./" + PERSISTENCE_PATH + "/" + this->m_dbName, &db);
+        leveldb::Status status = leveldb::DB::Open(GetOptions(), "./" + PERSISTENCE_PATH + "/" + this->m_dbName, &db);
         if(!status.ok())
         {
             // throw exception();
@@ -24,6 +24,7 @@
 #include <vector>
 
 #include <leveldb/db.h>
+#include <leveldb/write_batch.h>
 
 #include "depends/common/Common.h"
 #include "depends/common/FixedHash.h"
@@ -39,12 +40,30 @@ class LevelDB
     std::string m_subdirectory;
 
     std::shared_ptr<leveldb::DB> m_db;
+
+    /// Prepended to every key when this instance is a column of a shared database.
+    std::string m_keyPrefix;
+
+    std::string ColumnKey(const leveldb::Slice & key) const;
+    int DeleteColumn();
     
 public:
 
     /// Constructor.
     explicit LevelDB(const std::string & dbName, const std::string & subdirectory = "");
 
+    /// Constructor for a column of a database shared with other columns (see
+    /// OpenSharedDB). The column's keys are stored under its own prefix.
+    LevelDB(const std::shared_ptr<leveldb::DB> & sharedDB, const std::string & dbName,
+            const std::string & column);
+
+    /// Returns the options for opening a database. All databases share one LRU
+    /// block cache and bloom filter policy.
+    static leveldb::Options GetOptions();
+
+    /// Opens a database to be shared by several columns.
+    static std::shared_ptr<leveldb::DB> OpenSharedDB(const std::string & dbName);
+
     /// Destructor.
     ~LevelDB() = default;
 
@@ -53,6 +72,21 @@ public:
 
     /// Returns the DB Name
     std::string GetDBName();
+
+    /// Returns an iterator over the keys of this instance (without any column prefix).
+    leveldb::Iterator* NewIterator() const;
+
+    /// Adds an insert to the batch, with the key encoded as by the matching Insert.
+    void BatchPut(leveldb::WriteBatch & batch, const boost::multiprecision::uint256_t & blockNum,
+                  const std::vector<unsigned char> & body) const;
+    void BatchPut(leveldb::WriteBatch & batch, const dev::h256 & key,
+                  const std::vector<unsigned char> & body) const;
+    void BatchPut(leveldb::WriteBatch & batch, const std::string & key,
+                  const std::vector<unsigned char> & body) const;
+
+    /// Applies all writes in the batch atomically. The batch may hold writes for any
+    /// column sharing this instance's database.
+    int CommitBatch(leveldb::WriteBatch & batch);
     
     /// Returns the value at the specified key.
     std::string Lookup(const std::string & key) const;
@@ -66,6 +100,10 @@ public:
     /// Returns the value at the specified key.
     std::string Lookup(const dev::bytesConstRef & key) const;
 
+    /// Returns the values at the specified keys (empty where absent), all read from
+    /// the same snapshot of the database.
+    std::vector<std::string> BatchLookup(const std::vector<dev::h256> & keys) const;
+
     /// Sets the value at the specified key.
     int Insert(const dev::h256 & key, dev::bytesConstRef value);
 
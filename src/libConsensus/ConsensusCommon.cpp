@@ -135,6 +135,25 @@ PubKey ConsensusCommon::AggregateKeys(const vector<bool>& peer_map) {
   return *result;
 }
 
+PubKey ConsensusCommon::AggregateKeys(const CommitteeBitmap& peer_map) {
+  LOG_MARKER();
+
+  vector<PubKey> keys;
+  keys.reserve(peer_map.count());
+  deque<pair<PubKey, Peer>>::const_iterator j = m_committee.begin();
+  for (unsigned int i = 0; i < peer_map.size(); i++, j++) {
+    if (peer_map.test(i)) {
+      keys.emplace_back(j->first);
+    }
+  }
+  shared_ptr<PubKey> result = MultiSig::AggregatePubKeys(keys);
+  if (result == nullptr) {
+    return PubKey();
+  }
+
+  return *result;
+}
+
 CommitPoint ConsensusCommon::AggregateCommits(
     const vector<CommitPoint>& commits) {
   LOG_MARKER();
@@ -27,6 +27,7 @@
 #include <string>
 #include <vector>
 
+#include "ConsensusRoundState.h"
 #include "libCrypto/MultiSig.h"
 #include "libNetwork/PeerStore.h"
 #include "libUtils/TimeLockedFunction.h"
@@ -177,6 +178,9 @@ class ConsensusCommon {
   /// Aggregates public keys according to the response map.
   PubKey AggregateKeys(const std::vector<bool>& peer_map);
 
+  /// Aggregates public keys according to the committee bitmap.
+  PubKey AggregateKeys(const CommitteeBitmap& peer_map);
+
   /// Aggregates the list of received commits.
   CommitPoint AggregateCommits(const std::vector<CommitPoint>& commits);
 
@@ -101,13 +101,34 @@ void ConsensusLeader::SetStateSubset(uint16_t subsetID, State newState) {
   }
 }
 
+ConsensusLeader::RoundState::RoundState(unsigned int committeeSize)
+    : arena(CommitPointArray::GetArenaSize(committeeSize) +
+            NUM_CONSENSUS_SUBSETS *
+                (CommitPointArray::GetArenaSize(committeeSize) +
+                 ResponseArray::GetArenaSize(committeeSize))),
+      commitPoints(arena, committeeSize) {}
+
+void ConsensusLeader::StartNewRound() {
+  LOG_MARKER();
+
+  // Subsets of the current round stay referenced until they are regenerated,
+  // so its arena is only released then
+  m_prevRound = move(m_round);
+  m_round.reset(new RoundState(m_committee.size()));
+
+  // Add the leader to the commits
+  m_round->commitPoints.Put(m_myID, *m_commitPoint);
+  m_commitCounter = 1;
+}
+
 void ConsensusLeader::GenerateConsensusSubsets() {
   LOG_MARKER();
 
   // Get the list of all the peers who committed, by peer index
   vector<unsigned int> peersWhoCommitted;
-  for (unsigned int index = 0; index < m_commitMap.size(); index++) {
-    if (m_commitMap.at(index) && index != m_myID) {
+  const CommitteeBitmap& commitMap = m_round->commitPoints.GetMap();
+  for (unsigned int index = 0; index < commitMap.size(); index++) {
+    if (commitMap.test(index) && index != m_myID) {
       peersWhoCommitted.push_back(index);
     }
   }
@@ -123,48 +144,34 @@ void ConsensusLeader::GenerateConsensusSubsets() {
                         << m_numForConsensus << " numSubsets:" << numSubsets);
 
   m_consensusSubsets.clear();
+  // The subsets of the previous round are gone, so its arena can go too
+  m_prevRound.reset();
   m_consensusSubsets.resize(numSubsets);
 
   for (unsigned int i = 0; i < numSubsets; i++) {
     ConsensusSubset& subset = m_consensusSubsets.at(i);
-    subset.commitMap.resize(m_committee.size());
-    fill(subset.commitMap.begin(), subset.commitMap.end(), false);
-    subset.commitPointMap.resize(m_committee.size());
-    subset.commitPoints.clear();
-    subset.responseCounter = 0;
-    subset.responseDataMap.resize(m_committee.size());
-    subset.responseMap.resize(m_committee.size());
-    fill(subset.responseMap.begin(), subset.responseMap.end(), false);
-    subset.responseData.clear();
+    subset.commitPoints = CommitPointArray(m_round->arena, m_committee.size());
+    subset.responses = ResponseArray(m_round->arena, m_committee.size());
 
     subset.state = m_state;
     // add myself to subset commit map always
-    subset.commitPointMap.at(m_myID) = m_commitPointMap.at(m_myID);
-    subset.commitPoints.emplace_back(m_commitPointMap.at(m_myID));
-    subset.commitMap.at(m_myID) = true;
+    subset.commitPoints.CopyFrom(m_round->commitPoints, m_myID);
 
     for (unsigned int j = 0; j < m_numForConsensus - 1; j++) {
-      unsigned int index = peersWhoCommitted.at(j);
-      subset.commitPointMap.at(index) = m_commitPointMap.at(index);
-      subset.commitPoints.emplace_back(m_commitPointMap.at(index));
-      subset.commitMap.at(index) = true;
+      subset.commitPoints.CopyFrom(m_round->commitPoints,
+                                   peersWhoCommitted.at(j));
     }
 
     if (DEBUG_LEVEL >= 5) {
       LOG_GENERAL(INFO, "SubsetID: " << i);
-      for (unsigned int k = 0; k < subset.commitMap.size(); k++) {
+      for (unsigned int k = 0; k < subset.commitPoints.size(); k++) {
         LOG_GENERAL(INFO,
-                    "Commit map " << k << " = " << subset.commitMap.at(k));
+                    "Commit map " << k << " = " << subset.commitPoints.Has(k));
       }
     }
 
     random_shuffle(peersWhoCommitted.begin(), peersWhoCommitted.end());
   }
-  // Clear out the original commit map stuff, we don't need it anymore at this
-  // point
-  m_commitPointMap.clear();
-  m_commitPoints.clear();
-  m_commitMap.clear();
   LOG_GENERAL(INFO, "Generated " << numSubsets << " subsets of "
                                  << m_numForConsensus
                                  << " backups each for this consensus");
@@ -201,11 +208,8 @@ void ConsensusLeader::StartConsensusSubsets() {
       SetStateSubset(index, m_state);
 
       // Add the leader to the responses
-      Response r(*m_commitSecret, subset.challenge, m_myPrivKey);
-      subset.responseData.emplace_back(r);
-      subset.responseDataMap.at(m_myID) = r;
-      subset.responseMap.at(m_myID) = true;
-      subset.responseCounter = 1;
+      subset.responses.Put(
+          m_myID, Response(*m_commitSecret, subset.challenge, m_myPrivKey));
 
       if (BROADCAST_GOSSIP_MODE) {
         // Gossip challenge within my all peers
@@ -215,8 +219,8 @@ void ConsensusLeader::StartConsensusSubsets() {
         vector<Peer> commit_peers;
         deque<pair<PubKey, Peer>>::const_iterator j = m_committee.begin();
 
-        for (unsigned int i = 0; i < subset.commitMap.size(); i++, j++) {
-          if ((subset.commitMap.at(i)) && (i != m_myID)) {
+        for (unsigned int i = 0; i < subset.commitPoints.size(); i++, j++) {
+          if ((subset.commitPoints.Has(i)) && (i != m_myID)) {
             commit_peers.emplace_back(j->second);
           }
         }
@@ -288,7 +292,7 @@ bool ConsensusLeader::ProcessMessageCommitCore(
     return false;
   }
 
-  if (m_commitMap.at(backupID)) {
+  if (m_round->commitPoints.Has(backupID)) {
     LOG_GENERAL(WARNING, "Backup has already sent validated commit");
     return false;
   }
@@ -309,9 +313,7 @@ bool ConsensusLeader::ProcessMessageCommitCore(
   }
 
   // 33-byte commit
-  m_commitPoints.emplace_back(commitPoint);
-  m_commitPointMap.at(backupID) = commitPoint;
-  m_commitMap.at(backupID) = true;
+  m_round->commitPoints.Put(backupID, commitPoint);
 
   m_commitCounter++;
 
@@ -320,13 +322,6 @@ bool ConsensusLeader::ProcessMessageCommitCore(
                                   << m_numForConsensus << ".");
   }
 
-  // Redundant commits
-  if (m_commitCounter > m_numForConsensus) {
-    m_commitRedundantPointMap.at(backupID) = commitPoint;
-    m_commitRedundantMap.at(backupID) = true;
-    m_commitRedundantCounter++;
-  }
-
   if (NUM_CONSENSUS_SUBSETS > 1) {
     // notify the waiting thread to start with subset creations and subset
     // consensus.
@@ -416,14 +411,15 @@ bool ConsensusLeader::GenerateChallengeMessage(vector<unsigned char>& challenge,
   ConsensusSubset& subset = m_consensusSubsets.at(subsetID);
 
   // Aggregate commits
-  CommitPoint aggregated_commit = AggregateCommits(subset.commitPoints);
+  CommitPoint aggregated_commit =
+      AggregateCommits(subset.commitPoints.GetAll());
   if (!aggregated_commit.Initialized()) {
     LOG_GENERAL(WARNING, "[Subset " << subsetID << "] AggregateCommits failed");
     return false;
   }
 
   // Aggregate keys
-  PubKey aggregated_key = AggregateKeys(subset.commitMap);
+  PubKey aggregated_key = AggregateKeys(subset.commitPoints.GetMap());
   if (!aggregated_key.Initialized()) {
     LOG_GENERAL(WARNING,
                 "[Subset " << subsetID << "] Aggregated key generation failed");
@@ -495,12 +491,12 @@ bool ConsensusLeader::ProcessMessageResponseCore(
   ConsensusSubset& subset = m_consensusSubsets.at(subsetID);
 
   // Check the backup id
-  if (backupID >= subset.responseDataMap.size()) {
+  if (backupID >= subset.responses.size()) {
     LOG_GENERAL(WARNING, "[Subset " << subsetID << "] [Backup " << backupID
                                     << "] Backup ID beyond backup count");
     return false;
   }
-  if (!subset.commitMap.at(backupID)) {
+  if (!subset.commitPoints.Has(backupID)) {
     LOG_GENERAL(
         WARNING, "[Subset "
                      << subsetID << "] [Backup " << backupID
@@ -508,7 +504,7 @@ bool ConsensusLeader::ProcessMessageResponseCore(
     return false;
   }
 
-  if (subset.responseMap.at(backupID)) {
+  if (subset.responses.Has(backupID)) {
     LOG_GENERAL(WARNING, "[Subset "
                              << subsetID << "] [Backup " << backupID
                              << "] Backup has already sent validated response");
@@ -517,7 +513,7 @@ bool ConsensusLeader::ProcessMessageResponseCore(
 
   if (!MultiSig::VerifyResponse(r, subset.challenge,
                                 GetCommitteeMember(backupID).first,
-                                subset.commitPointMap.at(backupID))) {
+                                subset.commitPoints.Get(backupID))) {
     LOG_GENERAL(WARNING, "Invalid response for this backup");
     return false;
   }
@@ -535,17 +531,14 @@ bool ConsensusLeader::ProcessMessageResponseCore(
   }
 
   // 32-byte response
-  subset.responseData.emplace_back(r);
-  subset.responseDataMap.at(backupID) = r;
-  subset.responseMap.at(backupID) = true;
-  subset.responseCounter++;
+  subset.responses.Put(backupID, r);
 
   // Generate collective sig if sufficient responses have been obtained
   // ==================================================================
 
   bool result = true;
 
-  if (subset.responseCounter == m_numForConsensus) {
+  if (subset.responses.count() == m_numForConsensus) {
     LOG_GENERAL(INFO, "Sufficient responses obtained");
 
     vector<unsigned char> collectivesig = {
@@ -562,37 +555,25 @@ bool ConsensusLeader::ProcessMessageResponseCore(
       if (action == PROCESS_RESPONSE) {
         // First round: consensus over part of message (e.g., DS block header)
         // Second round: consensus over part of message + CS1 + B1
+        // Save the collective sig over the first round
+        m_CS1 = subset.collectiveSig;
+        m_B1 = subset.responses.GetMap().ToVector();
+
         subset.collectiveSig.Serialize(m_messageToCosign,
                                        m_messageToCosign.size());
         BitVector::SetBitVector(m_messageToCosign, m_messageToCosign.size(),
-                                subset.responseMap);
-
-        // Save the collective sig over the first round
-        m_CS1 = subset.collectiveSig;
-        m_B1 = subset.responseMap;
+                                m_B1);
 
         // reset settings for second round of consensus
-        m_commitMap.resize(m_committee.size());
-        fill(m_commitMap.begin(), m_commitMap.end(), false);
-        m_commitPointMap.resize(m_committee.size());
-        m_commitPoints.clear();
-
-        // Add the leader to the commits
-        m_commitMap.at(m_myID) = true;
-        m_commitPoints.emplace_back(*m_commitPoint);
-        m_commitPointMap.at(m_myID) = *m_commitPoint;
-        m_commitCounter = 1;
+        StartNewRound();
 
         m_commitFailureCounter = 0;
         m_commitFailureMap.clear();
 
-        m_commitRedundantCounter = 0;
-        fill(m_commitRedundantMap.begin(), m_commitRedundantMap.end(), false);
-
       } else {
         // Save the collective sig over the second round
         m_CS2 = subset.collectiveSig;
-        m_B2 = subset.responseMap;
+        m_B2 = subset.responses.GetMap().ToVector();
       }
 
       // Subset has finished consensus! Either Round 1 or Round 2
@@ -679,7 +660,8 @@ bool ConsensusLeader::GenerateCollectiveSigMessage(
   ConsensusSubset& subset = m_consensusSubsets.at(subsetID);
 
   // Aggregate responses
-  Response aggregated_response = AggregateResponses(subset.responseData);
+  Response aggregated_response =
+      AggregateResponses(subset.responses.GetAll());
   if (!aggregated_response.Initialized()) {
     LOG_GENERAL(WARNING, "AggregateCommits failed");
     SetStateSubset(subsetID, ERROR);
@@ -687,7 +669,7 @@ bool ConsensusLeader::GenerateCollectiveSigMessage(
   }
 
   // Aggregate keys
-  PubKey aggregated_key = AggregateKeys(subset.responseMap);
+  PubKey aggregated_key = AggregateKeys(subset.responses.GetMap());
   if (!aggregated_key.Initialized()) {
     LOG_GENERAL(WARNING, "Aggregated key generation failed");
     SetStateSubset(subsetID, ERROR);
@@ -719,7 +701,8 @@ bool ConsensusLeader::GenerateCollectiveSigMessage(
 
   if (!Messenger::SetConsensusCollectiveSig(
           collectivesig, offset, m_consensusID, m_blockNumber, m_blockHash,
-          m_myID, subset.collectiveSig, subset.responseMap,
+          m_myID, subset.collectiveSig,
+          subset.responses.GetMap().ToVector(),
           make_pair(m_myPrivKey, GetCommitteeMember(m_myID).first))) {
     LOG_GENERAL(WARNING, "Messenger::SetConsensusCollectiveSig failed.");
     return false;
@@ -753,11 +736,7 @@ ConsensusLeader::ConsensusLeader(
     NodeCommitFailureHandlerFunc nodeCommitFailureHandlerFunc,
     ShardCommitFailureHandlerFunc shardCommitFailureHandlerFunc)
     : ConsensusCommon(consensus_id, block_number, block_hash, node_id, privkey,
-                      committee, class_byte, ins_byte),
-      m_commitMap(committee.size(), false),
-      m_commitPointMap(committee.size(), CommitPoint()),
-      m_commitRedundantMap(committee.size(), false),
-      m_commitRedundantPointMap(committee.size(), CommitPoint()) {
+                      committee, class_byte, ins_byte) {
   LOG_MARKER();
 
   m_state = INITIAL;
@@ -776,11 +755,7 @@ ConsensusLeader::ConsensusLeader(
   m_commitSecret.reset(new CommitSecret());
   m_commitPoint.reset(new CommitPoint(*m_commitSecret));
 
-  // Add the leader to the commits
-  m_commitMap.at(m_myID) = true;
-  m_commitPoints.emplace_back(*m_commitPoint);
-  m_commitPointMap.at(m_myID) = *m_commitPoint;
-  m_commitCounter = 1;
+  StartNewRound();
 }
 
 ConsensusLeader::~ConsensusLeader() {}
@@ -817,7 +792,6 @@ bool ConsensusLeader::StartConsensus(
   // =====================
 
   m_state = ANNOUNCE_DONE;
-  m_commitRedundantCounter = 0;
   m_commitFailureCounter = 0;
 
   // Multicast to all nodes in the committee
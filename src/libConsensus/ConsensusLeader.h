@@ -67,37 +67,31 @@ class ConsensusLeader : public ConsensusCommon {
   std::condition_variable cv_scheduleSubsetConsensus;
   bool m_allCommitsReceived;
 
-  // TODO: the vectors should be replaced by more space efficient DS
-  std::vector<bool> m_commitMap;
-  std::vector<CommitPoint>
-      m_commitPointMap;  // ordered list of commits of size = committee size
-  std::vector<CommitPoint> m_commitPoints;  // unordered list of commits of size
-                                            // = 2/3 of committee size + 1
-  unsigned int m_commitRedundantCounter;
-  std::vector<bool> m_commitRedundantMap;
-  std::vector<CommitPoint>
-      m_commitRedundantPointMap;  // ordered list of redundant commits of size =
-                                  // 1/3 of committee size
+  // Commits received in the current round, held in wire format inside one
+  // arena per round. The previous round is kept until its subsets are replaced.
+  struct RoundState {
+    ConsensusArena arena;
+    CommitPointArray commitPoints;  // commits indexed by committee position
+
+    RoundState(unsigned int committeeSize);
+  };
+  std::unique_ptr<RoundState> m_round;
+  std::unique_ptr<RoundState> m_prevRound;
+
   // Generated challenge
   Challenge m_challenge;
 
   unsigned int m_commitFailureCounter;
   std::map<unsigned int, std::vector<unsigned char>> m_commitFailureMap;
 
-  // Tracking data for each consensus subset
-  // TODO: the vectors should be replaced by more space efficient DS
+  // Tracking data for each consensus subset (allocated from the round arena)
   struct ConsensusSubset {
-    std::vector<bool> commitMap;
-    std::vector<CommitPoint> commitPointMap;  // Ordered list of commits of
-                                              // fixed size = committee size
-    std::vector<CommitPoint> commitPoints;
-    unsigned int responseCounter;
+    CommitPointArray commitPoints;  // commit map and commits, indexed by
+                                    // committee position
     Challenge challenge;  // Challenge / Finalchallenge value generated
-    std::vector<Response> responseDataMap;  // Ordered list of responses of
-                                            // fixed size = committee size
-    /// Response map for the generated collective signature
-    std::vector<bool> responseMap;
-    std::vector<Response> responseData;
+    ResponseArray responses;  // Response map for the generated collective
+                              // signature and responses, indexed by committee
+                              // position
     Signature collectiveSig;
     State state;  // Subset consensus state
   };
@@ -111,6 +105,7 @@ class ConsensusLeader : public ConsensusCommon {
   bool CheckState(Action action);
   bool CheckStateSubset(uint16_t subsetID, Action action);
   void SetStateSubset(uint16_t subsetID, State newState);
+  void StartNewRound();
   void GenerateConsensusSubsets();
   void StartConsensusSubsets();
   void SubsetEnded(uint16_t subsetID);
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#include <algorithm>
+
+#include "ConsensusRoundState.h"
+
+using namespace std;
+
+namespace {
+inline size_t AlignUp(size_t n) { return (n + 7) & ~(size_t)7; }
+}  // namespace
+
+ConsensusArena::ConsensusArena(size_t capacity)
+    : m_blockSize(0), m_blockUsed(0), m_bytesUsed(0) {
+  Reset(capacity);
+}
+
+void ConsensusArena::Reset(size_t capacity) {
+  m_blocks.clear();
+  m_blockSize = AlignUp(capacity);
+  m_blockUsed = 0;
+  m_bytesUsed = 0;
+  if (m_blockSize > 0) {
+    m_blocks.emplace_back(new unsigned char[m_blockSize]());
+  }
+}
+
+unsigned char* ConsensusArena::Allocate(size_t size) {
+  size = AlignUp(size);
+  if (size == 0) {
+    return nullptr;
+  }
+
+  if (m_blocks.empty() || m_blockUsed + size > m_blockSize) {
+    // Capacity estimate was too small; chain another block (at least as large
+    // as the previous one) rather than moving anything already handed out
+    m_blockSize = max(m_blockSize, size);
+    m_blocks.emplace_back(new unsigned char[m_blockSize]());
+    m_blockUsed = 0;
+  }
+
+  unsigned char* result = m_blocks.back().get() + m_blockUsed;
+  m_blockUsed += size;
+  m_bytesUsed += size;
+  return result;
+}
+
+CommitteeBitmap::CommitteeBitmap(ConsensusArena& arena, unsigned int size)
+    : m_words(
+          reinterpret_cast<uint64_t*>(arena.Allocate(GetArenaSize(size)))),
+      m_size(size),
+      m_count(0) {}
+
+void CommitteeBitmap::reset() {
+  if (m_words != nullptr) {
+    fill(m_words, m_words + NumWords(m_size), 0);
+  }
+  m_count = 0;
+}
+
+vector<bool> CommitteeBitmap::ToVector() const {
+  vector<bool> result(m_size, false);
+  for (unsigned int i = 0; i < m_size; i++) {
+    if ((m_words[i >> 6] >> (i & 0x3F)) & 1) {
+      result[i] = true;
+    }
+  }
+  return result;
+}
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#ifndef __CONSENSUSROUNDSTATE_H__
+#define __CONSENSUSROUNDSTATE_H__
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "common/Constants.h"
+#include "libCrypto/MultiSig.h"
+
+/// Bump allocator holding the bookkeeping of one consensus round.
+/// Everything carved out of it is released at once by Reset() or destruction.
+class ConsensusArena {
+  std::vector<std::unique_ptr<unsigned char[]>> m_blocks;
+  size_t m_blockSize;
+  size_t m_blockUsed;
+  size_t m_bytesUsed;
+
+ public:
+  /// Constructor. Reserves one block of the specified size up front.
+  explicit ConsensusArena(size_t capacity = 0);
+
+  ConsensusArena(const ConsensusArena&) = delete;
+  ConsensusArena& operator=(const ConsensusArena&) = delete;
+
+  /// Releases every allocation and reserves a fresh block of the given size.
+  void Reset(size_t capacity);
+
+  /// Returns zero-initialized, 8-byte aligned storage of the requested size.
+  unsigned char* Allocate(size_t size);
+
+  /// Returns the number of heap blocks backing the arena.
+  size_t GetNumBlocks() const { return m_blocks.size(); }
+
+  /// Returns the number of bytes handed out since the last reset.
+  size_t GetBytesUsed() const { return m_bytesUsed; }
+};
+
+/// Fixed-capacity bitset over committee indices, stored inside an arena.
+class CommitteeBitmap {
+  uint64_t* m_words;
+  unsigned int m_size;
+  unsigned int m_count;
+
+  static unsigned int NumWords(unsigned int size) { return (size + 63) / 64; }
+
+ public:
+  /// Default constructor for an empty bitmap.
+  CommitteeBitmap() : m_words(nullptr), m_size(0), m_count(0) {}
+
+  /// Constructor for a cleared bitmap of the given capacity.
+  CommitteeBitmap(ConsensusArena& arena, unsigned int size);
+
+  /// Returns the arena bytes needed by a bitmap of the given capacity.
+  static size_t GetArenaSize(unsigned int size) {
+    return NumWords(size) * sizeof(uint64_t);
+  }
+
+  unsigned int size() const { return m_size; }
+  unsigned int count() const { return m_count; }
+
+  /// Checks the bit at the index (range-checked like std::vector::at).
+  bool test(unsigned int index) const {
+    if (index >= m_size) {
+      throw std::out_of_range("CommitteeBitmap index out of range");
+    }
+    return (m_words[index >> 6] >> (index & 0x3F)) & 1;
+  }
+
+  /// Sets the bit at the index (range-checked like std::vector::at).
+  void set(unsigned int index) {
+    if (!test(index)) {
+      m_words[index >> 6] |= (uint64_t)1 << (index & 0x3F);
+      m_count++;
+    }
+  }
+
+  /// Clears all bits.
+  void reset();
+
+  /// Returns the bitmap in the representation used by BitVector and the
+  /// co-signature maps.
+  std::vector<bool> ToVector() const;
+};
+
+/// Contiguous array of serialized fixed-size entries (commit points or
+/// responses) indexed by committee position, stored inside an arena.
+/// Entries are kept in wire format and only decoded into OpenSSL objects when
+/// they are needed for aggregation or verification.
+template <class T, unsigned int ENTRY_SIZE>
+class SerializedEntryArray {
+  unsigned char* m_data;
+  uint16_t* m_order;  // committee indices in order of insertion
+  CommitteeBitmap m_map;
+
+  static std::vector<unsigned char>& Scratch() {
+    static thread_local std::vector<unsigned char> scratch(ENTRY_SIZE);
+    return scratch;
+  }
+
+  void Append(unsigned int index) {
+    m_order[m_map.count()] = index;
+    m_map.set(index);
+  }
+
+ public:
+  /// Default constructor for an empty array.
+  SerializedEntryArray() : m_data(nullptr), m_order(nullptr) {}
+
+  /// Constructor for an empty array of the given capacity.
+  SerializedEntryArray(ConsensusArena& arena, unsigned int size)
+      : m_data(arena.Allocate(size * ENTRY_SIZE)),
+        m_order(reinterpret_cast<uint16_t*>(
+            arena.Allocate(size * sizeof(uint16_t)))),
+        m_map(arena, size) {}
+
+  /// Returns the arena bytes needed by an array of the given capacity.
+  static size_t GetArenaSize(unsigned int size) {
+    auto align = [](size_t n) { return (n + 7) & ~(size_t)7; };
+    return align(size * ENTRY_SIZE) + align(size * sizeof(uint16_t)) +
+           CommitteeBitmap::GetArenaSize(size);
+  }
+
+  unsigned int size() const { return m_map.size(); }
+  unsigned int count() const { return m_map.count(); }
+
+  /// Returns the occupancy bitmap (i.e., the commit or response map).
+  const CommitteeBitmap& GetMap() const { return m_map; }
+
+  /// Checks if an entry has been stored at the index.
+  bool Has(unsigned int index) const { return m_map.test(index); }
+
+  /// Stores the entry at the index. Returns false if the slot is taken or the
+  /// entry is uninitialized.
+  bool Put(unsigned int index, const T& entry) {
+    if (Has(index) || !entry.Initialized()) {
+      return false;
+    }
+    std::vector<unsigned char>& scratch = Scratch();
+    entry.Serialize(scratch, 0);
+    std::memcpy(m_data + index * ENTRY_SIZE, scratch.data(), ENTRY_SIZE);
+    Append(index);
+    return true;
+  }
+
+  /// Copies the raw entry at the index from another array of the same kind.
+  bool CopyFrom(const SerializedEntryArray& src, unsigned int index) {
+    if (Has(index) || !src.Has(index)) {
+      return false;
+    }
+    std::memcpy(m_data + index * ENTRY_SIZE, src.m_data + index * ENTRY_SIZE,
+                ENTRY_SIZE);
+    Append(index);
+    return true;
+  }
+
+  /// Decodes the entry at the index.
+  T Get(unsigned int index) const {
+    if (!Has(index)) {
+      return T();
+    }
+    std::vector<unsigned char>& scratch = Scratch();
+    scratch.assign(m_data + index * ENTRY_SIZE,
+                   m_data + (index + 1) * ENTRY_SIZE);
+    return T(scratch, 0);
+  }
+
+  /// Decodes all entries in order of insertion.
+  std::vector<T> GetAll() const {
+    std::vector<T> result;
+    result.reserve(count());
+    for (unsigned int i = 0; i < count(); i++) {
+      result.emplace_back(Get(m_order[i]));
+    }
+    return result;
+  }
+
+  /// Removes all entries.
+  void Clear() { m_map.reset(); }
+};
+
+using CommitPointArray = SerializedEntryArray<CommitPoint, COMMIT_POINT_SIZE>;
+using ResponseArray = SerializedEntryArray<Response, RESPONSE_SIZE>;
+
+#endif  // __CONSENSUSROUNDSTATE_H__
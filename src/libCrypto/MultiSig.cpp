@@ -362,19 +362,9 @@ void Challenge::Set(const CommitPoint& aggregatedCommit,
   // Hash commitment
   sha2.Update(buf);
 
-  // Clear buffer
-  fill(buf.begin(), buf.end(), 0x00);
-
-  // Convert the public key to octets
-  if (EC_POINT_point2oct(curve.m_group.get(), aggregatedPubkey.m_P.get(),
-                         POINT_CONVERSION_COMPRESSED, buf.data(),
-                         Schnorr::PUBKEY_COMPRESSED_SIZE_BYTES,
-                         NULL) != Schnorr::PUBKEY_COMPRESSED_SIZE_BYTES) {
-    LOG_GENERAL(WARNING, "Could not convert public key to octets");
-    return;
-  }
-
-  // Hash public key
+  // Hash public key (already held in compressed form)
+  buf.assign(aggregatedPubkey.GetBytes().begin(),
+             aggregatedPubkey.GetBytes().end());
   sha2.Update(buf);
 
   // Hash message
@@ -551,22 +541,32 @@ shared_ptr<PubKey> MultiSig::AggregatePubKeys(const vector<PubKey>& pubkeys) {
     return nullptr;
   }
 
-  shared_ptr<PubKey> aggregatedPubkey(new PubKey(pubkeys.at(0)));
-  if (aggregatedPubkey == nullptr) {
+  unique_ptr<EC_POINT, void (*)(EC_POINT*)> aggregatedPoint(
+      EC_POINT_new(curve.m_group.get()), EC_POINT_clear_free);
+  if ((aggregatedPoint == nullptr) ||
+      (EC_POINT_set_to_infinity(curve.m_group.get(), aggregatedPoint.get()) ==
+       0)) {
     LOG_GENERAL(WARNING, "Memory allocation failure");
     // throw exception();
     return nullptr;
   }
 
-  for (unsigned int i = 1; i < pubkeys.size(); i++) {
-    if (EC_POINT_add(curve.m_group.get(), aggregatedPubkey->m_P.get(),
-                     aggregatedPubkey->m_P.get(), pubkeys.at(i).m_P.get(),
-                     NULL) == 0) {
+  for (const auto& pubkey : pubkeys) {
+    shared_ptr<const EC_POINT> P = pubkey.GetPoint();
+    if ((P == nullptr) ||
+        (EC_POINT_add(curve.m_group.get(), aggregatedPoint.get(),
+                      aggregatedPoint.get(), P.get(), NULL) == 0)) {
       LOG_GENERAL(WARNING, "Pubkey aggregation failed");
       return nullptr;
     }
   }
 
+  shared_ptr<PubKey> aggregatedPubkey(new PubKey());
+  if (!aggregatedPubkey->SetPoint(aggregatedPoint.get())) {
+    LOG_GENERAL(WARNING, "Pubkey aggregation failed");
+    return nullptr;
+  }
+
   return aggregatedPubkey;
 }
 
@@ -693,6 +693,12 @@ bool MultiSig::VerifyResponse(const Response& response,
       return false;
     }
 
+    shared_ptr<const EC_POINT> P = pubkey.GetPoint();
+    if (P == nullptr) {
+      LOG_GENERAL(WARNING, "Public key is not a valid point");
+      return false;
+    }
+
     const Curve& curve = Schnorr::GetInstance().GetCurve();
 
     // The algorithm to check whether the commit point generated from its
@@ -718,7 +724,7 @@ bool MultiSig::VerifyResponse(const Response& response,
       // 2. Compute Q = sG + r*kpub
       err =
           (EC_POINT_mul(curve.m_group.get(), Q.get(), response.m_r.get(),
-                        pubkey.m_P.get(), challenge.m_c.get(), ctx.get()) == 0);
+                        P.get(), challenge.m_c.get(), ctx.get()) == 0);
       if (err) {
         LOG_GENERAL(WARNING, "Commit regenerate failed");
         return false;
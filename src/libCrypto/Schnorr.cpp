@@ -267,82 +267,79 @@ bool PrivKey::operator==(const PrivKey& r) const {
           (BN_cmp(m_d.get(), r.m_d.get()) == 0));
 }
 
-PubKey::PubKey()
-    : m_P(EC_POINT_new(Schnorr::GetInstance().GetCurve().m_group.get()),
-          EC_POINT_clear_free),
-      m_initialized(false) {
-  if (m_P == nullptr) {
-    LOG_GENERAL(WARNING, "Memory allocation failure");
-    // throw exception();
-  }
-}
+PubKey::PubKey() : m_initialized(false), m_hash(0) { m_bytes.fill(0x00); }
 
-PubKey::PubKey(const PrivKey& privkey)
-    : m_P(EC_POINT_new(Schnorr::GetInstance().GetCurve().m_group.get()),
-          EC_POINT_clear_free),
-      m_initialized(false) {
-  if (m_P == nullptr) {
-    LOG_GENERAL(WARNING, "Memory allocation failure");
-    // throw exception();
-    return;
-  } else if (!privkey.Initialized()) {
+PubKey::PubKey(const PrivKey& privkey) : m_initialized(false), m_hash(0) {
+  m_bytes.fill(0x00);
+
+  if (!privkey.Initialized()) {
     LOG_GENERAL(WARNING, "Private key is not initialized");
     return;
-  } else {
-    const Curve& curve = Schnorr::GetInstance().GetCurve();
+  }
 
-    if (BN_is_zero(privkey.m_d.get()) || BN_is_one(privkey.m_d.get()) ||
-        (BN_cmp(privkey.m_d.get(), curve.m_order.get()) != -1)) {
-      LOG_GENERAL(WARNING,
-                  "Input private key is weak. Public key "
-                  "generation failed");
-      return;
-    }
+  const Curve& curve = Schnorr::GetInstance().GetCurve();
 
-    if (EC_POINT_mul(curve.m_group.get(), m_P.get(), privkey.m_d.get(), NULL,
-                     NULL, NULL) == 0) {
-      LOG_GENERAL(WARNING, "Public key generation failed");
-      return;
-    }
+  if (BN_is_zero(privkey.m_d.get()) || BN_is_one(privkey.m_d.get()) ||
+      (BN_cmp(privkey.m_d.get(), curve.m_order.get()) != -1)) {
+    LOG_GENERAL(WARNING,
+                "Input private key is weak. Public key "
+                "generation failed");
+    return;
+  }
 
-    m_initialized = true;
+  unique_ptr<EC_POINT, void (*)(EC_POINT*)> P(EC_POINT_new(curve.m_group.get()),
+                                              EC_POINT_clear_free);
+  if (P == nullptr) {
+    LOG_GENERAL(WARNING, "Memory allocation failure");
+    // throw exception();
+    return;
   }
+
+  if (EC_POINT_mul(curve.m_group.get(), P.get(), privkey.m_d.get(), NULL, NULL,
+                   NULL) == 0) {
+    LOG_GENERAL(WARNING, "Public key generation failed");
+    return;
+  }
+
+  SetPoint(P.get());
 }
 
-PubKey::PubKey(const vector<unsigned char>& src, unsigned int offset) {
+PubKey::PubKey(const vector<unsigned char>& src, unsigned int offset)
+    : m_initialized(false), m_hash(0) {
+  m_bytes.fill(0x00);
+
   if (Deserialize(src, offset) != 0) {
     LOG_GENERAL(WARNING, "We failed to init PubKey.");
   }
 }
 
 PubKey::PubKey(const PubKey& src)
-    : m_P(EC_POINT_new(Schnorr::GetInstance().GetCurve().m_group.get()),
-          EC_POINT_clear_free),
-      m_initialized(false) {
-  if (m_P == nullptr) {
-    LOG_GENERAL(WARNING, "Memory allocation failure");
-    // throw exception();
-    return;
-  } else if (src.m_P == nullptr) {
-    LOG_GENERAL(WARNING, "src (ec point) is null in pub key construct.");
-    // throw exception();
-  } else {
-    if (EC_POINT_copy(m_P.get(), src.m_P.get()) != 1) {
-      LOG_GENERAL(WARNING, "PubKey copy failed");
-    } else {
-      m_initialized = true;
-    }
-  }
-}
+    : m_initialized(src.m_initialized),
+      m_bytes(src.m_bytes),
+      m_hash(src.m_hash),
+      m_P(atomic_load(&src.m_P)) {}
 
 PubKey::~PubKey() {}
 
 bool PubKey::Initialized() const { return m_initialized; }
 
+void PubKey::SetBytes(const unsigned char* src) {
+  copy(src, src + PUB_KEY_SIZE, m_bytes.begin());
+
+  // 64-bit FNV-1a over the encoding
+  m_hash = 0xcbf29ce484222325ULL;
+  for (const auto& b : m_bytes) {
+    m_hash = (m_hash ^ b) * 0x100000001b3ULL;
+  }
+}
+
 unsigned int PubKey::Serialize(vector<unsigned char>& dst,
                                unsigned int offset) const {
   if (m_initialized) {
-    ECPOINTSerialize::SetNumber(dst, offset, PUB_KEY_SIZE, m_P);
+    if (offset + PUB_KEY_SIZE > dst.size()) {
+      dst.resize(offset + PUB_KEY_SIZE);
+    }
+    copy(m_bytes.begin(), m_bytes.end(), dst.begin() + offset);
   }
 
   return PUB_KEY_SIZE;
@@ -351,85 +348,105 @@ unsigned int PubKey::Serialize(vector<unsigned char>& dst,
 int PubKey::Deserialize(const vector<unsigned char>& src, unsigned int offset) {
   // LOG_MARKER();
 
-  try {
-    m_P = ECPOINTSerialize::GetNumber(src, offset, PUB_KEY_SIZE);
-    if (m_P == nullptr) {
-      LOG_GENERAL(WARNING, "Deserialization failure");
-      m_initialized = false;
-      return -1;
-    } else {
-      m_initialized = true;
-    }
-  } catch (const std::exception& e) {
-    LOG_GENERAL(WARNING, "Error with PubKey::Deserialize." << ' ' << e.what());
+  m_initialized = false;
+  atomic_store(&m_P, shared_ptr<EC_POINT>());
+
+  if (offset + PUB_KEY_SIZE > src.size()) {
+    LOG_GENERAL(WARNING, "Unable to get PubKey of size "
+                             << PUB_KEY_SIZE
+                             << " from stream with available size "
+                             << src.size() - offset);
     return -1;
   }
+
+  // Only the compressed form is accepted; the point itself is checked when it
+  // is first decoded
+  const unsigned char prefix = src.at(offset);
+  if ((prefix != POINT_CONVERSION_COMPRESSED) &&
+      (prefix != (POINT_CONVERSION_COMPRESSED | 0x01))) {
+    LOG_GENERAL(WARNING, "Deserialization failure");
+    return -1;
+  }
+
+  SetBytes(src.data() + offset);
+  m_initialized = true;
+
   return 0;
 }
 
-PubKey& PubKey::operator=(const PubKey& src) {
-  m_initialized =
-      src.m_initialized && (EC_POINT_copy(m_P.get(), src.m_P.get()) == 1);
-  return *this;
-}
+shared_ptr<const EC_POINT> PubKey::GetPoint() const {
+  shared_ptr<EC_POINT> P = atomic_load(&m_P);
+  if ((P != nullptr) || !m_initialized) {
+    return P;
+  }
 
-bool PubKey::operator<(const PubKey& r) const {
-  unique_ptr<BN_CTX, void (*)(BN_CTX*)> ctx(BN_CTX_new(), BN_CTX_free);
-  if (ctx == nullptr) {
+  const Curve& curve = Schnorr::GetInstance().GetCurve();
+
+  P.reset(EC_POINT_new(curve.m_group.get()), EC_POINT_clear_free);
+  if (P == nullptr) {
     LOG_GENERAL(WARNING, "Memory allocation failure");
     // throw exception();
-    return false;
+    return nullptr;
   }
 
-  shared_ptr<BIGNUM> lhs_bnvalue(
-      EC_POINT_point2bn(Schnorr::GetInstance().GetCurve().m_group.get(),
-                        m_P.get(), POINT_CONVERSION_COMPRESSED, NULL,
-                        ctx.get()),
-      BN_clear_free);
-  shared_ptr<BIGNUM> rhs_bnvalue(
-      EC_POINT_point2bn(Schnorr::GetInstance().GetCurve().m_group.get(),
-                        r.m_P.get(), POINT_CONVERSION_COMPRESSED, NULL,
-                        ctx.get()),
-      BN_clear_free);
+  if (EC_POINT_oct2point(curve.m_group.get(), P.get(), m_bytes.data(),
+                         m_bytes.size(), NULL) != 1) {
+    LOG_GENERAL(WARNING, "PubKey is not a point on the curve");
+    return nullptr;
+  }
 
-  return (m_initialized && r.m_initialized &&
-          (BN_cmp(lhs_bnvalue.get(), rhs_bnvalue.get()) == -1));
+  // Concurrent decodes produce identical points, so whichever lands last wins
+  atomic_store(&m_P, P);
+
+  return P;
 }
 
-bool PubKey::operator>(const PubKey& r) const {
-  unique_ptr<BN_CTX, void (*)(BN_CTX*)> ctx(BN_CTX_new(), BN_CTX_free);
-  if (ctx == nullptr) {
+bool PubKey::SetPoint(const EC_POINT* point) {
+  m_initialized = false;
+  atomic_store(&m_P, shared_ptr<EC_POINT>());
+
+  const Curve& curve = Schnorr::GetInstance().GetCurve();
+
+  array<unsigned char, PUB_KEY_SIZE> buf;
+  if (EC_POINT_point2oct(curve.m_group.get(), point,
+                         POINT_CONVERSION_COMPRESSED, buf.data(), buf.size(),
+                         NULL) != buf.size()) {
+    LOG_GENERAL(WARNING, "Could not convert public key to octets");
+    return false;
+  }
+
+  shared_ptr<EC_POINT> P(EC_POINT_dup(point, curve.m_group.get()),
+                         EC_POINT_clear_free);
+  if (P == nullptr) {
     LOG_GENERAL(WARNING, "Memory allocation failure");
     // throw exception();
     return false;
   }
 
-  shared_ptr<BIGNUM> lhs_bnvalue(
-      EC_POINT_point2bn(Schnorr::GetInstance().GetCurve().m_group.get(),
-                        m_P.get(), POINT_CONVERSION_COMPRESSED, NULL,
-                        ctx.get()),
-      BN_clear_free);
-  shared_ptr<BIGNUM> rhs_bnvalue(
-      EC_POINT_point2bn(Schnorr::GetInstance().GetCurve().m_group.get(),
-                        r.m_P.get(), POINT_CONVERSION_COMPRESSED, NULL,
-                        ctx.get()),
-      BN_clear_free);
+  SetBytes(buf.data());
+  atomic_store(&m_P, P);
+  m_initialized = true;
 
-  return (m_initialized && r.m_initialized &&
-          (BN_cmp(lhs_bnvalue.get(), rhs_bnvalue.get()) == 1));
+  return true;
 }
 
-bool PubKey::operator==(const PubKey& r) const {
-  unique_ptr<BN_CTX, void (*)(BN_CTX*)> ctx(BN_CTX_new(), BN_CTX_free);
-  if (ctx == nullptr) {
-    LOG_GENERAL(WARNING, "Memory allocation failure");
-    // throw exception();
-    return false;
+PubKey& PubKey::operator=(const PubKey& src) {
+  if (this != &src) {
+    m_initialized = src.m_initialized;
+    m_bytes = src.m_bytes;
+    m_hash = src.m_hash;
+    atomic_store(&m_P, atomic_load(&src.m_P));
   }
+  return *this;
+}
 
-  return (m_initialized && r.m_initialized &&
-          (EC_POINT_cmp(Schnorr::GetInstance().GetCurve().m_group.get(),
-                        m_P.get(), r.m_P.get(), ctx.get()) == 0));
+bool PubKey::operator<(const PubKey& r) const { return m_bytes < r.m_bytes; }
+
+bool PubKey::operator>(const PubKey& r) const { return r < *this; }
+
+bool PubKey::operator==(const PubKey& r) const {
+  return (m_initialized && r.m_initialized && (m_hash == r.m_hash) &&
+          (m_bytes == r.m_bytes));
 }
 
 Signature::Signature()
@@ -560,7 +577,9 @@ bool Schnorr::Sign(const vector<unsigned char>& message, unsigned int offset,
                    unsigned int size, const PrivKey& privkey,
                    const PubKey& pubkey, Signature& result) {
   // LOG_MARKER();
-  lock_guard<mutex> g(m_mutexSchnorr);
+
+  // No lock needed: all scratch state is local and the curve is only read,
+  // the same as in Verify, so txns can be signed from several threads
 
   // Initial checks
 
@@ -651,20 +670,8 @@ bool Schnorr::Sign(const vector<unsigned char>& message, unsigned int offset,
       // Hash commitment
       sha2.Update(buf);
 
-      // Clear buffer
-      fill(buf.begin(), buf.end(), 0x00);
-
-      // Convert the public key to octets
-      err = (EC_POINT_point2oct(m_curve.m_group.get(), pubkey.m_P.get(),
-                                POINT_CONVERSION_COMPRESSED, buf.data(),
-                                PUBKEY_COMPRESSED_SIZE_BYTES,
-                                NULL) != PUBKEY_COMPRESSED_SIZE_BYTES);
-      if (err) {
-        LOG_GENERAL(WARNING, "Pubkey octet conversion failed");
-        return false;
-      }
-
-      // Hash public key
+      // Hash public key (already held in compressed form)
+      buf.assign(pubkey.GetBytes().begin(), pubkey.GetBytes().end());
       sha2.Update(buf);
 
       // Hash message
@@ -680,7 +687,7 @@ bool Schnorr::Sign(const vector<unsigned char>& message, unsigned int offset,
       }
 
       err = (BN_nnmod(result.m_r.get(), result.m_r.get(), m_curve.m_order.get(),
-                      NULL) == 0);
+                      ctx.get()) == 0);
       if (err) {
         LOG_GENERAL(WARNING, "BIGNUM NNmod failed");
         return false;
@@ -730,7 +737,9 @@ bool Schnorr::Verify(const vector<unsigned char>& message, unsigned int offset,
                      unsigned int size, const Signature& toverify,
                      const PubKey& pubkey) {
   // LOG_MARKER();
-  lock_guard<mutex> g(m_mutexSchnorr);
+
+  // No lock needed here: verification only reads the curve parameters and
+  // works on its own OpenSSL objects, so signatures can be checked in parallel
 
   // Initial checks
 
@@ -754,6 +763,12 @@ bool Schnorr::Verify(const vector<unsigned char>& message, unsigned int offset,
     return false;
   }
 
+  shared_ptr<const EC_POINT> P = pubkey.GetPoint();
+  if (P == nullptr) {
+    LOG_GENERAL(WARNING, "Public key is not a valid point");
+    return false;
+  }
+
   try {
     // Main verification procedure
 
@@ -799,7 +814,7 @@ bool Schnorr::Verify(const vector<unsigned char>& message, unsigned int offset,
       // 2. Compute Q = sG + r*kpub
       err2 =
           (EC_POINT_mul(m_curve.m_group.get(), Q.get(), toverify.m_s.get(),
-                        pubkey.m_P.get(), toverify.m_r.get(), ctx.get()) == 0);
+                        P.get(), toverify.m_r.get(), ctx.get()) == 0);
       err = err || err2;
       if (err2) {
         LOG_GENERAL(WARNING, "Commit regenerate failed");
@@ -829,21 +844,8 @@ bool Schnorr::Verify(const vector<unsigned char>& message, unsigned int offset,
       // Hash commitment
       sha2.Update(buf);
 
-      // Reset buf
-      fill(buf.begin(), buf.end(), 0x00);
-
-      // 4.2 Convert the public key to octets
-      err2 = (EC_POINT_point2oct(m_curve.m_group.get(), pubkey.m_P.get(),
-                                 POINT_CONVERSION_COMPRESSED, buf.data(),
-                                 PUBKEY_COMPRESSED_SIZE_BYTES,
-                                 NULL) != PUBKEY_COMPRESSED_SIZE_BYTES);
-      err = err || err2;
-      if (err2) {
-        LOG_GENERAL(WARNING, "Pubkey octet conversion failed");
-        return false;
-      }
-
-      // Hash public key
+      // 4.2 Hash public key (already held in compressed form)
+      buf.assign(pubkey.GetBytes().begin(), pubkey.GetBytes().end());
       sha2.Update(buf);
 
       // 4.3 Hash message
@@ -860,7 +862,7 @@ bool Schnorr::Verify(const vector<unsigned char>& message, unsigned int offset,
       }
 
       err2 = (BN_nnmod(challenge_built.get(), challenge_built.get(),
-                       m_curve.m_order.get(), NULL) == 0);
+                       m_curve.m_order.get(), ctx.get()) == 0);
       err = err || err2;
       if (err2) {
         LOG_GENERAL(WARNING, "Challenge rebuild mod failed");
@@ -24,6 +24,8 @@
 #include <openssl/ec.h>
 
 #include <array>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -124,10 +126,10 @@ inline std::ostream& operator<<(std::ostream& os, const PrivKey& p) {
 }
 
 /// Stores information on an EC-Schnorr public key.
+/// The key is held in its compressed encoding, which is what gets compared,
+/// hashed and serialized. The point on the curve is only decoded when a
+/// signature operation first needs it.
 struct PubKey : public Serializable {
-  /// The point on the curve.
-  std::shared_ptr<EC_POINT> m_P;
-
   /// Flag to indicate if parameters have been initialized.
   bool m_initialized;
 
@@ -156,6 +158,21 @@ struct PubKey : public Serializable {
   /// Implements the Deserialize function inherited from Serializable.
   int Deserialize(const std::vector<unsigned char>& src, unsigned int offset);
 
+  /// Returns the point on the curve, decoding it on first use.
+  /// Returns nullptr if the key is uninitialized or not a valid point.
+  std::shared_ptr<const EC_POINT> GetPoint() const;
+
+  /// Sets the key to the specified point on the curve.
+  bool SetPoint(const EC_POINT* point);
+
+  /// Returns the compressed encoding of the key.
+  const std::array<unsigned char, PUB_KEY_SIZE>& GetBytes() const {
+    return m_bytes;
+  }
+
+  /// Returns the hash of the compressed encoding.
+  uint64_t GetHash() const { return m_hash; }
+
   /// Assignment operator.
   PubKey& operator=(const PubKey& src);
 
@@ -172,6 +189,19 @@ struct PubKey : public Serializable {
   explicit operator std::string() const {
     return "0x" + DataConversion::SerializableToHexStr(*this);
   }
+
+ private:
+  /// The compressed encoding of the point.
+  std::array<unsigned char, PUB_KEY_SIZE> m_bytes;
+
+  /// Hash of m_bytes, computed whenever the key is set.
+  uint64_t m_hash;
+
+  /// The decoded point, shared between copies and only accessed through
+  /// std::atomic_load/atomic_store.
+  mutable std::shared_ptr<EC_POINT> m_P;
+
+  void SetBytes(const unsigned char* src);
 };
 
 inline std::ostream& operator<<(std::ostream& os, const PubKey& p) {
@@ -179,6 +209,13 @@ inline std::ostream& operator<<(std::ostream& os, const PubKey& p) {
   return os;
 }
 
+namespace std {
+template <>
+struct hash<PubKey> {
+  size_t operator()(const PubKey& key) const noexcept { return key.GetHash(); }
+};
+}  // namespace std
+
 /// Stores information on an EC-Schnorr signature.
 struct Signature : public Serializable {
   /// Challenge scalar.
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#ifndef __SIPHASH_H__
+#define __SIPHASH_H__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/// Implements the SipHash-2-4 keyed hash (64-bit output).
+class SipHash {
+  uint64_t m_v0, m_v1, m_v2, m_v3;
+
+  static uint64_t Rotl(uint64_t x, unsigned int b) {
+    return (x << b) | (x >> (64 - b));
+  }
+
+  static uint64_t Load64(const unsigned char* p) {
+    uint64_t result = 0;
+    for (unsigned int i = 0; i < 8; i++) {
+      result |= (uint64_t)p[i] << (8 * i);
+    }
+    return result;
+  }
+
+  void Round() {
+    m_v0 += m_v1;
+    m_v1 = Rotl(m_v1, 13);
+    m_v1 ^= m_v0;
+    m_v0 = Rotl(m_v0, 32);
+    m_v2 += m_v3;
+    m_v3 = Rotl(m_v3, 16);
+    m_v3 ^= m_v2;
+    m_v0 += m_v3;
+    m_v3 = Rotl(m_v3, 21);
+    m_v3 ^= m_v0;
+    m_v2 += m_v1;
+    m_v1 = Rotl(m_v1, 17);
+    m_v1 ^= m_v2;
+    m_v2 = Rotl(m_v2, 32);
+  }
+
+  void Compress(uint64_t m) {
+    m_v3 ^= m;
+    Round();
+    Round();
+    m_v0 ^= m;
+  }
+
+ public:
+  static const unsigned int KEY_SIZE = 16;
+
+  /// Constructor. The key is read as two little-endian 64-bit words.
+  explicit SipHash(const std::array<unsigned char, KEY_SIZE>& key) {
+    uint64_t k0 = Load64(key.data());
+    uint64_t k1 = Load64(key.data() + 8);
+    m_v0 = 0x736f6d6570736575ULL ^ k0;
+    m_v1 = 0x646f72616e646f6dULL ^ k1;
+    m_v2 = 0x6c7967656e657261ULL ^ k0;
+    m_v3 = 0x7465646279746573ULL ^ k1;
+  }
+
+  /// Hashes the input under the key given at construction.
+  /// The object holds only the keyed initial state, so it can be reused.
+  uint64_t Hash(const unsigned char* data, size_t len) const {
+    SipHash s(*this);
+
+    const unsigned char* end = data + len - (len % 8);
+    for (; data != end; data += 8) {
+      s.Compress(Load64(data));
+    }
+
+    uint64_t last = (uint64_t)(len & 0xFF) << 56;
+    for (unsigned int i = 0; i < len % 8; i++) {
+      last |= (uint64_t)data[i] << (8 * i);
+    }
+    s.Compress(last);
+
+    s.m_v2 ^= 0xFF;
+    s.Round();
+    s.Round();
+    s.Round();
+    s.Round();
+
+    return s.m_v0 ^ s.m_v1 ^ s.m_v2 ^ s.m_v3;
+  }
+};
+
+#endif  // __SIPHASH_H__
@@ -386,6 +386,10 @@ Address Account::GetAddressForContract(const Address& sender,
 }
 
 void Account::SetCode(const vector<unsigned char>& code) {
+  SetCode(vector<unsigned char>(code));
+}
+
+void Account::SetCode(vector<unsigned char>&& code) {
   // LOG_MARKER();
 
   if (code.size() == 0) {
@@ -393,9 +397,9 @@ void Account::SetCode(const vector<unsigned char>& code) {
     return;
   }
 
-  m_codeCache = code;
+  m_codeCache = move(code);
   SHA2<HASH_TYPE::HASH_VARIANT_256> sha2;
-  sha2.Update(code);
+  sha2.Update(m_codeCache);
   m_codeHash = dev::h256(sha2.Finalize());
   // LOG_GENERAL(INFO, "m_codeHash: " << m_codeHash);
 
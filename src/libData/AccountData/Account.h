@@ -123,6 +123,7 @@ class Account : public SerializableDataBlock {
 
   /// Set the code
   void SetCode(const std::vector<unsigned char>& code);
+  void SetCode(std::vector<unsigned char>&& code);
 
   const std::vector<unsigned char>& GetCode() const;
 
@@ -25,6 +25,7 @@
 #include "libMessage/Messenger.h"
 #include "libPersistence/BlockStorage.h"
 #include "libPersistence/ContractStorage.h"
+#include "libUtils/Metrics.h"
 #include "libUtils/SysCommand.h"
 
 using namespace std;
@@ -166,6 +167,49 @@ bool AccountStore::DeserializeDeltaTemp(const vector<unsigned char>& src,
   return m_accountStoreTemp->DeserializeDelta(src, offset);
 }
 
+bool AccountStore::MergeShardDeltaTemp(const vector<unsigned char>& src,
+                                       unsigned int offset) {
+  LOG_MARKER();
+
+  lock_guard<mutex> g(m_mutexDelta);
+
+  vector<Address> addresses;
+  if (!m_accountStoreTemp->DeserializeDelta(src, offset, &addresses)) {
+    return false;
+  }
+
+  // Only the accounts in this delta changed, so refreshing just those keeps
+  // the snapshot current at a cost proportional to the delta
+  const auto& tempAccounts = *m_accountStoreTemp->GetAddressToAccount();
+  for (const auto& address : addresses) {
+    auto it = tempAccounts.find(address);
+    if (it != tempAccounts.end()) {
+      m_shardDeltaAccounts[address] = it->second;
+    }
+  }
+
+  return true;
+}
+
+void AccountStore::RevertTempToShardDeltas() {
+  LOG_MARKER();
+
+  lock_guard<mutex> g(m_mutexDelta);
+
+  m_accountStoreTemp->Init();
+  m_stateDeltaSerialized.clear();
+
+  for (const auto& entry : m_shardDeltaAccounts) {
+    m_accountStoreTemp->AddAccountDuringDeserialization(entry.first,
+                                                        entry.second);
+  }
+}
+
+void AccountStore::ClearShardDeltas() {
+  lock_guard<mutex> g(m_mutexDelta);
+  m_shardDeltaAccounts.clear();
+}
+
 void AccountStore::MoveRootToDisk(const h256& root) {
   // convert h256 to bytes
   if (!BlockStorage::GetBlockStorage().PutMetadata(STATEROOT, root.asBytes()))
@@ -174,6 +218,7 @@ void AccountStore::MoveRootToDisk(const h256& root) {
 
 void AccountStore::MoveUpdatesToDisk() {
   LOG_MARKER();
+  ScopedPhaseTimer timer(EpochPhase::STATE_COMMIT);
 
   lock(m_mutexPrimary, m_mutexDB);
   unique_lock<shared_timed_mutex> g(m_mutexPrimary, adopt_lock);
@@ -308,6 +353,35 @@ boost::multiprecision::uint128_t AccountStore::GetNonceTemp(
   }
 }
 
+bool AccountStore::IndexContractsByCreator(const Address& creator) {
+  const Account* account = GetAccount(creator);
+  if (account == nullptr) {
+    return false;
+  }
+  const uint64_t nonce = account->GetNonce();
+
+  // Probe only the nonces used since the last scan, which covers contracts
+  // deployed before the index existed or while this node was not committing
+  ContractStorage& contractStorage = ContractStorage::GetContractStorage();
+  for (uint64_t i = contractStorage.GetCreatorScanNonce(creator); i < nonce;
+       i++) {
+    Address contractAddr = Account::GetAddressForContract(creator, i);
+    const Account* contractAccount = GetAccount(contractAddr);
+
+    if (contractAccount == nullptr || !contractAccount->isContract()) {
+      continue;
+    }
+
+    if (!contractStorage.PutContractCreation(creator, i, contractAddr)) {
+      LOG_GENERAL(WARNING, "Failed to index contract " << contractAddr.hex()
+                                                       << " by creator");
+      return false;
+    }
+  }
+
+  return contractStorage.PutCreatorScanNonce(creator, nonce);
+}
+
 StateHash AccountStore::GetStateDeltaHash() {
   lock_guard<mutex> g(m_mutexDelta);
 
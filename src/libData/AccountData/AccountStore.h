@@ -58,8 +58,11 @@ class AccountStoreTemp : public AccountStoreSC<std::map<Address, Account>> {
   //     const shared_ptr<unordered_map<Address, Account>>& addressToAccount);
   AccountStoreTemp(AccountStore& parent);
 
+  /// Merges the delta into the temp state. If addresses is provided, the
+  /// addresses of the accounts in the delta are appended to it.
   bool DeserializeDelta(const std::vector<unsigned char>& src,
-                        unsigned int offset);
+                        unsigned int offset,
+                        std::vector<Address>* addresses = nullptr);
 
   /// Returns the Account associated with the specified address.
   Account* GetAccount(const Address& address) override;
@@ -93,6 +96,10 @@ class AccountStore
 
   std::vector<unsigned char> m_stateDeltaSerialized;
 
+  // temp accounts touched by the shard state deltas merged in this epoch, as
+  // of the latest merge
+  std::map<Address, Account> m_shardDeltaAccounts;
+
   AccountStore();
   ~AccountStore();
 
@@ -119,6 +126,18 @@ class AccountStore
   bool DeserializeDeltaTemp(const std::vector<unsigned char>& src,
                             unsigned int offset);
 
+  /// Merges a state delta received from a shard into the temp state, and
+  /// remembers the accounts it touched so the temp state can later be rebuilt
+  /// from the shard deltas alone. The accumulated delta is not serialized.
+  bool MergeShardDeltaTemp(const std::vector<unsigned char>& src,
+                           unsigned int offset);
+
+  /// Resets the temp state to the shard state deltas merged so far.
+  void RevertTempToShardDeltas();
+
+  /// Forgets the shard state deltas merged so far.
+  void ClearShardDeltas();
+
   /// Empty the state trie, must be called explicitly otherwise will retrieve
   /// the historical data
   void Init() override;
@@ -158,6 +177,10 @@ class AccountStore
 
   boost::multiprecision::uint128_t GetNonceTemp(const Address& address);
 
+  /// Adds to the creator index the contracts deployed by the creator at the
+  /// nonces it has not scanned yet
+  bool IndexContractsByCreator(const Address& creator);
+
   bool UpdateCoinbaseTemp(const Address& rewardee,
                           const Address& genesisAddress,
                           const boost::multiprecision::uint128_t& amount);
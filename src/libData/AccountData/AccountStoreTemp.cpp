@@ -47,10 +47,11 @@ Account* AccountStoreTemp::GetAccount(const Address& address) {
 }
 
 bool AccountStoreTemp::DeserializeDelta(const vector<unsigned char>& src,
-                                        unsigned int offset) {
+                                        unsigned int offset,
+                                        vector<Address>* addresses) {
   LOG_MARKER();
 
-  if (!Messenger::GetAccountStoreDelta(src, offset, *this)) {
+  if (!Messenger::GetAccountStoreDelta(src, offset, *this, addresses)) {
     LOG_GENERAL(WARNING, "Messenger::GetAccountStoreDelta failed.");
     return false;
   }
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#ifndef __SHORTTXNID_H__
+#define __SHORTTXNID_H__
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <numeric>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Transaction.h"
+#include "common/Constants.h"
+#include "libCrypto/SipHash.h"
+
+/// Size in bytes of the short transaction IDs used in compact block relay.
+const unsigned int SHORT_TXN_ID_SIZE = 6;
+
+/// Maps transaction hashes to the short IDs carried in compact microblock
+/// announcements. IDs are salted with the hash of the announced block, so
+/// colliding transactions cannot be crafted ahead of time.
+class ShortTxnIdGenerator {
+  SipHash m_sipHash;
+
+  static std::array<unsigned char, SipHash::KEY_SIZE> GetKey(
+      const BlockHash& salt) {
+    std::array<unsigned char, SipHash::KEY_SIZE> key;
+    std::copy(salt.asArray().begin(),
+              salt.asArray().begin() + SipHash::KEY_SIZE, key.begin());
+    return key;
+  }
+
+ public:
+  /// Constructor for IDs salted with the specified block hash.
+  explicit ShortTxnIdGenerator(const BlockHash& salt)
+      : m_sipHash(GetKey(salt)) {}
+
+  /// Returns the short ID of the transaction hash.
+  uint64_t operator()(const TxnHash& tranHash) const {
+    return m_sipHash.Hash(tranHash.data(), TRAN_HASH_SIZE) &
+           ((1ULL << (8 * SHORT_TXN_ID_SIZE)) - 1);
+  }
+};
+
+/// Rebuilds the txn hashes of a compact microblock announcement from its
+/// short IDs. Hashes are taken from the local txn pool where the short ID is
+/// unambiguous, and the remaining ones from the txns fetched from the leader.
+class CompactTxnHashResolver {
+  const std::function<uint64_t(const TxnHash&)> m_shortTxnId;
+  const std::vector<uint64_t>& m_shortTxnIds;
+  std::vector<TxnHash> m_tranHashes;
+  std::vector<uint32_t> m_missingIndexes;
+
+ public:
+  /// Constructor for the short IDs of an announcement (which must outlive
+  /// the resolver), with all of them initially missing.
+  CompactTxnHashResolver(
+      const std::function<uint64_t(const TxnHash&)>& shortTxnId,
+      const std::vector<uint64_t>& shortTxnIds)
+      : m_shortTxnId(shortTxnId),
+        m_shortTxnIds(shortTxnIds),
+        m_tranHashes(shortTxnIds.size()),
+        m_missingIndexes(shortTxnIds.size()) {
+    std::iota(m_missingIndexes.begin(), m_missingIndexes.end(), 0);
+  }
+
+  /// Fills in the missing hashes whose short ID matches exactly one of the
+  /// local txn hashes. Short IDs shared by several local txns, or by several
+  /// txns of the block, stay missing.
+  void ResolveLocal(const std::vector<TxnHash>& localHashes) {
+    std::unordered_map<uint64_t, const TxnHash*> localTxns;
+    std::unordered_set<uint64_t> collisions;
+    localTxns.reserve(localHashes.size());
+    for (const auto& tranHash : localHashes) {
+      const uint64_t shortTxnId = m_shortTxnId(tranHash);
+      if (!localTxns.emplace(shortTxnId, &tranHash).second) {
+        collisions.emplace(shortTxnId);
+      }
+    }
+
+    std::unordered_set<uint64_t> blockTxns;
+    for (const auto& shortTxnId : m_shortTxnIds) {
+      if (!blockTxns.emplace(shortTxnId).second) {
+        collisions.emplace(shortTxnId);
+      }
+    }
+
+    std::vector<uint32_t> unresolved;
+    for (const auto& index : m_missingIndexes) {
+      const auto found = localTxns.find(m_shortTxnIds.at(index));
+      if (found == localTxns.end() || collisions.count(found->first) > 0) {
+        unresolved.emplace_back(index);
+      } else {
+        m_tranHashes.at(index) = *found->second;
+      }
+    }
+    m_missingIndexes = std::move(unresolved);
+  }
+
+  /// Fills in the missing hashes with the txns fetched for them. The leader
+  /// answers in the order of the requested indexes and leaves out the ones it
+  /// cannot find, so each fetched txn takes the first missing index with its
+  /// short ID, without being looked up in the (possibly colliding) pool.
+  void ResolveFetched(const std::vector<TxnHash>& fetchedHashes) {
+    std::unordered_map<uint64_t, std::deque<uint32_t>> requested;
+    for (const auto& index : m_missingIndexes) {
+      requested[m_shortTxnIds.at(index)].emplace_back(index);
+    }
+
+    std::vector<bool> resolved(m_tranHashes.size(), false);
+    for (const auto& tranHash : fetchedHashes) {
+      const auto found = requested.find(m_shortTxnId(tranHash));
+      if (found == requested.end() || found->second.empty()) {
+        continue;
+      }
+      m_tranHashes.at(found->second.front()) = tranHash;
+      resolved.at(found->second.front()) = true;
+      found->second.pop_front();
+    }
+
+    m_missingIndexes.erase(
+        std::remove_if(m_missingIndexes.begin(), m_missingIndexes.end(),
+                       [&resolved](uint32_t index) { return resolved[index]; }),
+        m_missingIndexes.end());
+  }
+
+  /// Returns the indexes of the short IDs not resolved yet.
+  const std::vector<uint32_t>& GetMissingIndexes() const {
+    return m_missingIndexes;
+  }
+
+  /// Returns the txn hashes, in the order of the short IDs.
+  std::vector<TxnHash>& GetTranHashes() { return m_tranHashes; }
+};
+
+#endif  // __SHORTTXNID_H__
@@ -119,10 +119,9 @@ Transaction::Transaction(const uint32_t& version, const uint64_t& nonce,
   }
 }
 
-Transaction::Transaction(const TxnHash& tranID,
-                         const TransactionCoreInfo coreInfo,
+Transaction::Transaction(const TxnHash& tranID, TransactionCoreInfo coreInfo,
                          const Signature& signature)
-    : m_tranID(tranID), m_coreInfo(coreInfo), m_signature(signature) {}
+    : m_tranID(tranID), m_coreInfo(move(coreInfo)), m_signature(signature) {}
 
 bool Transaction::Serialize(vector<unsigned char>& dst,
                             unsigned int offset) const {
@@ -81,6 +81,9 @@ class Transaction : public SerializableDataBlock {
   /// Copy constructor.
   Transaction(const Transaction& src);
 
+  /// Move constructor (takes over the code and data buffers).
+  Transaction(Transaction&& src) = default;
+
   /// Constructor with specified transaction fields.
   Transaction(const uint32_t& version, const uint64_t& nonce,
               const Address& toAddr, const KeyPair& senderKeyPair,
@@ -110,7 +113,7 @@ class Transaction : public SerializableDataBlock {
               const Signature& signature);
 
   /// Constructor with core information.
-  Transaction(const TxnHash& tranID, const TransactionCoreInfo coreInfo,
+  Transaction(const TxnHash& tranID, TransactionCoreInfo coreInfo,
               const Signature& signature);
 
   /// Constructor for loading transaction information from a byte stream.
@@ -184,6 +187,9 @@ class Transaction : public SerializableDataBlock {
 
   /// Assignment operator.
   Transaction& operator=(const Transaction& src);
+
+  /// Move assignment operator.
+  Transaction& operator=(Transaction&& src) = default;
 };
 
 #endif  // __TRANSACTION_H__
@@ -66,6 +66,8 @@ class TransactionWithReceipt : public SerializableDataBlock {
   TransactionWithReceipt(const Transaction& tran,
                          const TransactionReceipt& tranReceipt)
       : m_transaction(tran), m_tranReceipt(tranReceipt) {}
+  TransactionWithReceipt(Transaction&& tran, TransactionReceipt&& tranReceipt)
+      : m_transaction(std::move(tran)), m_tranReceipt(std::move(tranReceipt)) {}
   TransactionWithReceipt(const std::vector<unsigned char>& src,
                          unsigned int offset) {
     Deserialize(src, offset);
@@ -26,11 +26,9 @@
 
 struct TxnPool {
   struct PubKeyNonceHash {
-    std::size_t operator()(
-        const std::pair<PubKey, boost::multiprecision::uint128_t>& p) const {
-      std::size_t seed = 0;
-      boost::hash_combine(seed, std::string(p.first));
-      boost::hash_combine(seed, p.second.convert_to<std::string>());
+    std::size_t operator()(const std::pair<PubKey, uint64_t>& p) const {
+      std::size_t seed = std::hash<PubKey>()(p.first);
+      boost::hash_combine(seed, p.second);
 
       return seed;
     }
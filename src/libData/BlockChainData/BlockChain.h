@@ -58,6 +58,13 @@ class BlockChain {
     return m_blocks.size();
   }
 
+  /// Sets the number of blocks when only the most recent ones were added
+  /// (older blocks are then read from persistent storage on demand).
+  void SetBlockCount(const uint64_t& count) {
+    std::lock_guard<std::mutex> g(m_mutexBlocks);
+    m_blocks.set_size(count);
+  }
+
   /// Returns the last stored block.
   T GetLastBlock() {
     std::lock_guard<std::mutex> g(m_mutexBlocks);
@@ -57,6 +57,13 @@ class BlockLinkChain {
 
   BlockLinkChain() { Reset(); };
 
+  /// Sets the number of links when only the most recent ones are added
+  /// (older links are then read from persistent storage on demand).
+  void SetLinkCount(const uint64_t& count) {
+    std::lock_guard<std::mutex> g(m_mutexBlockLinkChain);
+    m_blockLinkChain.set_size(count);
+  }
+
   BlockLink GetBlockLink(const uint64_t& index) {
     std::lock_guard<std::mutex> g(m_mutexBlockLinkChain);
     if (m_blockLinkChain.size() <= index) {
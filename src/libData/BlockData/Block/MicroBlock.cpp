@@ -72,7 +72,11 @@ MicroBlock::MicroBlock(const vector<unsigned char>& src, unsigned int offset) {
 
 MicroBlock::MicroBlock(const MicroBlockHeader& header,
                        const vector<TxnHash>& tranHashes, CoSignatures&& cosigs)
-    : m_header(header), m_tranHashes(tranHashes) {
+    : MicroBlock(header, vector<TxnHash>(tranHashes), move(cosigs)) {}
+
+MicroBlock::MicroBlock(const MicroBlockHeader& header,
+                       vector<TxnHash>&& tranHashes, CoSignatures&& cosigs)
+    : m_header(header), m_tranHashes(move(tranHashes)) {
   if (m_header.GetNumTxs() != m_tranHashes.size()) {
     LOG_GENERAL(WARNING, "Num of Txns get from header "
                              << m_header.GetNumTxs()
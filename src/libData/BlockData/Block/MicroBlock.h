@@ -50,6 +50,8 @@ class MicroBlock : public BlockBase {
   /// Constructor with predefined member values
   MicroBlock(const MicroBlockHeader& header,
              const std::vector<TxnHash>& tranHashes, CoSignatures&& cosigs);
+  MicroBlock(const MicroBlockHeader& header, std::vector<TxnHash>&& tranHashes,
+             CoSignatures&& cosigs);
 
   /// Implements the Serialize function inherited from Serializable.
   bool Serialize(std::vector<unsigned char>& dst, unsigned int offset) const;
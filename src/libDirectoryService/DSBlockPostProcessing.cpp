@@ -30,6 +30,7 @@
 #include "depends/libTrie/TrieDB.h"
 #include "depends/libTrie/TrieHash.h"
 #include "libCrypto/Sha2.h"
+#include "libData/AccountData/AccountStore.h"
 #include "libMediator/Mediator.h"
 #include "libMessage/Messenger.h"
 #include "libNetwork/Guard.h"
@@ -38,6 +39,7 @@
 #include "libUtils/DetachedFunction.h"
 #include "libUtils/HashUtils.h"
 #include "libUtils/Logger.h"
+#include "libUtils/Metrics.h"
 #include "libUtils/SanityChecks.h"
 
 using namespace std;
@@ -426,7 +428,7 @@ void DirectoryService::StartFirstTxEpoch() {
     m_mediator.m_node->m_myshardId = m_shards.size();
     m_mediator.m_node->m_justDidFallback = false;
     m_mediator.m_node->CommitTxnPacketBuffer();
-    m_stateDeltaFromShards.clear();
+    AccountStore::GetInstance().ClearShardDeltas();
 
     // Start sharding work
     SetState(MICROBLOCK_SUBMISSION);
@@ -525,6 +527,7 @@ void DirectoryService::ProcessDSBlockConsensusWhenDone(
 
   LOG_EPOCH(INFO, to_string(m_mediator.m_currentEpochNum).c_str(),
             "DS block consensus is DONE!!!");
+  Metrics::GetInstance().EndPhase(EpochPhase::DSBLOCK_CONSENSUS);
 
   lock_guard<mutex> g(m_mediator.m_node->m_mutexDSBlock);
 
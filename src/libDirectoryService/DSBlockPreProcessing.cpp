@@ -38,6 +38,7 @@
 #include "libUtils/DetachedFunction.h"
 #include "libUtils/HashUtils.h"
 #include "libUtils/Logger.h"
+#include "libUtils/Metrics.h"
 #include "libUtils/SanityChecks.h"
 #include "libUtils/TimestampVerifier.h"
 #include "libUtils/UpgradeManager.h"
@@ -1266,6 +1267,7 @@ void DirectoryService::RunConsensusOnDSBlock(bool isRejoin) {
 
   LOG_MARKER();
   SetState(DSBLOCK_CONSENSUS_PREP);
+  Metrics::GetInstance().StartPhase(EpochPhase::DSBLOCK_CONSENSUS);
 
   {
     lock_guard<mutex> h(m_mutexCoinbaseRewardees);
@@ -396,6 +396,16 @@ vector<Peer> DirectoryService::GetBroadcastList(
   return vector<Peer>();
 }
 
+vector<PubKey> DirectoryService::GetBroadcastOriginators() {
+  // DS messages are only broadcast within the DS committee
+  vector<PubKey> keys;
+  lock_guard<mutex> g(m_mediator.m_mutexDSCommittee);
+  for (const auto& member : *m_mediator.m_DSCommittee) {
+    keys.emplace_back(member.first);
+  }
+  return keys;
+}
+
 bool DirectoryService::CleanVariables() {
   if (LOOKUP_NODE_MODE) {
     LOG_GENERAL(WARNING,
@@ -34,6 +34,7 @@
 #include <vector>
 
 #include "common/Broadcastable.h"
+#include "common/Constants.h"
 #include "common/Executable.h"
 #include "libConsensus/Consensus.h"
 #include "libData/BlockData/Block.h"
@@ -45,9 +46,11 @@
 #include "libNetwork/PeerStore.h"
 #include "libNetwork/ShardStruct.h"
 #include "libPersistence/BlockStorage.h"
+#include "libUtils/ThreadPool.h"
 #include "libUtils/TimeUtils.h"
 
 class Mediator;
+struct PoWVerifyRequest;
 
 struct PoWSolution {
   uint64_t nonce;
@@ -210,7 +213,10 @@ class DirectoryService : public Executable, public Broadcastable {
                             unsigned int offset, const Peer& from);
   bool ProcessPoWPacketSubmission(const std::vector<unsigned char>& message,
                                   unsigned int offset, const Peer& from);
-  bool ProcessPoWSubmissionFromPacket(const DSPowSolution& sol);
+  void ProcessPoWSubmissionsFromPacket(const std::vector<DSPowSolution>& sols);
+  bool PreCheckPoWSubmission(const DSPowSolution& sol,
+                             PoWVerifyRequest& request);
+  void AddVerifiedPoWSubmission(const DSPowSolution& sol);
 
   bool ProcessDSBlockConsensus(const std::vector<unsigned char>& message,
                                unsigned int offset, const Peer& from);
@@ -320,6 +326,10 @@ class DirectoryService : public Executable, public Broadcastable {
   bool ProcessMicroblockSubmissionFromShardCore(
       const MicroBlock& microBlocks,
       const std::vector<unsigned char>& stateDelta);
+  bool VerifyMicroBlockSubmission(const MicroBlock& microBlock,
+                                  const std::vector<unsigned char>& stateDelta);
+  bool MergeMicroBlockSubmission(const MicroBlock& microBlock,
+                                 const std::vector<unsigned char>& stateDelta);
   bool ProcessMissingMicroblockSubmission(
       const uint64_t epochNumber, const std::vector<MicroBlock>& microBlocks,
       const std::vector<std::vector<unsigned char>>& stateDeltas);
@@ -329,6 +339,8 @@ class DirectoryService : public Executable, public Broadcastable {
                                   uint32_t& numTxs);
   bool VerifyMicroBlockCoSignature(const MicroBlock& microBlock,
                                    uint32_t shardId);
+  bool VerifyStateDelta(const std::vector<unsigned char>& stateDelta,
+                        const StateHash& microBlockStateDeltaHash);
   bool ProcessStateDelta(const std::vector<unsigned char>& stateDelta,
                          const StateHash& microBlockStateDeltaHash,
                          const BlockHash& microBlockHash);
@@ -505,10 +517,6 @@ class DirectoryService : public Executable, public Broadcastable {
   /// The epoch number when DS tries doing Rejoin
   uint64_t m_latestActiveDSBlockNum = 0;
 
-  /// Serialized account store temp to revert to if ds microblock consensus
-  /// failed
-  std::vector<unsigned char> m_stateDeltaFromShards;
-
   /// Whether ds started microblock consensus
   std::atomic<bool> m_stopRecvNewMBSubmission;
 
@@ -516,6 +524,9 @@ class DirectoryService : public Executable, public Broadcastable {
   std::mutex m_mutexPrepareRunFinalblockConsensus;
   std::atomic<bool> m_startedRunFinalblockConsensus;
 
+  std::mutex m_mutexMBVerifyPool;
+  ThreadPool m_mbVerifyPool{MICROBLOCK_VERIFY_THREADS, "MBVerifyPool"};
+
   std::mutex m_mutexMicroBlocks;
   std::unordered_map<uint64_t, std::set<MicroBlock>> m_microBlocks;
   std::unordered_map<uint64_t, std::vector<BlockHash>> m_missingMicroBlocks;
@@ -551,6 +562,10 @@ class DirectoryService : public Executable, public Broadcastable {
   std::vector<Peer> GetBroadcastList(unsigned char ins_type,
                                      const Peer& broadcast_originator);
 
+  /// Implements the GetBroadcastOriginators function inherited from
+  /// Broadcastable.
+  std::vector<PubKey> GetBroadcastOriginators();
+
   /// Launches separate thread to execute sharding consensus after wait_window
   /// seconds.
   void ScheduleShardingConsensus(const unsigned int wait_window);
@@ -34,6 +34,7 @@
 #include "libUtils/DataConversion.h"
 #include "libUtils/DetachedFunction.h"
 #include "libUtils/Logger.h"
+#include "libUtils/Metrics.h"
 #include "libUtils/SanityChecks.h"
 #include "libUtils/UpgradeManager.h"
 
@@ -67,16 +68,24 @@ void DirectoryService::StoreFinalBlockToDisk() {
                 << ", Timestamp: " << m_finalBlock->GetTimestamp()
                 << ", NumTxs: " << m_finalBlock->GetHeader().GetNumTxs());
 
+  // The block and its state delta are committed together
+  BlockStorage::Batch batch;
+
   vector<unsigned char> serializedTxBlock;
   m_finalBlock->Serialize(serializedTxBlock, 0);
   BlockStorage::GetBlockStorage().PutTxBlock(
-      m_finalBlock->GetHeader().GetBlockNum(), serializedTxBlock);
+      batch, m_finalBlock->GetHeader().GetBlockNum(), serializedTxBlock);
 
   vector<unsigned char> stateDelta;
   AccountStore::GetInstance().GetSerializedDelta(stateDelta);
   BlockStorage::GetBlockStorage().PutStateDelta(
-      m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum(),
+      batch, m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum(),
       stateDelta);
+
+  if (!BlockStorage::GetBlockStorage().CommitBatch(batch)) {
+    LOG_GENERAL(WARNING, "Failed to store final block "
+                             << m_finalBlock->GetHeader().GetBlockNum());
+  }
 }
 
 bool DirectoryService::ComposeFinalBlockMessageForSender(
@@ -249,6 +258,7 @@ void DirectoryService::ProcessFinalBlockConsensusWhenDone() {
 
   LOG_EPOCH(INFO, to_string(m_mediator.m_currentEpochNum).c_str(),
             "Final block consensus is DONE!!!");
+  Metrics::GetInstance().EndPhase(EpochPhase::FINALBLOCK_CONSENSUS);
 
   // Clear microblock(s)
   // m_microBlocks.clear();
@@ -326,7 +336,7 @@ void DirectoryService::ProcessFinalBlockConsensusWhenDone() {
 
   AccountStore::GetInstance().InitTemp();
   AccountStore::GetInstance().InitReversibles();
-  m_stateDeltaFromShards.clear();
+  AccountStore::GetInstance().ClearShardDeltas();
   m_allPoWConns.clear();
   ClearDSPoWSolns();
   ResetPoWSubmissionCounter();
@@ -35,6 +35,7 @@
 #include "libUtils/DataConversion.h"
 #include "libUtils/DetachedFunction.h"
 #include "libUtils/Logger.h"
+#include "libUtils/Metrics.h"
 #include "libUtils/RootComputation.h"
 #include "libUtils/SanityChecks.h"
 #include "libUtils/TimestampVerifier.h"
@@ -119,6 +120,8 @@ bool DirectoryService::ComposeFinalBlock() {
     return true;
   }
 
+  ScopedPhaseTimer timer(EpochPhase::FINALBLOCK_COMPOSITION);
+
   std::vector<MicroBlockInfo> mbInfos;
   std::vector<uint32_t> shardIds;
   uint8_t type = TXBLOCKTYPE::FINAL;
@@ -232,7 +235,7 @@ bool DirectoryService::RunConsensusOnFinalBlockWhenDSPrimary(
 
     if (!m_mediator.m_node->ComposeMicroBlock()) {
       LOG_GENERAL(WARNING, "DS ComposeMicroBlock Failed");
-      m_mediator.m_node->m_microblock = nullptr;
+      atomic_store(&m_mediator.m_node->m_microblock, shared_ptr<MicroBlock>());
     } else {
       m_microBlocks[m_mediator.m_currentEpochNum].emplace(
           *(m_mediator.m_node->m_microblock));
@@ -519,8 +522,7 @@ bool DirectoryService::CheckMicroBlocks(std::vector<unsigned char>& errorMsg,
 
     // AccountStore::GetInstance().InitTemp();
     // LOG_GENERAL(WARNING, "Got missing microblocks, revert state delta");
-    // AccountStore::GetInstance().DeserializeDeltaTemp(
-    //     m_mediator.m_ds->m_stateDeltaFromShards, 0);
+    // AccountStore::GetInstance().RevertTempToShardDeltas();
 
     m_consensusObject->SetConsensusErrorCode(
         ConsensusCommon::FINALBLOCK_MISSING_MICROBLOCKS);
@@ -1048,7 +1050,7 @@ bool DirectoryService::CheckMicroBlockValidity(
   }
 
   if (!ret) {
-    m_mediator.m_node->m_microblock = nullptr;
+    atomic_store(&m_mediator.m_node->m_microblock, shared_ptr<MicroBlock>());
     Serializable::SetNumber<uint32_t>(errorMsg, errorMsg.size(),
                                       m_mediator.m_selfPeer.m_listenPortHost,
                                       sizeof(uint32_t));
@@ -1077,15 +1079,27 @@ bool DirectoryService::FinalBlockValidator(
 
   m_finalBlock.reset(new TxBlock);
 
-  m_mediator.m_node->m_microblock.reset(new MicroBlock());
+  // Decode before publishing, ProcessSubmitMissingTxnRequest may read it
+  shared_ptr<MicroBlock> microblock(new MicroBlock());
+  vector<uint64_t> shortTxnIds;
 
   if (!Messenger::GetDSFinalBlockAnnouncement(
           message, offset, consensusID, blockNumber, blockHash, leaderID,
-          leaderKey, *m_finalBlock, m_mediator.m_node->m_microblock,
+          leaderKey, *m_finalBlock, microblock, shortTxnIds,
           messageToCosign)) {
     LOG_EPOCH(WARNING, to_string(m_mediator.m_currentEpochNum).c_str(),
               "Messenger::GetDSFinalBlockAnnouncement failed.");
-    m_mediator.m_node->m_microblock = nullptr;
+    atomic_store(&m_mediator.m_node->m_microblock, shared_ptr<MicroBlock>());
+    return false;
+  }
+  atomic_store(&m_mediator.m_node->m_microblock, microblock);
+
+  if (m_mediator.m_node->m_microblock != nullptr &&
+      !m_mediator.m_node->ResolveCompactMicroBlock(
+          shortTxnIds, m_mediator.m_DSCommittee->at(leaderID).second)) {
+    LOG_EPOCH(WARNING, to_string(m_mediator.m_currentEpochNum).c_str(),
+              "ResolveCompactMicroBlock failed.");
+    atomic_store(&m_mediator.m_node->m_microblock, shared_ptr<MicroBlock>());
     return false;
   }
 
@@ -1109,11 +1123,13 @@ bool DirectoryService::FinalBlockValidator(
       m_needCheckMicroBlock = false;
       AccountStore::GetInstance().SerializeDelta();
       AccountStore::GetInstance().CommitTempReversible();
+    } else if (m_mediator.m_node->m_microblock == nullptr) {
+      // No DS microblock, so the delta holds only the merged shard deltas
+      AccountStore::GetInstance().SerializeDelta();
     }
   } else {
-    m_mediator.m_node->m_microblock = nullptr;
-    AccountStore::GetInstance().InitTemp();
-    AccountStore::GetInstance().DeserializeDeltaTemp(m_stateDeltaFromShards, 0);
+    atomic_store(&m_mediator.m_node->m_microblock, shared_ptr<MicroBlock>());
+    AccountStore::GetInstance().RevertTempToShardDeltas();
     AccountStore::GetInstance().SerializeDelta();
   }
 
@@ -1263,6 +1279,7 @@ void DirectoryService::RunConsensusOnFinalBlock(
 #endif  // FALLBACK_TEST
 
     SetState(FINALBLOCK_CONSENSUS_PREP);
+    Metrics::GetInstance().StartPhase(EpochPhase::FINALBLOCK_CONSENSUS);
 
     m_mediator.m_node->PrepareGoodStateForFinalBlock();
 
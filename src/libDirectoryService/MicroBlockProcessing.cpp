@@ -36,6 +36,7 @@
 #include "libUtils/DataConversion.h"
 #include "libUtils/DetachedFunction.h"
 #include "libUtils/Logger.h"
+#include "libUtils/ParallelFor.h"
 #include "libUtils/SanityChecks.h"
 #include "libUtils/TimestampVerifier.h"
 
@@ -124,6 +125,34 @@ bool DirectoryService::VerifyMicroBlockCoSignature(const MicroBlock& microBlock,
   return true;
 }
 
+// Checks the state delta against the hash in the microblock. This does not
+// touch any shared state, so callers run it before taking m_mutexMicroBlocks.
+bool DirectoryService::VerifyStateDelta(
+    const vector<unsigned char>& stateDelta,
+    const StateHash& microBlockStateDeltaHash) {
+  if ((microBlockStateDeltaHash == StateHash()) || stateDelta.empty()) {
+    // Nothing to check, ProcessStateDelta will skip it
+    return true;
+  }
+
+  SHA2<HASH_TYPE::HASH_VARIANT_256> sha2;
+  sha2.Update(stateDelta);
+  StateHash stateDeltaHash(sha2.Finalize());
+
+  LOG_GENERAL(INFO, "Calculated StateHash: " << stateDeltaHash);
+
+  if (stateDeltaHash != microBlockStateDeltaHash) {
+    LOG_GENERAL(WARNING,
+                "State delta hash calculated does not match microblock");
+    return false;
+  }
+
+  return true;
+}
+
+// Merges a state delta already checked by VerifyStateDelta into the temp
+// state. The accumulated delta is only serialized when the final block is
+// composed or validated.
 bool DirectoryService::ProcessStateDelta(
     const vector<unsigned char>& stateDelta,
     const StateHash& microBlockStateDeltaHash,
@@ -155,37 +184,11 @@ bool DirectoryService::ProcessStateDelta(
     LOG_GENERAL(INFO, "State Delta size: " << stateDelta.size());
   }
 
-  SHA2<HASH_TYPE::HASH_VARIANT_256> sha2;
-  sha2.Update(stateDelta);
-  StateHash stateDeltaHash(sha2.Finalize());
-
-  LOG_GENERAL(INFO, "Calculated StateHash: " << stateDeltaHash);
-
-  if (stateDeltaHash != microBlockStateDeltaHash) {
-    LOG_GENERAL(WARNING,
-                "State delta hash calculated does not match microblock");
-    return false;
-  }
-
-  if (microBlockStateDeltaHash == StateHash()) {
-    LOG_GENERAL(INFO, "State Delta from microblock is empty");
-    return false;
-  }
-
-  if (!AccountStore::GetInstance().DeserializeDeltaTemp(stateDelta, 0)) {
-    LOG_GENERAL(WARNING, "AccountStore::DeserializeDeltaTemp failed.");
+  if (!AccountStore::GetInstance().MergeShardDeltaTemp(stateDelta, 0)) {
+    LOG_GENERAL(WARNING, "AccountStore::MergeShardDeltaTemp failed.");
     return false;
   }
 
-  m_stateDeltaFromShards.clear();
-
-  if (!AccountStore::GetInstance().SerializeDelta()) {
-    LOG_GENERAL(WARNING, "AccountStore::SerializeDelta failed.");
-    return false;
-  }
-
-  AccountStore::GetInstance().GetSerializedDelta(m_stateDeltaFromShards);
-
   m_microBlockStateDeltas[m_mediator.m_currentEpochNum].emplace(microBlockHash,
                                                                 stateDelta);
 
@@ -201,6 +204,14 @@ bool DirectoryService::ProcessMicroblockSubmissionFromShardCore(
     return true;
   }
 
+  return VerifyMicroBlockSubmission(microBlock, stateDelta) &&
+         MergeMicroBlockSubmission(microBlock, stateDelta);
+}
+
+// Runs every check on a submission that does not depend on the other
+// submissions of the epoch, so several of them can be verified concurrently
+bool DirectoryService::VerifyMicroBlockSubmission(
+    const MicroBlock& microBlock, const vector<unsigned char>& stateDelta) {
   // Verify the Block Hash
   BlockHash temp_blockHash = microBlock.GetHeader().GetMyHash();
   if (temp_blockHash != microBlock.GetBlockHash()) {
@@ -272,6 +283,20 @@ bool DirectoryService::ProcessMicroblockSubmissionFromShardCore(
   LOG_GENERAL(INFO, "MicroBlock StateDeltaHash: "
                         << microBlock.GetHeader().GetHashes());
 
+  if (!m_mediator.GetIsVacuousEpoch() &&
+      !VerifyStateDelta(stateDelta,
+                        microBlock.GetHeader().GetStateDeltaHash())) {
+    LOG_GENERAL(WARNING, "State delta attached to the microblock is invalid");
+    return false;
+  }
+
+  return true;
+}
+
+// Adds a submission already checked by VerifyMicroBlockSubmission to the
+// epoch's microblocks and merges its state delta into the temp state
+bool DirectoryService::MergeMicroBlockSubmission(
+    const MicroBlock& microBlock, const vector<unsigned char>& stateDelta) {
   lock_guard<mutex> g(m_mutexMicroBlocks);
 
   if (m_stopRecvNewMBSubmission) {
@@ -348,10 +373,19 @@ void DirectoryService::CommitMBSubmissionMsgBuffer() {
     if (it->first < m_mediator.m_currentEpochNum) {
       it = m_MBSubmissionBuffer.erase(it);
     } else if (it->first == m_mediator.m_currentEpochNum) {
-      for (const auto& entry : it->second) {
-        ProcessMicroblockSubmissionFromShardCore(entry.m_microBlock,
-                                                 entry.m_stateDelta);
-      }
+      // Verify the buffered submissions together, then merge them in the
+      // order they arrived
+      const auto& entries = it->second;
+      ParallelVerifyThenMerge(
+          m_mbVerifyPool, m_mutexMBVerifyPool, entries.size(),
+          [this, &entries](size_t i) -> bool {
+            return VerifyMicroBlockSubmission(entries.at(i).m_microBlock,
+                                              entries.at(i).m_stateDelta);
+          },
+          [this, &entries](size_t i) -> bool {
+            return MergeMicroBlockSubmission(entries.at(i).m_microBlock,
+                                             entries.at(i).m_stateDelta);
+          });
       m_MBSubmissionBuffer.erase(it);
       break;
     } else {
@@ -476,18 +510,40 @@ bool DirectoryService::ProcessMissingMicroblockSubmission(
                   << " , local: " << m_mediator.m_currentEpochNum);
   }
 
+  if (microBlocks.size() != stateDeltas.size()) {
+    LOG_GENERAL(WARNING, "size of microBlocks fetched "
+                             << microBlocks.size()
+                             << " is different from size of "
+                                "stateDeltas fetched "
+                             << stateDeltas.size());
+    return false;
+  }
+
+  // The fetched microblocks come from different shards and are independent,
+  // so check their co-signatures and state deltas in parallel before taking
+  // the lock
+  const bool isVacuousEpoch = m_mediator.GetIsVacuousEpoch(epochNumber);
+  vector<unsigned char> coSigVerified(microBlocks.size(), false);
+  vector<unsigned char> stateDeltaVerified(microBlocks.size(), false);
+  ParallelFor(
+      m_mbVerifyPool, m_mutexMBVerifyPool, microBlocks.size(),
+      [&](size_t i) -> void {
+        const auto& microBlock = microBlocks.at(i);
+        const uint32_t shardId = microBlock.GetHeader().GetShardId();
+        coSigVerified[i] = (shardId == m_mediator.m_node->m_myshardId) ||
+                           ((shardId <= m_shards.size()) &&
+                            VerifyMicroBlockCoSignature(microBlock, shardId));
+        stateDeltaVerified[i] =
+            isVacuousEpoch ||
+            VerifyStateDelta(stateDeltas.at(i),
+                             microBlock.GetHeader().GetStateDeltaHash());
+      });
+
   {
     lock_guard<mutex> g(m_mutexMicroBlocks);
     auto& microBlocksAtEpoch = m_microBlocks[epochNumber];
-
-    if (microBlocks.size() != stateDeltas.size()) {
-      LOG_GENERAL(WARNING, "size of microBlocks fetched "
-                               << microBlocks.size()
-                               << " is different from size of "
-                                  "stateDeltas fetched "
-                               << stateDeltas.size());
-      return false;
-    }
+    bool mergedStateDelta = false;
+    BlockStorage::Batch batch;
 
     for (unsigned int i = 0; i < microBlocks.size(); ++i) {
       if (!m_mediator.CheckWhetherBlockIsLatest(
@@ -539,12 +595,10 @@ bool DirectoryService::ProcessMissingMicroblockSubmission(
       }
 
       // Verify the co-signature
-      if (shardId != m_mediator.m_node->m_myshardId) {
-        if (!VerifyMicroBlockCoSignature(microBlocks[i], shardId)) {
-          LOG_EPOCH(WARNING, to_string(m_mediator.m_currentEpochNum).c_str(),
-                    "Microblock co-sig verification failed");
-          continue;
-        }
+      if (!coSigVerified[i]) {
+        LOG_EPOCH(WARNING, to_string(m_mediator.m_currentEpochNum).c_str(),
+                  "Microblock co-sig verification failed");
+        continue;
       }
 
       {
@@ -592,8 +646,9 @@ bool DirectoryService::ProcessMissingMicroblockSubmission(
         }
       }
 
-      if (!m_mediator.GetIsVacuousEpoch(epochNumber)) {
-        if (!ProcessStateDelta(
+      if (!isVacuousEpoch) {
+        if (!stateDeltaVerified[i] ||
+            !ProcessStateDelta(
                 stateDeltas.at(i),
                 microBlocks.at(i).GetHeader().GetStateDeltaHash(),
                 microBlocks.at(i).GetBlockHash())) {
@@ -601,14 +656,13 @@ bool DirectoryService::ProcessMissingMicroblockSubmission(
                       "State delta attached to the microblock is invalid");
           continue;
         }
+        mergedStateDelta = true;
       }
 
       vector<unsigned char> body;
       microBlocks[i].Serialize(body, 0);
-      if (!BlockStorage::GetBlockStorage().PutMicroBlock(
-              microBlocks[i].GetBlockHash(), body)) {
-        LOG_GENERAL(WARNING, "Failed to put microblock in persistence");
-      }
+      BlockStorage::GetBlockStorage().PutMicroBlock(
+          batch, microBlocks[i].GetBlockHash(), body);
 
       microBlocksAtEpoch.emplace(microBlocks.at(i));
       // m_fetchedMicroBlocks.emplace(microBlock);
@@ -618,6 +672,15 @@ bool DirectoryService::ProcessMissingMicroblockSubmission(
                             << " microblocks received for Epoch "
                             << epochNumber);
     }
+
+    // Refresh the serialized delta once for the whole batch
+    if (mergedStateDelta && !AccountStore::GetInstance().SerializeDelta()) {
+      LOG_GENERAL(WARNING, "AccountStore::SerializeDelta failed.");
+    }
+
+    if (!BlockStorage::GetBlockStorage().CommitBatch(batch)) {
+      LOG_GENERAL(WARNING, "Failed to put microblocks in persistence");
+    }
   }
 
   // TODO: Check if every microblock is obtained
@@ -81,9 +81,7 @@ bool DirectoryService::ProcessAndSendPoWPacketSubmissionToOtherDSComm() {
     P2PComm::GetInstance().SendMessage(peerList, powpacketmessage);
   }
 
-  for (auto& sol : m_powSolutions) {
-    ProcessPoWSubmissionFromPacket(sol);
-  }
+  ProcessPoWSubmissionsFromPacket(m_powSolutions);
 
   return true;
 }
@@ -108,9 +106,7 @@ bool DirectoryService::ProcessPoWPacketSubmission(
   }
 
   LOG_GENERAL(INFO, "PoW solutions received in this packet: " << tmp.size());
-  for (auto& sol : tmp) {
-    ProcessPoWSubmissionFromPacket(sol);
-  }
+  ProcessPoWSubmissionsFromPacket(tmp);
 
   return true;
 }
@@ -177,16 +173,16 @@ bool DirectoryService::ProcessPoWSubmission(
   return true;
 }
 
-bool DirectoryService::ProcessPoWSubmissionFromPacket(
-    const DSPowSolution& sol) {
+void DirectoryService::ProcessPoWSubmissionsFromPacket(
+    const vector<DSPowSolution>& sols) {
   LOG_MARKER();
 
   if (LOOKUP_NODE_MODE) {
     LOG_GENERAL(
         WARNING,
-        "DirectoryService::ProcessPoWSubmissionFromPacket not expected to be "
+        "DirectoryService::ProcessPoWSubmissionsFromPacket not expected to be "
         "called from LookUp node.");
-    return true;
+    return;
   }
 
   if (m_state == FINALBLOCK_CONSENSUS) {
@@ -206,18 +202,59 @@ bool DirectoryService::ProcessPoWSubmissionFromPacket(
   if (!CheckState(PROCESS_POWSUBMISSION)) {
     LOG_EPOCH(INFO, to_string(m_mediator.m_currentEpochNum).c_str(),
               "Not at POW_SUBMISSION. Current state is " << m_state);
-    return false;
+    return;
+  }
+
+  // Cheap checks run sequentially; only the survivors reach ethash
+  vector<const DSPowSolution*> toVerify;
+  vector<PoWVerifyRequest> requests;
+  for (const auto& sol : sols) {
+    PoWVerifyRequest request;
+    if (PreCheckPoWSubmission(sol, request)) {
+      toVerify.emplace_back(&sol);
+      requests.emplace_back(request);
+    }
+  }
+
+  if (requests.empty()) {
+    return;
+  }
+
+  m_timespec = r_timer_start();
+
+  vector<unsigned char> results = POW::GetInstance().PoWVerifyBatch(requests);
+
+  LOG_EPOCH(INFO, to_string(m_mediator.m_currentEpochNum).c_str(),
+            "[POWSTAT] pow verify of " << requests.size()
+                                       << " submissions (microsec): "
+                                       << r_timer_end(m_timespec));
+
+  for (size_t i = 0; i < toVerify.size(); i++) {
+    const DSPowSolution& sol = *toVerify.at(i);
+    if (results.at(i)) {
+      AddVerifiedPoWSubmission(sol);
+    } else {
+      LOG_EPOCH(INFO, to_string(m_mediator.m_currentEpochNum).c_str(),
+                "Invalid PoW submission"
+                    << "\n"
+                    << "blockNum: " << sol.GetBlockNumber() << " Difficulty: "
+                    << to_string(sol.GetDifficultyLevel())
+                    << " nonce: " << sol.GetNonce()
+                    << " ip: " << sol.GetSubmitterPeer() << " rand1: "
+                    << DataConversion::charArrToHexStr(m_mediator.m_dsBlockRand)
+                    << " rand2: "
+                    << DataConversion::charArrToHexStr(
+                           m_mediator.m_txBlockRand));
+    }
   }
+}
+
+bool DirectoryService::PreCheckPoWSubmission(const DSPowSolution& sol,
+                                             PoWVerifyRequest& request) {
   uint8_t difficultyLevel = sol.GetDifficultyLevel();
   uint64_t blockNumber = sol.GetBlockNumber();
   Peer submitterPeer = sol.GetSubmitterPeer();
   PubKey submitterPubKey = sol.GetSubmitterKey();
-  uint64_t nonce = sol.GetNonce();
-  string resultingHash = sol.GetResultingHash();
-  string mixHash = sol.GetMixHash();
-  Signature signature = sol.GetSignature();
-  uint32_t lookupId = sol.GetLookupId();
-  uint128_t gasPrice = sol.GetGasPrice();
 
   // Check block number
   if (!CheckWhetherDSBlockIsFresh(blockNumber)) {
@@ -235,7 +272,7 @@ bool DirectoryService::ProcessPoWSubmissionFromPacket(
                   << m_state
                   << ". Don't verify cause I have other work to do. "
                      "Assume true as it has no impact.");
-    return true;
+    return false;
   }
 
   if (!Guard::GetInstance().IsValidIP(submitterPeer.m_ipAddress)) {
@@ -249,6 +286,12 @@ bool DirectoryService::ProcessPoWSubmissionFromPacket(
     return false;
   }
 
+  if (sol.GetResultingHash().size() != 64 || sol.GetMixHash().size() != 64) {
+    LOG_GENERAL(WARNING, "Wrong resultingHash or mixHash size submitted by "
+                             << submitterPeer);
+    return false;
+  }
+
   // Log all values
   LOG_EPOCH(INFO, to_string(m_mediator.m_currentEpochNum).c_str(),
             "Winner Public_key             = 0x"
@@ -257,11 +300,6 @@ bool DirectoryService::ProcessPoWSubmissionFromPacket(
             "Winner Peer ip addr           = " << submitterPeer);
   LOG_EPOCH(INFO, to_string(m_mediator.m_currentEpochNum).c_str(),
             "Difficulty                    = " << to_string(difficultyLevel));
-
-  // Define the PoW parameters
-  array<unsigned char, 32> rand1 = m_mediator.m_dsBlockRand;
-  array<unsigned char, 32> rand2 = m_mediator.m_txBlockRand;
-
   LOG_EPOCH(INFO, to_string(m_mediator.m_currentEpochNum).c_str(),
             "dsblock_num                  = " << blockNumber);
 
@@ -299,77 +337,83 @@ bool DirectoryService::ProcessPoWSubmissionFromPacket(
     }
   }
 
-  m_timespec = r_timer_start();
+  // Define the PoW parameters
+  request.blockNum = blockNumber;
+  request.difficulty = difficultyLevel;
+  request.headerHash = POW::GetInstance().GetHeaderHash(
+      m_mediator.m_dsBlockRand, m_mediator.m_txBlockRand,
+      submitterPeer.m_ipAddress, submitterPubKey, sol.GetLookupId(),
+      sol.GetGasPrice());
+  request.nonce = sol.GetNonce();
+  request.result = POW::StringToBlockhash(sol.GetResultingHash());
+  request.mixHash = POW::StringToBlockhash(sol.GetMixHash());
 
-  bool result = POW::GetInstance().PoWVerify(
-      blockNumber, difficultyLevel, rand1, rand2, submitterPeer.m_ipAddress,
-      submitterPubKey, lookupId, gasPrice, nonce, resultingHash, mixHash);
+  return true;
+}
 
-  LOG_EPOCH(INFO, to_string(m_mediator.m_currentEpochNum).c_str(),
-            "[POWSTAT] pow verify (microsec): " << r_timer_end(m_timespec));
-
-  if (result) {
-    // Do another check on the state before accessing m_allPoWs
-    // Accept slightly late entries as we need to multicast the DSBLOCK to
-    // everyone if ((m_state != POW_SUBMISSION) && (m_state !=
-    // DSBLOCK_CONSENSUS_PREP))
-    if (!CheckState(VERIFYPOW)) {
-      LOG_EPOCH(INFO, to_string(m_mediator.m_currentEpochNum).c_str(),
-                "Too late - current state is " << m_state);
-    } else {
-      LOG_EPOCH(INFO, to_string(m_mediator.m_currentEpochNum).c_str(),
-                "POW verification passed");
-      lock(m_mutexAllPOW, m_mutexAllPoWConns);
-      lock_guard<mutex> g(m_mutexAllPOW, adopt_lock);
-      lock_guard<mutex> g2(m_mutexAllPoWConns, adopt_lock);
-
-      PoWSolution soln(nonce, DataConversion::HexStrToStdArray(resultingHash),
-                       DataConversion::HexStrToStdArray(mixHash), lookupId,
-                       gasPrice);
-
-      m_allPoWConns.emplace(submitterPubKey, submitterPeer);
-      if (m_allPoWs.find(submitterPubKey) == m_allPoWs.end()) {
-        m_allPoWs[submitterPubKey] = soln;
-      } else if (m_allPoWs[submitterPubKey].result > soln.result) {
-        LOG_EPOCH(INFO, std::to_string(m_mediator.m_currentEpochNum).c_str(),
-                  "Harder PoW result: "
-                      << DataConversion::charArrToHexStr(soln.result)
-                      << " overwrite the old PoW: "
-                      << DataConversion::charArrToHexStr(
-                             m_allPoWs[submitterPubKey].result));
-        m_allPoWs[submitterPubKey] = soln;
-      } else if (m_allPoWs[submitterPubKey].result == soln.result) {
-        LOG_GENERAL(INFO,
-                    "Same pow submission may be received from another packet. "
-                    "Ignore it!!")
-        return true;
-      }
-
-      uint8_t expectedDSDiff = DS_POW_DIFFICULTY;
-      if (blockNumber > 1) {
-        expectedDSDiff = m_mediator.m_dsBlockChain.GetLastBlock()
-                             .GetHeader()
-                             .GetDSDifficulty();
-      }
-
-      if (difficultyLevel == expectedDSDiff) {
-        AddDSPoWs(submitterPubKey, soln);
-      }
-
-      UpdatePoWSubmissionCounterforNode(submitterPubKey);
-    }
-  } else {
+void DirectoryService::AddVerifiedPoWSubmission(const DSPowSolution& sol) {
+  uint8_t difficultyLevel = sol.GetDifficultyLevel();
+  uint64_t blockNumber = sol.GetBlockNumber();
+  Peer submitterPeer = sol.GetSubmitterPeer();
+  PubKey submitterPubKey = sol.GetSubmitterKey();
+
+  // Do another check on the state before accessing m_allPoWs
+  // Accept slightly late entries as we need to multicast the DSBLOCK to
+  // everyone if ((m_state != POW_SUBMISSION) && (m_state !=
+  // DSBLOCK_CONSENSUS_PREP))
+  if (!CheckState(VERIFYPOW)) {
     LOG_EPOCH(INFO, to_string(m_mediator.m_currentEpochNum).c_str(),
-              "Invalid PoW submission"
-                  << "\n"
-                  << "blockNum: " << blockNumber
-                  << " Difficulty: " << to_string(difficultyLevel)
-                  << " nonce: " << nonce << " ip: " << submitterPeer
-                  << " rand1: " << DataConversion::charArrToHexStr(rand1)
-                  << " rand2: " << DataConversion::charArrToHexStr(rand2));
+              "Too late - current state is " << m_state);
+    return;
+  }
+
+  // The limit was checked before verification, but the same node may appear
+  // more than once in a batch
+  if (CheckPoWSubmissionExceedsLimitsForNode(submitterPubKey)) {
+    LOG_GENERAL(WARNING, submitterPeer << " has exceeded max pow submission");
+    return;
+  }
+
+  LOG_EPOCH(INFO, to_string(m_mediator.m_currentEpochNum).c_str(),
+            "POW verification passed");
+  lock(m_mutexAllPOW, m_mutexAllPoWConns);
+  lock_guard<mutex> g(m_mutexAllPOW, adopt_lock);
+  lock_guard<mutex> g2(m_mutexAllPoWConns, adopt_lock);
+
+  PoWSolution soln(sol.GetNonce(),
+                   DataConversion::HexStrToStdArray(sol.GetResultingHash()),
+                   DataConversion::HexStrToStdArray(sol.GetMixHash()),
+                   sol.GetLookupId(), sol.GetGasPrice());
+
+  m_allPoWConns.emplace(submitterPubKey, submitterPeer);
+  if (m_allPoWs.find(submitterPubKey) == m_allPoWs.end()) {
+    m_allPoWs[submitterPubKey] = soln;
+  } else if (m_allPoWs[submitterPubKey].result > soln.result) {
+    LOG_EPOCH(INFO, std::to_string(m_mediator.m_currentEpochNum).c_str(),
+              "Harder PoW result: "
+                  << DataConversion::charArrToHexStr(soln.result)
+                  << " overwrite the old PoW: "
+                  << DataConversion::charArrToHexStr(
+                         m_allPoWs[submitterPubKey].result));
+    m_allPoWs[submitterPubKey] = soln;
+  } else if (m_allPoWs[submitterPubKey].result == soln.result) {
+    LOG_GENERAL(INFO,
+                "Same pow submission may be received from another packet. "
+                "Ignore it!!")
+    return;
+  }
+
+  uint8_t expectedDSDiff = DS_POW_DIFFICULTY;
+  if (blockNumber > 1) {
+    expectedDSDiff =
+        m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetDSDifficulty();
+  }
+
+  if (difficultyLevel == expectedDSDiff) {
+    AddDSPoWs(submitterPubKey, soln);
   }
 
-  return result;
+  UpdatePoWSubmissionCounterforNode(submitterPubKey);
 }
 
 bool DirectoryService::CheckSolnFromNonDSCommittee(
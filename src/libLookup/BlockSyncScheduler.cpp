@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#include <algorithm>
+
+#include "BlockSyncScheduler.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+namespace {
+const int MAX_SCORE = 10;
+const int MIN_SCORE = -20;
+const int SUCCESS_REWARD = 1;
+const int TIMEOUT_PENALTY = 3;
+const int INVALID_PENALTY = 5;
+
+// Score a lookup gives up for each window it is already serving
+const int SCORE_PER_IN_FLIGHT = 2;
+}  // namespace
+
+BlockSyncScheduler::BlockSyncScheduler(unsigned int windowSize,
+                                       unsigned int maxInFlight,
+                                       chrono::milliseconds timeout)
+    : m_windowSize(max(windowSize, 1u)),
+      m_maxInFlight(max(maxInFlight, 1u)),
+      m_timeout(timeout),
+      m_active(false),
+      m_lowBlockNum(0),
+      m_numTaken(0),
+      m_numScored(0) {}
+
+void BlockSyncScheduler::Start(uint64_t lowBlockNum,
+                               uint64_t knownHighBlockNum,
+                               const vector<PubKey>& lookups) {
+  m_active = true;
+  m_lowBlockNum = lowBlockNum;
+  m_lookups = lookups;
+  m_windows.clear();
+  m_numTaken = 0;
+  m_numScored = 0;
+
+  uint64_t low = lowBlockNum;
+  while (low <= knownHighBlockNum) {
+    uint64_t high = min(knownHighBlockNum, low + m_windowSize - 1);
+    m_windows.push_back({low, high, PENDING, PubKey(), PubKey(), false,
+                         Clock::time_point(), {}});
+    low = high + 1;
+  }
+  m_windows.push_back(
+      {low, 0, PENDING, PubKey(), PubKey(), false, Clock::time_point(), {}});
+
+  for (const auto& lookup : m_lookups) {
+    m_scores.emplace(lookup, 0);
+  }
+
+  LOG_GENERAL(INFO, "Syncing Tx blocks from " << lowBlockNum << " in "
+                                              << m_windows.size()
+                                              << " windows from "
+                                              << m_lookups.size()
+                                              << " lookups");
+}
+
+void BlockSyncScheduler::Stop() {
+  m_active = false;
+  m_windows.clear();
+  m_numTaken = 0;
+  m_numScored = 0;
+}
+
+vector<BlockSyncScheduler::Request> BlockSyncScheduler::Schedule(
+    Clock::time_point now) {
+  vector<Request> requests;
+
+  if (!m_active) {
+    return requests;
+  }
+
+  unsigned int numInFlight = 0;
+  for (auto& window : m_windows) {
+    if (window.state != IN_FLIGHT) {
+      continue;
+    }
+    if (window.deadline > now) {
+      numInFlight++;
+      continue;
+    }
+    LOG_GENERAL(WARNING, "Tx blocks " << window.lowBlockNum << " to "
+                                      << window.highBlockNum
+                                      << " timed out from " << window.lookup);
+    window.state = PENDING;
+    window.lastFailed = window.lookup;
+    window.hasFailed = true;
+    AdjustScore(window.lookup, -TIMEOUT_PENALTY);
+  }
+
+  for (auto& window : m_windows) {
+    if (numInFlight >= m_maxInFlight) {
+      break;
+    }
+    if (window.state != PENDING) {
+      continue;
+    }
+
+    PubKey lookup;
+    if (!PickLookup(window, lookup)) {
+      LOG_GENERAL(WARNING, "No lookup to fetch Tx blocks from");
+      break;
+    }
+
+    window.state = IN_FLIGHT;
+    window.lookup = lookup;
+    window.deadline = now + m_timeout;
+    numInFlight++;
+    requests.push_back({window.lowBlockNum, window.highBlockNum, lookup});
+  }
+
+  return requests;
+}
+
+bool BlockSyncScheduler::OnResponse(const PubKey& lookup, uint64_t lowBlockNum,
+                                    uint64_t highBlockNum,
+                                    vector<TxBlock>&& txBlocks) {
+  if (!m_active) {
+    return false;
+  }
+
+  auto it = find_if(m_windows.begin(), m_windows.end(),
+                    [lowBlockNum](const Window& window) {
+                      return window.lowBlockNum == lowBlockNum;
+                    });
+  if (it == m_windows.end() || it->state == RECEIVED) {
+    return false;
+  }
+
+  // The open-ended window accepts whatever the lookup has, possibly nothing
+  bool valid = (it->highBlockNum == 0) ? (highBlockNum + 1 >= lowBlockNum)
+                                       : (highBlockNum == it->highBlockNum);
+  valid = valid && (txBlocks.size() == highBlockNum + 1 - lowBlockNum);
+  for (unsigned int i = 0; valid && i < txBlocks.size(); i++) {
+    valid = (txBlocks.at(i).GetHeader().GetBlockNum() == lowBlockNum + i);
+  }
+
+  if (!valid) {
+    LOG_GENERAL(WARNING, "Malformed Tx blocks " << lowBlockNum << " to "
+                                                << highBlockNum << " from "
+                                                << lookup);
+    AdjustScore(lookup, -INVALID_PENALTY);
+    if (it->state == IN_FLIGHT && it->lookup == lookup) {
+      it->state = PENDING;
+      it->lastFailed = lookup;
+      it->hasFailed = true;
+    }
+    return false;
+  }
+
+  // A late answer to a timed-out request is as good as any other
+  it->state = RECEIVED;
+  it->lookup = lookup;
+  it->txBlocks = move(txBlocks);
+  return true;
+}
+
+bool BlockSyncScheduler::IsComplete() const {
+  return m_active &&
+         all_of(m_windows.begin(), m_windows.end(), [](const Window& window) {
+           return window.state == RECEIVED;
+         });
+}
+
+vector<TxBlock> BlockSyncScheduler::TakeBlocks() {
+  vector<TxBlock> txBlocks;
+
+  if (!m_active) {
+    return txBlocks;
+  }
+
+  size_t end = m_numTaken;
+  size_t count = 0;
+  while (end < m_windows.size() && m_windows.at(end).state == RECEIVED) {
+    count += m_windows.at(end).txBlocks.size();
+    end++;
+  }
+  txBlocks.reserve(count);
+
+  for (; m_numTaken < end; m_numTaken++) {
+    Window& window = m_windows.at(m_numTaken);
+    m_lowBlockNum = window.lowBlockNum + window.txBlocks.size();
+    move(window.txBlocks.begin(), window.txBlocks.end(),
+         back_inserter(txBlocks));
+    window.txBlocks.clear();
+  }
+
+  return txBlocks;
+}
+
+void BlockSyncScheduler::ScoreTakenBlocks(bool accepted) {
+  for (; m_numScored < m_numTaken; m_numScored++) {
+    AdjustScore(m_windows.at(m_numScored).lookup,
+                accepted ? SUCCESS_REWARD : -INVALID_PENALTY);
+  }
+}
+
+void BlockSyncScheduler::Finish(bool accepted) {
+  ScoreTakenBlocks(accepted);
+  Stop();
+}
+
+int BlockSyncScheduler::GetScore(const PubKey& lookup) const {
+  auto it = m_scores.find(lookup);
+  return (it == m_scores.end()) ? 0 : it->second;
+}
+
+void BlockSyncScheduler::AdjustScore(const PubKey& lookup, int delta) {
+  int& score = m_scores[lookup];
+  score = min(MAX_SCORE, max(MIN_SCORE, score + delta));
+}
+
+unsigned int BlockSyncScheduler::GetNumInFlight(const PubKey& lookup) const {
+  return count_if(m_windows.begin(), m_windows.end(),
+                  [&lookup](const Window& window) {
+                    return window.state == IN_FLIGHT && window.lookup == lookup;
+                  });
+}
+
+bool BlockSyncScheduler::PickLookup(const Window& window,
+                                    PubKey& lookup) const {
+  bool found = false;
+  int bestRank = 0;
+
+  for (const auto& candidate : m_lookups) {
+    // Give a failed window to someone else if there is anyone else
+    if (window.hasFailed && m_lookups.size() > 1 &&
+        candidate == window.lastFailed) {
+      continue;
+    }
+
+    int rank = GetScore(candidate) -
+               SCORE_PER_IN_FLIGHT * (int)GetNumInFlight(candidate);
+    if (!found || rank > bestRank) {
+      found = true;
+      bestRank = rank;
+      lookup = candidate;
+    }
+  }
+
+  return found;
+}
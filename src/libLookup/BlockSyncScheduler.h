@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#ifndef __BLOCKSYNCSCHEDULER_H__
+#define __BLOCKSYNCSCHEDULER_H__
+
+#include <chrono>
+#include <map>
+#include <vector>
+
+#include "libCrypto/Schnorr.h"
+#include "libData/BlockData/Block/TxBlock.h"
+
+/// Splits a range of Tx blocks into windows that are fetched concurrently from
+/// several lookup nodes. Received windows are handed out in order as soon as
+/// all the windows before them have been, so the caller can verify and commit
+/// each contiguous prefix without waiting for the whole range.
+/// Lookups that answer gain score and are preferred for later windows. A window
+/// that times out or comes back malformed is handed to another lookup and the
+/// lookup that failed it loses score.
+/// Not thread-safe; callers serialize access.
+class BlockSyncScheduler {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  /// A block range to request from a lookup.
+  struct Request {
+    uint64_t lowBlockNum;
+    uint64_t highBlockNum;  // 0 for the open-ended last window
+    PubKey lookup;
+  };
+
+  /// Constructor.
+  BlockSyncScheduler(unsigned int windowSize, unsigned int maxInFlight,
+                     std::chrono::milliseconds timeout);
+
+  /// Starts syncing from lowBlockNum. Blocks up to knownHighBlockNum are split
+  /// into windows and the rest is fetched as one open-ended window.
+  /// Any sync in progress is discarded; lookup scores are kept.
+  void Start(uint64_t lowBlockNum, uint64_t knownHighBlockNum,
+             const std::vector<PubKey>& lookups);
+
+  /// Discards the sync in progress without touching the lookup scores.
+  void Stop();
+
+  /// Checks if a sync is in progress.
+  bool IsActive() const { return m_active; }
+
+  /// Returns the first block number of the sync in progress that has not
+  /// been taken yet.
+  uint64_t GetLowBlockNum() const { return m_lowBlockNum; }
+
+  /// Returns the number of windows of the sync in progress.
+  size_t GetNumWindows() const { return m_windows.size(); }
+
+  /// Returns the requests to send now: windows not yet sent or timed out,
+  /// up to the in-flight limit.
+  std::vector<Request> Schedule(Clock::time_point now = Clock::now());
+
+  /// Records the blocks sent by a lookup for [lowBlockNum, highBlockNum].
+  /// Returns false if the response does not complete any pending window.
+  bool OnResponse(const PubKey& lookup, uint64_t lowBlockNum,
+                  uint64_t highBlockNum, std::vector<TxBlock>&& txBlocks);
+
+  /// Checks if every window has been received.
+  bool IsComplete() const;
+
+  /// Returns the blocks of the received windows that directly follow the ones
+  /// already taken, in order. Empty if the next window has not arrived.
+  std::vector<TxBlock> TakeBlocks();
+
+  /// Credits the lookups that served the blocks taken since the last call if
+  /// the blocks were accepted, or penalizes them otherwise.
+  void ScoreTakenBlocks(bool accepted);
+
+  /// Scores the blocks taken since the last call, then ends the sync.
+  void Finish(bool accepted);
+
+  /// Returns the current score of a lookup.
+  int GetScore(const PubKey& lookup) const;
+
+ private:
+  enum WindowState { PENDING, IN_FLIGHT, RECEIVED };
+
+  struct Window {
+    uint64_t lowBlockNum;
+    uint64_t highBlockNum;
+    WindowState state;
+    PubKey lookup;      // lookup the window was last sent to
+    PubKey lastFailed;  // lookup that last failed to deliver it
+    bool hasFailed;
+    Clock::time_point deadline;
+    std::vector<TxBlock> txBlocks;
+  };
+
+  const unsigned int m_windowSize;
+  const unsigned int m_maxInFlight;
+  const std::chrono::milliseconds m_timeout;
+
+  bool m_active;
+  uint64_t m_lowBlockNum;
+  std::vector<PubKey> m_lookups;
+  std::vector<Window> m_windows;
+  size_t m_numTaken;   // windows handed out by TakeBlocks
+  size_t m_numScored;  // windows whose lookups have been scored
+  std::map<PubKey, int> m_scores;
+
+  void AdjustScore(const PubKey& lookup, int delta);
+  unsigned int GetNumInFlight(const PubKey& lookup) const;
+  bool PickLookup(const Window& window, PubKey& lookup) const;
+};
+
+#endif  // __BLOCKSYNCSCHEDULER_H__
@@ -46,9 +46,9 @@
 #include "libNetwork/P2PComm.h"
 #include "libPOW/pow.h"
 #include "libPersistence/BlockStorage.h"
+#include "libServer/Server.h"
 #include "libUtils/DataConversion.h"
 #include "libUtils/DetachedFunction.h"
-#include "libUtils/GetTxnFromFile.h"
 #include "libUtils/SanityChecks.h"
 #include "libUtils/SysCommand.h"
 
@@ -128,10 +128,9 @@ Transaction CreateValidTestingTransaction(PrivKey& fromPrivKey,
 }
 
 bool Lookup::GenTxnToSend(size_t num_txn,
-                          map<uint32_t, vector<Transaction>>& mp,
+                          map<uint32_t, vector<TxnCorpus::Span>>& mp,
                           uint32_t numShards) {
   LOG_MARKER();
-  vector<Transaction> txns;
 
   if (GENESIS_WALLETS.size() == 0) {
     LOG_GENERAL(WARNING, "No genesis accounts found");
@@ -142,6 +141,16 @@ bool Lookup::GenTxnToSend(size_t num_txn,
     return false;
   }
 
+  if (num_txn == 0) {
+    return true;
+  }
+
+  if (!m_txnCorpus.IsOpen() &&
+      !m_txnCorpus.Open(TxnCorpus::GetDefaultPath())) {
+    LOG_GENERAL(WARNING, "Failed to open the txn corpus");
+    return false;
+  }
+
   unsigned int NUM_TXN_TO_DS = num_txn / GENESIS_WALLETS.size();
 
   for (auto& addrStr : GENESIS_WALLETS) {
@@ -151,12 +160,12 @@ bool Lookup::GenTxnToSend(size_t num_txn,
       return false;
     }
     auto txnShard = Transaction::GetShardIndex(addr, numShards);
-    txns.clear();
 
     uint64_t nonce = AccountStore::GetInstance().GetAccount(addr)->GetNonce();
 
-    if (!GetTxnFromFile::GetFromFile(addr, static_cast<uint32_t>(nonce) + 1,
-                                     num_txn, txns)) {
+    // The spans point into the corpus mapping, so the txns are neither read
+    // nor decoded until they are copied into the outgoing packet
+    if (!m_txnCorpus.Get(addr, nonce + 1, num_txn, mp[txnShard])) {
       LOG_GENERAL(WARNING, "Failed to get txns from file");
       return false;
     }
@@ -173,20 +182,14 @@ bool Lookup::GenTxnToSend(size_t num_txn,
 
         curr_offset = txn.Serialize(txns, curr_offset);
     }*/
-    //[Change back here]
-    copy(txns.begin(), txns.end(), back_inserter(mp[txnShard]));
 
     LOG_GENERAL(INFO, "[Batching] Last Nonce sent "
                           << nonce + num_txn << " of Addr " << addr.hex());
-    txns.clear();
 
-    if (!GetTxnFromFile::GetFromFile(addr,
-                                     static_cast<uint32_t>(nonce) + num_txn + 1,
-                                     NUM_TXN_TO_DS, txns)) {
+    if (!m_txnCorpus.Get(addr, nonce + num_txn + 1, NUM_TXN_TO_DS,
+                         mp[numShards])) {
       LOG_GENERAL(WARNING, "Failed to get txns for DS");
     }
-
-    copy(txns.begin(), txns.end(), back_inserter(mp[numShards]));
   }
 
   return true;
@@ -198,6 +201,23 @@ VectorOfLookupNode Lookup::GetLookupNodes() const {
   return m_lookupNodes;
 }
 
+vector<PubKey> Lookup::GetBroadcastOriginators() {
+  // Lookup messages are broadcast among the lookups, or sent by the DS
+  // committee
+  vector<PubKey> keys;
+  {
+    lock_guard<mutex> lock(m_mutexLookupNodes);
+    for (const auto& node : m_lookupNodes) {
+      keys.emplace_back(node.first);
+    }
+  }
+  lock_guard<mutex> g(m_mediator.m_mutexDSCommittee);
+  for (const auto& member : *m_mediator.m_DSCommittee) {
+    keys.emplace_back(member.first);
+  }
+  return keys;
+}
+
 void Lookup::SendMessageToLookupNodes(
     const std::vector<unsigned char>& message) const {
   LOG_MARKER();
@@ -417,12 +437,70 @@ bool Lookup::GetTxBlockFromLookupNodes(uint64_t lowBlockNum,
                                        uint64_t highBlockNum) {
   LOG_MARKER();
 
+  if (highBlockNum == 0 && FetchTxBlocksInWindows(lowBlockNum)) {
+    return true;
+  }
+
   SendMessageToRandomLookupNode(
       ComposeGetTxBlockMessage(lowBlockNum, highBlockNum));
 
   return true;
 }
 
+bool Lookup::FetchTxBlocksInWindows(uint64_t lowBlockNum) {
+  LOG_MARKER();
+
+  // The Tx blocks before the latest DS block are known to exist, so that part
+  // of the range can be split up front. The rest is fetched as one window.
+  uint64_t knownHighBlockNum =
+      m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetEpochNum();
+  knownHighBlockNum = (knownHighBlockNum > 0) ? knownHighBlockNum - 1 : 0;
+
+  lock_guard<mutex> g(m_mutexTxBlockSync);
+
+  // lowBlockNum 0 and 1 have special meanings to the lookup, and windows only
+  // pay off if there are several of them
+  if (lowBlockNum <= 1 ||
+      knownHighBlockNum < lowBlockNum + TXBLOCK_SYNC_WINDOW_SIZE) {
+    m_txBlockSyncScheduler.Stop();
+    return false;
+  }
+
+  if (!m_txBlockSyncScheduler.IsActive() ||
+      m_txBlockSyncScheduler.GetLowBlockNum() != lowBlockNum) {
+    vector<PubKey> lookups;
+    for (const auto& lookupNode : GetLookupNodes()) {
+      lookups.emplace_back(lookupNode.first);
+    }
+    if (lookups.empty()) {
+      LOG_GENERAL(WARNING, "There is no lookup node existed yet!");
+      return false;
+    }
+    m_txBlockSyncScheduler.Start(lowBlockNum, knownHighBlockNum, lookups);
+    m_txBlockSyncStartTime = chrono::steady_clock::now();
+  }
+
+  DispatchTxBlockSyncRequests();
+  return true;
+}
+
+void Lookup::DispatchTxBlockSyncRequests() {
+  const VectorOfLookupNode lookupNodes = GetLookupNodes();
+
+  for (const auto& request : m_txBlockSyncScheduler.Schedule()) {
+    auto it = find_if(lookupNodes.begin(), lookupNodes.end(),
+                      [&request](const pair<PubKey, Peer>& lookupNode) {
+                        return lookupNode.first == request.lookup;
+                      });
+    if (it == lookupNodes.end()) {
+      continue;
+    }
+    P2PComm::GetInstance().SendMessage(
+        it->second,
+        ComposeGetTxBlockMessage(request.lowBlockNum, request.highBlockNum));
+  }
+}
+
 bool Lookup::GetStateDeltaFromLookupNodes(const uint64_t& blockNum) {
   LOG_MARKER();
 
@@ -1565,6 +1643,10 @@ bool Lookup::ProcessSetDSBlockFromSeed(const vector<unsigned char>& message,
       } else {
         m_mediator.m_archDB->InsertDSBlock(dsblock);
       }
+
+      if (LOOKUP_NODE_MODE) {
+        Server::GetSubscriptionServer().PublishDSBlock(dsblock);
+      }
     }
 
     if (m_syncType == SyncType::DS_SYNC ||
@@ -1617,6 +1699,11 @@ bool Lookup::ProcessSetTxBlockFromSeed(const vector<unsigned char>& message,
                                                  << lowBlockNum << " to "
                                                  << highBlockNum);
 
+  if (ProcessTxBlockSyncWindow(lookupPubKey, lowBlockNum, highBlockNum,
+                               txBlocks)) {
+    return true;
+  }
+
   if (lowBlockNum > highBlockNum) {
     LOG_GENERAL(
         WARNING,
@@ -1640,27 +1727,97 @@ bool Lookup::ProcessSetTxBlockFromSeed(const vector<unsigned char>& message,
               "I already have the block");
     return false;
   } else {
-    auto res = m_mediator.m_validator->CheckTxBlocks(
-        txBlocks, m_mediator.m_blocklinkchain.GetBuiltDSComm(),
-        m_mediator.m_blocklinkchain.GetLatestBlockLink());
-    switch (res) {
-      case ValidatorBase::TxBlockValidationMsg::VALID:
-        CommitTxBlocks(txBlocks);
-        break;
-      case ValidatorBase::TxBlockValidationMsg::INVALID:
-        LOG_GENERAL(INFO, "[TxBlockVerif]"
-                              << "Invalid blocks");
-        break;
-      case ValidatorBase::TxBlockValidationMsg::STALEDSINFO:
-        LOG_GENERAL(INFO, "[TxBlockVerif]"
-                              << "Saved to buffer");
-        m_txBlockBuffer.clear();
-        for (const auto& txBlock : txBlocks) {
-          m_txBlockBuffer.emplace_back(txBlock);
-        }
-        break;
-      default:;
+    CheckAndCommitTxBlocks(txBlocks);
+  }
+
+  return true;
+}
+
+bool Lookup::ProcessTxBlockSyncWindow(const PubKey& lookupPubKey,
+                                      uint64_t lowBlockNum,
+                                      uint64_t highBlockNum,
+                                      vector<TxBlock>& txBlocks) {
+  lock_guard<mutex> g(m_mutexTxBlockSync);
+
+  if (!m_txBlockSyncScheduler.IsActive()) {
+    return false;
+  }
+
+  if (!m_txBlockSyncScheduler.OnResponse(lookupPubKey, lowBlockNum,
+                                         highBlockNum, move(txBlocks))) {
+    DispatchTxBlockSyncRequests();
+    return true;
+  }
+
+  // Commit whatever prefix of the range is now contiguous, and keep the
+  // windows after it in flight
+  const bool complete = m_txBlockSyncScheduler.IsComplete();
+  vector<TxBlock> readyTxBlocks = m_txBlockSyncScheduler.TakeBlocks();
+
+  if (readyTxBlocks.empty()) {
+    if (complete) {
+      m_txBlockSyncScheduler.Finish(true);
+    } else {
+      DispatchTxBlockSyncRequests();
     }
+    return true;
+  }
+
+  uint64_t latestSynBlockNum =
+      m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum() + 1;
+
+  if (readyTxBlocks.front().GetHeader().GetBlockNum() != latestSynBlockNum) {
+    // The chain moved on while the windows were in flight; not the fault of
+    // the lookups that served them
+    LOG_GENERAL(INFO, "[TxBlockSync] Discarding blocks from "
+                          << readyTxBlocks.front().GetHeader().GetBlockNum()
+                          << ", chain is at " << latestSynBlockNum);
+    m_txBlockSyncScheduler.Finish(true);
+    return true;
+  }
+
+  bool accepted = CheckAndCommitTxBlocks(readyTxBlocks);
+  if (!accepted || complete) {
+    m_txBlockSyncScheduler.Finish(accepted);
+  } else {
+    m_txBlockSyncScheduler.ScoreTakenBlocks(true);
+    DispatchTxBlockSyncRequests();
+  }
+
+  if (accepted) {
+    auto elapsed = chrono::duration_cast<chrono::milliseconds>(
+        chrono::steady_clock::now() - m_txBlockSyncStartTime);
+    LOG_GENERAL(INFO, "[TxBlockSync] Synced blocks "
+                          << readyTxBlocks.front().GetHeader().GetBlockNum()
+                          << " to "
+                          << readyTxBlocks.back().GetHeader().GetBlockNum()
+                          << " in " << elapsed.count() << " ms");
+  }
+
+  return true;
+}
+
+bool Lookup::CheckAndCommitTxBlocks(const vector<TxBlock>& txBlocks) {
+  auto res = m_mediator.m_validator->CheckTxBlocks(
+      txBlocks, m_mediator.m_blocklinkchain.GetBuiltDSComm(),
+      m_mediator.m_blocklinkchain.GetLatestBlockLink());
+  switch (res) {
+    case ValidatorBase::TxBlockValidationMsg::VALID:
+      CommitTxBlocks(txBlocks);
+      break;
+    case ValidatorBase::TxBlockValidationMsg::INVALID:
+      LOG_GENERAL(INFO, "[TxBlockVerif]"
+                            << "Invalid blocks");
+      return false;
+    case ValidatorBase::TxBlockValidationMsg::STALEDSINFO:
+      LOG_GENERAL(INFO, "[TxBlockVerif]"
+                            << "Saved to buffer");
+      m_txBlockBuffer.clear();
+      for (const auto& txBlock : txBlocks) {
+        m_txBlockBuffer.emplace_back(txBlock);
+      }
+      break;
+    default:;
   }
 
   return true;
@@ -1721,6 +1878,10 @@ void Lookup::CommitTxBlocks(const vector<TxBlock>& txBlocks) {
       }
       m_mediator.m_archDB->InsertTxBlock(txBlock);
     }
+
+    if (LOOKUP_NODE_MODE) {
+      Server::GetSubscriptionServer().PublishTxBlock(txBlock);
+    }
   }
 
   m_mediator.m_currentEpochNum =
@@ -2674,6 +2835,9 @@ bool Lookup::RsyncTxBodies() {
     return false;
   }
   LOG_GENERAL(INFO, "RunRsync: " << output);
+
+  // The synced bodies were never inserted into the txn body filter
+  BlockStorage::GetBlockStorage().RebuildTxBodyFilter();
   return true;
 }
 
@@ -3048,34 +3212,32 @@ bool Lookup::AlreadyJoinedNetwork() {
   return m_syncType == SyncType::NO_SYNC;
 }
 
-bool Lookup::AddToTxnShardMap(const Transaction& tx, uint32_t shardId) {
+TxnIngressQueue::Result Lookup::AddToTxnShardMap(const Transaction& tx,
+                                                 uint32_t shardId) {
   if (!LOOKUP_NODE_MODE) {
     LOG_GENERAL(WARNING,
                 "Lookup::AddToTxnShardMap not expected to be called from "
                 "other than the LookUp node.");
-    return true;
+    return TxnIngressQueue::ADDED;
   }
 
-  lock_guard<mutex> g(m_txnShardMapMutex);
-
-  m_txnShardMap[shardId].push_back(tx);
-
-  return true;
-}
-
-bool Lookup::DeleteTxnShardMap(uint32_t shardId) {
-  if (!LOOKUP_NODE_MODE) {
-    LOG_GENERAL(WARNING,
-                "Lookup::DeleteTxnShardMap not expected to be called from "
-                "other than the LookUp node.");
-    return true;
+  const TxnIngressQueue::Result result = m_txnIngressQueue.Add(tx, shardId);
+  switch (result) {
+    case TxnIngressQueue::ADDED:
+      break;
+    case TxnIngressQueue::DUPLICATE:
+      LOG_GENERAL(INFO, "Txn " << tx.GetTranID() << " already queued");
+      break;
+    case TxnIngressQueue::SENDER_LIMIT:
+      LOG_GENERAL(INFO, "Sender of txn " << tx.GetTranID()
+                                         << " reached its ingress limit");
+      break;
+    case TxnIngressQueue::QUEUE_FULL:
+      LOG_GENERAL(WARNING, "Txn queue of shard " << shardId << " is full");
+      break;
   }
 
-  lock_guard<mutex> g(m_txnShardMapMutex);
-
-  m_txnShardMap[shardId].clear();
-
-  return true;
+  return result;
 }
 
 void Lookup::SenderTxnBatchThread() {
@@ -3117,7 +3279,7 @@ void Lookup::SendTxnPacketToNodes(uint32_t numShards) {
     return;
   }
 
-  map<uint32_t, vector<Transaction>> mp;
+  map<uint32_t, vector<TxnCorpus::Span>> mp;
 
   if (!GenTxnToSend(NUM_TXN_TO_SEND_PER_ACCOUNT, mp, numShards)) {
     LOG_GENERAL(WARNING, "GenTxnToSend failed");
@@ -3136,31 +3298,32 @@ void Lookup::SendTxnPacketToNodes(uint32_t numShards) {
         chrono::milliseconds(LOOKUP_DELAY_SEND_TXNPACKET_IN_MS));
   }
 
+  // Txns submitted from here on count towards the next round's limits
+  m_txnIngressQueue.NextRound();
+
   for (unsigned int i = 0; i < numShards + 1; i++) {
     vector<unsigned char> msg = {MessageType::NODE,
                                  NodeInstructionType::FORWARDTXNPACKET};
-    bool result = false;
-
-    {
-      lock_guard<mutex> g(m_txnShardMapMutex);
-      auto transactionNumber = mp[i].size();
 
-      LOG_GENERAL(INFO, "Transaction number generated: " << transactionNumber);
+    // Take the queued txns out, so new submissions go to an empty queue
+    // while this packet is serialized
+    vector<Transaction> txns;
+    m_txnIngressQueue.Drain(i, txns);
 
-      if (m_txnShardMap[i].empty() && mp[i].empty()) {
-        LOG_GENERAL(INFO, "No txns to send to shard " << i);
-        continue;
-      }
+    LOG_GENERAL(INFO, "Transaction number generated: " << mp[i].size());
 
-      result = Messenger::SetNodeForwardTxnBlock(
-          msg, MessageOffset::BODY, m_mediator.m_currentEpochNum, i,
-          m_mediator.m_selfKey, m_txnShardMap[i], mp[i]);
+    if (txns.empty() && mp[i].empty()) {
+      LOG_GENERAL(INFO, "No txns to send to shard " << i);
+      continue;
     }
 
-    if (!result) {
+    if (!Messenger::SetNodeForwardTxnBlock(
+            msg, MessageOffset::BODY, m_mediator.m_currentEpochNum, i,
+            m_mediator.m_selfKey, txns, mp[i])) {
       LOG_EPOCH(WARNING, to_string(m_mediator.m_currentEpochNum).c_str(),
                 "Messenger::SetNodeForwardTxnBlock failed.");
       LOG_GENERAL(WARNING, "Cannot create packet for " << i << " shard");
+      m_txnIngressQueue.Restore(i, move(txns));
       continue;
     }
     vector<Peer> toSend;
@@ -3177,6 +3340,7 @@ void Lookup::SendTxnPacketToNodes(uint32_t numShards) {
           LOG_GENERAL(INFO, "Sent to node " << get<SHARD_NODE_PEER>(*it));
         }
         if (m_mediator.m_ds->m_shards.at(i).empty()) {
+          m_txnIngressQueue.Restore(i, move(txns));
           continue;
         }
         uint16_t lastBlockHash = DataConversion::charArrTo16Bits(
@@ -3193,8 +3357,6 @@ void Lookup::SendTxnPacketToNodes(uint32_t numShards) {
       } else {
         P2PComm::GetInstance().SendBroadcastMessage(toSend, msg);
       }
-
-      DeleteTxnShardMap(i);
     } else if (i == numShards) {
       // To send DS
       {
@@ -3207,6 +3369,7 @@ void Lookup::SendTxnPacketToNodes(uint32_t numShards) {
           toSend.push_back(it->second);
         }
         if (m_mediator.m_DSCommittee->empty()) {
+          m_txnIngressQueue.Restore(i, move(txns));
           continue;
         }
         BlockLink bl = m_mediator.m_blocklinkchain.GetLatestBlockLink();
@@ -3245,8 +3408,6 @@ void Lookup::SendTxnPacketToNodes(uint32_t numShards) {
 
       LOG_GENERAL(INFO, "[DSMB]"
                             << " Sent DS the txns");
-
-      DeleteTxnShardMap(i);
     }
   }
 }
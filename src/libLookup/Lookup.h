@@ -36,9 +36,12 @@
 #include "libData/BlockData/Block/DSBlock.h"
 #include "libData/BlockData/Block/MicroBlock.h"
 #include "libData/BlockData/Block/TxBlock.h"
+#include "libLookup/BlockSyncScheduler.h"
+#include "libLookup/TxnIngressQueue.h"
 #include "libNetwork/Peer.h"
 #include "libNetwork/ShardStruct.h"
 #include "libUtils/Logger.h"
+#include "libUtils/TxnCorpus.h"
 
 #include <condition_variable>
 #include <map>
@@ -71,8 +74,12 @@ class Lookup : public Executable, public Broadcastable {
   std::mutex m_mutexNodesInNetwork;
   std::vector<Peer> m_nodesInNetwork;
   std::unordered_set<Peer> l_nodesInNetwork;
-  std::map<uint32_t, std::vector<Transaction>> m_txnShardMap;
-  std::mutex m_txnShardMapMutex;
+  TxnIngressQueue m_txnIngressQueue{TXN_INGRESS_QUEUE_SIZE,
+                                    TXN_INGRESS_SENDER_MAX_TXNS,
+                                    TXN_INGRESS_SENDER_MAX_BYTES};
+
+  // Pregenerated txns (see gentxn), mapped on first use
+  TxnCorpus m_txnCorpus;
 
   // Start PoW variables
   bool m_receivedRaiseStartPoW = false;
@@ -110,6 +117,13 @@ class Lookup : public Executable, public Broadcastable {
   // TxBlockBuffer
   std::vector<TxBlock> m_txBlockBuffer;
 
+  // Windowed Tx block sync across several lookups
+  std::mutex m_mutexTxBlockSync;
+  BlockSyncScheduler m_txBlockSyncScheduler{
+      TXBLOCK_SYNC_WINDOW_SIZE, TXBLOCK_SYNC_MAX_INFLIGHT,
+      std::chrono::seconds(TXBLOCK_SYNC_TIMEOUT_IN_SECONDS)};
+  std::chrono::steady_clock::time_point m_txBlockSyncStartTime;
+
   std::vector<unsigned char> ComposeGetDSInfoMessage(bool initialDS = false);
   std::vector<unsigned char> ComposeGetStateMessage();
 
@@ -131,6 +145,23 @@ class Lookup : public Executable, public Broadcastable {
   void RetrieveTxBlocks(std::vector<TxBlock>& txBlocks, uint64_t& lowBlockNum,
                         uint64_t& highBlockNum);
 
+  /// Fetches the Tx blocks from lowBlockNum onwards in windows spread over the
+  /// lookup nodes. Returns false if the range is too short to be worth it.
+  bool FetchTxBlocksInWindows(uint64_t lowBlockNum);
+
+  /// Sends out the window requests that are due. Needs m_mutexTxBlockSync.
+  void DispatchTxBlockSyncRequests();
+
+  /// Hands a received Tx block range to the windowed sync, committing the
+  /// blocks once every window is in. Returns false if no sync is running.
+  bool ProcessTxBlockSyncWindow(const PubKey& lookupPubKey,
+                                uint64_t lowBlockNum, uint64_t highBlockNum,
+                                std::vector<TxBlock>& txBlocks);
+
+  /// Verifies the Tx blocks and commits or buffers them depending on the
+  /// result. Returns false if the blocks are invalid.
+  bool CheckAndCommitTxBlocks(const std::vector<TxBlock>& txBlocks);
+
  public:
   /// Constructor.
   Lookup(Mediator& mediator);
@@ -147,9 +178,13 @@ class Lookup : public Executable, public Broadcastable {
   // Getter for m_lookupNodes
   VectorOfLookupNode GetLookupNodes() const;
 
+  /// Implements the GetBroadcastOriginators function inherited from
+  /// Broadcastable.
+  std::vector<PubKey> GetBroadcastOriginators();
+
   // Gen n valid txns
   bool GenTxnToSend(size_t num_txn,
-                    std::map<uint32_t, std::vector<Transaction>>& mp,
+                    std::map<uint32_t, std::vector<TxnCorpus::Span>>& mp,
                     uint32_t numShards);
 
   // Calls P2PComm::SendBroadcastMessage to Lookup Nodes
@@ -205,12 +240,13 @@ class Lookup : public Executable, public Broadcastable {
   // Rejoin the network as a lookup node in case of failure happens in protocol
   void RejoinAsLookup();
 
-  bool AddToTxnShardMap(const Transaction& tx, uint32_t shardId);
+  // Returns why the txn was not queued, if it is a resubmission or over the
+  // ingress limits
+  TxnIngressQueue::Result AddToTxnShardMap(const Transaction& tx,
+                                           uint32_t shardId);
 
   void CheckBufferTxBlocks();
 
-  bool DeleteTxnShardMap(uint32_t shardId);
-
   void SetServerTrue();
 
   bool GetIsServer();
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#include <iterator>
+
+#include "TxnIngressQueue.h"
+
+using namespace std;
+
+TxnIngressQueue::TxnIngressQueue(size_t queueSize,
+                                 unsigned int maxTxnsPerSender,
+                                 uint64_t maxBytesPerSender)
+    : m_queueSize(queueSize),
+      m_maxTxnsPerSender(maxTxnsPerSender),
+      m_maxBytesPerSender(maxBytesPerSender) {}
+
+TxnIngressQueue::~TxnIngressQueue() {
+  for (auto& entry : m_queues) {
+    Transaction* tx = nullptr;
+    while (entry.second->queue.pop(tx)) {
+      delete tx;
+    }
+  }
+}
+
+TxnIngressQueue::ShardQueue& TxnIngressQueue::GetQueue(uint32_t shardId) {
+  {
+    shared_lock<shared_timed_mutex> g(m_mutexQueues);
+    const auto& it = m_queues.find(shardId);
+    if (it != m_queues.end()) {
+      return *it->second;
+    }
+  }
+
+  lock_guard<shared_timed_mutex> g(m_mutexQueues);
+  auto& queue = m_queues[shardId];
+  if (!queue) {
+    queue.reset(new ShardQueue(m_queueSize));
+  }
+  return *queue;
+}
+
+bool TxnIngressQueue::MarkSeen(const TxnHash& txnHash) {
+  Stripe& stripe = m_stripes[hash<TxnHash>()(txnHash) % NUM_STRIPES];
+  lock_guard<mutex> g(stripe.mutex);
+  if (stripe.previous.find(txnHash) != stripe.previous.end()) {
+    return false;
+  }
+  return stripe.current.insert(txnHash).second;
+}
+
+void TxnIngressQueue::UnmarkSeen(const TxnHash& txnHash) {
+  Stripe& stripe = m_stripes[hash<TxnHash>()(txnHash) % NUM_STRIPES];
+  lock_guard<mutex> g(stripe.mutex);
+  stripe.current.erase(txnHash);
+}
+
+bool TxnIngressQueue::ReserveSender(const PubKey& sender, uint64_t numBytes) {
+  Stripe& stripe = m_stripes[hash<PubKey>()(sender) % NUM_STRIPES];
+  lock_guard<mutex> g(stripe.mutex);
+  SenderUsage& usage = stripe.senders[sender];
+  if (usage.numTxns >= m_maxTxnsPerSender ||
+      usage.numBytes + numBytes > m_maxBytesPerSender) {
+    return false;
+  }
+  usage.numTxns++;
+  usage.numBytes += numBytes;
+  return true;
+}
+
+TxnIngressQueue::Result TxnIngressQueue::Add(const Transaction& tx,
+                                             uint32_t shardId) {
+  ShardQueue& queue = GetQueue(shardId);
+
+  // Take the queue slot first, as it is the only check without a lock
+  if (queue.size.fetch_add(1) >= m_queueSize) {
+    queue.size--;
+    return QUEUE_FULL;
+  }
+
+  if (!MarkSeen(tx.GetTranID())) {
+    queue.size--;
+    return DUPLICATE;
+  }
+
+  if (!ReserveSender(tx.GetSenderPubKey(),
+                     tx.GetCode().size() + tx.GetData().size())) {
+    UnmarkSeen(tx.GetTranID());
+    queue.size--;
+    return SENDER_LIMIT;
+  }
+
+  queue.queue.push(new Transaction(tx));
+  return ADDED;
+}
+
+void TxnIngressQueue::Drain(uint32_t shardId, vector<Transaction>& txns) {
+  ShardQueue& queue = GetQueue(shardId);
+
+  {
+    lock_guard<mutex> g(queue.mutexCarryOver);
+    txns.insert(txns.end(), make_move_iterator(queue.carryOver.begin()),
+                make_move_iterator(queue.carryOver.end()));
+    queue.size -= queue.carryOver.size();
+    queue.carryOver.clear();
+  }
+
+  Transaction* tx = nullptr;
+  while (queue.queue.pop(tx)) {
+    txns.emplace_back(move(*tx));
+    delete tx;
+    queue.size--;
+  }
+}
+
+void TxnIngressQueue::Restore(uint32_t shardId, vector<Transaction>&& txns) {
+  ShardQueue& queue = GetQueue(shardId);
+
+  lock_guard<mutex> g(queue.mutexCarryOver);
+  queue.size += txns.size();
+  queue.carryOver.insert(queue.carryOver.end(),
+                         make_move_iterator(txns.begin()),
+                         make_move_iterator(txns.end()));
+  txns.clear();
+}
+
+void TxnIngressQueue::NextRound() {
+  for (auto& stripe : m_stripes) {
+    lock_guard<mutex> g(stripe.mutex);
+    stripe.previous = move(stripe.current);
+    stripe.current.clear();
+    stripe.senders.clear();
+  }
+}
+
+size_t TxnIngressQueue::GetSize(uint32_t shardId) {
+  return GetQueue(shardId).size;
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#ifndef __TXNINGRESSQUEUE_H__
+#define __TXNINGRESSQUEUE_H__
+
+#include <array>
+#include <atomic>
+#include <boost/lockfree/queue.hpp>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "libData/AccountData/Transaction.h"
+
+/// Transactions submitted to a lookup, waiting to be forwarded to the shards.
+/// Each shard (and the DS committee) has its own lock-free queue, so adding a
+/// transaction never waits for a packet being built from an earlier batch.
+/// Resubmitted transactions are dropped, and each sender may only add a
+/// limited number of transactions and payload bytes per round. The hashes and
+/// per-sender counts are split into stripes that are locked independently.
+class TxnIngressQueue {
+ public:
+  enum Result { ADDED, DUPLICATE, SENDER_LIMIT, QUEUE_FULL };
+
+ private:
+  struct ShardQueue {
+    boost::lockfree::queue<Transaction*> queue;
+    std::atomic<size_t> size;
+    // Restored txns, which go out ahead of the queue in the next drain
+    std::vector<Transaction> carryOver;
+    std::mutex mutexCarryOver;
+
+    explicit ShardQueue(size_t capacity) : queue(capacity), size(0) {}
+  };
+
+  struct SenderUsage {
+    unsigned int numTxns;
+    uint64_t numBytes;
+  };
+
+  struct Stripe {
+    std::mutex mutex;
+    // Hashes seen this round and the previous one
+    std::unordered_set<TxnHash> current;
+    std::unordered_set<TxnHash> previous;
+    std::unordered_map<PubKey, SenderUsage> senders;
+  };
+
+  static const unsigned int NUM_STRIPES = 16;
+
+  const size_t m_queueSize;
+  const unsigned int m_maxTxnsPerSender;
+  const uint64_t m_maxBytesPerSender;
+
+  std::array<Stripe, NUM_STRIPES> m_stripes;
+
+  std::map<uint32_t, std::unique_ptr<ShardQueue>> m_queues;
+  std::shared_timed_mutex m_mutexQueues;
+
+  ShardQueue& GetQueue(uint32_t shardId);
+  bool MarkSeen(const TxnHash& txnHash);
+  void UnmarkSeen(const TxnHash& txnHash);
+  bool ReserveSender(const PubKey& sender, uint64_t numBytes);
+
+ public:
+  /// Constructor. queueSize bounds each shard queue; the sender limits apply
+  /// per round (see NextRound).
+  TxnIngressQueue(size_t queueSize, unsigned int maxTxnsPerSender,
+                  uint64_t maxBytesPerSender);
+
+  /// Destructor.
+  ~TxnIngressQueue();
+
+  TxnIngressQueue(const TxnIngressQueue&) = delete;
+  TxnIngressQueue& operator=(const TxnIngressQueue&) = delete;
+
+  /// Queues the transaction for the shard unless it is a resubmission or a
+  /// limit is reached.
+  Result Add(const Transaction& tx, uint32_t shardId);
+
+  /// Moves all transactions queued for the shard into txns, in the order
+  /// they were added.
+  void Drain(uint32_t shardId, std::vector<Transaction>& txns);
+
+  /// Puts back transactions taken by Drain that could not be sent. They are
+  /// returned first by the next Drain.
+  void Restore(uint32_t shardId, std::vector<Transaction>&& txns);
+
+  /// Starts a new round: resets the sender limits and forgets hashes that are
+  /// older than the previous round.
+  void NextRound();
+
+  /// Returns the number of transactions queued for the shard.
+  size_t GetSize(uint32_t shardId);
+};
+
+#endif  // __TXNINGRESSQUEUE_H__
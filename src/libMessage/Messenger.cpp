@@ -19,12 +19,16 @@
 
 #include "Messenger.h"
 #include "libData/AccountData/AccountStore.h"
+#include "libData/AccountData/ShortTxnId.h"
 #include "libData/AccountData/Transaction.h"
 #include "libData/BlockChainData/BlockLinkChain.h"
 #include "libDirectoryService/DirectoryService.h"
+#include "libMessage/ProtoArena.h"
 #include "libMessage/ZilliqaMessage.pb.h"
 #include "libUtils/Logger.h"
 
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
 #include <algorithm>
 #include <map>
 #include <random>
@@ -43,8 +47,7 @@ void SerializableToProtobufByteArray(const Serializable& serializable,
 
 void ProtobufByteArrayToSerializable(const ByteArray& byteArray,
                                      Serializable& serializable) {
-  vector<unsigned char> tmp;
-  copy(byteArray.data().begin(), byteArray.data().end(), back_inserter(tmp));
+  vector<unsigned char> tmp(byteArray.data().begin(), byteArray.data().end());
   serializable.Deserialize(tmp, 0);
 }
 
@@ -59,8 +62,7 @@ void SerializableToProtobufByteArray(const SerializableDataBlock& serializable,
 // Temporary function for use by data blocks
 void ProtobufByteArrayToSerializable(const ByteArray& byteArray,
                                      SerializableDataBlock& serializable) {
-  vector<unsigned char> tmp;
-  copy(byteArray.data().begin(), byteArray.data().end(), back_inserter(tmp));
+  vector<unsigned char> tmp(byteArray.data().begin(), byteArray.data().end());
   serializable.Deserialize(tmp, 0);
 }
 
@@ -73,20 +75,26 @@ void NumberToProtobufByteArray(const T& number, ByteArray& byteArray) {
 
 template <class T, size_t S>
 void ProtobufByteArrayToNumber(const ByteArray& byteArray, T& number) {
-  vector<unsigned char> tmp;
-  copy(byteArray.data().begin(), byteArray.data().end(), back_inserter(tmp));
+  vector<unsigned char> tmp(byteArray.data().begin(), byteArray.data().end());
   number = Serializable::GetNumber<T>(tmp, 0, S);
 }
 
 template <class T>
 bool SerializeToArray(const T& protoMessage, vector<unsigned char>& dst,
                       const unsigned int offset) {
-  if ((offset + protoMessage.ByteSize()) > dst.size()) {
-    dst.resize(offset + protoMessage.ByteSize());
+  if (!protoMessage.IsInitialized()) {
+    return false;
+  }
+
+  // Computing the size also caches it in every submessage, so the message is
+  // walked once for the size and once for the serialization
+  const size_t size = protoMessage.ByteSizeLong();
+  if ((offset + size) > dst.size()) {
+    dst.resize(offset + size);
   }
 
-  return protoMessage.SerializeToArray(dst.data() + offset,
-                                       protoMessage.ByteSize());
+  protoMessage.SerializeWithCachedSizesToArray(dst.data() + offset);
+  return true;
 }
 
 template bool SerializeToArray<ProtoAccountStore>(
@@ -102,7 +110,7 @@ bool RepeatableToArray(const T& repeatable, vector<unsigned char>& dst,
       LOG_GENERAL(WARNING, "SerializeToArray failed, offset: " << tempOffset);
       return false;
     }
-    tempOffset += element.ByteSize();
+    tempOffset += element.GetCachedSize();
   }
   return true;
 }
@@ -152,11 +160,8 @@ bool ProtobufToAccount(const ProtoAccount& protoAccount, Account& account) {
        tmpStorageRoot.asArray().begin());
 
   if (protoAccount.code().size() > 0) {
-    vector<unsigned char> tmpVec;
-    tmpVec.resize(protoAccount.code().size());
-    copy(protoAccount.code().begin(), protoAccount.code().end(),
-         tmpVec.begin());
-    account.SetCode(tmpVec);
+    account.SetCode(vector<unsigned char>(protoAccount.code().begin(),
+                                          protoAccount.code().end()));
 
     dev::h256 tmpHash;
     copy(protoAccount.codehash().begin(),
@@ -178,10 +183,8 @@ bool ProtobufToAccount(const ProtoAccount& protoAccount, Account& account) {
     account.SetCreateBlockNum(protoAccount.createblocknum());
 
     if (protoAccount.initdata().size() > 0) {
-      tmpVec.resize(protoAccount.initdata().size());
-      copy(protoAccount.initdata().begin(), protoAccount.initdata().end(),
-           tmpVec.begin());
-      account.InitContract(tmpVec);
+      account.InitContract(vector<unsigned char>(
+          protoAccount.initdata().begin(), protoAccount.initdata().end()));
     }
 
     for (const auto& entry : protoAccount.storage()) {
@@ -284,17 +287,14 @@ bool ProtobufToAccountDelta(const ProtoAccount& protoAccount, Account& account,
                                  << MAX_CODE_SIZE_IN_BYTES);
         return false;
       }
-      tmpVec.resize(protoAccount.code().size());
-      copy(protoAccount.code().begin(), protoAccount.code().end(),
-           tmpVec.begin());
+      tmpVec.assign(protoAccount.code().begin(), protoAccount.code().end());
       if (tmpVec != account.GetCode()) {
         account.SetCode(tmpVec);
       }
 
       if (!protoAccount.initdata().empty() && account.GetInitData().empty()) {
-        tmpVec.resize(protoAccount.initdata().size());
-        copy(protoAccount.initdata().begin(), protoAccount.initdata().end(),
-             tmpVec.begin());
+        tmpVec.assign(protoAccount.initdata().begin(),
+                      protoAccount.initdata().end());
         account.SetInitData(tmpVec);
         doInitContract = true;
       }
@@ -647,12 +647,10 @@ void ProtobufToTransactionCoreInfo(
   ProtobufByteArrayToNumber<uint128_t, UINT128_SIZE>(
       protoTxnCoreInfo.gasprice(), txnCoreInfo.gasPrice);
   txnCoreInfo.gasLimit = protoTxnCoreInfo.gaslimit();
-  txnCoreInfo.code.resize(protoTxnCoreInfo.code().size());
-  copy(protoTxnCoreInfo.code().begin(), protoTxnCoreInfo.code().end(),
-       txnCoreInfo.code.begin());
-  txnCoreInfo.data.resize(protoTxnCoreInfo.data().size());
-  copy(protoTxnCoreInfo.data().begin(), protoTxnCoreInfo.data().end(),
-       txnCoreInfo.data.begin());
+  txnCoreInfo.code.assign(protoTxnCoreInfo.code().begin(),
+                          protoTxnCoreInfo.code().end());
+  txnCoreInfo.data.assign(protoTxnCoreInfo.data().begin(),
+                          protoTxnCoreInfo.data().end());
 }
 
 void TransactionToProtobuf(const Transaction& transaction,
@@ -707,10 +705,7 @@ void ProtobufToTransaction(const ProtoTransaction& protoTransaction,
     return;
   }
 
-  transaction = Transaction(
-      tranID, txnCoreInfo.version, txnCoreInfo.nonce, txnCoreInfo.toAddr,
-      txnCoreInfo.senderPubKey, txnCoreInfo.amount, txnCoreInfo.gasPrice,
-      txnCoreInfo.gasLimit, txnCoreInfo.code, txnCoreInfo.data, signature);
+  transaction = Transaction(tranID, move(txnCoreInfo), signature);
 }
 
 void TransactionOffsetToProtobuf(const std::vector<uint32_t>& txnOffsets,
@@ -738,10 +733,11 @@ void TransactionArrayToProtobuf(const std::vector<Transaction>& txns,
 void ProtobufToTransactionArray(
     const ProtoTransactionArray& protoTransactionArray,
     std::vector<Transaction>& txns) {
+  txns.reserve(txns.size() + protoTransactionArray.transactions().size());
   for (const auto& protoTransaction : protoTransactionArray.transactions()) {
     Transaction txn;
     ProtobufToTransaction(protoTransaction, txn);
-    txns.push_back(txn);
+    txns.emplace_back(move(txn));
   }
 }
 
@@ -755,11 +751,7 @@ void TransactionReceiptToProtobuf(const TransactionReceipt& transReceipt,
 void ProtobufToTransactionReceipt(
     const ProtoTransactionReceipt& protoTransactionReceipt,
     TransactionReceipt& transactionReceipt) {
-  std::string tranReceiptStr;
-  tranReceiptStr.resize(protoTransactionReceipt.receipt().size());
-  copy(protoTransactionReceipt.receipt().begin(),
-       protoTransactionReceipt.receipt().end(), tranReceiptStr.begin());
-  transactionReceipt.SetString(tranReceiptStr);
+  transactionReceipt.SetString(protoTransactionReceipt.receipt());
   transactionReceipt.SetCumGas(protoTransactionReceipt.cumgas());
 }
 
@@ -783,7 +775,8 @@ void ProtobufToTransactionWithReceipt(
   TransactionReceipt receipt;
   ProtobufToTransactionReceipt(protoWithTransaction.receipt(), receipt);
 
-  transactionWithReceipt = TransactionWithReceipt(transaction, receipt);
+  transactionWithReceipt =
+      TransactionWithReceipt(move(transaction), move(receipt));
 }
 
 void PeerToProtobuf(const Peer& peer, ProtoPeer& protoPeer) {
@@ -1053,6 +1046,54 @@ void MicroBlockToProtobuf(const MicroBlock& microBlock,
   BlockBaseToProtobuf(microBlock, *protoBlockBase);
 }
 
+void MicroBlockToCompactProtobuf(const MicroBlock& microBlock,
+                                 ProtoMicroBlock& protoMicroBlock) {
+  // Same as MicroBlockToProtobuf, but the txn hashes are replaced by short IDs
+  // that the receiver resolves against its own txn pool
+
+  MicroBlockHeaderToProtobuf(microBlock.GetHeader(),
+                             *protoMicroBlock.mutable_header());
+
+  const ShortTxnIdGenerator shortTxnId(microBlock.GetHeader().GetMyHash());
+  const vector<TxnHash>& tranHashes = microBlock.GetTranHashes();
+  vector<unsigned char> shortTxnIds;
+  shortTxnIds.reserve(tranHashes.size() * SHORT_TXN_ID_SIZE);
+  unsigned int curOffset = 0;
+  for (const auto& hash : tranHashes) {
+    Serializable::SetNumber<uint64_t>(shortTxnIds, curOffset, shortTxnId(hash),
+                                      SHORT_TXN_ID_SIZE);
+    curOffset += SHORT_TXN_ID_SIZE;
+  }
+  protoMicroBlock.set_shorttxnids(shortTxnIds.data(), shortTxnIds.size());
+
+  BlockBaseToProtobuf(microBlock, *protoMicroBlock.mutable_blockbase());
+}
+
+bool ProtobufToShortTxnIds(const ProtoMicroBlock& protoMicroBlock,
+                           vector<uint64_t>& shortTxnIds) {
+  shortTxnIds.clear();
+
+  if (!protoMicroBlock.has_shorttxnids()) {
+    return true;
+  }
+
+  const string& ids = protoMicroBlock.shorttxnids();
+  if ((ids.size() % SHORT_TXN_ID_SIZE) != 0) {
+    LOG_GENERAL(WARNING, "Invalid short txn ids size " << ids.size());
+    return false;
+  }
+
+  const vector<unsigned char> raw(ids.begin(), ids.end());
+  shortTxnIds.reserve(raw.size() / SHORT_TXN_ID_SIZE);
+  for (unsigned int curOffset = 0; curOffset < raw.size();
+       curOffset += SHORT_TXN_ID_SIZE) {
+    shortTxnIds.emplace_back(Serializable::GetNumber<uint64_t>(
+        raw, curOffset, SHORT_TXN_ID_SIZE));
+  }
+
+  return true;
+}
+
 void ProtobufToMicroBlockHeader(
     const ProtoMicroBlock::MicroBlockHeader& protoMicroBlockHeader,
     MicroBlockHeader& microBlockHeader) {
@@ -1123,6 +1164,7 @@ void ProtobufToMicroBlock(const ProtoMicroBlock& protoMicroBlock,
   // Deserialize body
 
   vector<TxnHash> tranHashes;
+  tranHashes.reserve(protoMicroBlock.tranhashes().size());
   for (const auto& hash : protoMicroBlock.tranhashes()) {
     tranHashes.emplace_back();
     unsigned int size =
@@ -1131,7 +1173,7 @@ void ProtobufToMicroBlock(const ProtoMicroBlock& protoMicroBlock,
          tranHashes.back().asArray().begin());
   }
 
-  microBlock = MicroBlock(header, tranHashes, CoSignatures());
+  microBlock = MicroBlock(header, move(tranHashes), CoSignatures());
 
   const ZilliqaMessage::ProtoBlockBase& protoBlockBase =
       protoMicroBlock.blockbase();
@@ -1845,7 +1887,8 @@ bool Messenger::SetAccount(vector<unsigned char>& dst,
 [[gnu::unused]] bool Messenger::GetAccount(const vector<unsigned char>& src,
                                            const unsigned int offset,
                                            Account& account) {
-  ProtoAccount result;
+  ProtoArenaScope arena;
+  ProtoAccount& result = arena.Create<ProtoAccount>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -1880,7 +1923,8 @@ bool Messenger::SetAccountDelta(vector<unsigned char>& dst,
 bool Messenger::GetAccountDelta(const vector<unsigned char>& src,
                                 const unsigned int offset, Account& account,
                                 const bool fullCopy) {
-  ProtoAccount result;
+  ProtoArenaScope arena;
+  ProtoAccount& result = arena.Create<ProtoAccount>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -1929,7 +1973,8 @@ template <class MAP>
 bool Messenger::GetAccountStore(const vector<unsigned char>& src,
                                 const unsigned int offset,
                                 MAP& addressToAccount) {
-  ProtoAccountStore result;
+  ProtoArenaScope arena;
+  ProtoAccountStore& result = arena.Create<ProtoAccountStore>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -1964,7 +2009,8 @@ bool Messenger::GetAccountStore(const vector<unsigned char>& src,
 bool Messenger::GetAccountStore(const vector<unsigned char>& src,
                                 const unsigned int offset,
                                 AccountStore& accountStore) {
-  ProtoAccountStore result;
+  ProtoArenaScope arena;
+  ProtoAccountStore& result = arena.Create<ProtoAccountStore>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2029,7 +2075,8 @@ bool Messenger::GetAccountStoreDelta(const vector<unsigned char>& src,
                                      const unsigned int offset,
                                      AccountStore& accountStore,
                                      const bool reversible) {
-  ProtoAccountStore result;
+  ProtoArenaScope arena;
+  ProtoAccountStore& result = arena.Create<ProtoAccountStore>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2076,8 +2123,10 @@ bool Messenger::GetAccountStoreDelta(const vector<unsigned char>& src,
 
 bool Messenger::GetAccountStoreDelta(const vector<unsigned char>& src,
                                      const unsigned int offset,
-                                     AccountStoreTemp& accountStoreTemp) {
-  ProtoAccountStore result;
+                                     AccountStoreTemp& accountStoreTemp,
+                                     vector<Address>* addresses) {
+  ProtoArenaScope arena;
+  ProtoAccountStore& result = arena.Create<ProtoAccountStore>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2089,6 +2138,10 @@ bool Messenger::GetAccountStoreDelta(const vector<unsigned char>& src,
   LOG_GENERAL(INFO,
               "Total Number of Accounts Delta: " << result.entries().size());
 
+  if (addresses != nullptr) {
+    addresses->reserve(addresses->size() + result.entries().size());
+  }
+
   for (const auto& entry : result.entries()) {
     Address address;
     Account account;
@@ -2118,6 +2171,10 @@ bool Messenger::GetAccountStoreDelta(const vector<unsigned char>& src,
     }
 
     accountStoreTemp.AddAccountDuringDeserialization(address, account);
+
+    if (addresses != nullptr) {
+      addresses->emplace_back(address);
+    }
   }
 
   return true;
@@ -2175,7 +2232,9 @@ bool Messenger::SetDSBlockHeader(vector<unsigned char>& dst,
 bool Messenger::GetDSBlockHeader(const vector<unsigned char>& src,
                                  const unsigned int offset,
                                  DSBlockHeader& dsBlockHeader) {
-  ProtoDSBlock::DSBlockHeader result;
+  ProtoArenaScope arena;
+  ProtoDSBlock::DSBlockHeader& result =
+      arena.Create<ProtoDSBlock::DSBlockHeader>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2205,7 +2264,8 @@ bool Messenger::SetDSBlock(vector<unsigned char>& dst,
 
 bool Messenger::GetDSBlock(const vector<unsigned char>& src,
                            const unsigned int offset, DSBlock& dsBlock) {
-  ProtoDSBlock result;
+  ProtoArenaScope arena;
+  ProtoDSBlock& result = arena.Create<ProtoDSBlock>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2238,7 +2298,9 @@ bool Messenger::SetMicroBlockHeader(vector<unsigned char>& dst,
 bool Messenger::GetMicroBlockHeader(const vector<unsigned char>& src,
                                     const unsigned int offset,
                                     MicroBlockHeader& microBlockHeader) {
-  ProtoMicroBlock::MicroBlockHeader result;
+  ProtoArenaScope arena;
+  ProtoMicroBlock::MicroBlockHeader& result =
+      arena.Create<ProtoMicroBlock::MicroBlockHeader>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2271,7 +2333,8 @@ bool Messenger::SetMicroBlock(vector<unsigned char>& dst,
 bool Messenger::GetMicroBlock(const vector<unsigned char>& src,
                               const unsigned int offset,
                               MicroBlock& microBlock) {
-  ProtoMicroBlock result;
+  ProtoArenaScope arena;
+  ProtoMicroBlock& result = arena.Create<ProtoMicroBlock>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2303,7 +2366,9 @@ bool Messenger::SetTxBlockHeader(vector<unsigned char>& dst,
 bool Messenger::GetTxBlockHeader(const vector<unsigned char>& src,
                                  const unsigned int offset,
                                  TxBlockHeader& txBlockHeader) {
-  ProtoTxBlock::TxBlockHeader result;
+  ProtoArenaScope arena;
+  ProtoTxBlock::TxBlockHeader& result =
+      arena.Create<ProtoTxBlock::TxBlockHeader>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2333,7 +2398,8 @@ bool Messenger::SetTxBlock(vector<unsigned char>& dst,
 
 bool Messenger::GetTxBlock(const vector<unsigned char>& src,
                            const unsigned int offset, TxBlock& txBlock) {
-  ProtoTxBlock result;
+  ProtoArenaScope arena;
+  ProtoTxBlock& result = arena.Create<ProtoTxBlock>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2365,7 +2431,9 @@ bool Messenger::SetVCBlockHeader(vector<unsigned char>& dst,
 bool Messenger::GetVCBlockHeader(const vector<unsigned char>& src,
                                  const unsigned int offset,
                                  VCBlockHeader& vcBlockHeader) {
-  ProtoVCBlock::VCBlockHeader result;
+  ProtoArenaScope arena;
+  ProtoVCBlock::VCBlockHeader& result =
+      arena.Create<ProtoVCBlock::VCBlockHeader>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2395,7 +2463,8 @@ bool Messenger::SetVCBlock(vector<unsigned char>& dst,
 
 bool Messenger::GetVCBlock(const vector<unsigned char>& src,
                            const unsigned int offset, VCBlock& vcBlock) {
-  ProtoVCBlock result;
+  ProtoArenaScope arena;
+  ProtoVCBlock& result = arena.Create<ProtoVCBlock>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2429,7 +2498,9 @@ bool Messenger::SetFallbackBlockHeader(
 bool Messenger::GetFallbackBlockHeader(
     const vector<unsigned char>& src, const unsigned int offset,
     FallbackBlockHeader& fallbackBlockHeader) {
-  ProtoFallbackBlock::FallbackBlockHeader result;
+  ProtoArenaScope arena;
+  ProtoFallbackBlock::FallbackBlockHeader& result =
+      arena.Create<ProtoFallbackBlock::FallbackBlockHeader>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2463,7 +2534,8 @@ bool Messenger::SetFallbackBlock(vector<unsigned char>& dst,
 bool Messenger::GetFallbackBlock(const vector<unsigned char>& src,
                                  const unsigned int offset,
                                  FallbackBlock& fallbackBlock) {
-  ProtoFallbackBlock result;
+  ProtoArenaScope arena;
+  ProtoFallbackBlock& result = arena.Create<ProtoFallbackBlock>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2494,7 +2566,8 @@ bool Messenger::SetTransactionCoreInfo(std::vector<unsigned char>& dst,
 bool Messenger::GetTransactionCoreInfo(const std::vector<unsigned char>& src,
                                        const unsigned int offset,
                                        TransactionCoreInfo& transaction) {
-  ProtoTransactionCoreInfo result;
+  ProtoArenaScope arena;
+  ProtoTransactionCoreInfo& result = arena.Create<ProtoTransactionCoreInfo>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2525,7 +2598,8 @@ bool Messenger::SetTransaction(std::vector<unsigned char>& dst,
 bool Messenger::GetTransaction(const std::vector<unsigned char>& src,
                                const unsigned int offset,
                                Transaction& transaction) {
-  ProtoTransaction result;
+  ProtoArenaScope arena;
+  ProtoTransaction& result = arena.Create<ProtoTransaction>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2554,7 +2628,8 @@ bool Messenger::SetTransactionFileOffset(
 bool Messenger::GetTransactionFileOffset(const std::vector<unsigned char>& src,
                                          const unsigned int offset,
                                          std::vector<uint32_t>& txnOffsets) {
-  ProtoTxnFileOffset result;
+  ProtoArenaScope arena;
+  ProtoTxnFileOffset& result = arena.Create<ProtoTxnFileOffset>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2582,7 +2657,8 @@ bool Messenger::SetTransactionArray(std::vector<unsigned char>& dst,
 bool Messenger::GetTransactionArray(const std::vector<unsigned char>& src,
                                     const unsigned int offset,
                                     std::vector<Transaction>& txns) {
-  ProtoTransactionArray result;
+  ProtoArenaScope arena;
+  ProtoTransactionArray& result = arena.Create<ProtoTransactionArray>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2612,7 +2688,8 @@ bool Messenger::SetTransactionReceipt(
 bool Messenger::GetTransactionReceipt(const std::vector<unsigned char>& src,
                                       const unsigned int offset,
                                       TransactionReceipt& transactionReceipt) {
-  ProtoTransactionReceipt result;
+  ProtoArenaScope arena;
+  ProtoTransactionReceipt& result = arena.Create<ProtoTransactionReceipt>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2643,7 +2720,9 @@ bool Messenger::SetTransactionWithReceipt(
 bool Messenger::GetTransactionWithReceipt(
     const std::vector<unsigned char>& src, const unsigned int offset,
     TransactionWithReceipt& transactionWithReceipt) {
-  ProtoTransactionWithReceipt result;
+  ProtoArenaScope arena;
+  ProtoTransactionWithReceipt& result =
+      arena.Create<ProtoTransactionWithReceipt>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2673,7 +2752,8 @@ bool Messenger::SetPeer(std::vector<unsigned char>& dst,
 
 bool Messenger::GetPeer(const std::vector<unsigned char>& src,
                         const unsigned int offset, Peer& peer) {
-  ProtoPeer result;
+  ProtoArenaScope arena;
+  ProtoPeer& result = arena.Create<ProtoPeer>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2752,7 +2832,8 @@ bool Messenger::GetDSPoWSubmission(const vector<unsigned char>& src,
                                    uint32_t& lookupId, uint128_t& gasPrice) {
   LOG_MARKER();
 
-  DSPoWSubmission result;
+  ProtoArenaScope arena;
+  DSPoWSubmission& result = arena.Create<DSPoWSubmission>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2837,7 +2918,8 @@ bool Messenger::GetDSPowPacketSubmission(
     vector<DSPowSolution>& dsPowSolutions) {
   LOG_MARKER();
 
-  DSPoWPacketSubmission result;
+  ProtoArenaScope arena;
+  DSPoWPacketSubmission& result = arena.Create<DSPoWPacketSubmission>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2862,7 +2944,8 @@ bool Messenger::GetDSMicroBlockSubmission(
     vector<vector<unsigned char>>& stateDeltas) {
   LOG_MARKER();
 
-  DSMicroBlockSubmission result;
+  ProtoArenaScope arena;
+  DSMicroBlockSubmission& result = arena.Create<DSMicroBlockSubmission>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2879,9 +2962,7 @@ bool Messenger::GetDSMicroBlockSubmission(
     microBlocks.emplace_back(move(microBlock));
   }
   for (const auto& proto_delta : result.statedeltas()) {
-    stateDeltas.emplace_back();
-    copy(proto_delta.begin(), proto_delta.end(),
-         std::back_inserter(stateDeltas.back()));
+    stateDeltas.emplace_back(proto_delta.begin(), proto_delta.end());
   }
 
   return true;
@@ -2966,7 +3047,8 @@ bool Messenger::GetDSDSBlockAnnouncement(
     MapOfPubKeyPoW& dsWinnerPoWs, vector<unsigned char>& messageToCosign) {
   LOG_MARKER();
 
-  ConsensusAnnouncement announcement;
+  ProtoArenaScope arena;
+  ConsensusAnnouncement& announcement = arena.Create<ConsensusAnnouncement>();
 
   announcement.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -3057,7 +3139,7 @@ bool Messenger::SetDSFinalBlockAnnouncement(
   DSFinalBlockAnnouncement* finalblock = announcement.mutable_finalblock();
   TxBlockToProtobuf(txBlock, *finalblock->mutable_txblock());
   if (microBlock != nullptr) {
-    MicroBlockToProtobuf(*microBlock, *finalblock->mutable_microblock());
+    MicroBlockToCompactProtobuf(*microBlock, *finalblock->mutable_microblock());
   } else {
     LOG_GENERAL(WARNING, "microblock is nullptr");
   }
@@ -3094,11 +3176,12 @@ bool Messenger::GetDSFinalBlockAnnouncement(
     const uint32_t consensusID, const uint64_t blockNumber,
     const vector<unsigned char>& blockHash, const uint16_t leaderID,
     const PubKey& leaderKey, TxBlock& txBlock,
-    shared_ptr<MicroBlock>& microBlock,
+    shared_ptr<MicroBlock>& microBlock, vector<uint64_t>& shortTxnIds,
     vector<unsigned char>& messageToCosign) {
   LOG_MARKER();
 
-  ConsensusAnnouncement announcement;
+  ProtoArenaScope arena;
+  ConsensusAnnouncement& announcement = arena.Create<ConsensusAnnouncement>();
 
   announcement.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -3127,6 +3210,10 @@ bool Messenger::GetDSFinalBlockAnnouncement(
 
   if (finalblock.has_microblock()) {
     ProtobufToMicroBlock(finalblock.microblock(), *microBlock);
+    if (!ProtobufToShortTxnIds(finalblock.microblock(), shortTxnIds)) {
+      LOG_GENERAL(WARNING, "ProtobufToShortTxnIds failed.");
+      return false;
+    }
   } else {
     LOG_GENERAL(WARNING, "Announcement doesn't include ds microblock");
     microBlock = nullptr;
@@ -3194,7 +3281,8 @@ bool Messenger::GetDSVCBlockAnnouncement(
     vector<unsigned char>& messageToCosign) {
   LOG_MARKER();
 
-  ConsensusAnnouncement announcement;
+  ProtoArenaScope arena;
+  ConsensusAnnouncement& announcement = arena.Create<ConsensusAnnouncement>();
 
   announcement.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -3273,7 +3361,8 @@ bool Messenger::GetNodeVCDSBlocksMessage(
     vector<vector<Peer>>& shardReceivers, vector<vector<Peer>>& shardSenders) {
   LOG_MARKER();
 
-  NodeDSBlock result;
+  ProtoArenaScope arena;
+  NodeDSBlock& result = arena.Create<NodeDSBlock>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -3331,7 +3420,8 @@ bool Messenger::GetNodeFinalBlock(const vector<unsigned char>& src,
                                   vector<unsigned char>& stateDelta) {
   LOG_MARKER();
 
-  NodeFinalBlock result;
+  ProtoArenaScope arena;
+  NodeFinalBlock& result = arena.Create<NodeFinalBlock>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -3344,9 +3434,7 @@ bool Messenger::GetNodeFinalBlock(const vector<unsigned char>& src,
   dsBlockNumber = result.dsblocknumber();
   consensusID = result.consensusid();
   ProtobufToTxBlock(result.txblock(), txBlock);
-  stateDelta.resize(result.statedelta().size());
-  copy(result.statedelta().begin(), result.statedelta().end(),
-       stateDelta.begin());
+  stateDelta.assign(result.statedelta().begin(), result.statedelta().end());
 
   return true;
 }
@@ -3384,7 +3472,8 @@ bool Messenger::GetNodeForwardTransaction(const vector<unsigned char>& src,
                                           ForwardedTxnEntry& entry) {
   LOG_MARKER();
 
-  NodeForwardTransaction result;
+  ProtoArenaScope arena;
+  NodeForwardTransaction& result = arena.Create<NodeForwardTransaction>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -3433,7 +3522,8 @@ bool Messenger::GetNodeVCBlock(const vector<unsigned char>& src,
                                const unsigned int offset, VCBlock& vcBlock) {
   LOG_MARKER();
 
-  NodeVCBlock result;
+  ProtoArenaScope arena;
+  NodeVCBlock& result = arena.Create<NodeVCBlock>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -3502,6 +3592,89 @@ bool Messenger::SetNodeForwardTxnBlock(
   return SerializeToArray(result, dst, offset);
 }
 
+bool Messenger::SetNodeForwardTxnBlock(
+    std::vector<unsigned char>& dst, const unsigned int offset,
+    const uint64_t epochNumber, const uint32_t shardId,
+    const std::pair<PrivKey, PubKey>& lookupKey,
+    const std::vector<Transaction>& txnsCurrent,
+    const std::vector<TxnCorpus::Span>& txnsGenerated) {
+  LOG_MARKER();
+
+  using google::protobuf::io::CodedOutputStream;
+  using google::protobuf::internal::WireFormatLite;
+
+  NodeForwardTxnBlock result;
+
+  result.set_epochnumber(epochNumber);
+  result.set_shardid(shardId);
+  SerializableToProtobufByteArray(lookupKey.second, *result.mutable_pubkey());
+
+  for (const auto& txn : txnsCurrent) {
+    TransactionToProtobuf(txn, *result.add_transactions());
+  }
+
+  // The signed data is every serialized txn back to back, so the generated
+  // ones can be appended to it as they are
+  vector<unsigned char> tmp;
+  if (result.transactions().size() > 0 &&
+      !RepeatableToArray(result.transactions(), tmp, 0)) {
+    LOG_GENERAL(WARNING, "Failed to serialize transactions.");
+    return false;
+  }
+  for (const auto& txn : txnsGenerated) {
+    tmp.insert(tmp.end(), txn.first, txn.first + txn.second);
+  }
+
+  Signature signature;
+  if (!tmp.empty()) {
+    if (!Schnorr::GetInstance().Sign(tmp, lookupKey.first, lookupKey.second,
+                                     signature)) {
+      LOG_GENERAL(WARNING, "Failed to sign transactions.");
+      return false;
+    }
+  }
+
+  SerializableToProtobufByteArray(signature, *result.mutable_signature());
+
+  if (!result.IsInitialized()) {
+    LOG_GENERAL(WARNING, "NodeForwardTxnBlock initialization failed.");
+    return false;
+  }
+
+  if (!SerializeToArray(result, dst, offset)) {
+    return false;
+  }
+
+  // Emit the generated txns as further occurrences of the transactions field
+  // after the signature. Parsers merge repeated fields in wire order, so the
+  // receiver sees the current txns followed by the generated ones, as with
+  // the other overload.
+  const uint32_t tag = WireFormatLite::MakeTag(
+      NodeForwardTxnBlock::kTransactionsFieldNumber,
+      WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+  size_t pos = offset + result.GetCachedSize();
+  size_t size = pos;
+  for (const auto& txn : txnsGenerated) {
+    size += CodedOutputStream::VarintSize32(tag) +
+            CodedOutputStream::VarintSize32(txn.second) + txn.second;
+  }
+  dst.resize(size);
+
+  for (const auto& txn : txnsGenerated) {
+    unsigned char* target = dst.data() + pos;
+    target = CodedOutputStream::WriteVarint32ToArray(tag, target);
+    target = CodedOutputStream::WriteVarint32ToArray(txn.second, target);
+    target = copy(txn.first, txn.first + txn.second, target);
+    pos = target - dst.data();
+  }
+
+  LOG_GENERAL(INFO, "Epoch: " << epochNumber << " shardId: " << shardId
+                              << " Current txns: " << txnsCurrent.size()
+                              << " Generated txns: " << txnsGenerated.size());
+
+  return true;
+}
+
 bool Messenger::GetNodeForwardTxnBlock(const std::vector<unsigned char>& src,
                                        const unsigned int offset,
                                        uint64_t& epochNumber, uint32_t& shardId,
@@ -3509,7 +3682,8 @@ bool Messenger::GetNodeForwardTxnBlock(const std::vector<unsigned char>& src,
                                        std::vector<Transaction>& txns) {
   LOG_MARKER();
 
-  NodeForwardTxnBlock result;
+  ProtoArenaScope arena;
+  NodeForwardTxnBlock& result = arena.Create<NodeForwardTxnBlock>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -3562,7 +3736,7 @@ bool Messenger::SetNodeMicroBlockAnnouncement(
   // Set the MicroBlock announcement parameters
 
   NodeMicroBlockAnnouncement* microblock = announcement.mutable_microblock();
-  MicroBlockToProtobuf(microBlock, *microblock->mutable_microblock());
+  MicroBlockToCompactProtobuf(microBlock, *microblock->mutable_microblock());
 
   if (!microblock->IsInitialized()) {
     LOG_GENERAL(WARNING, "NodeMicroBlockAnnouncement initialization failed.");
@@ -3596,10 +3770,11 @@ bool Messenger::GetNodeMicroBlockAnnouncement(
     const uint32_t consensusID, const uint64_t blockNumber,
     const vector<unsigned char>& blockHash, const uint16_t leaderID,
     const PubKey& leaderKey, MicroBlock& microBlock,
-    vector<unsigned char>& messageToCosign) {
+    vector<uint64_t>& shortTxnIds, vector<unsigned char>& messageToCosign) {
   LOG_MARKER();
 
-  ConsensusAnnouncement announcement;
+  ProtoArenaScope arena;
+  ConsensusAnnouncement& announcement = arena.Create<ConsensusAnnouncement>();
 
   announcement.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -3625,6 +3800,10 @@ bool Messenger::GetNodeMicroBlockAnnouncement(
 
   const NodeMicroBlockAnnouncement& microblock = announcement.microblock();
   ProtobufToMicroBlock(microblock.microblock(), microBlock);
+  if (!ProtobufToShortTxnIds(microblock.microblock(), shortTxnIds)) {
+    LOG_GENERAL(WARNING, "ProtobufToShortTxnIds failed.");
+    return false;
+  }
 
   // Get the part of the announcement that should be co-signed during the first
   // round of consensus
@@ -3691,7 +3870,8 @@ bool Messenger::GetNodeFallbackBlockAnnouncement(
     vector<unsigned char>& messageToCosign) {
   LOG_MARKER();
 
-  ConsensusAnnouncement announcement;
+  ProtoArenaScope arena;
+  ConsensusAnnouncement& announcement = arena.Create<ConsensusAnnouncement>();
 
   announcement.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -3754,7 +3934,8 @@ bool Messenger::GetNodeFallbackBlock(const vector<unsigned char>& src,
                                      FallbackBlock& fallbackBlock) {
   LOG_MARKER();
 
-  NodeFallbackBlock result;
+  ProtoArenaScope arena;
+  NodeFallbackBlock& result = arena.Create<NodeFallbackBlock>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -3790,7 +3971,9 @@ bool Messenger::ShardStructureToArray(std::vector<unsigned char>& dst,
 bool Messenger::ArrayToShardStructure(const std::vector<unsigned char>& src,
                                       const unsigned int offset,
                                       DequeOfShard& shards) {
-  ProtoShardingStructure protoShardingStructure;
+  ProtoArenaScope arena;
+  ProtoShardingStructure& protoShardingStructure =
+      arena.Create<ProtoShardingStructure>();
   protoShardingStructure.ParseFromArray(src.data() + offset,
                                         src.size() - offset);
   ProtobufToShardingStructure(protoShardingStructure, shards);
@@ -3823,7 +4006,8 @@ bool Messenger::GetLookupGetSeedPeers(const vector<unsigned char>& src,
                                       uint32_t& listenPort) {
   LOG_MARKER();
 
-  LookupGetSeedPeers result;
+  ProtoArenaScope arena;
+  LookupGetSeedPeers& result = arena.Create<LookupGetSeedPeers>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -3894,7 +4078,8 @@ bool Messenger::GetLookupSetSeedPeers(const vector<unsigned char>& src,
                                       vector<Peer>& candidateSeeds) {
   LOG_MARKER();
 
-  LookupSetSeedPeers result;
+  ProtoArenaScope arena;
+  LookupSetSeedPeers& result = arena.Create<LookupSetSeedPeers>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -3955,7 +4140,8 @@ bool Messenger::GetLookupGetDSInfoFromSeed(const vector<unsigned char>& src,
                                            bool& initialDS) {
   LOG_MARKER();
 
-  LookupGetDSInfoFromSeed result;
+  ProtoArenaScope arena;
+  LookupGetDSInfoFromSeed& result = arena.Create<LookupGetDSInfoFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -4014,7 +4200,8 @@ bool Messenger::GetLookupSetDSInfoFromSeed(const vector<unsigned char>& src,
                                            bool& initialDS) {
   LOG_MARKER();
 
-  LookupSetDSInfoFromSeed result;
+  ProtoArenaScope arena;
+  LookupSetDSInfoFromSeed& result = arena.Create<LookupSetDSInfoFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
   ProtobufByteArrayToSerializable(result.pubkey(), senderPubKey);
@@ -4073,7 +4260,8 @@ bool Messenger::GetLookupGetDSBlockFromSeed(const vector<unsigned char>& src,
                                             uint32_t& listenPort) {
   LOG_MARKER();
 
-  LookupGetDSBlockFromSeed result;
+  ProtoArenaScope arena;
+  LookupGetDSBlockFromSeed& result = arena.Create<LookupGetDSBlockFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -4140,7 +4328,8 @@ bool Messenger::GetLookupSetDSBlockFromSeed(const vector<unsigned char>& src,
                                             vector<DSBlock>& dsBlocks) {
   LOG_MARKER();
 
-  LookupSetDSBlockFromSeed result;
+  ProtoArenaScope arena;
+  LookupSetDSBlockFromSeed& result = arena.Create<LookupSetDSBlockFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -4206,7 +4395,8 @@ bool Messenger::GetLookupGetTxBlockFromSeed(const vector<unsigned char>& src,
                                             uint32_t& listenPort) {
   LOG_MARKER();
 
-  LookupGetTxBlockFromSeed result;
+  ProtoArenaScope arena;
+  LookupGetTxBlockFromSeed& result = arena.Create<LookupGetTxBlockFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -4273,7 +4463,8 @@ bool Messenger::GetLookupSetTxBlockFromSeed(const vector<unsigned char>& src,
                                             vector<TxBlock>& txBlocks) {
   LOG_MARKER();
 
-  LookupSetTxBlockFromSeed result;
+  ProtoArenaScope arena;
+  LookupSetTxBlockFromSeed& result = arena.Create<LookupSetTxBlockFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -4336,7 +4527,9 @@ bool Messenger::GetLookupGetStateDeltaFromSeed(const vector<unsigned char>& src,
                                                uint32_t& listenPort) {
   LOG_MARKER();
 
-  LookupGetStateDeltaFromSeed result;
+  ProtoArenaScope arena;
+  LookupGetStateDeltaFromSeed& result =
+      arena.Create<LookupGetStateDeltaFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -4389,7 +4582,9 @@ bool Messenger::GetLookupSetStateDeltaFromSeed(
     vector<unsigned char>& stateDelta) {
   LOG_MARKER();
 
-  LookupSetStateDeltaFromSeed result;
+  ProtoArenaScope arena;
+  LookupSetStateDeltaFromSeed& result =
+      arena.Create<LookupSetStateDeltaFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -4400,9 +4595,7 @@ bool Messenger::GetLookupSetStateDeltaFromSeed(
 
   blockNum = result.blocknum();
 
-  stateDelta.resize(result.statedelta().size());
-  std::copy(result.statedelta().begin(), result.statedelta().end(),
-            stateDelta.begin());
+  stateDelta.assign(result.statedelta().begin(), result.statedelta().end());
 
   ProtobufByteArrayToSerializable(result.pubkey(), lookupPubKey);
   Signature signature;
@@ -4441,7 +4634,8 @@ bool Messenger::GetLookupGetTxBodyFromSeed(const vector<unsigned char>& src,
                                            uint32_t& listenPort) {
   LOG_MARKER();
 
-  LookupGetTxBodyFromSeed result;
+  ProtoArenaScope arena;
+  LookupGetTxBodyFromSeed& result = arena.Create<LookupGetTxBodyFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -4481,7 +4675,8 @@ bool Messenger::GetLookupSetTxBodyFromSeed(const vector<unsigned char>& src,
                                            TransactionWithReceipt& txBody) {
   LOG_MARKER();
 
-  LookupSetTxBodyFromSeed result;
+  ProtoArenaScope arena;
+  LookupSetTxBodyFromSeed& result = arena.Create<LookupSetTxBodyFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -4519,7 +4714,9 @@ bool Messenger::GetLookupSetNetworkIDFromSeed(const vector<unsigned char>& src,
                                               string& networkID) {
   LOG_MARKER();
 
-  LookupSetNetworkIDFromSeed result;
+  ProtoArenaScope arena;
+  LookupSetNetworkIDFromSeed& result =
+      arena.Create<LookupSetNetworkIDFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -4555,7 +4752,8 @@ bool Messenger::GetLookupGetStateFromSeed(const vector<unsigned char>& src,
                                           uint32_t& listenPort) {
   LOG_MARKER();
 
-  LookupGetStateFromSeed result;
+  ProtoArenaScope arena;
+  LookupGetStateFromSeed& result = arena.Create<LookupGetStateFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -4609,7 +4807,8 @@ bool Messenger::GetLookupSetStateFromSeed(
     PubKey& lookupPubKey, vector<unsigned char>& accountStoreBytes) {
   LOG_MARKER();
 
-  LookupSetStateFromSeed result;
+  ProtoArenaScope arena;
+  LookupSetStateFromSeed& result = arena.Create<LookupSetStateFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -4622,8 +4821,8 @@ bool Messenger::GetLookupSetStateFromSeed(
   Signature signature;
   ProtobufByteArrayToSerializable(result.signature(), signature);
 
-  copy(result.accountstore().data().begin(), result.accountstore().data().end(),
-       back_inserter(accountStoreBytes));
+  accountStoreBytes.assign(result.accountstore().data().begin(),
+                           result.accountstore().data().end());
 
   if (!Schnorr::GetInstance().Verify(accountStoreBytes, signature,
                                      lookupPubKey)) {
@@ -4656,7 +4855,8 @@ bool Messenger::GetLookupSetLookupOffline(const vector<unsigned char>& src,
                                           uint32_t& listenPort) {
   LOG_MARKER();
 
-  LookupSetLookupOffline result;
+  ProtoArenaScope arena;
+  LookupSetLookupOffline& result = arena.Create<LookupSetLookupOffline>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -4694,7 +4894,8 @@ bool Messenger::GetLookupSetLookupOnline(const vector<unsigned char>& src,
                                          uint32_t& listenPort, PubKey& pubKey) {
   LOG_MARKER();
 
-  LookupSetLookupOnline result;
+  ProtoArenaScope arena;
+  LookupSetLookupOnline& result = arena.Create<LookupSetLookupOnline>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -4732,7 +4933,8 @@ bool Messenger::GetLookupGetOfflineLookups(const vector<unsigned char>& src,
                                            uint32_t& listenPort) {
   LOG_MARKER();
 
-  LookupGetOfflineLookups result;
+  ProtoArenaScope arena;
+  LookupGetOfflineLookups& result = arena.Create<LookupGetOfflineLookups>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -4789,7 +4991,8 @@ bool Messenger::GetLookupSetOfflineLookups(const vector<unsigned char>& src,
                                            vector<Peer>& nodes) {
   LOG_MARKER();
 
-  LookupSetOfflineLookups result;
+  ProtoArenaScope arena;
+  LookupSetOfflineLookups& result = arena.Create<LookupSetOfflineLookups>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -4846,7 +5049,8 @@ bool Messenger::GetLookupGetStartPoWFromSeed(const vector<unsigned char>& src,
                                              uint32_t& listenPort) {
   LOG_MARKER();
 
-  LookupGetStartPoWFromSeed result;
+  ProtoArenaScope arena;
+  LookupGetStartPoWFromSeed& result = arena.Create<LookupGetStartPoWFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -4895,7 +5099,8 @@ bool Messenger::GetLookupSetStartPoWFromSeed(
     PubKey& lookupPubKey) {
   LOG_MARKER();
 
-  LookupSetStartPoWFromSeed result;
+  ProtoArenaScope arena;
+  LookupSetStartPoWFromSeed& result = arena.Create<LookupSetStartPoWFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -4941,7 +5146,8 @@ bool Messenger::GetLookupGetShardsFromSeed(const vector<unsigned char>& src,
                                            uint32_t& listenPort) {
   LOG_MARKER();
 
-  LookupGetShardsFromSeed result;
+  ProtoArenaScope arena;
+  LookupGetShardsFromSeed& result = arena.Create<LookupGetShardsFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -4994,7 +5200,8 @@ bool Messenger::GetLookupSetShardsFromSeed(const vector<unsigned char>& src,
                                            DequeOfShard& shards) {
   LOG_MARKER();
 
-  LookupSetShardsFromSeed result;
+  ProtoArenaScope arena;
+  LookupSetShardsFromSeed& result = arena.Create<LookupSetShardsFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -5049,7 +5256,9 @@ bool Messenger::GetLookupGetMicroBlockFromLookup(
     vector<BlockHash>& microBlockHashes, uint32_t& portNo) {
   LOG_MARKER();
 
-  LookupGetMicroBlockFromLookup result;
+  ProtoArenaScope arena;
+  LookupGetMicroBlockFromLookup& result =
+      arena.Create<LookupGetMicroBlockFromLookup>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -5113,7 +5322,9 @@ bool Messenger::GetLookupSetMicroBlockFromLookup(
     const vector<unsigned char>& src, const unsigned int offset,
     PubKey& lookupPubKey, vector<MicroBlock>& mbs) {
   LOG_MARKER();
-  LookupSetMicroBlockFromLookup result;
+  ProtoArenaScope arena;
+  LookupSetMicroBlockFromLookup& result =
+      arena.Create<LookupSetMicroBlockFromLookup>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -5178,7 +5389,8 @@ bool Messenger::GetLookupGetTxnsFromLookup(const vector<unsigned char>& src,
                                            uint32_t& portNo) {
   LOG_MARKER();
 
-  LookupGetTxnsFromLookup result;
+  ProtoArenaScope arena;
+  LookupGetTxnsFromLookup& result = arena.Create<LookupGetTxnsFromLookup>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -5241,7 +5453,8 @@ bool Messenger::GetLookupSetTxnsFromLookup(
     PubKey& lookupPubKey, vector<TransactionWithReceipt>& txns) {
   LOG_MARKER();
 
-  LookupSetTxnsFromLookup result;
+  ProtoArenaScope arena;
+  LookupSetTxnsFromLookup& result = arena.Create<LookupSetTxnsFromLookup>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -5331,7 +5544,8 @@ bool Messenger::GetConsensusCommit(
     CommitPoint& commit, const deque<pair<PubKey, Peer>>& committeeKeys) {
   LOG_MARKER();
 
-  ConsensusCommit result;
+  ProtoArenaScope arena;
+  ConsensusCommit& result = arena.Create<ConsensusCommit>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -5457,7 +5671,8 @@ bool Messenger::GetConsensusChallenge(
     const PubKey& leaderKey) {
   LOG_MARKER();
 
-  ConsensusChallenge result;
+  ProtoArenaScope arena;
+  ConsensusChallenge& result = arena.Create<ConsensusChallenge>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -5581,7 +5796,8 @@ bool Messenger::GetConsensusResponse(
     const deque<pair<PubKey, Peer>>& committeeKeys) {
   LOG_MARKER();
 
-  ConsensusResponse result;
+  ProtoArenaScope arena;
+  ConsensusResponse& result = arena.Create<ConsensusResponse>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -5704,7 +5920,8 @@ bool Messenger::GetConsensusCollectiveSig(
     vector<bool>& bitmap, Signature& collectiveSig, const PubKey& leaderKey) {
   LOG_MARKER();
 
-  ConsensusCollectiveSig result;
+  ProtoArenaScope arena;
+  ConsensusCollectiveSig& result = arena.Create<ConsensusCollectiveSig>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -5832,7 +6049,8 @@ bool Messenger::GetConsensusCommitFailure(
     const deque<pair<PubKey, Peer>>& committeeKeys) {
   LOG_MARKER();
 
-  ConsensusCommitFailure result;
+  ProtoArenaScope arena;
+  ConsensusCommitFailure& result = arena.Create<ConsensusCommitFailure>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -5881,9 +6099,8 @@ bool Messenger::GetConsensusCommitFailure(
     return false;
   }
 
-  errorMsg.resize(result.consensusinfo().errormsg().size());
-  copy(result.consensusinfo().errormsg().begin(),
-       result.consensusinfo().errormsg().end(), errorMsg.begin());
+  errorMsg.assign(result.consensusinfo().errormsg().begin(),
+                  result.consensusinfo().errormsg().end());
 
   vector<unsigned char> tmp(result.consensusinfo().ByteSize());
   result.consensusinfo().SerializeToArray(tmp.data(), tmp.size());
@@ -5922,7 +6139,8 @@ bool Messenger::SetBlockLink(
 bool Messenger::GetBlockLink(
     const vector<unsigned char>& src, const unsigned int offset,
     std::tuple<uint64_t, uint64_t, BlockType, BlockHash>& blocklink) {
-  ProtoBlockLink result;
+  ProtoArenaScope arena;
+  ProtoBlockLink& result = arena.Create<ProtoBlockLink>();
   BlockHash blkhash;
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -5963,7 +6181,9 @@ bool Messenger::SetFallbackBlockWShardingStructure(
 bool Messenger::GetFallbackBlockWShardingStructure(
     const vector<unsigned char>& src, const unsigned int offset,
     FallbackBlock& fallbackblock, DequeOfShard& shards) {
-  ProtoFallbackBlockWShardingStructure result;
+  ProtoArenaScope arena;
+  ProtoFallbackBlockWShardingStructure& result =
+      arena.Create<ProtoFallbackBlockWShardingStructure>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -5983,7 +6203,9 @@ bool Messenger::GetFallbackBlockWShardingStructure(
 bool Messenger::GetLookupGetDirectoryBlocksFromSeed(
     const vector<unsigned char>& src, const unsigned int offset,
     uint32_t& portno, uint64_t& index_num) {
-  LookupGetDirectoryBlocksFromSeed result;
+  ProtoArenaScope arena;
+  LookupGetDirectoryBlocksFromSeed& result =
+      arena.Create<LookupGetDirectoryBlocksFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -6060,7 +6282,9 @@ bool Messenger::GetLookupSetDirectoryBlocksFromSeed(
     vector<boost::variant<DSBlock, VCBlock, FallbackBlockWShardingStructure>>&
         directoryBlocks,
     uint64_t& index_num) {
-  LookupSetDirectoryBlocksFromSeed result;
+  ProtoArenaScope arena;
+  LookupSetDirectoryBlocksFromSeed& result =
+      arena.Create<LookupSetDirectoryBlocksFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -6145,7 +6369,9 @@ bool Messenger::GetLookupGetDSTxBlockFromSeed(
     uint64_t& txHighBlockNum, uint32_t& listenPort) {
   LOG_MARKER();
 
-  LookupGetDSTxBlockFromSeed result;
+  ProtoArenaScope arena;
+  LookupGetDSTxBlockFromSeed& result =
+      arena.Create<LookupGetDSTxBlockFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -6221,7 +6447,9 @@ bool Messenger::GetVCNodeSetDSTxBlockFromSeed(const vector<unsigned char>& src,
                                               vector<TxBlock>& txBlocks,
                                               PubKey& lookupPubKey) {
   LOG_MARKER();
-  VCNodeSetDSTxBlockFromSeed result;
+  ProtoArenaScope arena;
+  VCNodeSetDSTxBlockFromSeed& result =
+      arena.Create<VCNodeSetDSTxBlockFromSeed>();
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
   if (!result.IsInitialized()) {
@@ -29,6 +29,7 @@
 #include "libDirectoryService/DirectoryService.h"
 #include "libNetwork/Peer.h"
 #include "libNetwork/ShardStruct.h"
+#include "libUtils/TxnCorpus.h"
 
 class Messenger {
  public:
@@ -82,9 +83,10 @@ class Messenger {
                                    const unsigned int offset,
                                    AccountStore& accountStore,
                                    const bool reversible);
-  static bool GetAccountStoreDelta(const std::vector<unsigned char>& src,
-                                   const unsigned int offset,
-                                   AccountStoreTemp& accountStoreTemp);
+  static bool GetAccountStoreDelta(
+      const std::vector<unsigned char>& src, const unsigned int offset,
+      AccountStoreTemp& accountStoreTemp,
+      std::vector<Address>* addresses = nullptr);
 
   static bool GetMbInfoHash(const std::vector<MicroBlockInfo>& mbInfos,
                             MBInfoHash& dst);
@@ -262,6 +264,7 @@ class Messenger {
       const std::vector<unsigned char>& blockHash, const uint16_t leaderID,
       const PubKey& leaderKey, TxBlock& txBlock,
       std::shared_ptr<MicroBlock>& microBlock,
+      std::vector<uint64_t>& shortTxnIds,
       std::vector<unsigned char>& messageToCosign);
 
   static bool SetDSVCBlockAnnouncement(
@@ -330,6 +333,15 @@ class Messenger {
       const std::pair<PrivKey, PubKey>& lookupKey,
       const std::vector<Transaction>& txnsCurrent,
       const std::vector<Transaction>& txnsGenerated);
+  /// Same as above, but takes the generated txns already serialized by
+  /// SetTransaction (e.g., straight out of a TxnCorpus mapping) and copies
+  /// them into the message without decoding them.
+  static bool SetNodeForwardTxnBlock(
+      std::vector<unsigned char>& dst, const unsigned int offset,
+      const uint64_t epochNumber, const uint32_t shardId,
+      const std::pair<PrivKey, PubKey>& lookupKey,
+      const std::vector<Transaction>& txnsCurrent,
+      const std::vector<TxnCorpus::Span>& txnsGenerated);
   static bool GetNodeForwardTxnBlock(const std::vector<unsigned char>& src,
                                      const unsigned int offset,
                                      uint64_t& epochNumber, uint32_t& shardId,
@@ -348,6 +360,7 @@ class Messenger {
       const uint32_t consensusID, const uint64_t blockNumber,
       const std::vector<unsigned char>& blockHash, const uint16_t leaderID,
       const PubKey& leaderKey, MicroBlock& microBlock,
+      std::vector<uint64_t>& shortTxnIds,
       std::vector<unsigned char>& messageToCosign);
 
   static bool SetNodeFallbackBlockAnnouncement(
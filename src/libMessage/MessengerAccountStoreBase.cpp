@@ -19,6 +19,7 @@
 
 #include "MessengerAccountStoreBase.h"
 #include "libData/AccountData/AccountStore.h"
+#include "libMessage/ProtoArena.h"
 #include "libMessage/ZilliqaMessage.pb.h"
 #include "libUtils/Logger.h"
 
@@ -85,7 +86,8 @@ template <class MAP>
 bool MessengerAccountStoreBase::GetAccountStore(
     const vector<unsigned char>& src, const unsigned int offset,
     MAP& addressToAccount) {
-  ProtoAccountStore result;
+  ProtoArenaScope arena;
+  ProtoAccountStore& result = arena.Create<ProtoAccountStore>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -111,7 +113,7 @@ bool MessengerAccountStoreBase::GetAccountStore(
       return false;
     }
 
-    addressToAccount[address] = account;
+    addressToAccount[address] = move(account);
   }
 
   return true;
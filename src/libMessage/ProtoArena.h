@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#ifndef __PROTOARENA_H__
+#define __PROTOARENA_H__
+
+#include <google/protobuf/arena.h>
+#include <memory>
+#include <vector>
+
+/// Allocates the protobuf messages of one decode on a per-thread arena.
+/// Everything allocated on it is released at once when the outermost scope on
+/// the thread ends. The arena's initial block is kept between decodes and is
+/// grown to the largest decode seen (up to MAX_BLOCK_SIZE), so a handler
+/// thread that keeps decoding messages of similar size stops hitting the heap
+/// for protobuf objects after the first few messages.
+class ProtoArenaScope {
+  static const size_t INITIAL_BLOCK_SIZE = 64 * 1024;
+  static const size_t MAX_BLOCK_SIZE = 1024 * 1024;
+
+  struct ThreadArena {
+    std::vector<char> block;
+    std::unique_ptr<google::protobuf::Arena> arena;
+    unsigned int depth = 0;
+
+    void Rebuild(size_t size) {
+      arena.reset();
+      block.resize(size);
+      arena.reset(new google::protobuf::Arena(block.data(), block.size()));
+    }
+  };
+
+  static ThreadArena& GetThreadArena() {
+    static thread_local ThreadArena threadArena;
+    return threadArena;
+  }
+
+ public:
+  ProtoArenaScope() {
+    ThreadArena& threadArena = GetThreadArena();
+    if (!threadArena.arena) {
+      threadArena.Rebuild(INITIAL_BLOCK_SIZE);
+    }
+    threadArena.depth++;
+  }
+
+  ~ProtoArenaScope() {
+    ThreadArena& threadArena = GetThreadArena();
+    if (--threadArena.depth > 0) {
+      return;
+    }
+
+    size_t allocated = threadArena.arena->SpaceAllocated();
+    if (allocated > threadArena.block.size() &&
+        threadArena.block.size() < MAX_BLOCK_SIZE) {
+      size_t size = threadArena.block.size();
+      while (size < allocated && size < MAX_BLOCK_SIZE) {
+        size *= 2;
+      }
+      threadArena.Rebuild(size);
+    } else {
+      threadArena.arena->Reset();
+    }
+  }
+
+  ProtoArenaScope(const ProtoArenaScope&) = delete;
+  ProtoArenaScope& operator=(const ProtoArenaScope&) = delete;
+
+  /// Returns a new message that lives until the outermost scope ends.
+  template <class T>
+  T& Create() {
+    return *google::protobuf::Arena::CreateMessage<T>(
+        GetThreadArena().arena.get());
+  }
+};
+
+#endif  // __PROTOARENA_H__
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#include <algorithm>
+
+#include "ChunkedBroadcast.h"
+#include "common/Constants.h"
+#include "common/Serializable.h"
+#include "libCrypto/Sha2.h"
+#include "libUtils/Logger.h"
+#include "libUtils/ReedSolomon.h"
+
+using namespace std;
+
+namespace {
+const unsigned int HASH_LEN = 32;
+const unsigned int INDEX_OFFSET = HASH_LEN;
+const unsigned int DATA_SHARDS_OFFSET = INDEX_OFFSET + 1;
+const unsigned int NUM_SHARDS_OFFSET = DATA_SHARDS_OFFSET + 1;
+const unsigned int SIZE_OFFSET = NUM_SHARDS_OFFSET + 1;
+const unsigned int MESSAGE_HASH_OFFSET = SIZE_OFFSET + sizeof(uint32_t);
+const unsigned int SHARD_HASHES_OFFSET = MESSAGE_HASH_OFFSET + HASH_LEN;
+
+vector<unsigned char> GetHash(const vector<unsigned char>& src,
+                              unsigned int offset, unsigned int size) {
+  SHA2<HASH_TYPE::HASH_VARIANT_256> sha256;
+  sha256.Update(src, offset, size);
+  return sha256.Finalize();
+}
+}  // namespace
+
+bool ChunkedBroadcast::MakeChunks(const vector<unsigned char>& message,
+                                  unsigned int dataShards,
+                                  unsigned int parityShards,
+                                  vector<vector<unsigned char>>& chunks) {
+  if (dataShards + parityShards > MAX_SHARDS) {
+    LOG_GENERAL(WARNING, "Too many shards " << dataShards << " + "
+                                            << parityShards);
+    return false;
+  }
+
+  vector<vector<unsigned char>> shards;
+  if (!ReedSolomon::Encode(message, dataShards, parityShards, shards)) {
+    return false;
+  }
+
+  // The header is the same for every chunk but for the index
+  vector<unsigned char> header(SHARD_HASHES_OFFSET);
+  header.at(DATA_SHARDS_OFFSET) = dataShards;
+  header.at(NUM_SHARDS_OFFSET) = shards.size();
+  Serializable::SetNumber<uint32_t>(header, SIZE_OFFSET, message.size(),
+                                    sizeof(uint32_t));
+  const vector<unsigned char> messageHash =
+      GetHash(message, 0, message.size());
+  copy(messageHash.begin(), messageHash.end(),
+       header.begin() + MESSAGE_HASH_OFFSET);
+  for (const auto& shard : shards) {
+    const vector<unsigned char> shardHash = GetHash(shard, 0, shard.size());
+    header.insert(header.end(), shardHash.begin(), shardHash.end());
+  }
+  const vector<unsigned char> setId =
+      GetHash(header, DATA_SHARDS_OFFSET, header.size() - DATA_SHARDS_OFFSET);
+  copy(setId.begin(), setId.end(), header.begin());
+
+  chunks.clear();
+  for (unsigned int i = 0; i < shards.size(); i++) {
+    vector<unsigned char> chunk(header);
+    chunk.at(INDEX_OFFSET) = i;
+    chunk.insert(chunk.end(), shards[i].begin(), shards[i].end());
+    chunks.emplace_back(move(chunk));
+  }
+
+  return true;
+}
+
+bool ChunkedBroadcast::AddChunk(const vector<unsigned char>& chunk,
+                                vector<unsigned char>& message) {
+  if (chunk.size() <= FIXED_HEADER_LEN) {
+    LOG_GENERAL(WARNING, "Chunk too short (" << chunk.size() << " bytes)");
+    return false;
+  }
+
+  const vector<unsigned char> setId(chunk.begin(), chunk.begin() + HASH_LEN);
+  const unsigned int index = chunk.at(INDEX_OFFSET);
+  const unsigned int dataShards = chunk.at(DATA_SHARDS_OFFSET);
+  const unsigned int numShards = chunk.at(NUM_SHARDS_OFFSET);
+  const uint32_t size =
+      Serializable::GetNumber<uint32_t>(chunk, SIZE_OFFSET, sizeof(uint32_t));
+  const size_t headerLen = FIXED_HEADER_LEN + (size_t)numShards * HASH_LEN;
+
+  if ((dataShards == 0) || (dataShards > numShards) || (index >= numShards) ||
+      (size > (size_t)P2P_MAX_DECOMPRESSED_SIZE_MB * 1024 * 1024) ||
+      (chunk.size() - headerLen !=
+       max<size_t>(1, (size + dataShards - 1) / dataShards))) {
+    LOG_GENERAL(WARNING, "Malformed chunk header");
+    return false;
+  }
+
+  // A chunk is only taken into the set that its header and shard hash to, so
+  // a forged chunk can neither change the set nor slip in a bad shard
+  if ((GetHash(chunk, DATA_SHARDS_OFFSET, headerLen - DATA_SHARDS_OFFSET) !=
+       setId) ||
+      !equal(chunk.begin() + SHARD_HASHES_OFFSET + index * HASH_LEN,
+             chunk.begin() + SHARD_HASHES_OFFSET + (index + 1) * HASH_LEN,
+             GetHash(chunk, headerLen, chunk.size() - headerLen).begin())) {
+    LOG_GENERAL(WARNING, "Chunk does not match its set ID");
+    return false;
+  }
+
+  lock_guard<mutex> g(m_mutexAssemblies);
+
+  auto it = m_assemblies.find(setId);
+  if (it == m_assemblies.end()) {
+    Assembly assembly;
+    assembly.dataShards = dataShards;
+    assembly.size = size;
+    assembly.messageHash.assign(chunk.begin() + MESSAGE_HASH_OFFSET,
+                                chunk.begin() + SHARD_HASHES_OFFSET);
+    assembly.shards.resize(numShards);
+    assembly.received = 0;
+    assembly.done = false;
+    assembly.firstSeen = chrono::system_clock::now();
+    it = m_assemblies.emplace(setId, move(assembly)).first;
+  }
+
+  Assembly& assembly = it->second;
+  if (assembly.done || !assembly.shards[index].empty()) {
+    return false;
+  }
+
+  assembly.shards[index].assign(chunk.begin() + headerLen, chunk.end());
+  if (++assembly.received < dataShards) {
+    return false;
+  }
+
+  vector<unsigned char> rebuilt;
+  if (!ReedSolomon::Decode(assembly.shards, dataShards, size, rebuilt) ||
+      (GetHash(rebuilt, 0, rebuilt.size()) != assembly.messageHash)) {
+    // Only the originator can have made such a set; keep collecting, as
+    // other shards may still rebuild the message
+    LOG_GENERAL(WARNING, "Chunks do not rebuild the message, dropping shard "
+                             << index);
+    assembly.shards[index].clear();
+    assembly.received--;
+    return false;
+  }
+
+  // Whatever arrives later is only relayed
+  assembly.done = true;
+  assembly.shards.clear();
+  assembly.shards.shrink_to_fit();
+  message = move(rebuilt);
+
+  return true;
+}
+
+void ChunkedBroadcast::Expire(chrono::seconds expiry) {
+  const auto cutoff = chrono::system_clock::now() - expiry;
+
+  lock_guard<mutex> g(m_mutexAssemblies);
+  for (auto it = m_assemblies.begin(); it != m_assemblies.end();) {
+    if (it->second.firstSeen < cutoff) {
+      it = m_assemblies.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
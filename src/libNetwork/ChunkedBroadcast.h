@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#ifndef __CHUNKEDBROADCAST_H__
+#define __CHUNKEDBROADCAST_H__
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+
+/// Splits large broadcast messages into Reed-Solomon coded chunks, and puts
+/// them back together on the receiving side once any dataShards chunks of a
+/// message have arrived.
+class ChunkedBroadcast {
+  struct Assembly {
+    unsigned int dataShards;
+    uint32_t size;
+    std::vector<unsigned char> messageHash;
+    std::vector<std::vector<unsigned char>> shards;
+    unsigned int received;
+    bool done;
+    std::chrono::time_point<std::chrono::system_clock> firstSeen;
+  };
+
+  std::map<std::vector<unsigned char>, Assembly> m_assemblies;
+  std::mutex m_mutexAssemblies;
+
+ public:
+  /// Chunk layout: [32-byte set ID] [1-byte index] [1-byte data shards]
+  /// [1-byte total shards] [4-byte message size] [32-byte message hash]
+  /// [32-byte hash of each shard] [shard]
+  /// The set ID is the hash of everything between the index and the shard,
+  /// so it binds each chunk to the header and shards of the whole message.
+  static const unsigned int FIXED_HEADER_LEN = 32 + 1 + 1 + 1 + 4 + 32;
+
+  /// Upper bound on data + parity shards, as it has to fit in one byte.
+  static const unsigned int MAX_SHARDS = 255;
+
+  /// Encodes the message into dataShards + parityShards chunks.
+  static bool MakeChunks(const std::vector<unsigned char>& message,
+                         unsigned int dataShards, unsigned int parityShards,
+                         std::vector<std::vector<unsigned char>>& chunks);
+
+  /// Stores a received chunk if it belongs to its set. Returns true exactly
+  /// once per message, when enough chunks have arrived to rebuild and verify
+  /// it.
+  bool AddChunk(const std::vector<unsigned char>& chunk,
+                std::vector<unsigned char>& message);
+
+  /// Drops the partially received messages older than the expiry.
+  void Expire(std::chrono::seconds expiry);
+};
+
+#endif  // __CHUNKEDBROADCAST_H__
@@ -29,18 +29,23 @@
 #include <stdint.h>
 #include <sys/socket.h>
 #include <unistd.h>
+#include <algorithm>
 #include <cstring>
 #include <memory>
+#include <random>
 
 #include "Blacklist.h"
+#include "ChunkedBroadcast.h"
 #include "P2PComm.h"
 #include "PeerStore.h"
 #include "common/Messages.h"
 #include "libCrypto/Sha2.h"
+#include "libUtils/Compression.h"
 #include "libUtils/DataConversion.h"
 #include "libUtils/DetachedFunction.h"
 #include "libUtils/JoinableFunction.h"
 #include "libUtils/Logger.h"
+#include "libUtils/Metrics.h"
 
 using namespace std;
 using namespace boost::multiprecision;
@@ -48,14 +53,24 @@ using namespace boost::multiprecision;
 const unsigned char START_BYTE_NORMAL = 0x11;
 const unsigned char START_BYTE_BROADCAST = 0x22;
 const unsigned char START_BYTE_GOSSIP = 0x33;
+const unsigned char START_BYTE_TREE = 0x44;
+const unsigned char START_BYTE_CHUNK = 0x55;
+const unsigned char START_BYTE_COMPRESSED = 0x80;
 const unsigned int HDR_LEN = 6;
 const unsigned int HASH_LEN = 32;
+const unsigned int TREE_FANOUT_LEN = 1;
+const unsigned int TREE_COUNT_LEN = 4;
+const unsigned int TREE_PEER_LEN = IP_SIZE + PORT_SIZE;
+const unsigned int TREE_SIG_LEN =
+    PUB_KEY_SIZE + SIGNATURE_CHALLENGE_SIZE + SIGNATURE_RESPONSE_SIZE;
+const unsigned int TREE_DIGEST_COUNT_LEN = 4;
 const unsigned int GOSSIP_MSGTYPE_LEN = 1;
 const unsigned int GOSSIP_ROUND_LEN = 4;
 const unsigned int GOSSIP_SNDR_LISTNR_PORT_LEN = 4;
 
 P2PComm::Dispatcher P2PComm::m_dispatcher;
 P2PComm::BroadcastListFunc P2PComm::m_broadcast_list_retriever;
+P2PComm::OriginatorListFunc P2PComm::m_originator_list_retriever;
 
 /// Comparison operator for ordering the list of message hashes.
 struct hash_compare {
@@ -72,6 +87,28 @@ static void close_socket(int* cli_sock) {
   }
 }
 
+// Raised before each push to the send queue, as the send thread may pop and
+// lower it straight away
+static MetricGauge& GetSendQueueDepth() {
+  static MetricGauge& gauge = Metrics::GetInstance().GetGauge(
+      "zilliqa_send_queue_depth", "Messages waiting in the P2P send queue");
+  return gauge;
+}
+
+static MetricCounter& GetCompressionInputBytes() {
+  static MetricCounter& counter = Metrics::GetInstance().GetCounter(
+      "zilliqa_p2p_compression_input_bytes_total",
+      "Bytes of outgoing messages before compression");
+  return counter;
+}
+
+static MetricCounter& GetCompressionOutputBytes() {
+  static MetricCounter& counter = Metrics::GetInstance().GetCounter(
+      "zilliqa_p2p_compression_output_bytes_total",
+      "Bytes of outgoing messages after compression");
+  return counter;
+}
+
 static bool comparePairSecond(
     const pair<vector<unsigned char>, chrono::time_point<chrono::system_clock>>&
         a,
@@ -86,6 +123,8 @@ P2PComm::P2PComm() : m_sendQueue(SENDQUEUE_SIZE) {
 
     while (true) {
       this_thread::sleep_for(chrono::seconds(BROADCAST_INTERVAL));
+      m_chunkedBroadcast.Expire(chrono::seconds(BROADCAST_EXPIRY));
+
       lock(m_broadcastToRemoveMutex, m_broadcastHashesMutex);
       lock_guard<mutex> g(m_broadcastToRemoveMutex, adopt_lock);
       lock_guard<mutex> g2(m_broadcastHashesMutex, adopt_lock);
@@ -104,6 +143,7 @@ P2PComm::P2PComm() : m_sendQueue(SENDQUEUE_SIZE) {
 
       for (auto it = m_broadcastToRemove.begin(); it != up; ++it) {
         m_broadcastHashes.erase(it->first);
+        m_unrelayedHashes.erase(it->first);
       }
 
       m_broadcastToRemove.erase(m_broadcastToRemove.begin(), up);
@@ -220,10 +260,31 @@ bool SendJob::SendMessageSocketCore(const Peer& peer,
     // 0x33 - start byte (report)
     // 0x00 0x00 0x00 0x01 - 4-byte length of message
     // 0x00
+
+    // 0x01 ~ 0xFF - version, defined in constant file
+    // 0x44 - start byte (tree broadcast)
+    // 0xLL 0xLL 0xLL 0xLL - 4-byte length of hash + subtree + layout + message
+    // <32-byte hash> <1-byte fanout> <4-byte peer count> <20-byte peers>
+    // <33-byte originator key> <64-byte signature> <4-byte digest count>
+    // <32-byte subtree digests> <message>
+
+    // 0x01 ~ 0xFF - version, defined in constant file
+    // 0x55 - start byte (erasure-coded chunk, sent like a tree broadcast)
+    // 0xLL 0xLL 0xLL 0xLL - 4-byte length of hash + subtree + layout + chunk
+    // <32-byte hash> <1-byte fanout> <4-byte peer count> <20-byte peers>
+    // <33-byte originator key> <64-byte signature> <4-byte digest count>
+    // <32-byte subtree digests> <chunk>
+
+    // 0x91 / 0xA2 / 0xC4 / 0xD5 - start byte with the compressed flag set
+    // <message> (after the hash or subtree, if any) is a zstd frame
     uint32_t length = message.size();
+    const unsigned char plainStartByte = start_byte & ~START_BYTE_COMPRESSED;
+    const bool hasPrefix = (plainStartByte == START_BYTE_BROADCAST) ||
+                           (plainStartByte == START_BYTE_TREE) ||
+                           (plainStartByte == START_BYTE_CHUNK);
 
-    if (start_byte == START_BYTE_BROADCAST) {
-      length += HASH_LEN;
+    if (hasPrefix) {
+      length += msg_hash.size();
     }
 
     unsigned char buf[HDR_LEN] = {(unsigned char)(MSG_VERSION & 0xFF),
@@ -237,17 +298,18 @@ bool SendJob::SendMessageSocketCore(const Peer& peer,
       LOG_GENERAL(INFO, "DEBUG: not written_length == " << HDR_LEN);
     }
 
-    if (start_byte != START_BYTE_BROADCAST) {
+    if (!hasPrefix) {
       writeMsg(&message.at(0), cli_sock, peer, length);
       return true;
     }
 
-    if (HASH_LEN != writeMsg(&msg_hash.at(0), cli_sock, peer, HASH_LEN)) {
+    if (msg_hash.size() !=
+        writeMsg(&msg_hash.at(0), cli_sock, peer, msg_hash.size())) {
       LOG_GENERAL(WARNING, "Wrong message hash length.");
       return false;
     }
 
-    length -= HASH_LEN;
+    length -= msg_hash.size();
     writeMsg(&message.at(0), cli_sock, peer, length);
   } catch (const std::exception& e) {
     LOG_GENERAL(WARNING, "Error with write socket." << ' ' << e.what());
@@ -256,7 +318,7 @@ bool SendJob::SendMessageSocketCore(const Peer& peer,
   return true;
 }
 
-void SendJob::SendMessageCore(const Peer& peer,
+bool SendJob::SendMessageCore(const Peer& peer,
                               const vector<unsigned char> message,
                               unsigned char startbyte,
                               const vector<unsigned char> hash) {
@@ -270,11 +332,36 @@ void SendJob::SendMessageCore(const Peer& peer,
     if (retry_counter > MAXRETRYCONN) {
       LOG_GENERAL(WARNING,
                   "Socket connect failed over " << MAXRETRYCONN << " times.");
-      return;
+      return false;
     }
     this_thread::sleep_for(
         chrono::milliseconds(rand() % PUMPMESSAGE_MILLISECONDS + 1));
   }
+  return true;
+}
+
+unsigned char SendJob::CompressMessage(vector<unsigned char>& message,
+                                       unsigned char startbyte) {
+  if ((P2P_COMPRESSION_THRESHOLD == 0) ||
+      (message.size() < P2P_COMPRESSION_THRESHOLD) ||
+      ((startbyte != START_BYTE_NORMAL) &&
+       (startbyte != START_BYTE_BROADCAST) && (startbyte != START_BYTE_TREE) &&
+       (startbyte != START_BYTE_CHUNK))) {
+    return startbyte;
+  }
+
+  vector<unsigned char> compressed;
+  if (!Compression::Compress(message.data(), message.size(),
+                             P2P_COMPRESSION_LEVEL, compressed) ||
+      (compressed.size() >= message.size())) {
+    return startbyte;
+  }
+
+  GetCompressionInputBytes().Increment(message.size());
+  GetCompressionOutputBytes().Increment(compressed.size());
+
+  message = move(compressed);
+  return startbyte | START_BYTE_COMPRESSED;
 }
 
 void SendJobPeer::DoSend() {
@@ -285,7 +372,8 @@ void SendJobPeer::DoSend() {
     return;
   }
 
-  SendMessageCore(m_peer, m_message, m_startbyte, m_hash);
+  const unsigned char startbyte = CompressMessage(m_message, m_startbyte);
+  SendMessageCore(m_peer, m_message, startbyte, m_hash);
 }
 
 template <class T>
@@ -297,6 +385,9 @@ void SendJobPeers<T>::DoSend() {
   }
   random_shuffle(indexes.begin(), indexes.end());
 
+  // Compressed once for all the peers
+  const unsigned char startbyte = CompressMessage(m_message, m_startbyte);
+
   if ((m_startbyte == START_BYTE_BROADCAST) && (m_selfPeer != Peer())) {
     LOG_STATE(
         "[BROAD][" << std::setw(15) << std::left
@@ -317,7 +408,7 @@ void SendJobPeers<T>::DoSend() {
       continue;
     }
 
-    SendMessageCore(peer, m_message, m_startbyte, m_hash);
+    SendMessageCore(peer, m_message, startbyte, m_hash);
   }
 
   if ((m_startbyte == START_BYTE_BROADCAST) && (m_selfPeer != Peer())) {
@@ -329,6 +420,110 @@ void SendJobPeers<T>::DoSend() {
   }
 }
 
+void SendJobTree::SplitTree(const vector<Peer>& peers, unsigned int fanout,
+                            deque<vector<Peer>>& groups) {
+  const size_t numGroups = min((size_t)fanout, peers.size());
+  size_t begin = 0;
+
+  for (size_t i = 0; i < numGroups; i++) {
+    const size_t end = begin + (peers.size() - begin) / (numGroups - i);
+    groups.emplace_back(peers.begin() + begin, peers.begin() + end);
+    begin = end;
+  }
+}
+
+static vector<unsigned char> GetSubtreeDigest(const vector<Peer>& subtree) {
+  vector<unsigned char> serialized(subtree.size() * TREE_PEER_LEN);
+  unsigned int curr_offset = 0;
+  for (const auto& peer : subtree) {
+    curr_offset += peer.Serialize(serialized, curr_offset);
+  }
+
+  SHA2<HASH_TYPE::HASH_VARIANT_256> sha256;
+  sha256.Update(serialized);
+  return sha256.Finalize();
+}
+
+void SendJobTree::GetSubtreeDigests(const vector<Peer>& peers,
+                                    unsigned int fanout,
+                                    vector<vector<unsigned char>>& digests) {
+  deque<vector<Peer>> groups;
+  SplitTree(peers, fanout, groups);
+
+  for (const auto& group : groups) {
+    const vector<Peer> subtree(group.begin() + 1, group.end());
+    if (!subtree.empty()) {
+      digests.emplace_back(GetSubtreeDigest(subtree));
+      GetSubtreeDigests(subtree, fanout, digests);
+    }
+  }
+}
+
+void SendJobTree::DoSend() {
+  // Compressed once for all the children
+  const unsigned char startbyte = CompressMessage(m_message, m_startbyte);
+
+  if (m_selfPeer != Peer()) {
+    LOG_STATE(
+        "[BROAD][" << std::setw(15) << std::left
+                   << m_selfPeer.GetPrintableIPAddress() << "]["
+                   << DataConversion::Uint8VecToHexStr(m_hash).substr(0, 6)
+                   << "] BEGN");
+  }
+
+  deque<vector<Peer>> groups;
+  SplitTree(m_peers, m_fanout, groups);
+
+  while (!groups.empty()) {
+    const vector<Peer> group = move(groups.front());
+    groups.pop_front();
+
+    const Peer& child = group.front();
+    const vector<Peer> subtree(group.begin() + 1, group.end());
+
+    if (Blacklist::GetInstance().Exist(child.m_ipAddress)) {
+      LOG_GENERAL(INFO, "The node "
+                            << child
+                            << " is in black list, block all message to it.");
+    } else {
+      // Prefix = [hash][fanout][peer count][subtree peers][layout signature]
+      vector<unsigned char> prefix(m_hash);
+      prefix.resize(HASH_LEN + TREE_FANOUT_LEN + TREE_COUNT_LEN +
+                    subtree.size() * TREE_PEER_LEN);
+      unsigned int curr_offset = HASH_LEN;
+      prefix.at(curr_offset) = min(m_fanout, (unsigned int)UINT8_MAX);
+      curr_offset += TREE_FANOUT_LEN;
+      Serializable::SetNumber<uint32_t>(prefix, curr_offset, subtree.size(),
+                                        TREE_COUNT_LEN);
+      curr_offset += TREE_COUNT_LEN;
+      for (const auto& peer : subtree) {
+        curr_offset += peer.Serialize(prefix, curr_offset);
+      }
+      prefix.insert(prefix.end(), m_layoutSignature.begin(),
+                    m_layoutSignature.end());
+
+      if (SendMessageCore(child, m_message, startbyte, prefix)) {
+        continue;
+      }
+    }
+
+    // The child timed out, so its subtree is served from here instead
+    if (!subtree.empty()) {
+      LOG_GENERAL(INFO, "Taking over the " << subtree.size()
+                                           << " peers under " << child);
+      SplitTree(subtree, m_fanout, groups);
+    }
+  }
+
+  if (m_selfPeer != Peer()) {
+    LOG_STATE(
+        "[BROAD][" << std::setw(15) << std::left
+                   << m_selfPeer.GetPrintableIPAddress() << "]["
+                   << DataConversion::Uint8VecToHexStr(m_hash).substr(0, 6)
+                   << "] DONE");
+  }
+}
+
 void P2PComm::ProcessSendJob(SendJob* job) {
   auto funcSendMsg = [job]() mutable -> void {
     job->DoSend();
@@ -344,6 +539,221 @@ void P2PComm::ClearBroadcastHashAsync(
   m_broadcastToRemove.emplace_back(message_hash, chrono::system_clock::now());
 }
 
+bool P2PComm::SignTreeLayout(const vector<Peer>& peers, unsigned int fanout,
+                             const vector<unsigned char>& msg_hash,
+                             vector<unsigned char>& layoutSignature) {
+  vector<vector<unsigned char>> digests;
+  if (m_hasSelfKey) {
+    SendJobTree::GetSubtreeDigests(peers, fanout, digests);
+  }
+
+  // Signed = [hash][fanout][subtree digests]
+  vector<unsigned char> signedLayout(msg_hash);
+  signedLayout.emplace_back(min(fanout, (unsigned int)UINT8_MAX));
+  for (const auto& digest : digests) {
+    signedLayout.insert(signedLayout.end(), digest.begin(), digest.end());
+  }
+
+  // Layout signature = [key][signature][digest count][subtree digests]
+  layoutSignature.assign(TREE_SIG_LEN + TREE_DIGEST_COUNT_LEN, 0);
+  Serializable::SetNumber<uint32_t>(layoutSignature, TREE_SIG_LEN,
+                                    digests.size(), TREE_DIGEST_COUNT_LEN);
+  layoutSignature.insert(layoutSignature.end(),
+                         signedLayout.begin() + HASH_LEN + TREE_FANOUT_LEN,
+                         signedLayout.end());
+
+  if (!m_hasSelfKey) {
+    return false;
+  }
+
+  Signature signature;
+  if (!Schnorr::GetInstance().Sign(signedLayout, m_selfKey.first,
+                                   m_selfKey.second, signature)) {
+    return false;
+  }
+  m_selfKey.second.Serialize(layoutSignature, 0);
+  signature.Serialize(layoutSignature, PUB_KEY_SIZE);
+
+  return true;
+}
+
+bool P2PComm::IsTreeLayoutSigned(const vector<Peer>& subtree,
+                                 unsigned char fanout,
+                                 const vector<unsigned char>& msg_hash,
+                                 const vector<unsigned char>& layoutSignature) {
+  if (!m_originator_list_retriever) {
+    return false;
+  }
+
+  PubKey originator;
+  if (originator.Deserialize(layoutSignature, 0) != 0) {
+    return false;
+  }
+
+  const vector<PubKey> originators = m_originator_list_retriever();
+  if (find(originators.begin(), originators.end(), originator) ==
+      originators.end()) {
+    return false;
+  }
+
+  // The subtree handed to this node has to be one that the originator laid out
+  const vector<unsigned char> digest = GetSubtreeDigest(subtree);
+  bool found = false;
+  for (size_t i = TREE_SIG_LEN + TREE_DIGEST_COUNT_LEN;
+       !found && (i + HASH_LEN <= layoutSignature.size()); i += HASH_LEN) {
+    found = equal(digest.begin(), digest.end(), layoutSignature.begin() + i);
+  }
+  if (!found) {
+    return false;
+  }
+
+  vector<unsigned char> signedLayout(msg_hash);
+  signedLayout.emplace_back(fanout);
+  signedLayout.insert(signedLayout.end(),
+                      layoutSignature.begin() + TREE_SIG_LEN +
+                          TREE_DIGEST_COUNT_LEN,
+                      layoutSignature.end());
+
+  Signature signature;
+  if (signature.Deserialize(layoutSignature, PUB_KEY_SIZE) != 0) {
+    return false;
+  }
+
+  return Schnorr::GetInstance().Verify(signedLayout, signature, originator);
+}
+
+bool P2PComm::ReadMessage(struct evbuffer* input,
+                          vector<unsigned char>& message) {
+  size_t len = evbuffer_get_length(input);
+  if (len == 0) {
+    LOG_GENERAL(WARNING, "evbuffer_get_length failure.");
+    return false;
+  }
+
+  unsigned char startByte = 0;
+  if (len > HDR_LEN) {
+    evbuffer_ptr pos;
+    evbuffer_ptr_set(input, &pos, 1, EVBUFFER_PTR_SET);
+    evbuffer_copyout_from(input, &pos, &startByte, 1);
+  }
+
+  if (!(startByte & START_BYTE_COMPRESSED)) {
+    message.resize(len);
+    if (evbuffer_copyout(input, message.data(), len) !=
+        static_cast<ev_ssize_t>(len)) {
+      LOG_GENERAL(WARNING, "evbuffer_copyout failure.");
+      return false;
+    }
+    if (evbuffer_drain(input, len) != 0) {
+      LOG_GENERAL(WARNING, "evbuffer_drain failure.");
+      return false;
+    }
+    return true;
+  }
+
+  // Compressed frame: only the header (and the hash, for broadcast) is copied
+  // out, the rest is decompressed straight from the buffer chain
+
+  // Reads the 4-byte count that ends the prefix so far
+  auto getPrefixCount = [input, len](size_t prefixLen) -> size_t {
+    if (len <= prefixLen) {
+      return 0;
+    }
+    unsigned char count[TREE_COUNT_LEN];
+    evbuffer_ptr pos;
+    evbuffer_ptr_set(input, &pos, prefixLen - TREE_COUNT_LEN,
+                     EVBUFFER_PTR_SET);
+    evbuffer_copyout_from(input, &pos, count, TREE_COUNT_LEN);
+    return (size_t)((count[0] << 24) + (count[1] << 16) + (count[2] << 8) +
+                    count[3]);
+  };
+
+  const unsigned char plainStartByte = startByte & ~START_BYTE_COMPRESSED;
+  size_t prefixLen = HDR_LEN;
+  if (plainStartByte == START_BYTE_BROADCAST) {
+    prefixLen += HASH_LEN;
+  } else if ((plainStartByte == START_BYTE_TREE) ||
+             (plainStartByte == START_BYTE_CHUNK)) {
+    prefixLen += HASH_LEN + TREE_FANOUT_LEN + TREE_COUNT_LEN;
+    prefixLen += getPrefixCount(prefixLen) * TREE_PEER_LEN + TREE_SIG_LEN +
+                 TREE_DIGEST_COUNT_LEN;
+    prefixLen += getPrefixCount(prefixLen) * HASH_LEN;
+  }
+  if (len <= prefixLen) {
+    LOG_GENERAL(WARNING, "Empty compressed message received.");
+    return false;
+  }
+
+  message.resize(prefixLen);
+  if (evbuffer_copyout(input, message.data(), prefixLen) !=
+      static_cast<ev_ssize_t>(prefixLen)) {
+    LOG_GENERAL(WARNING, "evbuffer_copyout failure.");
+    return false;
+  }
+
+  const uint32_t messageLength =
+      (message[2] << 24) + (message[3] << 16) + (message[4] << 8) + message[5];
+  if (messageLength != len - HDR_LEN) {
+    LOG_GENERAL(WARNING, "Incorrect message length.");
+    return false;
+  }
+
+  if (plainStartByte != START_BYTE_NORMAL) {
+    // Don't pay for decompressing a broadcast we already have, unless it may
+    // still have to be relayed
+    P2PComm& p2p = P2PComm::GetInstance();
+    vector<unsigned char> msg_hash(message.begin() + HDR_LEN,
+                                   message.begin() + HDR_LEN + HASH_LEN);
+    lock_guard<mutex> guard(p2p.m_broadcastHashesMutex);
+    if ((p2p.m_broadcastHashes.find(msg_hash) !=
+         p2p.m_broadcastHashes.end()) &&
+        (p2p.m_unrelayedHashes.find(msg_hash) ==
+         p2p.m_unrelayedHashes.end())) {
+      LOG_GENERAL(INFO, "Discarding duplicate broadcast message.");
+      return false;
+    }
+  }
+
+  evbuffer_ptr pos;
+  evbuffer_ptr_set(input, &pos, prefixLen, EVBUFFER_PTR_SET);
+  const int numChunks = evbuffer_peek(input, -1, &pos, NULL, 0);
+  vector<evbuffer_iovec> chunks(numChunks);
+  evbuffer_peek(input, -1, &pos, chunks.data(), numChunks);
+
+  // A small frame must not inflate to the absolute cap on this thread, so
+  // the output is also bounded by the compressed size
+  StreamDecompressor decompressor(
+      min({(size_t)P2P_MAX_DECOMPRESSED_SIZE_MB * 1024 * 1024,
+           (len - prefixLen) * max(P2P_MAX_COMPRESSION_RATIO, 1U),
+           (size_t)UINT32_MAX - prefixLen}));
+  for (const auto& chunk : chunks) {
+    if (!decompressor.Update(static_cast<const unsigned char*>(chunk.iov_base),
+                             chunk.iov_len, message)) {
+      LOG_GENERAL(WARNING, "Decompression of message failed.");
+      return false;
+    }
+  }
+  if (!decompressor.Finished()) {
+    LOG_GENERAL(WARNING, "Compressed message is truncated.");
+    return false;
+  }
+
+  if (evbuffer_drain(input, len) != 0) {
+    LOG_GENERAL(WARNING, "evbuffer_drain failure.");
+    return false;
+  }
+
+  // From here on the frame is handled as if it was sent uncompressed
+  const uint32_t length = message.size() - HDR_LEN;
+  message[1] = plainStartByte;
+  message[2] = (length >> 24) & 0xFF;
+  message[3] = (length >> 16) & 0xFF;
+  message[4] = (length >> 8) & 0xFF;
+  message[5] = length & 0xFF;
+
+  return true;
+}
+
 void P2PComm::EventCallback(struct bufferevent* bev, short events,
                             [[gnu::unused]] void* ctx) {
   unique_ptr<struct bufferevent, decltype(&bufferevent_free)> socket_closer(
@@ -373,19 +783,8 @@ void P2PComm::EventCallback(struct bufferevent* bev, short events,
     LOG_GENERAL(WARNING, "bufferevent_get_input failure.");
     return;
   }
-  size_t len = evbuffer_get_length(input);
-  if (len == 0) {
-    LOG_GENERAL(WARNING, "evbuffer_get_length failure.");
-    return;
-  }
-  vector<unsigned char> message(len);
-  if (evbuffer_copyout(input, message.data(), len) !=
-      static_cast<ev_ssize_t>(len)) {
-    LOG_GENERAL(WARNING, "evbuffer_copyout failure.");
-    return;
-  }
-  if (evbuffer_drain(input, len) != 0) {
-    LOG_GENERAL(WARNING, "evbuffer_drain failure.");
+  vector<unsigned char> message;
+  if (!ReadMessage(input, message)) {
     return;
   }
 
@@ -437,7 +836,8 @@ void P2PComm::EventCallback(struct bufferevent* bev, short events,
     return;
   }
 
-  if (startByte == START_BYTE_BROADCAST) {
+  if ((startByte == START_BYTE_BROADCAST) || (startByte == START_BYTE_TREE) ||
+      (startByte == START_BYTE_CHUNK)) {
     LOG_PAYLOAD(INFO, "Incoming broadcast message from " << from, message,
                 Logger::MAX_BYTES_TO_DISPLAY);
 
@@ -448,12 +848,68 @@ void P2PComm::EventCallback(struct bufferevent* bev, short events,
       return;
     }
 
+    // Tree broadcast carries the fanout and the subtree to forward to, and
+    // the originator's signature over the layout of the whole tree
+    unsigned int payloadOffset = HDR_LEN + HASH_LEN;
+    unsigned char fanout = 0;
+    vector<Peer> subtree;
+    vector<unsigned char> layoutSignature;
+
+    if (startByte != START_BYTE_BROADCAST) {
+      if (message.size() <= payloadOffset + TREE_FANOUT_LEN + TREE_COUNT_LEN) {
+        LOG_GENERAL(WARNING, "Subtree missing in tree broadcast message.");
+        return;
+      }
+
+      fanout = message.at(payloadOffset);
+      payloadOffset += TREE_FANOUT_LEN;
+      const uint32_t count = Serializable::GetNumber<uint32_t>(
+          message, payloadOffset, TREE_COUNT_LEN);
+      payloadOffset += TREE_COUNT_LEN;
+
+      if ((fanout == 0) ||
+          ((uint64_t)count * TREE_PEER_LEN >= message.size() - payloadOffset)) {
+        LOG_GENERAL(WARNING, "Incorrect subtree in tree broadcast message.");
+        return;
+      }
+
+      subtree.resize(count);
+      for (auto& peer : subtree) {
+        if (peer.Deserialize(message, payloadOffset) != 0) {
+          return;
+        }
+        payloadOffset += TREE_PEER_LEN;
+      }
+
+      if (message.size() <=
+          payloadOffset + TREE_SIG_LEN + TREE_DIGEST_COUNT_LEN) {
+        LOG_GENERAL(WARNING, "Layout missing in tree broadcast message.");
+        return;
+      }
+
+      const uint32_t numDigests = Serializable::GetNumber<uint32_t>(
+          message, payloadOffset + TREE_SIG_LEN, TREE_DIGEST_COUNT_LEN);
+      const uint64_t layoutLen = TREE_SIG_LEN + TREE_DIGEST_COUNT_LEN +
+                                 (uint64_t)numDigests * HASH_LEN;
+
+      if (layoutLen >= message.size() - payloadOffset) {
+        LOG_GENERAL(WARNING, "Incorrect layout in tree broadcast message.");
+        return;
+      }
+
+      layoutSignature.assign(message.begin() + payloadOffset,
+                             message.begin() + payloadOffset + layoutLen);
+      payloadOffset += layoutLen;
+    }
+
     vector<unsigned char> msg_hash(message.begin() + HDR_LEN,
                                    message.begin() + HDR_LEN + HASH_LEN);
 
     P2PComm& p2p = P2PComm::GetInstance();
 
-    // Check if this message has been received before
+    // Check if this message has been received before. A tree broadcast is
+    // delivered with its first copy, but only relayed once a copy with a
+    // signed layout arrives, so a forged frame cannot suppress the genuine one.
     bool found = false;
     {
       lock_guard<mutex> guard(p2p.m_broadcastHashesMutex);
@@ -463,37 +919,68 @@ void P2PComm::EventCallback(struct bufferevent* bev, short events,
       // While we have the lock, we should quickly add the hash
       if (!found) {
         SHA2<HASH_TYPE::HASH_VARIANT_256> sha256;
-        sha256.Update(message, HDR_LEN + HASH_LEN,
-                      message.size() - HDR_LEN - HASH_LEN);
+        sha256.Update(message, payloadOffset, message.size() - payloadOffset);
         vector<unsigned char> this_msg_hash = sha256.Finalize();
 
         if (this_msg_hash == msg_hash) {
           p2p.m_broadcastHashes.insert(this_msg_hash);
+          if (startByte != START_BYTE_BROADCAST) {
+            p2p.m_unrelayedHashes.insert(this_msg_hash);
+          }
         } else {
           LOG_GENERAL(WARNING, "Incorrect message hash.");
           return;
         }
+      } else if (subtree.empty() || (p2p.m_unrelayedHashes.find(msg_hash) ==
+                                     p2p.m_unrelayedHashes.end())) {
+        // We already sent and/or received this message before -> discard
+        LOG_GENERAL(INFO, "Discarding duplicate broadcast message.");
+        return;
       }
     }
 
-    if (found) {
-      // We already sent and/or received this message before -> discard
-      LOG_GENERAL(INFO, "Discarding duplicate broadcast message.");
-      return;
-    }
+    if (startByte != START_BYTE_BROADCAST) {
+      if (subtree.empty()) {
+        // Nothing to relay
+      } else if (IsTreeLayoutSigned(subtree, fanout, msg_hash,
+                                    layoutSignature)) {
+        bool relay = false;
+        {
+          lock_guard<mutex> guard(p2p.m_broadcastHashesMutex);
+          relay = (p2p.m_unrelayedHashes.erase(msg_hash) > 0);
+        }
+        if (relay) {
+          p2p.RelayTreeMessage(
+              subtree,
+              vector<unsigned char>(message.begin() + payloadOffset,
+                                    message.end()),
+              msg_hash, fanout, startByte, layoutSignature);
+        }
+      } else {
+        LOG_GENERAL(WARNING, "Not relaying tree broadcast from "
+                                 << from
+                                 << ", its layout is not signed by a known "
+                                    "originator");
+      }
 
-    unsigned char msg_type = 0xFF;
-    unsigned char ins_type = 0xFF;
-    if (messageLength - HASH_LEN > MessageOffset::INST) {
-      msg_type = message.at(HDR_LEN + HASH_LEN + MessageOffset::TYPE);
-      ins_type = message.at(HDR_LEN + HASH_LEN + MessageOffset::INST);
-    }
+      if (found) {
+        // Already delivered with the first copy
+        return;
+      }
+    } else {
+      unsigned char msg_type = 0xFF;
+      unsigned char ins_type = 0xFF;
+      if (messageLength - HASH_LEN > MessageOffset::INST) {
+        msg_type = message.at(HDR_LEN + HASH_LEN + MessageOffset::TYPE);
+        ins_type = message.at(HDR_LEN + HASH_LEN + MessageOffset::INST);
+      }
 
-    vector<Peer> broadcast_list =
-        m_broadcast_list_retriever(msg_type, ins_type, from);
+      vector<Peer> broadcast_list =
+          m_broadcast_list_retriever(msg_type, ins_type, from);
 
-    if (broadcast_list.size() > 0) {
-      p2p.RebroadcastMessage(broadcast_list, message, msg_hash);
+      if (broadcast_list.size() > 0) {
+        p2p.RebroadcastMessage(broadcast_list, message, msg_hash);
+      }
     }
 
     p2p.ClearBroadcastHashAsync(msg_hash);
@@ -503,12 +990,21 @@ void P2PComm::EventCallback(struct bufferevent* bev, short events,
                    << DataConversion::Uint8VecToHexStr(msg_hash).substr(0, 6)
                    << "] RECV");
 
+    vector<unsigned char> payload(message.begin() + payloadOffset,
+                                  message.end());
+
+    if (startByte == START_BYTE_CHUNK) {
+      // Only the rebuilt message goes up, once enough chunks are in
+      vector<unsigned char> rebuilt;
+      if (!p2p.m_chunkedBroadcast.AddChunk(payload, rebuilt)) {
+        return;
+      }
+      payload = move(rebuilt);
+    }
+
     // Move the shared_ptr message to raw pointer type
     pair<vector<unsigned char>, Peer>* raw_message =
-        new pair<vector<unsigned char>, Peer>(
-            vector<unsigned char>(message.begin() + HDR_LEN + HASH_LEN,
-                                  message.end()),
-            from);
+        new pair<vector<unsigned char>, Peer>(move(payload), from);
     LOG_GENERAL(INFO, "Size of Message: " << message.size());
 
     // Queue the message
@@ -634,7 +1130,8 @@ void P2PComm::AcceptConnectionCallback([[gnu::unused]] evconnlistener* listener,
 }
 
 void P2PComm::StartMessagePump(uint32_t listen_port_host, Dispatcher dispatcher,
-                               BroadcastListFunc broadcast_list_retriever) {
+                               BroadcastListFunc broadcast_list_retriever,
+                               OriginatorListFunc originator_list_retriever) {
   LOG_MARKER();
 
   // Launch the thread that reads messages from the send queue
@@ -642,6 +1139,7 @@ void P2PComm::StartMessagePump(uint32_t listen_port_host, Dispatcher dispatcher,
     SendJob* job = NULL;
     while (true) {
       while (m_sendQueue.pop(job)) {
+        GetSendQueueDepth().Decrement();
         ProcessSendJob(job);
       }
     }
@@ -666,6 +1164,7 @@ void P2PComm::StartMessagePump(uint32_t listen_port_host, Dispatcher dispatcher,
 
   m_dispatcher = dispatcher;
   m_broadcast_list_retriever = broadcast_list_retriever;
+  m_originator_list_retriever = originator_list_retriever;
 
   struct sockaddr_in serv_addr;
   memset(&serv_addr, 0, sizeof(struct sockaddr_in));
@@ -702,7 +1201,9 @@ void P2PComm::SendMessage(const vector<Peer>& peers,
   job->m_hash.clear();
 
   // Queue job
+  GetSendQueueDepth().Increment();
   if (!m_sendQueue.bounded_push(job)) {
+    GetSendQueueDepth().Decrement();
     LOG_GENERAL(WARNING, "SendQueue is full");
   }
 }
@@ -725,7 +1226,9 @@ void P2PComm::SendMessage(const deque<Peer>& peers,
   job->m_hash.clear();
 
   // Queue job
+  GetSendQueueDepth().Increment();
   if (!m_sendQueue.bounded_push(job)) {
+    GetSendQueueDepth().Decrement();
     LOG_GENERAL(WARNING, "SendQueue is full");
   }
 }
@@ -744,7 +1247,9 @@ void P2PComm::SendMessage(const Peer& peer,
   job->m_hash.clear();
 
   // Queue job
+  GetSendQueueDepth().Increment();
   if (!m_sendQueue.bounded_push(job)) {
+    GetSendQueueDepth().Decrement();
     LOG_GENERAL(WARNING, "SendQueue is full");
   }
 }
@@ -757,6 +1262,25 @@ void P2PComm::SendBroadcastMessage(const vector<Peer>& peers,
     return;
   }
 
+  if ((P2P_BROADCAST_TREE_FANOUT > 0) &&
+      (peers.size() > P2P_BROADCAST_TREE_FANOUT) &&
+      (P2P_CHUNKED_BROADCAST_THRESHOLD > 0) &&
+      (message.size() >= P2P_CHUNKED_BROADCAST_THRESHOLD)) {
+    SendChunkedBroadcastMessage(
+        vector<Peer>(peers.begin(), peers.end()), message,
+        min(P2P_BROADCAST_TREE_FANOUT, (unsigned int)UINT8_MAX),
+        P2P_CHUNK_DATA_SHARDS, P2P_CHUNK_PARITY_SHARDS);
+    return;
+  }
+
+  if ((P2P_BROADCAST_TREE_FANOUT > 0) &&
+      (peers.size() > P2P_BROADCAST_TREE_FANOUT)) {
+    SendTreeBroadcastMessage(
+        vector<Peer>(peers.begin(), peers.end()), message,
+        min(P2P_BROADCAST_TREE_FANOUT, (unsigned int)UINT8_MAX));
+    return;
+  }
+
   SHA2<HASH_TYPE::HASH_VARIANT_256> sha256;
   sha256.Update(message);
 
@@ -771,7 +1295,9 @@ void P2PComm::SendBroadcastMessage(const vector<Peer>& peers,
   vector<unsigned char> hashCopy(job->m_hash);
 
   // Queue job
+  GetSendQueueDepth().Increment();
   if (!m_sendQueue.bounded_push(job)) {
+    GetSendQueueDepth().Decrement();
     LOG_GENERAL(WARNING, "SendQueue is full");
   }
 
@@ -787,6 +1313,25 @@ void P2PComm::SendBroadcastMessage(const deque<Peer>& peers,
     return;
   }
 
+  if ((P2P_BROADCAST_TREE_FANOUT > 0) &&
+      (peers.size() > P2P_BROADCAST_TREE_FANOUT) &&
+      (P2P_CHUNKED_BROADCAST_THRESHOLD > 0) &&
+      (message.size() >= P2P_CHUNKED_BROADCAST_THRESHOLD)) {
+    SendChunkedBroadcastMessage(
+        vector<Peer>(peers.begin(), peers.end()), message,
+        min(P2P_BROADCAST_TREE_FANOUT, (unsigned int)UINT8_MAX),
+        P2P_CHUNK_DATA_SHARDS, P2P_CHUNK_PARITY_SHARDS);
+    return;
+  }
+
+  if ((P2P_BROADCAST_TREE_FANOUT > 0) &&
+      (peers.size() > P2P_BROADCAST_TREE_FANOUT)) {
+    SendTreeBroadcastMessage(
+        vector<Peer>(peers.begin(), peers.end()), message,
+        min(P2P_BROADCAST_TREE_FANOUT, (unsigned int)UINT8_MAX));
+    return;
+  }
+
   SHA2<HASH_TYPE::HASH_VARIANT_256> sha256;
   sha256.Update(message);
 
@@ -801,7 +1346,90 @@ void P2PComm::SendBroadcastMessage(const deque<Peer>& peers,
   vector<unsigned char> hashCopy(job->m_hash);
 
   // Queue job
+  GetSendQueueDepth().Increment();
   if (!m_sendQueue.bounded_push(job)) {
+    GetSendQueueDepth().Decrement();
+    LOG_GENERAL(WARNING, "SendQueue is full");
+  }
+
+  lock_guard<mutex> guard(m_broadcastHashesMutex);
+  m_broadcastHashes.insert(hashCopy);
+}
+
+void P2PComm::SendTreeBroadcastMessage(const vector<Peer>& peers,
+                                       const vector<unsigned char>& message,
+                                       unsigned char fanout) {
+  LOG_MARKER();
+
+  if (peers.empty() || (fanout == 0)) {
+    return;
+  }
+
+  SendTreeMessage(peers, message, fanout, START_BYTE_TREE);
+}
+
+void P2PComm::SendChunkedBroadcastMessage(const vector<Peer>& peers,
+                                          const vector<unsigned char>& message,
+                                          unsigned char fanout,
+                                          unsigned int dataShards,
+                                          unsigned int parityShards) {
+  LOG_MARKER();
+
+  if (peers.empty() || (fanout == 0)) {
+    return;
+  }
+
+  vector<vector<unsigned char>> chunks;
+  if (!ChunkedBroadcast::MakeChunks(message, dataShards, parityShards,
+                                    chunks)) {
+    LOG_GENERAL(WARNING, "Falling back to tree broadcast");
+    SendTreeMessage(peers, message, fanout, START_BYTE_TREE);
+    return;
+  }
+
+  // Every chunk goes down its own tree, so each peer is an inner node for
+  // some chunks and a leaf for the rest
+  for (const auto& chunk : chunks) {
+    SendTreeMessage(peers, chunk, fanout, START_BYTE_CHUNK);
+  }
+}
+
+void P2PComm::SendTreeMessage(const vector<Peer>& peers,
+                              const vector<unsigned char>& message,
+                              unsigned char fanout, unsigned char startByte) {
+  SHA2<HASH_TYPE::HASH_VARIANT_256> sha256;
+  sha256.Update(message);
+
+  // Make job
+  SendJobTree* job = new SendJobTree;
+  job->m_selfPeer = m_selfPeer;
+  job->m_startbyte = startByte;
+  job->m_message = message;
+  job->m_hash = sha256.Finalize();
+  job->m_fanout = fanout;
+
+  // The tree is laid over the peers in an order seeded by the message hash,
+  // so that the inner nodes differ from one broadcast to the next
+  job->m_peers = peers;
+  mt19937_64 rng(Serializable::GetNumber<uint64_t>(job->m_hash, 0,
+                                                   sizeof(uint64_t)));
+  shuffle(job->m_peers.begin(), job->m_peers.end(), rng);
+
+  // Receivers only relay what this node signed, so without a key the tree is
+  // flattened and every peer is sent to directly
+  if (!SignTreeLayout(job->m_peers, fanout, job->m_hash,
+                      job->m_layoutSignature)) {
+    LOG_GENERAL(WARNING, "Tree layout not signed, sending to all "
+                             << peers.size() << " peers directly");
+    job->m_fanout = job->m_peers.size();
+  }
+
+  vector<unsigned char> hashCopy(job->m_hash);
+
+  // Queue job
+  GetSendQueueDepth().Increment();
+  if (!m_sendQueue.bounded_push(job)) {
+    GetSendQueueDepth().Decrement();
     LOG_GENERAL(WARNING, "SendQueue is full");
   }
 
@@ -824,7 +1452,34 @@ void P2PComm::RebroadcastMessage(const vector<Peer>& peers,
   job->m_hash = msg_hash;
 
   // Queue job
+  GetSendQueueDepth().Increment();
+  if (!m_sendQueue.bounded_push(job)) {
+    GetSendQueueDepth().Decrement();
+    LOG_GENERAL(WARNING, "SendQueue is full");
+  }
+}
+
+void P2PComm::RelayTreeMessage(const vector<Peer>& subtree,
+                               const vector<unsigned char>& message,
+                               const vector<unsigned char>& msg_hash,
+                               unsigned char fanout, unsigned char startByte,
+                               const vector<unsigned char>& layoutSignature) {
+  LOG_MARKER();
+
+  // Make job
+  SendJobTree* job = new SendJobTree;
+  job->m_peers = subtree;
+  job->m_selfPeer = Peer();
+  job->m_startbyte = startByte;
+  job->m_message = message;
+  job->m_hash = msg_hash;
+  job->m_fanout = fanout;
+  job->m_layoutSignature = layoutSignature;
+
+  // Queue job
+  GetSendQueueDepth().Increment();
   if (!m_sendQueue.bounded_push(job)) {
+    GetSendQueueDepth().Decrement();
     LOG_GENERAL(WARNING, "SendQueue is full");
   }
 }
@@ -841,7 +1496,10 @@ void P2PComm::SendMessageNoQueue(const Peer& peer,
     return;
   }
 
-  SendJob::SendMessageCore(peer, message, startByteType, {});
+  vector<unsigned char> toSend(message);
+  const unsigned char startbyte =
+      SendJob::CompressMessage(toSend, startByteType);
+  SendJob::SendMessageCore(peer, toSend, startbyte, {});
 }
 
 bool P2PComm::SpreadRumor(const std::vector<unsigned char>& message) {
@@ -871,6 +1529,11 @@ void P2PComm::SendRumorToForeignPeers(
 
 void P2PComm::SetSelfPeer(const Peer& self) { m_selfPeer = self; }
 
+void P2PComm::SetSelfKey(const pair<PrivKey, PubKey>& self) {
+  m_selfKey = self;
+  m_hasSelfKey = true;
+}
+
 void P2PComm::InitializeRumorManager(const std::vector<Peer>& peers) {
   LOG_MARKER();
 
@@ -28,12 +28,15 @@
 #include <set>
 #include <vector>
 
+#include "ChunkedBroadcast.h"
 #include "Peer.h"
 #include "RumorManager.h"
 #include "common/Constants.h"
+#include "libCrypto/Schnorr.h"
 #include "libUtils/Logger.h"
 #include "libUtils/ThreadPool.h"
 
+struct evbuffer;
 struct evconnlistener;
 
 extern const unsigned char START_BYTE_NORMAL;
@@ -54,11 +57,16 @@ class SendJob {
   std::vector<unsigned char> m_message;
   std::vector<unsigned char> m_hash;
 
-  static void SendMessageCore(const Peer& peer,
+  static bool SendMessageCore(const Peer& peer,
                               const std::vector<unsigned char> message,
                               unsigned char startbyte,
                               const std::vector<unsigned char> hash);
 
+  /// Compresses the message in place if it is eligible and worth it, and
+  /// returns the start byte to send it with.
+  static unsigned char CompressMessage(std::vector<unsigned char>& message,
+                                       unsigned char startbyte);
+
   virtual ~SendJob() {}
   virtual void DoSend() = 0;
 };
@@ -76,15 +84,41 @@ class SendJobPeers : public SendJob {
   void DoSend();
 };
 
+/// Sends a broadcast down a k-ary tree. Each child is handed the peers of its
+/// subtree and forwards the message to them in turn.
+class SendJobTree : public SendJob {
+ public:
+  std::vector<Peer> m_peers;
+  unsigned int m_fanout;
+  /// The originator's signature over the tree layout, passed on unchanged.
+  std::vector<unsigned char> m_layoutSignature;
+  void DoSend();
+
+  /// Splits the peers into at most fanout groups of near-equal size. The head
+  /// of each group is a child and the rest of the group is its subtree.
+  static void SplitTree(const std::vector<Peer>& peers, unsigned int fanout,
+                        std::deque<std::vector<Peer>>& groups);
+
+  /// Appends the digest of every non-empty subtree in the tree over the peers,
+  /// in the order in which the tree is walked.
+  static void GetSubtreeDigests(
+      const std::vector<Peer>& peers, unsigned int fanout,
+      std::vector<std::vector<unsigned char>>& digests);
+};
+
 /// Provides network layer functionality.
 class P2PComm {
   std::set<std::vector<unsigned char>> m_broadcastHashes;
+  // Tree broadcasts delivered here but not yet relayed, because no copy with a
+  // signed layout has arrived. Guarded by m_broadcastHashesMutex.
+  std::set<std::vector<unsigned char>> m_unrelayedHashes;
   std::mutex m_broadcastHashesMutex;
   std::deque<std::pair<std::vector<unsigned char>,
                        std::chrono::time_point<std::chrono::system_clock>>>
       m_broadcastToRemove;
   std::mutex m_broadcastToRemoveMutex;
   RumorManager m_rumorManager;
+  ChunkedBroadcast m_chunkedBroadcast;
 
   const static uint32_t MAXPUMPMESSAGE = 128;
 
@@ -101,12 +135,27 @@ class P2PComm {
   static ShaMessage shaMessage(const std::vector<unsigned char>& message);
 
   Peer m_selfPeer;
+  std::pair<PrivKey, PubKey> m_selfKey;
+  bool m_hasSelfKey = false;
 
   ThreadPool m_SendPool{MAXMESSAGE, "SendPool"};
 
   boost::lockfree::queue<SendJob*> m_sendQueue;
   void ProcessSendJob(SendJob* job);
 
+  void SendTreeMessage(const std::vector<Peer>& peers,
+                       const std::vector<unsigned char>& message,
+                       unsigned char fanout, unsigned char startByte);
+
+  static bool ReadMessage(struct evbuffer* input,
+                          std::vector<unsigned char>& message);
+  bool SignTreeLayout(const std::vector<Peer>& peers, unsigned int fanout,
+                      const std::vector<unsigned char>& msg_hash,
+                      std::vector<unsigned char>& layoutSignature);
+  static bool IsTreeLayoutSigned(
+      const std::vector<Peer>& subtree, unsigned char fanout,
+      const std::vector<unsigned char>& msg_hash,
+      const std::vector<unsigned char>& layoutSignature);
   static void EventCallback(struct bufferevent* bev, short events, void* ctx);
   static void AcceptConnectionCallback(evconnlistener* listener,
                                        evutil_socket_t cli_sock,
@@ -123,12 +172,15 @@ class P2PComm {
   using BroadcastListFunc = std::function<std::vector<Peer>(
       unsigned char msg_type, unsigned char ins_type, const Peer&)>;
 
+  using OriginatorListFunc = std::function<std::vector<PubKey>()>;
+
   void InitializeRumorManager(const std::vector<Peer>& peers);
 
  private:
   using SocketCloser = std::unique_ptr<int, void (*)(int*)>;
   static Dispatcher m_dispatcher;
   static BroadcastListFunc m_broadcast_list_retriever;
+  static OriginatorListFunc m_originator_list_retriever;
 
  public:
   /// Accept TCP connection for libevent usage
@@ -137,9 +189,11 @@ class P2PComm {
                                struct sockaddr* cli_addr, int socklen,
                                void* arg);
 
-  /// Listens for incoming socket connections.
+  /// Listens for incoming socket connections. Tree broadcasts are only relayed
+  /// further if their layout is signed by one of the listed originators.
   void StartMessagePump(uint32_t listen_port_host, Dispatcher dispatcher,
-                        BroadcastListFunc broadcast_list_retriever);
+                        BroadcastListFunc broadcast_list_retriever,
+                        OriginatorListFunc originator_list_retriever = nullptr);
 
   /// Multicasts message to specified list of peers.
   void SendMessage(const std::vector<Peer>& peers,
@@ -163,16 +217,40 @@ class P2PComm {
   void SendBroadcastMessage(const std::deque<Peer>& peers,
                             const std::vector<unsigned char>& message);
 
+  /// Broadcasts message through a tree of the specified fanout over the list
+  /// of peers, instead of sending it to every peer directly.
+  void SendTreeBroadcastMessage(const std::vector<Peer>& peers,
+                                const std::vector<unsigned char>& message,
+                                unsigned char fanout);
+
+  /// Broadcasts message as Reed-Solomon coded chunks, each through its own
+  /// tree of the specified fanout. Receivers rebuild it from any dataShards
+  /// of the chunks.
+  void SendChunkedBroadcastMessage(const std::vector<Peer>& peers,
+                                   const std::vector<unsigned char>& message,
+                                   unsigned char fanout,
+                                   unsigned int dataShards,
+                                   unsigned int parityShards);
+
   void RebroadcastMessage(const std::vector<Peer>& peers,
                           const std::vector<unsigned char>& message,
                           const std::vector<unsigned char>& msg_hash);
 
+  void RelayTreeMessage(const std::vector<Peer>& subtree,
+                        const std::vector<unsigned char>& message,
+                        const std::vector<unsigned char>& msg_hash,
+                        unsigned char fanout, unsigned char startByte,
+                        const std::vector<unsigned char>& layoutSignature);
+
   void SendMessageNoQueue(
       const Peer& peer, const std::vector<unsigned char>& message,
       const unsigned char& startByteType = START_BYTE_NORMAL);
 
   void SetSelfPeer(const Peer& self);
 
+  /// Sets the key that signs the layout of the tree broadcasts sent from here.
+  void SetSelfKey(const std::pair<PrivKey, PubKey>& self);
+
   bool SpreadRumor(const std::vector<unsigned char>& message);
 
   void SendRumorToForeignPeer(const Peer& foreignPeer,
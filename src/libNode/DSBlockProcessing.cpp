@@ -43,6 +43,7 @@
 #include "libMessage/Messenger.h"
 #include "libNetwork/Guard.h"
 #include "libPOW/pow.h"
+#include "libServer/Server.h"
 #include "libUtils/BitVector.h"
 #include "libUtils/DataConversion.h"
 #include "libUtils/DetachedFunction.h"
@@ -79,6 +80,13 @@ void Node::StoreDSBlockToDisk(const DSBlock& dsblock) {
 
   BlockStorage::GetBlockStorage().PutDSBlock(dsblock.GetHeader().GetBlockNum(),
                                              serializedDSBlock);
+
+  if (LOOKUP_NODE_MODE) {
+    Server::CacheDSBlock(dsblock);
+    Server::AddToChainStats(dsblock);
+    Server::GetSubscriptionServer().PublishDSBlock(dsblock);
+  }
+
   m_mediator.m_ds->m_latestActiveDSBlockNum = dsblock.GetHeader().GetBlockNum();
   BlockStorage::GetBlockStorage().PutMetadata(
       LATESTACTIVEDSBLOCKNUM, DataConversion::StringToCharArray(to_string(
@@ -300,7 +300,7 @@ bool Node::ProcessFallbackBlock(const vector<unsigned char>& message,
     // consensus
     {
       lock_guard<mutex> g(m_mutexProcessedTransactions);
-      m_processedTransactions.erase(m_mediator.m_currentEpochNum);
+      m_processedTransactions.Erase(m_mediator.m_currentEpochNum);
     }
 
     CleanCreatedTransaction();
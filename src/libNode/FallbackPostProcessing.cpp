@@ -188,7 +188,7 @@ void Node::ProcessFallbackConsensusWhenDone() {
     // consensus
     {
       lock_guard<mutex> g(m_mutexProcessedTransactions);
-      m_processedTransactions.erase(m_mediator.m_currentEpochNum);
+      m_processedTransactions.Erase(m_mediator.m_currentEpochNum);
     }
 
     AccountStore::GetInstance().InitTemp();
@@ -44,6 +44,7 @@
 #include "libMediator/Mediator.h"
 #include "libMessage/Messenger.h"
 #include "libPOW/pow.h"
+#include "libPersistence/ContractStorage.h"
 #include "libServer/Server.h"
 #include "libUtils/BitVector.h"
 #include "libUtils/DataConversion.h"
@@ -65,7 +66,9 @@ void Node::StoreState() {
   AccountStore::GetInstance().MoveUpdatesToDisk();
 }
 
-void Node::StoreFinalBlock(const TxBlock& txBlock) {
+void Node::StoreFinalBlock(const TxBlock& txBlock,
+                           const vector<unsigned char>& stateDelta,
+                           bool isVacuousEpoch) {
   LOG_MARKER();
 
   AddBlock(txBlock);
@@ -83,11 +86,32 @@ void Node::StoreFinalBlock(const TxBlock& txBlock) {
                 << ", Timestamp: " << txBlock.GetTimestamp()
                 << ", NumTxs: " << txBlock.GetHeader().GetNumTxs());
 
-  // Store Tx Block to disk
+  // The block, its state delta and the epoch metadata are committed together
+  BlockStorage::Batch batch;
+
   vector<unsigned char> serializedTxBlock;
   txBlock.Serialize(serializedTxBlock, 0);
-  BlockStorage::GetBlockStorage().PutTxBlock(txBlock.GetHeader().GetBlockNum(),
-                                             serializedTxBlock);
+  BlockStorage::GetBlockStorage().PutTxBlock(
+      batch, txBlock.GetHeader().GetBlockNum(), serializedTxBlock);
+
+  BlockStorage::GetBlockStorage().PutStateDelta(
+      batch, txBlock.GetHeader().GetBlockNum(), stateDelta);
+
+  if (isVacuousEpoch) {
+    BlockStorage::GetBlockStorage().PutMetadata(
+        batch, MetaType::DSINCOMPLETED, {'0'});
+  }
+
+  if (!BlockStorage::GetBlockStorage().CommitBatch(batch)) {
+    LOG_GENERAL(WARNING, "Failed to store final block "
+                             << txBlock.GetHeader().GetBlockNum());
+  }
+
+  if (LOOKUP_NODE_MODE) {
+    Server::CacheTxBlock(txBlock);
+    Server::AddToChainStats(txBlock);
+    Server::GetSubscriptionServer().PublishTxBlock(txBlock);
+  }
 
   LOG_EPOCH(
       INFO, to_string(m_mediator.m_currentEpochNum).c_str(),
@@ -458,14 +482,12 @@ bool Node::FindTxnInProcessedTxnsList(
 
   lock_guard<mutex> g(m_mutexProcessedTransactions);
 
-  auto& processedTransactions = m_processedTransactions[blockNum];
-  // auto& committedTransactions = m_committedTransactions[blockNum];
-  const auto& txnIt = processedTransactions.find(tx_hash);
+  TransactionWithReceipt txn;
 
   // Check if transaction is part of submitted Tx list
-  if (txnIt != processedTransactions.end()) {
+  if (m_processedTransactions.Find(blockNum, tx_hash, txn)) {
     if ((sharing_mode == SEND_ONLY) || (sharing_mode == SEND_AND_FORWARD)) {
-      txns_to_send.emplace_back(txnIt->second);
+      txns_to_send.emplace_back(std::move(txn));
     }
 
     // Move entry from submitted Tx list to committed Tx list
@@ -751,9 +773,6 @@ bool Node::ProcessFinalBlock(const vector<unsigned char>& message,
   ProcessStateDeltaFromFinalBlock(stateDelta,
                                   txBlock.GetHeader().GetStateDeltaHash());
 
-  BlockStorage::GetBlockStorage().PutStateDelta(
-      txBlock.GetHeader().GetBlockNum(), stateDelta);
-
   if (!LOOKUP_NODE_MODE &&
       (!CheckStateRoot(txBlock) || m_doRejoinAtStateRoot)) {
     RejoinAsNormal();
@@ -767,7 +786,7 @@ bool Node::ProcessFinalBlock(const vector<unsigned char>& message,
             txBlock, txBlock.GetHeader().GetBlockNum(), toSendTxnToLookup)) {
       return false;
     }
-    StoreFinalBlock(txBlock);
+    StoreFinalBlock(txBlock, stateDelta, isVacuousEpoch);
   } else {
     LOG_GENERAL(INFO, "isVacuousEpoch now");
 
@@ -775,8 +794,7 @@ bool Node::ProcessFinalBlock(const vector<unsigned char>& message,
     CleanMicroblockConsensusBuffer();
 
     StoreState();
-    StoreFinalBlock(txBlock);
-    BlockStorage::GetBlockStorage().PutMetadata(MetaType::DSINCOMPLETED, {'0'});
+    StoreFinalBlock(txBlock, stateDelta, isVacuousEpoch);
   }
 
   // m_mediator.HeartBeatPulse();
@@ -893,17 +911,33 @@ bool Node::ProcessStateDeltaFromFinalBlock(
 void Node::CommitForwardedTransactions(const ForwardedTxnEntry& entry) {
   LOG_MARKER();
 
+  BlockStorage::Batch batch;
+
   unsigned int txn_counter = 0;
   for (const auto& twr : entry.m_transactions) {
     if (LOOKUP_NODE_MODE) {
       Server::AddToRecentTransactions(twr.GetTransaction().GetTranID());
+      Server::CacheTransaction(twr);
+      Server::GetSubscriptionServer().PublishTransaction(twr);
+
+      // Index contract deployments by creator once they are committed
+      const Transaction& tx = twr.GetTransaction();
+      if (!tx.GetCode().empty() && tx.GetToAddr() == NullAddress) {
+        const Address contractAddr = Account::GetAddressForContract(
+            tx.GetSenderAddr(), tx.GetNonce() - 1);
+        if (!ContractStorage::GetContractStorage().PutContractCreation(
+                tx.GetSenderAddr(), tx.GetNonce() - 1, contractAddr)) {
+          LOG_GENERAL(WARNING, "Failed to index contract "
+                                   << contractAddr.hex() << " by creator");
+        }
+      }
     }
 
     // Store TxBody to disk
     vector<unsigned char> serializedTxBody;
     twr.Serialize(serializedTxBody, 0);
-    BlockStorage::GetBlockStorage().PutTxBody(twr.GetTransaction().GetTranID(),
-                                              serializedTxBody);
+    BlockStorage::GetBlockStorage().PutTxBody(
+        batch, twr.GetTransaction().GetTranID(), serializedTxBody);
 
     txn_counter++;
     if (txn_counter % 10000 == 0) {
@@ -911,6 +945,11 @@ void Node::CommitForwardedTransactions(const ForwardedTxnEntry& entry) {
                 "Proceessed " << txn_counter << " of txns.");
     }
   }
+
+  if (!BlockStorage::GetBlockStorage().CommitBatch(batch)) {
+    LOG_GENERAL(WARNING, "Failed to store txn bodies for block "
+                             << entry.m_blockNum);
+  }
 }
 
 void Node::DeleteEntryFromFwdingAssgnAndMissingBodyCountMap(
@@ -38,6 +38,7 @@
 #include "libCrypto/Sha2.h"
 #include "libData/AccountData/Account.h"
 #include "libData/AccountData/AccountStore.h"
+#include "libData/AccountData/ShortTxnId.h"
 #include "libData/AccountData/Transaction.h"
 #include "libData/AccountData/TransactionReceipt.h"
 #include "libMediator/Mediator.h"
@@ -47,6 +48,7 @@
 #include "libUtils/DataConversion.h"
 #include "libUtils/DetachedFunction.h"
 #include "libUtils/Logger.h"
+#include "libUtils/Metrics.h"
 #include "libUtils/RootComputation.h"
 #include "libUtils/SanityChecks.h"
 #include "libUtils/TimeLockedFunction.h"
@@ -66,6 +68,7 @@ bool Node::ComposeMicroBlock() {
   }
   // To-do: Replace dummy values with the required ones
   LOG_MARKER();
+  ScopedPhaseTimer timer(EpochPhase::MICROBLOCK_COMPOSITION);
 
   // TxBlockHeader
   uint8_t type = TXBLOCKTYPE::MICRO;
@@ -143,14 +146,18 @@ bool Node::ComposeMicroBlock() {
 
   LOG_EPOCH(INFO, to_string(m_mediator.m_currentEpochNum).c_str(),
             "Creating new micro block.")
-  m_microblock.reset(new MicroBlock(
-      MicroBlockHeader(
-          type, version, shardId, gasLimit, gasUsed, rewards, prevHash,
-          m_mediator.m_currentEpochNum,
-          {txRootHash, stateDeltaHash, txReceiptHash}, numTxs, minerPubKey,
-          m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum(),
-          committeeHash),
-      tranHashes, CoSignatures()));
+  atomic_store(
+      &m_microblock,
+      make_shared<MicroBlock>(
+          MicroBlockHeader(
+              type, version, shardId, gasLimit, gasUsed, rewards, prevHash,
+              m_mediator.m_currentEpochNum,
+              {txRootHash, stateDeltaHash, txReceiptHash}, numTxs, minerPubKey,
+              m_mediator.m_dsBlockChain.GetLastBlock()
+                  .GetHeader()
+                  .GetBlockNum(),
+              committeeHash),
+          tranHashes, CoSignatures()));
 
   LOG_EPOCH(INFO, to_string(m_mediator.m_currentEpochNum).c_str(),
             "Micro block proposed with "
@@ -203,6 +210,14 @@ bool Node::OnNodeMissingTxns(const std::vector<unsigned char>& errorMsg,
   uint128_t ipAddr = from.m_ipAddress;
   Peer peer(ipAddr, portNo);
 
+  return SendMissingTxns(epochNum, missingTransactions, peer);
+}
+
+bool Node::SendMissingTxns(const uint64_t epochNum,
+                           const vector<TxnHash>& missingTransactions,
+                           const Peer& peer) {
+  LOG_MARKER();
+
   lock_guard<mutex> g(m_mutexProcessedTransactions);
 
   unsigned int cur_offset = 0;
@@ -217,22 +232,23 @@ bool Node::OnNodeMissingTxns(const std::vector<unsigned char>& errorMsg,
 
   std::vector<Transaction> txns;
 
-  const std::unordered_map<TxnHash, TransactionWithReceipt>&
-      processedTransactions = (epochNum == m_mediator.m_currentEpochNum)
-                                  ? t_processedTransactions
-                                  : m_processedTransactions[epochNum];
-
-  for (uint32_t i = 0; i < numOfAbsentHashes; i++) {
-    // LOG_GENERAL(INFO, "Peer " << from << " : " << portNo << " missing txn "
-    // << missingTransactions[i])
-    auto found = processedTransactions.find(missingTransactions[i]);
-    if (found != processedTransactions.end()) {
-      txns.push_back(found->second.GetTransaction());
+  for (const auto& missingTransaction : missingTransactions) {
+    if (epochNum == m_mediator.m_currentEpochNum) {
+      auto found = t_processedTransactions.find(missingTransaction);
+      if (found != t_processedTransactions.end()) {
+        txns.push_back(found->second.GetTransaction());
+        continue;
+      }
     } else {
-      LOG_GENERAL(INFO, "Leader unable to find txn proposed in microblock "
-                            << missingTransactions[i]);
-      continue;
+      TransactionWithReceipt txn;
+      if (m_processedTransactions.Find(epochNum, missingTransaction, txn)) {
+        txns.push_back(txn.GetTransaction());
+        continue;
+      }
     }
+
+    LOG_GENERAL(INFO, "Leader unable to find txn proposed in microblock "
+                          << missingTransaction);
   }
 
   if (!Messenger::SetTransactionArray(tx_message, cur_offset, txns)) {
@@ -245,6 +261,117 @@ bool Node::OnNodeMissingTxns(const std::vector<unsigned char>& errorMsg,
   return true;
 }
 
+bool Node::ResolveCompactMicroBlock(const vector<uint64_t>& shortTxnIds,
+                                    const Peer& leader) {
+  if (LOOKUP_NODE_MODE) {
+    LOG_GENERAL(WARNING,
+                "Node::ResolveCompactMicroBlock not expected to be called "
+                "from LookUp node.");
+    return true;
+  }
+
+  LOG_MARKER();
+
+  if (shortTxnIds.empty()) {
+    // Either a full announcement or a block without txns
+    return true;
+  }
+
+  if (!m_microblock->GetTranHashes().empty()) {
+    LOG_GENERAL(WARNING, "Announcement carries both txn hashes and short ids");
+    return false;
+  }
+
+  CompactTxnHashResolver resolver(
+      ShortTxnIdGenerator(m_microblock->GetHeader().GetMyHash()), shortTxnIds);
+  {
+    vector<TxnHash> localHashes;
+    {
+      lock_guard<mutex> g(m_mutexCreatedTransactions);
+      localHashes.reserve(m_createdTxns.HashIndex.size());
+      for (const auto& entry : m_createdTxns.HashIndex) {
+        localHashes.emplace_back(entry.first);
+      }
+    }
+    resolver.ResolveLocal(localHashes);
+  }
+  const vector<uint32_t>& missingIndexes = resolver.GetMissingIndexes();
+
+  if (!missingIndexes.empty()) {
+    LOG_EPOCH(INFO, to_string(m_mediator.m_currentEpochNum).c_str(),
+              "Fetching " << missingIndexes.size() << " of "
+                          << shortTxnIds.size() << " txns from leader");
+
+    // Message = [8-byte epoch num] [32-byte block hash] [4-byte listen port]
+    // [4-byte count] [4-byte txn index] ... [4-byte txn index]
+    vector<unsigned char> request = {MessageType::NODE,
+                                     NodeInstructionType::SUBMITTRANSACTION,
+                                     SUBMITTRANSACTIONTYPE::MISSINGTXNREQUEST};
+    unsigned int curOffset = MessageOffset::BODY + MessageOffset::INST;
+    Serializable::SetNumber<uint64_t>(request, curOffset,
+                                      m_mediator.m_currentEpochNum,
+                                      sizeof(uint64_t));
+    curOffset += sizeof(uint64_t);
+    const BlockHash& blockHash = m_microblock->GetBlockHash();
+    request.insert(request.end(), blockHash.asArray().begin(),
+                   blockHash.asArray().end());
+    curOffset += BLOCK_HASH_SIZE;
+    Serializable::SetNumber<uint32_t>(request, curOffset,
+                                      m_mediator.m_selfPeer.m_listenPortHost,
+                                      sizeof(uint32_t));
+    curOffset += sizeof(uint32_t);
+    Serializable::SetNumber<uint32_t>(request, curOffset, missingIndexes.size(),
+                                      sizeof(uint32_t));
+    curOffset += sizeof(uint32_t);
+    for (const auto& index : missingIndexes) {
+      Serializable::SetNumber<uint32_t>(request, curOffset, index,
+                                        sizeof(uint32_t));
+      curOffset += sizeof(uint32_t);
+    }
+
+    // Start collecting the fetched txns before the leader can answer
+    unique_lock<mutex> lock(m_mutexCVMicroBlockMissingTxn);
+    m_fetchingCompactTxns = true;
+    m_fetchedCompactTxnHashes.clear();
+
+    P2PComm::GetInstance().SendMessage(leader, request);
+
+    // Wait no longer than the leader keeps collecting commits
+    cv_MicroBlockMissingTxn.wait_for(
+        lock,
+        chrono::seconds(
+            min(FETCHING_MISSING_DATA_TIMEOUT, COMMIT_WINDOW_IN_SECONDS)),
+        [this, &resolver]() {
+          resolver.ResolveFetched(m_fetchedCompactTxnHashes);
+          m_fetchedCompactTxnHashes.clear();
+          return resolver.GetMissingIndexes().empty();
+        });
+
+    m_fetchingCompactTxns = false;
+    m_fetchedCompactTxnHashes.clear();
+
+    if (!missingIndexes.empty()) {
+      LOG_EPOCH(WARNING, to_string(m_mediator.m_currentEpochNum).c_str(),
+                "Unable to resolve " << missingIndexes.size()
+                                     << " txns of compact microblock");
+      return false;
+    }
+  }
+
+  // Rebuild the block with the full txn hashes, keeping the block base
+  MicroBlock microblock(m_microblock->GetHeader(),
+                        move(resolver.GetTranHashes()),
+                        CoSignatures(m_microblock->GetCS1(),
+                                     m_microblock->GetB1(),
+                                     m_microblock->GetCS2(),
+                                     m_microblock->GetB2()));
+  microblock.SetBlockHash(m_microblock->GetBlockHash());
+  microblock.SetTimestamp(m_microblock->GetTimestamp());
+  atomic_store(&m_microblock, make_shared<MicroBlock>(move(microblock)));
+
+  return true;
+}
+
 bool Node::OnCommitFailure([
     [gnu::unused]] const std::map<unsigned int, std::vector<unsigned char>>&
                                commitFailureMap) {
@@ -453,13 +580,13 @@ void Node::UpdateProcessedTransactions() {
 
   {
     lock_guard<mutex> g(m_mutexProcessedTransactions);
-    m_processedTransactions[(m_mediator.m_ds->m_mode ==
-                             DirectoryService::Mode::IDLE)
-                                ? m_mediator.m_currentEpochNum
-                                : m_mediator.m_txBlockChain.GetLastBlock()
-                                      .GetHeader()
-                                      .GetBlockNum()] =
-        std::move(t_processedTransactions);
+    const uint64_t epochNum =
+        (m_mediator.m_ds->m_mode == DirectoryService::Mode::IDLE)
+            ? m_mediator.m_currentEpochNum
+            : m_mediator.m_txBlockChain.GetLastBlock()
+                  .GetHeader()
+                  .GetBlockNum();
+    m_processedTransactions.Put(epochNum, std::move(t_processedTransactions));
     t_processedTransactions.clear();
   }
 }
@@ -831,6 +958,7 @@ bool Node::RunConsensusOnMicroBlock() {
   LOG_MARKER();
 
   SetState(MICROBLOCK_CONSENSUS_PREP);
+  Metrics::GetInstance().StartPhase(EpochPhase::MICROBLOCK_CONSENSUS);
 
   if (m_mediator.GetIsVacuousEpoch()) {
     LOG_EPOCH(INFO, to_string(m_mediator.m_currentEpochNum).c_str(),
@@ -1030,13 +1158,8 @@ unsigned char Node::CheckLegitimacyOfTxnHashes(
       AccountStore::GetInstance().InitTemp();
       if (m_mediator.m_ds->m_mode != DirectoryService::Mode::IDLE) {
         LOG_GENERAL(WARNING, "Got missing txns, revert state delta");
-        if (!AccountStore::GetInstance().DeserializeDeltaTemp(
-                m_mediator.m_ds->m_stateDeltaFromShards, 0)) {
-          LOG_GENERAL(WARNING, "AccountStore::DeserializeDeltaTemp failed.");
-          return LEGITIMACYRESULT::DESERIALIZATIONERROR;
-        } else {
-          AccountStore::GetInstance().SerializeDelta();
-        }
+        AccountStore::GetInstance().RevertTempToShardDeltas();
+        AccountStore::GetInstance().SerializeDelta();
       }
 
       return LEGITIMACYRESULT::MISSEDTXN;
@@ -1268,11 +1391,15 @@ bool Node::MicroBlockValidator(const vector<unsigned char>& message,
     return true;
   }
 
-  m_microblock.reset(new MicroBlock);
+  // Decode before publishing, ProcessSubmitMissingTxnRequest may read it
+  auto microblock = make_shared<MicroBlock>();
+  vector<uint64_t> shortTxnIds;
 
-  if (!Messenger::GetNodeMicroBlockAnnouncement(
-          message, offset, consensusID, blockNumber, blockHash, leaderID,
-          leaderKey, *m_microblock, messageToCosign)) {
+  const bool decoded = Messenger::GetNodeMicroBlockAnnouncement(
+      message, offset, consensusID, blockNumber, blockHash, leaderID,
+      leaderKey, *microblock, shortTxnIds, messageToCosign);
+  atomic_store(&m_microblock, microblock);
+  if (!decoded) {
     LOG_EPOCH(WARNING, to_string(m_mediator.m_currentEpochNum).c_str(),
               "Messenger::GetNodeMicroBlockAnnouncement failed.");
     return false;
@@ -1296,8 +1423,15 @@ bool Node::MicroBlockValidator(const vector<unsigned char>& message,
     return false;
   }
 
+  if (!ResolveCompactMicroBlock(shortTxnIds,
+                                m_myShardMembers->at(leaderID).second)) {
+    LOG_GENERAL(WARNING, "ResolveCompactMicroBlock failed");
+    atomic_store(&m_microblock, shared_ptr<MicroBlock>());
+    return false;
+  }
+
   if (!CheckMicroBlockValidity(errorMsg)) {
-    m_microblock = nullptr;
+    atomic_store(&m_microblock, shared_ptr<MicroBlock>());
     Serializable::SetNumber<uint32_t>(errorMsg, errorMsg.size(),
                                       m_mediator.m_selfPeer.m_listenPortHost,
                                       sizeof(uint32_t));
@@ -53,6 +53,7 @@
 #include "libUtils/DataConversion.h"
 #include "libUtils/DetachedFunction.h"
 #include "libUtils/Logger.h"
+#include "libUtils/Metrics.h"
 #include "libUtils/SanityChecks.h"
 #include "libUtils/TimeLockedFunction.h"
 #include "libUtils/TimeUtils.h"
@@ -847,6 +848,30 @@ vector<Peer> Node::GetBroadcastList(
   return vector<Peer>();
 }
 
+vector<PubKey> Node::GetBroadcastOriginators() {
+  // Node messages are broadcast by the DS committee and the lookups to the
+  // shards, and by shard members within their shard
+  vector<PubKey> keys;
+  {
+    lock_guard<mutex> g(m_mediator.m_mutexDSCommittee);
+    for (const auto& member : *m_mediator.m_DSCommittee) {
+      keys.emplace_back(member.first);
+    }
+  }
+  {
+    lock_guard<mutex> g(m_mediator.m_ds->m_mutexShards);
+    for (const auto& shard : m_mediator.m_ds->m_shards) {
+      for (const auto& member : shard) {
+        keys.emplace_back(std::get<SHARD_NODE_PUBKEY>(member));
+      }
+    }
+  }
+  for (const auto& node : m_mediator.m_lookup->GetLookupNodes()) {
+    keys.emplace_back(node.first);
+  }
+  return keys;
+}
+
 /// Return a valid transaction from fromKeyPair to toAddr with the specified
 /// amount
 ///
@@ -952,15 +977,97 @@ bool Node::ProcessSubmitMissingTxn(const vector<unsigned char>& message,
     return false;
   }
 
-  lock_guard<mutex> g(m_mutexCreatedTransactions);
-  for (const auto& submittedTxn : txns) {
-    m_createdTxns.insert(submittedTxn);
+  {
+    lock_guard<mutex> g(m_mutexCreatedTransactions);
+    for (const auto& submittedTxn : txns) {
+      m_createdTxns.insert(submittedTxn);
+    }
   }
 
+  lock_guard<mutex> cv_lk(m_mutexCVMicroBlockMissingTxn);
+  if (m_fetchingCompactTxns) {
+    for (const auto& submittedTxn : txns) {
+      m_fetchedCompactTxnHashes.emplace_back(submittedTxn.GetTranID());
+    }
+  }
   cv_MicroBlockMissingTxn.notify_all();
   return true;
 }
 
+bool Node::ProcessSubmitMissingTxnRequest(const vector<unsigned char>& message,
+                                          unsigned int offset,
+                                          const Peer& from) {
+  if (LOOKUP_NODE_MODE) {
+    LOG_GENERAL(WARNING,
+                "Node::ProcessSubmitMissingTxnRequest not expected to be "
+                "called from LookUp node.");
+    return true;
+  }
+
+  // Message = [8-byte epoch num] [32-byte block hash] [4-byte listen port]
+  // [4-byte count] [4-byte txn index] ... [4-byte txn index]
+
+  LOG_MARKER();
+
+  unsigned int cur_offset = offset;
+
+  if (message.size() < cur_offset + sizeof(uint64_t) + BLOCK_HASH_SIZE +
+                            sizeof(uint32_t) + sizeof(uint32_t)) {
+    LOG_GENERAL(WARNING, "Malformed Message");
+    return false;
+  }
+
+  uint64_t epochNum =
+      Serializable::GetNumber<uint64_t>(message, cur_offset, sizeof(uint64_t));
+  cur_offset += sizeof(uint64_t);
+
+  BlockHash blockHash;
+  copy(message.begin() + cur_offset,
+       message.begin() + cur_offset + BLOCK_HASH_SIZE,
+       blockHash.asArray().begin());
+  cur_offset += BLOCK_HASH_SIZE;
+
+  uint32_t portNo =
+      Serializable::GetNumber<uint32_t>(message, cur_offset, sizeof(uint32_t));
+  cur_offset += sizeof(uint32_t);
+
+  uint32_t numOfIndexes =
+      Serializable::GetNumber<uint32_t>(message, cur_offset, sizeof(uint32_t));
+  cur_offset += sizeof(uint32_t);
+
+  if ((message.size() - cur_offset) / sizeof(uint32_t) < numOfIndexes) {
+    LOG_GENERAL(WARNING, "Malformed Message");
+    return false;
+  }
+
+  // The indexes refer to the microblock I proposed in the ongoing consensus.
+  // Consensus threads replace m_microblock with atomic_store.
+  shared_ptr<MicroBlock> microblock = atomic_load(&m_microblock);
+  if (microblock == nullptr || microblock->GetBlockHash() != blockHash) {
+    LOG_EPOCH(INFO, to_string(m_mediator.m_currentEpochNum).c_str(),
+              "Missing txns requested for a microblock I did not propose");
+    return false;
+  }
+
+  const vector<TxnHash>& tranHashes = microblock->GetTranHashes();
+  vector<TxnHash> missingTransactions;
+  missingTransactions.reserve(numOfIndexes);
+  for (uint32_t i = 0; i < numOfIndexes; i++) {
+    uint32_t index = Serializable::GetNumber<uint32_t>(message, cur_offset,
+                                                       sizeof(uint32_t));
+    cur_offset += sizeof(uint32_t);
+
+    if (index >= tranHashes.size()) {
+      LOG_GENERAL(WARNING, "Requested txn index " << index << " out of range");
+      return false;
+    }
+    missingTransactions.emplace_back(tranHashes[index]);
+  }
+
+  return SendMissingTxns(epochNum, missingTransactions,
+                         Peer(from.m_ipAddress, portNo));
+}
+
 bool Node::ProcessSubmitTransaction(const vector<unsigned char>& message,
                                     unsigned int offset,
                                     [[gnu::unused]] const Peer& from) {
@@ -980,7 +1087,8 @@ bool Node::ProcessSubmitTransaction(const vector<unsigned char>& message,
   unsigned char submitTxnType = message[cur_offset];
   cur_offset += MessageOffset::INST;
 
-  if (submitTxnType == SUBMITTRANSACTIONTYPE::MISSINGTXN) {
+  if (submitTxnType == SUBMITTRANSACTIONTYPE::MISSINGTXN ||
+      submitTxnType == SUBMITTRANSACTIONTYPE::MISSINGTXNREQUEST) {
     if (m_mediator.m_ds->m_mode == DirectoryService::IDLE) {
       if (m_state != MICROBLOCK_CONSENSUS) {
         LOG_EPOCH(INFO, to_string(m_mediator.m_currentEpochNum).c_str(),
@@ -997,7 +1105,11 @@ bool Node::ProcessSubmitTransaction(const vector<unsigned char>& message,
       }
     }
 
-    ProcessSubmitMissingTxn(message, cur_offset, from);
+    if (submitTxnType == SUBMITTRANSACTIONTYPE::MISSINGTXNREQUEST) {
+      ProcessSubmitMissingTxnRequest(message, cur_offset, from);
+    } else {
+      ProcessSubmitMissingTxn(message, cur_offset, from);
+    }
   }
   return true;
 }
@@ -1110,6 +1222,11 @@ bool Node::ProcessTxnPacketFromLookupCore(const vector<unsigned char>& message,
     return false;
   }
 
+  ScopedPhaseTimer timer(EpochPhase::TXN_INGESTION);
+  static MetricCounter& txnsReceived = Metrics::GetInstance().GetCounter(
+      "zilliqa_txns_received_total", "Transactions received from lookups");
+  txnsReceived.Increment(txns.size());
+
   // If network is gossip mode enabled, lookup sends the gossip forward type
   // message to shard nodes. And this node wont be responsible for sending
   // gossip (txnpkt) from this function but will be done at gossip layer.
@@ -1373,7 +1490,7 @@ bool Node::CleanVariables() {
   m_consensusBlockHash.clear();
   {
     std::lock_guard<mutex> lock(m_mutexMicroBlock);
-    m_microblock.reset();
+    atomic_store(&m_microblock, shared_ptr<MicroBlock>());
     m_gasUsedTotal = 0;
     m_txnFees = 0;
   }
@@ -1419,7 +1536,7 @@ void Node::CleanCreatedTransaction() {
   }
   {
     std::lock_guard<mutex> lock(m_mutexProcessedTransactions);
-    m_processedTransactions.clear();
+    m_processedTransactions.Clear();
     t_processedTransactions.clear();
   }
   m_TxnOrder.clear();
@@ -43,6 +43,7 @@
 #include "libNetwork/P2PComm.h"
 #include "libNetwork/PeerStore.h"
 #include "libPersistence/BlockStorage.h"
+#include "libPersistence/ProcessedTxnHistory.h"
 
 class Mediator;
 class Retriever;
@@ -60,7 +61,10 @@ class Node : public Executable, public Broadcastable {
     NUM_ACTIONS
   };
 
-  enum SUBMITTRANSACTIONTYPE : unsigned char { MISSINGTXN = 0x01 };
+  enum SUBMITTRANSACTIONTYPE : unsigned char {
+    MISSINGTXN = 0x01,
+    MISSINGTXNREQUEST = 0x02
+  };
 
   enum REJOINTYPE : unsigned char {
     ATFINALBLOCK = 0x00,
@@ -119,9 +123,9 @@ class Node : public Executable, public Broadcastable {
   TxnPool m_createdTxns, t_createdTxns;
   std::vector<TxnHash> m_txnsOrdering;
   std::mutex m_mutexProcessedTransactions;
-  std::unordered_map<uint64_t,
-                     std::unordered_map<TxnHash, TransactionWithReceipt>>
-      m_processedTransactions;
+  ProcessedTxnHistory m_processedTransactions{"processedTxns",
+                                              PROCESSED_TXN_MEMORY_EPOCHS,
+                                              PROCESSED_TXN_DISK_EPOCHS};
   std::unordered_map<TxnHash, TransactionWithReceipt> t_processedTransactions;
   // operates under m_mutexProcessedTransaction
   std::vector<TxnHash> m_TxnOrder;
@@ -173,6 +177,11 @@ class Node : public Executable, public Broadcastable {
       std::array<unsigned char, 32>& rand2);
   bool ProcessSubmitMissingTxn(const std::vector<unsigned char>& message,
                                unsigned int offset, const Peer& from);
+  bool ProcessSubmitMissingTxnRequest(const std::vector<unsigned char>& message,
+                                      unsigned int offset, const Peer& from);
+  bool SendMissingTxns(const uint64_t epochNum,
+                       const std::vector<TxnHash>& missingTransactions,
+                       const Peer& peer);
 
   // internal calls from ActOnFinalBlock for NODE_FORWARD_ONLY and
   // SEND_AND_FORWARD
@@ -209,7 +218,9 @@ class Node : public Executable, public Broadcastable {
 
   void StoreState();
   // void StoreMicroBlocks();
-  void StoreFinalBlock(const TxBlock& txBlock);
+  void StoreFinalBlock(const TxBlock& txBlock,
+                       const std::vector<unsigned char>& stateDelta,
+                       bool isVacuousEpoch);
   void InitiatePoW();
   void ScheduleMicroBlockConsensus();
   void BeginNextConsensusRound();
@@ -391,6 +402,10 @@ class Node : public Executable, public Broadcastable {
 
   std::mutex m_mutexCVMicroBlockMissingTxn;
   std::condition_variable cv_MicroBlockMissingTxn;
+  // Hashes of the txns fetched for the compact microblock being resolved,
+  // guarded by m_mutexCVMicroBlockMissingTxn
+  bool m_fetchingCompactTxns = false;
+  std::vector<TxnHash> m_fetchedCompactTxnHashes;
 
   // std::condition_variable m_cvNewRoundStarted;
   // std::mutex m_mutexNewRoundStarted;
@@ -466,6 +481,10 @@ class Node : public Executable, public Broadcastable {
   std::vector<Peer> GetBroadcastList(unsigned char ins_type,
                                      const Peer& broadcast_originator);
 
+  /// Implements the GetBroadcastOriginators function inherited from
+  /// Broadcastable.
+  std::vector<PubKey> GetBroadcastOriginators();
+
   Mediator& GetMediator() { return m_mediator; }
 
   /// Recover the previous state by retrieving persistence data
@@ -506,6 +525,11 @@ class Node : public Executable, public Broadcastable {
   bool OnNodeMissingTxns(const std::vector<unsigned char>& errorMsg,
                          const Peer& from);
 
+  /// Rebuilds the txn hashes of a compact m_microblock from the local txn pool,
+  /// fetching the ones not found from the leader in a single request.
+  bool ResolveCompactMicroBlock(const std::vector<uint64_t>& shortTxnIds,
+                                const Peer& leader);
+
   void UpdateStateForNextConsensusRound();
 
   // Start synchronization with lookup as a shard node
@@ -48,6 +48,7 @@
 #include "libUtils/DataConversion.h"
 #include "libUtils/DetachedFunction.h"
 #include "libUtils/Logger.h"
+#include "libUtils/Metrics.h"
 #include "libUtils/SanityChecks.h"
 #include "libUtils/TimeLockedFunction.h"
 #include "libUtils/TimeUtils.h"
@@ -112,6 +113,7 @@ bool Node::StartPoW(const uint64_t& block_num, uint8_t ds_difficulty,
 
   lock_guard<mutex> g(m_mutexGasPrice);
 
+  ScopedPhaseTimer timer(EpochPhase::POW);
   ethash_mining_result winning_result;
 
   uint32_t shardGuardDiff = 1;
@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "EpochContextCache.h"
+#include "common/Constants.h"
+#include "depends/libethash/include/ethash/keccak.hpp"
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+namespace {
+const char CACHE_FILE_MAGIC[4] = {'Z', 'E', 'C', '1'};
+
+// Number of epochs whose contexts are held in memory (current and next)
+const size_t MAX_CACHED_EPOCHS = 2;
+
+template <class Map>
+void Prune(Map& contexts) {
+  while (contexts.size() > MAX_CACHED_EPOCHS) {
+    contexts.erase(contexts.begin());
+  }
+}
+}  // namespace
+
+EpochContextCache::EpochContextCache() : m_precomputing(false) {
+  static_assert(sizeof(FileHeader) == sizeof(ethash_hash512),
+                "FileHeader must keep the light cache aligned");
+}
+
+EpochContextCache::~EpochContextCache() {
+  lock_guard<mutex> g(m_mutexPrecompute);
+  if (m_precomputeThread.joinable()) {
+    m_precomputeThread.join();
+  }
+}
+
+string EpochContextCache::GetFilePath(int epochNumber) {
+  return ETHASH_CACHE_PATH + "/light_" + to_string(epochNumber) + ".cache";
+}
+
+shared_ptr<ethash::epoch_context> EpochContextCache::LoadLightContext(
+    int epochNumber) {
+  const string path = GetFilePath(epochNumber);
+
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(FileHeader)) {
+    close(fd);
+    return nullptr;
+  }
+
+  const size_t mapSize = st.st_size;
+  void* map = mmap(nullptr, mapSize, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED) {
+    LOG_GENERAL(WARNING, "Failed to map " << path);
+    return nullptr;
+  }
+
+  const auto* header = static_cast<const FileHeader*>(map);
+  const auto* lightCache = reinterpret_cast<const ethash_hash512*>(
+      static_cast<const unsigned char*>(map) + sizeof(FileHeader));
+  const int numItems = ethash::calculate_light_cache_num_items(epochNumber);
+  const size_t lightCacheSize = ethash::get_light_cache_size(numItems);
+
+  if (memcmp(header->magic, CACHE_FILE_MAGIC, sizeof(CACHE_FILE_MAGIC)) != 0 ||
+      header->epochNumber != epochNumber || header->numItems != numItems ||
+      mapSize != sizeof(FileHeader) + lightCacheSize ||
+      memcmp(header->checksum,
+             ethash::keccak256(reinterpret_cast<const uint8_t*>(lightCache),
+                               lightCacheSize)
+                 .bytes,
+             sizeof(header->checksum)) != 0) {
+    LOG_GENERAL(WARNING, path << " is corrupted, rebuilding it");
+    munmap(map, mapSize);
+    return nullptr;
+  }
+
+  auto* context = new ethash::epoch_context{
+      epochNumber, numItems, lightCache,
+      ethash::calculate_full_dataset_num_items(epochNumber)};
+
+  return shared_ptr<ethash::epoch_context>(
+      context, [map, mapSize](ethash::epoch_context* c) {
+        delete c;
+        munmap(map, mapSize);
+      });
+}
+
+bool EpochContextCache::SaveLightContext(const ethash::epoch_context& context) {
+  const string path = GetFilePath(context.epoch_number);
+  const string tmpPath = path + ".tmp";
+  const size_t lightCacheSize =
+      ethash::get_light_cache_size(context.light_cache_num_items);
+  const auto* lightCache = reinterpret_cast<const char*>(context.light_cache);
+
+  FileHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, CACHE_FILE_MAGIC, sizeof(CACHE_FILE_MAGIC));
+  header.epochNumber = context.epoch_number;
+  header.numItems = context.light_cache_num_items;
+  memcpy(header.checksum,
+         ethash::keccak256(reinterpret_cast<const uint8_t*>(lightCache),
+                           lightCacheSize)
+             .bytes,
+         sizeof(header.checksum));
+
+  mkdir(ETHASH_CACHE_PATH.c_str(), 0755);
+
+  {
+    ofstream file(tmpPath, ios::binary | ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(lightCache, lightCacheSize);
+    if (!file) {
+      LOG_GENERAL(WARNING, "Failed to write " << tmpPath);
+      remove(tmpPath.c_str());
+      return false;
+    }
+  }
+
+  // Publish the file only once it is complete
+  if (rename(tmpPath.c_str(), path.c_str()) != 0) {
+    LOG_GENERAL(WARNING, "Failed to rename " << tmpPath << " to " << path);
+    remove(tmpPath.c_str());
+    return false;
+  }
+
+  // The cache of the epoch before the previous one is no longer needed
+  if (context.epoch_number >= 2) {
+    remove(GetFilePath(context.epoch_number - 2).c_str());
+  }
+
+  return true;
+}
+
+shared_ptr<ethash::epoch_context> EpochContextCache::GetLightContext(
+    int epochNumber) {
+  unique_lock<mutex> lock(m_mutex);
+  m_cvBuilding.wait(lock, [this, epochNumber] {
+    return !m_buildingLight.count(epochNumber);
+  });
+
+  auto it = m_lightContexts.find(epochNumber);
+  if (it != m_lightContexts.end()) {
+    return it->second;
+  }
+
+  // Build outside the lock; other callers for the same epoch wait for it
+  m_buildingLight.insert(epochNumber);
+  lock.unlock();
+
+  shared_ptr<ethash::epoch_context> context;
+  if (POW_EPOCH_CONTEXT_CACHE) {
+    context = LoadLightContext(epochNumber);
+  }
+
+  if (context) {
+    LOG_GENERAL(INFO, "Loaded light cache of epoch " << epochNumber
+                                                     << " from disk");
+  } else {
+    auto startTime = chrono::steady_clock::now();
+    context = ethash::create_epoch_context(epochNumber);
+    LOG_GENERAL(INFO, "Built light cache of epoch "
+                          << epochNumber << " in "
+                          << chrono::duration_cast<chrono::milliseconds>(
+                                 chrono::steady_clock::now() - startTime)
+                                 .count()
+                          << " ms");
+    if (context && POW_EPOCH_CONTEXT_CACHE) {
+      SaveLightContext(*context);
+    }
+  }
+
+  lock.lock();
+  m_buildingLight.erase(epochNumber);
+  if (context) {
+    m_lightContexts[epochNumber] = context;
+    Prune(m_lightContexts);
+  }
+  m_cvBuilding.notify_all();
+
+  return context;
+}
+
+shared_ptr<ethash::epoch_context_full> EpochContextCache::GetFullContext(
+    int epochNumber) {
+  unique_lock<mutex> lock(m_mutex);
+  m_cvBuilding.wait(lock, [this, epochNumber] {
+    return !m_buildingFull.count(epochNumber);
+  });
+
+  auto it = m_fullContexts.find(epochNumber);
+  if (it != m_fullContexts.end()) {
+    return it->second;
+  }
+
+  m_buildingFull.insert(epochNumber);
+  lock.unlock();
+
+  // ethash generates the dataset items lazily on first access, so only the
+  // light cache and the dataset allocation are prepared here
+  shared_ptr<ethash::epoch_context_full> context =
+      ethash::create_epoch_context_full(epochNumber);
+
+  lock.lock();
+  m_buildingFull.erase(epochNumber);
+  if (context) {
+    m_fullContexts[epochNumber] = context;
+    Prune(m_fullContexts);
+  }
+  m_cvBuilding.notify_all();
+
+  return context;
+}
+
+void EpochContextCache::PrecomputeAsync(int epochNumber, bool full) {
+  lock_guard<mutex> g(m_mutexPrecompute);
+
+  if (m_precomputing) {
+    return;
+  }
+
+  if (m_precomputeThread.joinable()) {
+    m_precomputeThread.join();
+  }
+
+  m_precomputing = true;
+  m_precomputeThread = thread([this, epochNumber, full]() {
+    // Stay out of the way of mining and consensus
+    setpriority(PRIO_PROCESS, syscall(SYS_gettid), 19);
+
+    LOG_GENERAL(INFO, "Precomputing contexts of epoch " << epochNumber);
+    GetLightContext(epochNumber);
+    if (full) {
+      GetFullContext(epochNumber);
+    }
+    m_precomputing = false;
+  });
+}
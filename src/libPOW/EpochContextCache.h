@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#ifndef __EPOCHCONTEXTCACHE_H__
+#define __EPOCHCONTEXTCACHE_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+
+#include "depends/libethash/include/ethash/ethash.hpp"
+
+/// Holds the ethash epoch contexts of the current and next epoch.
+/// Light caches are written to <ETHASH_CACHE_PATH>/light_<epoch>.cache and
+/// mapped back on the next request, so a restart or an epoch switch does not
+/// have to rebuild them. The next epoch can be built ahead of time on a
+/// low-priority background thread.
+class EpochContextCache {
+  struct FileHeader {
+    char magic[4];
+    int32_t epochNumber;
+    int32_t numItems;
+    uint32_t reserved;
+    uint8_t checksum[32];  // keccak256 of the light cache
+    uint8_t padding[16];   // keeps the light cache 64-byte aligned
+  };
+
+  std::mutex m_mutex;
+  std::condition_variable m_cvBuilding;
+  std::set<int> m_buildingLight;
+  std::set<int> m_buildingFull;
+  std::map<int, std::shared_ptr<ethash::epoch_context>> m_lightContexts;
+  std::map<int, std::shared_ptr<ethash::epoch_context_full>> m_fullContexts;
+
+  std::mutex m_mutexPrecompute;
+  std::thread m_precomputeThread;
+  std::atomic<bool> m_precomputing;
+
+  static std::string GetFilePath(int epochNumber);
+  static std::shared_ptr<ethash::epoch_context> LoadLightContext(
+      int epochNumber);
+  static bool SaveLightContext(const ethash::epoch_context& context);
+
+  EpochContextCache(EpochContextCache const&) = delete;
+  void operator=(EpochContextCache const&) = delete;
+
+ public:
+  /// Constructor.
+  EpochContextCache();
+
+  /// Destructor. Waits for any background precomputation to finish.
+  ~EpochContextCache();
+
+  /// Returns the light context of the epoch, loading it from disk or building
+  /// it if it is not already held in memory.
+  std::shared_ptr<ethash::epoch_context> GetLightContext(int epochNumber);
+
+  /// Returns the full context of the epoch, creating it if it is not already
+  /// held in memory.
+  std::shared_ptr<ethash::epoch_context_full> GetFullContext(int epochNumber);
+
+  /// Builds the contexts of the epoch on a low-priority background thread.
+  /// Does nothing if a precomputation is already running.
+  void PrecomputeAsync(int epochNumber, bool full);
+};
+
+#endif  // __EPOCHCONTEXTCACHE_H__
@@ -17,15 +17,16 @@
  * program files.
  */
 
+#include <pthread.h>
 #include <boost/algorithm/string/predicate.hpp>
 #include <chrono>
 #include <ctime>
 #include <iomanip>
 #include <iostream>
+#include <map>
 
 #include "common/Serializable.h"
 #include "libCrypto/Sha2.h"
-#include "libUtils/DataConversion.h"
 #include "pow.h"
 
 #ifdef OPENCL_MINE
@@ -38,12 +39,20 @@
 
 POW::POW() {
   m_currentBlockNum = 0;
-  m_epochContextLight =
-      ethash::create_epoch_context(ethash::get_epoch_number(m_currentBlockNum));
+  m_numMiningThreads = POW_CPU_MINING_THREADS;
+  m_hashRate = 0;
+  const int epochNumber = ethash::get_epoch_number(m_currentBlockNum);
+  const bool isMineFullCpu =
+      FULL_DATASET_MINE && !CUDA_GPU_MINE && !OPENCL_GPU_MINE;
 
-  if (FULL_DATASET_MINE && !CUDA_GPU_MINE && !OPENCL_GPU_MINE) {
-    m_epochContextFull = ethash::create_epoch_context_full(
-        ethash::get_epoch_number(m_currentBlockNum));
+  m_epochContextLight = m_contextCache.GetLightContext(epochNumber);
+
+  if (isMineFullCpu) {
+    m_epochContextFull = m_contextCache.GetFullContext(epochNumber);
+  }
+
+  if (!LOOKUP_NODE_MODE && POW_EPOCH_CONTEXT_CACHE) {
+    m_contextCache.PrecomputeAsync(epochNumber + 1, isMineFullCpu);
   }
 
   if (!LOOKUP_NODE_MODE) {
@@ -64,6 +73,10 @@ POW& POW::GetInstance() {
 
 void POW::StopMining() { m_shouldMine = false; }
 
+void POW::SetNumMiningThreads(unsigned int numThreads) {
+  m_numMiningThreads = numThreads;
+}
+
 std::string POW::BytesToHexString(const uint8_t* str, const uint64_t s) {
   std::ostringstream ret;
 
@@ -149,19 +162,24 @@ bool POW::EthashConfigureClient(uint64_t block_number, bool fullDataset) {
                     << " currentBlockNum: " << m_currentBlockNum);
   }
 
-  if (ethash::get_epoch_number(block_number) !=
-      ethash::get_epoch_number(m_currentBlockNum)) {
-    auto epochNumber = ethash::get_epoch_number(block_number);
-    m_epochContextLight = ethash::create_epoch_context(epochNumber);
+  const int epochNumber = ethash::get_epoch_number(block_number);
+  const bool epochChanged =
+      epochNumber != ethash::get_epoch_number(m_currentBlockNum);
+
+  if (epochChanged) {
+    std::atomic_store(&m_epochContextLight,
+                      m_contextCache.GetLightContext(epochNumber));
   }
 
   bool isMineFullCpu = fullDataset && !CUDA_GPU_MINE && !OPENCL_GPU_MINE;
 
-  if (isMineFullCpu && (m_epochContextFull == nullptr ||
-                        ethash::get_epoch_number(block_number) !=
-                            ethash::get_epoch_number(m_currentBlockNum))) {
-    m_epochContextFull = ethash::create_epoch_context_full(
-        ethash::get_epoch_number(block_number));
+  if (isMineFullCpu && (m_epochContextFull == nullptr || epochChanged)) {
+    m_epochContextFull = m_contextCache.GetFullContext(epochNumber);
+  }
+
+  // Get the following epoch ready before it is needed
+  if (epochChanged && !LOOKUP_NODE_MODE && POW_EPOCH_CONTEXT_CACHE) {
+    m_contextCache.PrecomputeAsync(epochNumber + 1, isMineFullCpu);
   }
 
   m_currentBlockNum = block_number;
@@ -169,40 +187,82 @@ bool POW::EthashConfigureClient(uint64_t block_number, bool fullDataset) {
   return true;
 }
 
-ethash_mining_result_t POW::MineLight(ethash_hash256 const& header_hash,
-                                      ethash_hash256 const& boundary) {
-  uint64_t nonce = std::time(0);
-  while (m_shouldMine) {
-    auto mineResult = ethash::hash(*m_epochContextLight, header_hash, nonce);
-    if (ethash::is_less_or_equal(mineResult.final_hash, boundary)) {
-      ethash_mining_result_t winning_result = {
-          BlockhashToHexString(mineResult.final_hash),
-          BlockhashToHexString(mineResult.mix_hash), nonce, true};
-      return winning_result;
+template <class Context>
+ethash_mining_result_t POW::MineCPU(const Context& context,
+                                    ethash_hash256 const& header_hash,
+                                    ethash_hash256 const& boundary) {
+  unsigned int numThreads = m_numMiningThreads;
+  if (numThreads == 0) {
+    numThreads = std::max(std::thread::hardware_concurrency(), 1U);
+  }
+
+  // Every thread searches its own contiguous segment of the nonce space
+  const uint64_t startNonce = std::time(0);
+  const uint64_t segmentSize = UINT64_MAX / numThreads;
+
+  std::mutex mutexResult;
+  ethash_mining_result_t result = {"", "", 0, false};
+  std::atomic<uint64_t> numHashes(0);
+
+  auto worker = [&](unsigned int index) {
+    if (POW_PIN_MINING_THREADS) {
+      cpu_set_t cpuSet;
+      CPU_ZERO(&cpuSet);
+      CPU_SET(index % std::max(std::thread::hardware_concurrency(), 1U),
+              &cpuSet);
+      pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+    }
+
+    uint64_t nonce = startNonce + index * segmentSize;
+    uint64_t count = 0;
+    while (m_shouldMine) {
+      auto mineResult = ethash::hash(context, header_hash, nonce);
+      count++;
+      if (ethash::is_less_or_equal(mineResult.final_hash, boundary)) {
+        std::lock_guard<std::mutex> g(mutexResult);
+        if (!result.success) {
+          result = {BlockhashToHexString(mineResult.final_hash),
+                    BlockhashToHexString(mineResult.mix_hash), nonce, true};
+        }
+        m_shouldMine = false;
+        break;
+      }
+      nonce++;
     }
-    nonce++;
+    numHashes += count;
+  };
+
+  auto startTime = std::chrono::steady_clock::now();
+
+  std::vector<std::thread> threads;
+  for (unsigned int i = 1; i < numThreads; i++) {
+    threads.emplace_back(worker, i);
   }
+  worker(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::steady_clock::now() - startTime)
+                       .count();
+  m_hashRate = numHashes * 1000 / std::max<uint64_t>(elapsedMs, 1);
+  LOG_GENERAL(INFO, "Mined " << numHashes << " hashes with " << numThreads
+                             << " threads in " << elapsedMs << " ms ("
+                             << m_hashRate << " H/s)");
 
-  ethash_mining_result_t failure_result = {"", "", 0, false};
-  return failure_result;
+  return result;
+}
+
+ethash_mining_result_t POW::MineLight(ethash_hash256 const& header_hash,
+                                      ethash_hash256 const& boundary) {
+  return MineCPU(*std::atomic_load(&m_epochContextLight), header_hash,
+                 boundary);
 }
 
 ethash_mining_result_t POW::MineFull(ethash_hash256 const& header_hash,
                                      ethash_hash256 const& boundary) {
-  uint64_t nonce = std::time(0);
-  while (m_shouldMine) {
-    auto mineResult = ethash::hash(*m_epochContextFull, header_hash, nonce);
-    if (ethash::is_less_or_equal(mineResult.final_hash, boundary)) {
-      ethash_mining_result_t winning_result = {
-          BlockhashToHexString(mineResult.final_hash),
-          BlockhashToHexString(mineResult.mix_hash), nonce, true};
-      return winning_result;
-    }
-    nonce++;
-  }
-
-  ethash_mining_result_t failure_result = {"", "", 0, false};
-  return failure_result;
+  return MineCPU(*m_epochContextFull, header_hash, boundary);
 }
 
 ethash_mining_result_t POW::MineFullGPU(uint64_t blockNum,
@@ -327,12 +387,10 @@ ethash_mining_result_t POW::PoWMine(
   std::lock_guard<std::mutex> g(m_mutexPoWMine);
   EthashConfigureClient(blockNum, fullDataset);
   auto boundary = DifficultyLevelInInt(difficulty);
-  std::vector<unsigned char> sha3_result =
-      ConcatAndhash(rand1, rand2, ipAddr, pubKey, lookupId, gasPrice);
 
   // Let's hash the inputs before feeding to ethash
   auto headerHash =
-      StringToBlockhash(DataConversion::Uint8VecToHexStr(sha3_result));
+      GetHeaderHash(rand1, rand2, ipAddr, pubKey, lookupId, gasPrice);
   ethash_mining_result_t result;
 
   m_shouldMine = true;
@@ -356,29 +414,103 @@ bool POW::PoWVerify(uint64_t blockNum, uint8_t difficulty,
                     uint64_t winning_nonce, const std::string& winning_result,
                     const std::string& winning_mixhash) {
   LOG_MARKER();
-  EthashConfigureClient(blockNum);
-  const auto boundary = DifficultyLevelInInt(difficulty);
-  std::vector<unsigned char> sha3_result =
-      ConcatAndhash(rand1, rand2, ipAddr, pubKey, lookupId, gasPrice);
-  auto headerHash =
-      StringToBlockhash(DataConversion::Uint8VecToHexStr(sha3_result));
-  auto winnning_result = StringToBlockhash(winning_result);
-  auto winningMixhash = StringToBlockhash(winning_mixhash);
+  return PoWVerify(
+      {blockNum, difficulty,
+       GetHeaderHash(rand1, rand2, ipAddr, pubKey, lookupId, gasPrice),
+       winning_nonce, StringToBlockhash(winning_result),
+       StringToBlockhash(winning_mixhash)});
+}
 
-  if (!ethash::is_less_or_equal(winnning_result, boundary)) {
+bool POW::PoWVerify(const PoWVerifyRequest& request) {
+  return PoWVerify(request, *GetLightContext(request.blockNum));
+}
+
+bool POW::PoWVerify(const PoWVerifyRequest& request,
+                    const ethash::epoch_context& context) {
+  const auto boundary = DifficultyLevelInInt(request.difficulty);
+
+  if (!ethash::is_less_or_equal(request.result, boundary)) {
     LOG_GENERAL(WARNING, "PoW solution doesn't meet difficulty requirement");
     return false;
   }
 
-  return ethash::verify(*m_epochContextLight, headerHash, winningMixhash,
-                        winning_nonce, boundary);
+  return ethash::verify(context, request.headerHash, request.mixHash,
+                        request.nonce, boundary);
+}
+
+std::vector<unsigned char> POW::PoWVerifyBatch(
+    const std::vector<PoWVerifyRequest>& requests) {
+  std::vector<unsigned char> results(requests.size(), 0);
+
+  // Look up the context of every epoch in the batch before verifying, so
+  // that requests from different epochs never reconfigure the shared light
+  // context (and the workers never contend for it)
+  std::map<int, std::shared_ptr<ethash::epoch_context>> epochContexts;
+  std::vector<const ethash::epoch_context*> contexts(requests.size());
+  const auto current = std::atomic_load(&m_epochContextLight);
+  for (size_t i = 0; i < requests.size(); i++) {
+    const int epochNumber = ethash::get_epoch_number(requests[i].blockNum);
+    auto& context = epochContexts[epochNumber];
+    if (!context) {
+      context = (current->epoch_number == epochNumber)
+                    ? current
+                    : m_contextCache.GetLightContext(epochNumber);
+    }
+    contexts[i] = context.get();
+  }
+
+  if (requests.size() < 2 || POW_VERIFY_THREADS < 2) {
+    for (size_t i = 0; i < requests.size(); i++) {
+      results[i] = PoWVerify(requests[i], *contexts[i]);
+    }
+    return results;
+  }
+
+  std::lock_guard<std::mutex> g(m_mutexVerifyPool);
+
+  const size_t numJobs =
+      std::min(requests.size(), (size_t)POW_VERIFY_THREADS);
+  for (size_t job = 0; job < numJobs; job++) {
+    m_verifyPool.AddJob(
+        [this, job, numJobs, &requests, &contexts, &results]() -> void {
+          for (size_t i = job; i < requests.size(); i += numJobs) {
+            results[i] = PoWVerify(requests[i], *contexts[i]);
+          }
+        });
+  }
+  m_verifyPool.WaitAll();
+
+  return results;
+}
+
+ethash_hash256 POW::GetHeaderHash(
+    const std::array<unsigned char, UINT256_SIZE>& rand1,
+    const std::array<unsigned char, UINT256_SIZE>& rand2,
+    const boost::multiprecision::uint128_t& ipAddr, const PubKey& pubKey,
+    uint32_t lookupId, const boost::multiprecision::uint128_t& gasPrice) {
+  std::vector<unsigned char> sha2_result =
+      ConcatAndhash(rand1, rand2, ipAddr, pubKey, lookupId, gasPrice);
+
+  ethash_hash256 headerHash;
+  std::copy(sha2_result.begin(), sha2_result.end(), headerHash.bytes);
+  return headerHash;
+}
+
+std::shared_ptr<ethash::epoch_context> POW::GetLightContext(
+    uint64_t blockNum) {
+  auto context = std::atomic_load(&m_epochContextLight);
+  if (context->epoch_number == ethash::get_epoch_number(blockNum)) {
+    return context;
+  }
+
+  EthashConfigureClient(blockNum);
+  return std::atomic_load(&m_epochContextLight);
 }
 
 ethash::result POW::LightHash(uint64_t blockNum,
                               ethash_hash256 const& header_hash,
                               uint64_t nonce) {
-  EthashConfigureClient(blockNum);
-  return ethash::hash(*m_epochContextLight, header_hash, nonce);
+  return ethash::hash(*GetLightContext(blockNum), header_hash, nonce);
 }
 
 bool POW::CheckSolnAgainstsTargetedDifficulty(const ethash_hash256& result,
@@ -22,6 +22,7 @@
 
 #include <stdint.h>
 #include <array>
+#include <atomic>
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-parameter"
 #include <boost/multiprecision/cpp_int.hpp>
@@ -31,12 +32,14 @@
 #include <thread>
 #include <vector>
 
+#include "EpochContextCache.h"
 #include "common/Constants.h"
 #include "depends/common/Miner.h"
 #include "depends/libethash/include/ethash/ethash.hpp"
 //#include "ethash/ethash.hpp"
 #include "libCrypto/Schnorr.h"
 #include "libUtils/Logger.h"
+#include "libUtils/ThreadPool.h"
 
 /// Stores the result of PoW mining.
 typedef struct ethash_mining_result {
@@ -46,6 +49,16 @@ typedef struct ethash_mining_result {
   bool success;
 } ethash_mining_result_t;
 
+/// Stores the inputs of one PoW verification, with all hashes in binary form.
+struct PoWVerifyRequest {
+  uint64_t blockNum;
+  uint8_t difficulty;
+  ethash_hash256 headerHash;
+  uint64_t nonce;
+  ethash_hash256 result;
+  ethash_hash256 mixHash;
+};
+
 /// Implements the proof-of-work functionality.
 class POW {
   static std::string BytesToHexString(const uint8_t* str, const uint64_t s);
@@ -85,6 +98,13 @@ class POW {
   /// Terminates proof-of-work mining.
   void StopMining();
 
+  /// Sets the number of threads used for CPU mining (0 for one per hardware
+  /// thread). Defaults to POW_CPU_MINING_THREADS.
+  void SetNumMiningThreads(unsigned int numThreads);
+
+  /// Returns the hash rate (hashes per second) of the last CPU mining run.
+  uint64_t GetHashRate() const { return m_hashRate; }
+
   /// Verifies a proof-of-work submission.
   bool PoWVerify(uint64_t blockNum, uint8_t difficulty,
                  const std::array<unsigned char, UINT256_SIZE>& rand1,
@@ -94,6 +114,22 @@ class POW {
                  const boost::multiprecision::uint128_t& gasPrice,
                  uint64_t winning_nonce, const std::string& winning_result,
                  const std::string& winning_mixhash);
+
+  /// Verifies a proof-of-work submission whose hashes are already in binary
+  /// form. Safe to call concurrently.
+  bool PoWVerify(const PoWVerifyRequest& request);
+
+  /// Verifies a batch of proof-of-work submissions on POW_VERIFY_THREADS
+  /// threads. Element i of the result is nonzero if request i is valid.
+  std::vector<unsigned char> PoWVerifyBatch(
+      const std::vector<PoWVerifyRequest>& requests);
+
+  /// Returns the ethash header hash of the PoW inputs.
+  ethash_hash256 GetHeaderHash(
+      const std::array<unsigned char, UINT256_SIZE>& rand1,
+      const std::array<unsigned char, UINT256_SIZE>& rand2,
+      const boost::multiprecision::uint128_t& ipAddr, const PubKey& pubKey,
+      uint32_t lookupId, const boost::multiprecision::uint128_t& gasPrice);
   std::vector<unsigned char> ConcatAndhash(
       const std::array<unsigned char, UINT256_SIZE>& rand1,
       const std::array<unsigned char, UINT256_SIZE>& rand2,
@@ -108,20 +144,35 @@ class POW {
   static std::set<unsigned int> GetGpuToUse();
 
  private:
+  // Read and replaced through std::atomic_load / std::atomic_store only, so
+  // that verifiers can share it without holding m_mutexLightClientConfigure
   std::shared_ptr<ethash::epoch_context> m_epochContextLight = nullptr;
   std::shared_ptr<ethash::epoch_context_full> m_epochContextFull = nullptr;
+  EpochContextCache m_contextCache;
   uint64_t m_currentBlockNum;
   std::atomic<bool> m_shouldMine;
+  std::atomic<unsigned int> m_numMiningThreads;
+  std::atomic<uint64_t> m_hashRate;
   std::vector<dev::eth::MinerPtr> m_miners;
   std::vector<ethash_mining_result_t> m_vecMiningResult;
   std::atomic<int> m_minerIndex;
   std::condition_variable m_cvMiningResult;
   std::mutex m_mutexMiningResult;
+  std::mutex m_mutexVerifyPool;
+  ThreadPool m_verifyPool{POW_VERIFY_THREADS, "PoWVerifyPool"};
+
+  std::shared_ptr<ethash::epoch_context> GetLightContext(uint64_t blockNum);
+  bool PoWVerify(const PoWVerifyRequest& request,
+                 const ethash::epoch_context& context);
 
   ethash_mining_result_t MineLight(ethash_hash256 const& header_hash,
                                    ethash_hash256 const& boundary);
   ethash_mining_result_t MineFull(ethash_hash256 const& header_hash,
                                   ethash_hash256 const& boundary);
+  template <class Context>
+  ethash_mining_result_t MineCPU(const Context& context,
+                                 ethash_hash256 const& header_hash,
+                                 ethash_hash256 const& boundary);
   ethash_mining_result_t MineFullGPU(uint64_t blockNum,
                                      ethash_hash256 const& header_hash,
                                      uint8_t difficulty);
@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstring>
+
+#include <boost/crc.hpp>
+#include <boost/filesystem.hpp>
+
+#include "BlockArchive.h"
+#include "common/Constants.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+namespace {
+bool WriteAll(int fd, const unsigned char* data, size_t size, off_t offset) {
+  while (size > 0) {
+    ssize_t written = pwrite(fd, data, size, offset);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    data += written;
+    size -= written;
+    offset += written;
+  }
+  return true;
+}
+
+uint32_t GetChecksum(const unsigned char* data, size_t size) {
+  boost::crc_32_type crc;
+  crc.process_bytes(data, size);
+  return crc.checksum();
+}
+
+uint64_t GetFileSize(int fd) {
+  struct stat st;
+  return (fstat(fd, &st) == 0) ? st.st_size : 0;
+}
+}  // namespace
+
+BlockArchive::BlockArchive(const string& name)
+    : m_dataPath("./" + PERSISTENCE_PATH + "/" + name + ".dat"),
+      m_indexPath("./" + PERSISTENCE_PATH + "/" + name + ".idx"),
+      m_dataFd(-1),
+      m_indexFd(-1),
+      m_dataSize(0),
+      m_map(nullptr),
+      m_mapSize(0) {
+  if (!boost::filesystem::exists("./" + PERSISTENCE_PATH)) {
+    boost::filesystem::create_directories("./" + PERSISTENCE_PATH);
+  }
+
+  m_dataFd = open(m_dataPath.c_str(), O_RDWR | O_CREAT, 0644);
+  m_indexFd = open(m_indexPath.c_str(), O_RDWR | O_CREAT, 0644);
+  if (m_dataFd < 0 || m_indexFd < 0) {
+    LOG_GENERAL(WARNING, "Failed to open block archive " << name << ": "
+                                                         << strerror(errno));
+    return;
+  }
+
+  m_dataSize = GetFileSize(m_dataFd);
+
+  const uint64_t indexSize = GetFileSize(m_indexFd);
+  const uint64_t numEntries = indexSize / sizeof(IndexEntry);
+  if (numEntries > 0) {
+    void* indexMap = mmap(nullptr, numEntries * sizeof(IndexEntry), PROT_READ,
+                          MAP_SHARED, m_indexFd, 0);
+    if (indexMap == MAP_FAILED) {
+      LOG_GENERAL(WARNING, "Failed to map block archive index " << name);
+    } else {
+      const IndexEntry* entries = static_cast<const IndexEntry*>(indexMap);
+      m_index.assign(entries, entries + numEntries);
+      munmap(indexMap, numEntries * sizeof(IndexEntry));
+    }
+  }
+
+  // Drop entries written before their data made it to disk
+  for (auto& entry : m_index) {
+    if (entry.size > 0 && entry.offset + entry.size > m_dataSize) {
+      entry = IndexEntry();
+    }
+  }
+  TrimIndex();
+
+  LOG_GENERAL(INFO, "Opened block archive " << name << " with "
+                                            << m_index.size() << " entries");
+}
+
+BlockArchive::~BlockArchive() {
+  Unmap();
+  if (m_dataFd >= 0) {
+    close(m_dataFd);
+  }
+  if (m_indexFd >= 0) {
+    close(m_indexFd);
+  }
+}
+
+void BlockArchive::Unmap() {
+  if (m_map != nullptr) {
+    munmap(m_map, m_mapSize);
+    m_map = nullptr;
+    m_mapSize = 0;
+  }
+}
+
+bool BlockArchive::WriteIndexEntry(uint64_t blockNum) {
+  return WriteAll(m_indexFd,
+                  reinterpret_cast<const unsigned char*>(&m_index[blockNum]),
+                  sizeof(IndexEntry), blockNum * sizeof(IndexEntry));
+}
+
+void BlockArchive::TrimIndex() {
+  size_t numEntries = m_index.size();
+  while (numEntries > 0 && m_index[numEntries - 1].size == 0) {
+    numEntries--;
+  }
+  if (numEntries != m_index.size() ||
+      GetFileSize(m_indexFd) != numEntries * sizeof(IndexEntry)) {
+    m_index.resize(numEntries);
+    if (ftruncate(m_indexFd, numEntries * sizeof(IndexEntry)) != 0) {
+      LOG_GENERAL(WARNING, "Failed to truncate " << m_indexPath);
+    }
+  }
+}
+
+bool BlockArchive::Put(const uint64_t& blockNum,
+                       const vector<unsigned char>& body) {
+  lock_guard<mutex> g(m_mutex);
+
+  if (m_dataFd < 0 || m_indexFd < 0 || body.empty()) {
+    return false;
+  }
+
+  // Records are never overwritten, so a torn write cannot damage a block
+  // that is already indexed
+  const uint32_t checksum = GetChecksum(body.data(), body.size());
+  const uint64_t offset = m_dataSize;
+  if (!WriteAll(m_dataFd, body.data(), body.size(), offset)) {
+    LOG_GENERAL(WARNING, "Failed to write block " << blockNum << " to "
+                                                  << m_dataPath);
+    return false;
+  }
+  m_dataSize = offset + body.size();
+
+  if (blockNum >= m_index.size()) {
+    m_index.resize(blockNum + 1, IndexEntry());
+  }
+  m_index[blockNum] = {offset, (uint32_t)body.size(), checksum};
+
+  if (!WriteIndexEntry(blockNum)) {
+    LOG_GENERAL(WARNING, "Failed to index block " << blockNum << " in "
+                                                  << m_indexPath);
+    return false;
+  }
+
+  return true;
+}
+
+bool BlockArchive::Get(const uint64_t& blockNum, vector<unsigned char>& body) {
+  lock_guard<mutex> g(m_mutex);
+
+  if (blockNum >= m_index.size() || m_index[blockNum].size == 0) {
+    return false;
+  }
+
+  const IndexEntry& entry = m_index[blockNum];
+
+  // The mapping only covers the file as it was when last mapped
+  if (entry.offset + entry.size > m_mapSize) {
+    Unmap();
+    void* map =
+        mmap(nullptr, m_dataSize, PROT_READ, MAP_SHARED, m_dataFd, 0);
+    if (map == MAP_FAILED) {
+      LOG_GENERAL(WARNING, "Failed to map " << m_dataPath << ": "
+                                            << strerror(errno));
+      return false;
+    }
+    m_map = static_cast<unsigned char*>(map);
+    m_mapSize = m_dataSize;
+  }
+
+  if (GetChecksum(m_map + entry.offset, entry.size) != entry.checksum) {
+    LOG_GENERAL(WARNING, "Checksum mismatch for block " << blockNum << " in "
+                                                        << m_dataPath);
+    return false;
+  }
+
+  body.assign(m_map + entry.offset, m_map + entry.offset + entry.size);
+  return true;
+}
+
+bool BlockArchive::Delete(const uint64_t& blockNum) {
+  lock_guard<mutex> g(m_mutex);
+
+  if (blockNum >= m_index.size()) {
+    return false;
+  }
+
+  m_index[blockNum] = IndexEntry();
+  if (blockNum + 1 == m_index.size()) {
+    TrimIndex();
+    return true;
+  }
+  return WriteIndexEntry(blockNum);
+}
+
+uint64_t BlockArchive::GetBlockCount() {
+  lock_guard<mutex> g(m_mutex);
+  return m_index.size();
+}
+
+bool BlockArchive::Reset() {
+  lock_guard<mutex> g(m_mutex);
+
+  Unmap();
+  m_index.clear();
+  m_dataSize = 0;
+
+  return (ftruncate(m_dataFd, 0) == 0) && (ftruncate(m_indexFd, 0) == 0);
+}
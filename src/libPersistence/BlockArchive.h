@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#ifndef __BLOCKARCHIVE_H__
+#define __BLOCKARCHIVE_H__
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/// Append-only file of serialized blocks indexed by block number.
+/// Records are appended to <name>.dat and never rewritten, and <name>.idx
+/// holds one fixed-size {offset, size, checksum} entry per block number, so a
+/// block is found without scanning or decoding anything else. Reads are served
+/// from a read-only mapping of the data file, and a record that does not match
+/// its checksum is reported as absent.
+class BlockArchive {
+  struct IndexEntry {
+    uint64_t offset;
+    uint32_t size;  // 0 if the block is absent
+    uint32_t checksum;
+  };
+
+  const std::string m_dataPath;
+  const std::string m_indexPath;
+
+  int m_dataFd;
+  int m_indexFd;
+  uint64_t m_dataSize;
+  std::vector<IndexEntry> m_index;
+
+  unsigned char* m_map;
+  size_t m_mapSize;
+
+  std::mutex m_mutex;
+
+  void Unmap();
+  bool WriteIndexEntry(uint64_t blockNum);
+  void TrimIndex();
+
+ public:
+  /// Constructor. Opens (or creates) the archive files under the persistence
+  /// directory.
+  explicit BlockArchive(const std::string& name);
+
+  /// Destructor.
+  ~BlockArchive();
+
+  BlockArchive(const BlockArchive&) = delete;
+  BlockArchive& operator=(const BlockArchive&) = delete;
+
+  /// Appends the block body and points the index at it, replacing any earlier
+  /// body for the block number.
+  bool Put(const uint64_t& blockNum, const std::vector<unsigned char>& body);
+
+  /// Retrieves the block body.
+  bool Get(const uint64_t& blockNum, std::vector<unsigned char>& body);
+
+  /// Removes the block from the index.
+  bool Delete(const uint64_t& blockNum);
+
+  /// Returns one past the highest block number stored.
+  uint64_t GetBlockCount();
+
+  /// Removes all blocks.
+  bool Reset();
+};
+
+#endif  // __BLOCKARCHIVE_H__
@@ -37,25 +37,169 @@
 
 using namespace std;
 
+const string BlockStorage::SHARED_DB_NAME = "blockStorage";
+
 BlockStorage& BlockStorage::GetBlockStorage() {
   static BlockStorage bs;
   return bs;
 }
 
+namespace {
+const string TXBODY_FILTER_PATH = "./" + PERSISTENCE_PATH + "/txBodies.bloom";
+}  // namespace
+
+BlockStorage::~BlockStorage() {
+  if (m_txBodyFilter && m_txBodyFilterReady) {
+    m_txBodyFilter->Save(TXBODY_FILTER_PATH);
+  }
+}
+
+void BlockStorage::InitTxBodyFilter() {
+  LOG_MARKER();
+
+  m_txBodyFilter =
+      make_shared<BloomFilter>((size_t)TXBODY_FILTER_SIZE_MB << 20);
+
+  // The saved filter is only valid until the next write, so it is removed
+  // once loaded; after a crash the filter is rebuilt from the database
+  if (m_txBodyFilter->Load(TXBODY_FILTER_PATH)) {
+    boost::filesystem::remove(TXBODY_FILTER_PATH);
+    m_txBodyFilterReady = true;
+    LOG_GENERAL(INFO, "Loaded txn body filter with "
+                          << m_txBodyFilter->GetNumInserted() << " entries");
+    return;
+  }
+
+  RebuildTxBodyFilter();
+}
+
+void BlockStorage::RebuildTxBodyFilter() {
+  LOG_MARKER();
+
+  // Lookups fall back to the database while the filter is incomplete
+  m_txBodyFilterReady = false;
+  m_txBodyFilter->Clear();
+
+  leveldb::Iterator* it = m_txBodyDB->NewIterator();
+  for (it->SeekToFirst(); it->Valid(); it->Next()) {
+    try {
+      m_txBodyFilter->Insert(dev::h256(it->key().ToString()));
+    } catch (...) {
+      LOG_GENERAL(WARNING, "Invalid txn body key " << it->key().ToString());
+    }
+  }
+  delete it;
+
+  m_txBodyFilterReady = true;
+
+  LOG_GENERAL(INFO, "Rebuilt txn body filter with "
+                        << m_txBodyFilter->GetNumInserted() << " entries");
+}
+
 bool BlockStorage::PutBlock(const uint64_t& blockNum,
                             const vector<unsigned char>& body,
                             const BlockType& blockType) {
   int ret = -1;  // according to LevelDB::Insert return value
+  shared_ptr<BlockArchive> archive;
   if (blockType == BlockType::DS) {
     ret = m_dsBlockchainDB->Insert(blockNum, body);
+    archive = m_dsBlockArchive;
     LOG_GENERAL(INFO, "Stored DsBlock  Num:" << blockNum);
   } else if (blockType == BlockType::Tx) {
     ret = m_txBlockchainDB->Insert(blockNum, body);
+    archive = m_txBlockArchive;
     LOG_GENERAL(INFO, "Stored TxBlock  Num:" << blockNum);
   }
+
+  // The archive is only an index for fast reads; LevelDB stays authoritative
+  if (ret == 0 && archive && !archive->Put(blockNum, body)) {
+    LOG_GENERAL(WARNING, "Failed to archive block " << blockNum);
+  }
+
   return (ret == 0);
 }
 
+bool BlockStorage::ImportBlockArchive(const shared_ptr<LevelDB>& db,
+                                      const shared_ptr<BlockArchive>& archive) {
+  LOG_MARKER();
+
+  unsigned int count = 0;
+  leveldb::Iterator* it = db->NewIterator();
+  for (it->SeekToFirst(); it->Valid(); it->Next()) {
+    uint64_t blockNum;
+    try {
+      blockNum = stoull(it->key().ToString());
+    } catch (...) {
+      LOG_GENERAL(WARNING, "Invalid block number " << it->key().ToString());
+      delete it;
+      return false;
+    }
+    const leveldb::Slice& value = it->value();
+    if (!archive->Put(blockNum,
+                      vector<unsigned char>(value.data(),
+                                            value.data() + value.size()))) {
+      delete it;
+      return false;
+    }
+    count++;
+  }
+  delete it;
+
+  LOG_GENERAL(INFO, "Imported " << count << " blocks into block archive");
+  return true;
+}
+
+bool BlockStorage::ReconcileBlockArchive(
+    const shared_ptr<LevelDB>& db, const shared_ptr<BlockArchive>& archive) {
+  uint64_t count = archive->GetBlockCount();
+
+  if (count > 0) {
+    leveldb::Iterator* it = db->NewIterator();
+    it->SeekToFirst();
+    const bool empty = !it->Valid();
+    delete it;
+    if (empty) {
+      return archive->Reset();
+    }
+  }
+
+  // Blocks past the end of LevelDB were deleted there
+  while (count > 0 && db->Lookup(count - 1).empty()) {
+    archive->Delete(count - 1);
+    count = archive->GetBlockCount();
+  }
+
+  // A database written before the archive existed, or replaced since (e.g.,
+  // downloaded), is imported in full
+  if (count > 0) {
+    const string stored = db->Lookup(count - 1);
+    vector<unsigned char> archived;
+    if (!archive->Get(count - 1, archived) ||
+        string(archived.begin(), archived.end()) != stored) {
+      LOG_GENERAL(INFO, "Block archive does not match LevelDB at block "
+                            << count - 1);
+      if (!archive->Reset()) {
+        return false;
+      }
+      count = 0;
+    }
+  }
+  if (count == 0) {
+    return ImportBlockArchive(db, archive);
+  }
+
+  // Blocks past the end of the archive, e.g., after a failed archive write
+  for (string stored = db->Lookup(count); !stored.empty();
+       stored = db->Lookup(++count)) {
+    if (!archive->Put(count,
+                      vector<unsigned char>(stored.begin(), stored.end()))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 bool BlockStorage::PutDSBlock(const uint64_t& blockNum,
                               const vector<unsigned char>& body) {
   bool ret = false;
@@ -107,11 +251,70 @@ bool BlockStorage::PutTxBody(const dev::h256& key,
   } else  // IS_LOOKUP_NODE
   {
     ret = m_txBodyDB->Insert(key, body) && m_txBodyTmpDB->Insert(key, body);
+    m_txBodyFilter->Insert(key);
   }
 
   return (ret == 0);
 }
 
+void BlockStorage::PutTxBlock(Batch& batch, const uint64_t& blockNum,
+                              const vector<unsigned char>& body) {
+  m_txBlockchainDB->BatchPut(batch.For(m_txBlockchainDB), blockNum, body);
+  batch.m_txBlocks.emplace_back(blockNum, body);
+}
+
+void BlockStorage::PutMicroBlock(Batch& batch, const BlockHash& blockHash,
+                                 const vector<unsigned char>& body) {
+  m_microBlockDB->BatchPut(batch.For(m_microBlockDB), blockHash, body);
+}
+
+void BlockStorage::PutTxBody(Batch& batch, const dev::h256& key,
+                             const vector<unsigned char>& body) {
+  if (!LOOKUP_NODE_MODE) {
+    LOG_GENERAL(WARNING, "Non lookup node should not trigger this.");
+    return;
+  }
+  m_txBodyDB->BatchPut(batch.For(m_txBodyDB), key, body);
+  m_txBodyTmpDB->BatchPut(batch.For(m_txBodyTmpDB), key, body);
+  m_txBodyFilter->Insert(key);
+}
+
+void BlockStorage::PutStateDelta(Batch& batch, const uint64_t& finalBlockNum,
+                                 const vector<unsigned char>& stateDelta) {
+  m_stateDeltaDB->BatchPut(batch.For(m_stateDeltaDB), finalBlockNum,
+                           stateDelta);
+}
+
+void BlockStorage::PutMetadata(Batch& batch, MetaType type,
+                               const vector<unsigned char>& data) {
+  m_metadataDB->BatchPut(batch.For(m_metadataDB), to_string((int)type), data);
+}
+
+bool BlockStorage::CommitBatch(Batch& batch) {
+  LOG_MARKER();
+
+  bool ret = true;
+  for (auto& write : batch.m_writes) {
+    if (!write.first->Write(leveldb::WriteOptions(), &write.second).ok()) {
+      LOG_GENERAL(WARNING, "Failed to commit block storage batch");
+      ret = false;
+    }
+  }
+
+  if (ret) {
+    for (const auto& txBlock : batch.m_txBlocks) {
+      if (!m_txBlockArchive->Put(txBlock.first, txBlock.second)) {
+        LOG_GENERAL(WARNING, "Failed to archive block " << txBlock.first);
+      }
+    }
+  }
+
+  batch.m_writes.clear();
+  batch.m_txBlocks.clear();
+
+  return ret;
+}
+
 bool BlockStorage::PutMicroBlock(const BlockHash& blockHash,
                                  const vector<unsigned char>& body) {
   int ret = m_microBlockDB->Insert(blockHash, body);
@@ -141,8 +344,7 @@ bool BlockStorage::GetRangeMicroBlocks(const uint64_t lowEpochNum,
                                        list<MicroBlockSharedPtr>& blocks) {
   LOG_MARKER();
 
-  leveldb::Iterator* it =
-      m_microBlockDB->GetDB()->NewIterator(leveldb::ReadOptions());
+  leveldb::Iterator* it = m_microBlockDB->NewIterator();
   for (it->SeekToFirst(); it->Valid(); it->Next()) {
     string bns = it->key().ToString();
     string blockString = it->value().ToString();
@@ -177,16 +379,21 @@ bool BlockStorage::GetRangeMicroBlocks(const uint64_t lowEpochNum,
 
 bool BlockStorage::GetDSBlock(const uint64_t& blockNum,
                               DSBlockSharedPtr& block) {
-  string blockString = m_dsBlockchainDB->Lookup(blockNum);
+  vector<unsigned char> blockBytes;
+  if (!m_dsBlockArchive->Get(blockNum, blockBytes)) {
+    string blockString = m_dsBlockchainDB->Lookup(blockNum);
 
-  if (blockString.empty()) {
-    return false;
+    if (blockString.empty()) {
+      return false;
+    }
+
+    // LOG_GENERAL(INFO, blockString);
+    LOG_GENERAL(INFO, blockString.length());
+    blockBytes.assign(blockString.begin(), blockString.end());
+    m_dsBlockArchive->Put(blockNum, blockBytes);
   }
 
-  // LOG_GENERAL(INFO, blockString);
-  LOG_GENERAL(INFO, blockString.length());
-  block = DSBlockSharedPtr(new DSBlock(
-      std::vector<unsigned char>(blockString.begin(), blockString.end()), 0));
+  block = DSBlockSharedPtr(new DSBlock(blockBytes, 0));
 
   return true;
 }
@@ -250,18 +457,37 @@ bool BlockStorage::GetBlockLink(const uint64_t& index,
 
 bool BlockStorage::GetTxBlock(const uint64_t& blockNum,
                               TxBlockSharedPtr& block) {
-  string blockString = m_txBlockchainDB->Lookup(blockNum);
+  vector<unsigned char> blockBytes;
+  if (!m_txBlockArchive->Get(blockNum, blockBytes)) {
+    string blockString = m_txBlockchainDB->Lookup(blockNum);
 
-  if (blockString.empty()) {
-    return false;
+    if (blockString.empty()) {
+      return false;
+    }
+
+    blockBytes.assign(blockString.begin(), blockString.end());
+    m_txBlockArchive->Put(blockNum, blockBytes);
   }
 
-  block = TxBlockSharedPtr(new TxBlock(
-      std::vector<unsigned char>(blockString.begin(), blockString.end()), 0));
+  block = TxBlockSharedPtr(new TxBlock(blockBytes, 0));
 
   return true;
 }
 
+uint64_t BlockStorage::GetDSBlockCount() {
+  if (!ReconcileBlockArchive(m_dsBlockchainDB, m_dsBlockArchive)) {
+    LOG_GENERAL(WARNING, "Failed to reconcile DS block archive");
+  }
+  return m_dsBlockArchive->GetBlockCount();
+}
+
+uint64_t BlockStorage::GetTxBlockCount() {
+  if (!ReconcileBlockArchive(m_txBlockchainDB, m_txBlockArchive)) {
+    LOG_GENERAL(WARNING, "Failed to reconcile Tx block archive");
+  }
+  return m_txBlockArchive->GetBlockCount();
+}
+
 bool BlockStorage::GetTxBody(const dev::h256& key, TxBodySharedPtr& body) {
   std::string bodyString;
   if (!LOOKUP_NODE_MODE) {
@@ -269,6 +495,10 @@ bool BlockStorage::GetTxBody(const dev::h256& key, TxBodySharedPtr& body) {
     return false;
   } else  // IS_LOOKUP_NODE
   {
+    // Unknown hashes (e.g., bogus API queries) are rejected without a lookup
+    if (m_txBodyFilterReady && !m_txBodyFilter->MayContain(key)) {
+      return false;
+    }
     bodyString = m_txBodyDB->Lookup(key);
   }
 
@@ -281,8 +511,40 @@ bool BlockStorage::GetTxBody(const dev::h256& key, TxBodySharedPtr& body) {
   return true;
 }
 
+bool BlockStorage::GetTxBodies(const vector<dev::h256>& keys,
+                               vector<TxBodySharedPtr>& bodies) {
+  if (!LOOKUP_NODE_MODE) {
+    LOG_GENERAL(WARNING, "Non lookup node should not trigger this.");
+    return false;
+  }
+
+  bodies.assign(keys.size(), nullptr);
+
+  vector<dev::h256> knownKeys;
+  vector<size_t> knownIndexes;
+  for (size_t i = 0; i < keys.size(); i++) {
+    if (!m_txBodyFilterReady || m_txBodyFilter->MayContain(keys[i])) {
+      knownKeys.emplace_back(keys[i]);
+      knownIndexes.emplace_back(i);
+    }
+  }
+
+  vector<string> bodyStrings = m_txBodyDB->BatchLookup(knownKeys);
+  for (size_t i = 0; i < bodyStrings.size(); i++) {
+    if (bodyStrings[i].empty()) {
+      continue;
+    }
+    bodies[knownIndexes[i]] = TxBodySharedPtr(new TransactionWithReceipt(
+        vector<unsigned char>(bodyStrings[i].begin(), bodyStrings[i].end()),
+        0));
+  }
+
+  return true;
+}
+
 bool BlockStorage::DeleteDSBlock(const uint64_t& blocknum) {
   LOG_GENERAL(INFO, "Delete DSBlock Num: " << blocknum);
+  m_dsBlockArchive->Delete(blocknum);
   int ret = m_dsBlockchainDB->DeleteKey(blocknum);
   return (ret == 0);
 }
@@ -299,6 +561,7 @@ bool BlockStorage::DeleteFallbackBlock(const BlockHash& blockhash) {
 
 bool BlockStorage::DeleteTxBlock(const uint64_t& blocknum) {
   LOG_GENERAL(INFO, "Delete TxBlock Num: " << blocknum);
+  m_txBlockArchive->Delete(blocknum);
   int ret = m_txBlockchainDB->DeleteKey(blocknum);
   return (ret == 0);
 }
@@ -335,8 +598,7 @@ bool BlockStorage::DeleteTxBody(const dev::h256& key) {
 bool BlockStorage::GetAllDSBlocks(std::list<DSBlockSharedPtr>& blocks) {
   LOG_MARKER();
 
-  leveldb::Iterator* it =
-      m_dsBlockchainDB->GetDB()->NewIterator(leveldb::ReadOptions());
+  leveldb::Iterator* it = m_dsBlockchainDB->NewIterator();
   for (it->SeekToFirst(); it->Valid(); it->Next()) {
     string bns = it->key().ToString();
     string blockString = it->value().ToString();
@@ -365,8 +627,7 @@ bool BlockStorage::GetAllDSBlocks(std::list<DSBlockSharedPtr>& blocks) {
 bool BlockStorage::GetAllTxBlocks(std::list<TxBlockSharedPtr>& blocks) {
   LOG_MARKER();
 
-  leveldb::Iterator* it =
-      m_txBlockchainDB->GetDB()->NewIterator(leveldb::ReadOptions());
+  leveldb::Iterator* it = m_txBlockchainDB->NewIterator();
   for (it->SeekToFirst(); it->Valid(); it->Next()) {
     string bns = it->key().ToString();
     string blockString = it->value().ToString();
@@ -401,8 +662,7 @@ bool BlockStorage::GetAllTxBodiesTmp(std::list<TxnHash>& txnHashes) {
 
   LOG_MARKER();
 
-  leveldb::Iterator* it =
-      m_txBodyTmpDB->GetDB()->NewIterator(leveldb::ReadOptions());
+  leveldb::Iterator* it = m_txBodyTmpDB->NewIterator();
   for (it->SeekToFirst(); it->Valid(); it->Next()) {
     string hashString = it->key().ToString();
     if (hashString.empty()) {
@@ -420,8 +680,7 @@ bool BlockStorage::GetAllTxBodiesTmp(std::list<TxnHash>& txnHashes) {
 
 bool BlockStorage::GetAllBlockLink(std::list<BlockLink>& blocklinks) {
   LOG_MARKER();
-  leveldb::Iterator* it =
-      m_blockLinkDB->GetDB()->NewIterator(leveldb::ReadOptions());
+  leveldb::Iterator* it = m_blockLinkDB->NewIterator();
   for (it->SeekToFirst(); it->Valid(); it->Next()) {
     string bns = it->key().ToString();
     string blockString = it->value().ToString();
@@ -550,6 +809,57 @@ bool BlockStorage::GetDSCommittee(
   return true;
 }
 
+bool BlockStorage::PutDSCommitteeCheckpoint(
+    const uint64_t& linkIndex, const BlockHash& linkHash,
+    const deque<pair<PubKey, Peer>>& dsCommittee) {
+  LOG_MARKER();
+
+  vector<unsigned char> data;
+  unsigned int offset = 0;
+  Serializable::SetNumber<uint64_t>(data, offset, linkIndex, sizeof(uint64_t));
+  offset += sizeof(uint64_t);
+  data.insert(data.end(), linkHash.asArray().begin(), linkHash.asArray().end());
+  offset += BLOCK_HASH_SIZE;
+
+  for (const auto& ds : dsCommittee) {
+    offset += ds.first.Serialize(data, offset);
+    offset += ds.second.Serialize(data, offset);
+  }
+
+  return PutMetadata(MetaType::DSCOMMCHECKPOINT, data);
+}
+
+bool BlockStorage::GetDSCommitteeCheckpoint(
+    uint64_t& linkIndex, BlockHash& linkHash,
+    deque<pair<PubKey, Peer>>& dsCommittee) {
+  LOG_MARKER();
+
+  vector<unsigned char> data;
+  if (!GetMetadata(MetaType::DSCOMMCHECKPOINT, data)) {
+    return false;
+  }
+
+  const unsigned int headerSize = sizeof(uint64_t) + BLOCK_HASH_SIZE;
+  const unsigned int entrySize = PUB_KEY_SIZE + IP_SIZE + PORT_SIZE;
+  if (data.size() < headerSize || (data.size() - headerSize) % entrySize != 0) {
+    LOG_GENERAL(WARNING, "Invalid DS committee checkpoint");
+    return false;
+  }
+
+  linkIndex = Serializable::GetNumber<uint64_t>(data, 0, sizeof(uint64_t));
+  copy(data.begin() + sizeof(uint64_t), data.begin() + headerSize,
+       linkHash.asArray().begin());
+
+  dsCommittee.clear();
+  for (unsigned int offset = headerSize; offset < data.size();
+       offset += entrySize) {
+    dsCommittee.emplace_back(PubKey(data, offset),
+                             Peer(data, offset + PUB_KEY_SIZE));
+  }
+
+  return true;
+}
+
 bool BlockStorage::PutShardStructure(const DequeOfShard& shards,
                                      const uint32_t myshardId) {
   LOG_MARKER();
@@ -638,17 +948,18 @@ bool BlockStorage::ResetDB(DBTYPE type) {
     }
     case DS_BLOCK: {
       lock_guard<mutex> g(m_mutexDsBlockchain);
-      ret = m_dsBlockchainDB->ResetDB();
+      ret = m_dsBlockchainDB->ResetDB() && m_dsBlockArchive->Reset();
       break;
     }
     case TX_BLOCK: {
       lock_guard<mutex> g(m_mutexTxBlockchain);
-      ret = m_txBlockchainDB->ResetDB();
+      ret = m_txBlockchainDB->ResetDB() && m_txBlockArchive->Reset();
       break;
     }
     case TX_BODY: {
       lock_guard<mutex> g(m_mutexTxBody);
       ret = m_txBodyDB->ResetDB();
+      m_txBodyFilter->Clear();
       break;
     }
     case TX_BODY_TMP: {
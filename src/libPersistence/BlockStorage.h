@@ -20,11 +20,15 @@
 #ifndef BLOCKSTORAGE_H
 #define BLOCKSTORAGE_H
 
+#include <atomic>
 #include <list>
+#include <map>
 #include <mutex>
 #include <shared_mutex>
 #include <vector>
 
+#include "BlockArchive.h"
+#include "BloomFilter.h"
 #include "common/Singleton.h"
 #include "depends/libDatabase/LevelDB.h"
 #include "libData/BlockData/Block.h"
@@ -42,6 +46,7 @@ typedef std::shared_ptr<TransactionWithReceipt> TxBodySharedPtr;
 
 /// Manages persistent storage of DS and Tx blocks.
 class BlockStorage : public Singleton<BlockStorage> {
+  std::shared_ptr<leveldb::DB> m_sharedDB;
   std::shared_ptr<LevelDB> m_metadataDB;
   std::shared_ptr<LevelDB> m_dsBlockchainDB;
   std::shared_ptr<LevelDB> m_txBlockchainDB;
@@ -54,27 +59,43 @@ class BlockStorage : public Singleton<BlockStorage> {
   std::shared_ptr<LevelDB> m_blockLinkDB;
   std::shared_ptr<LevelDB> m_shardStructureDB;
   std::shared_ptr<LevelDB> m_stateDeltaDB;
+  std::shared_ptr<BlockArchive> m_dsBlockArchive;
+  std::shared_ptr<BlockArchive> m_txBlockArchive;
+  std::shared_ptr<BloomFilter> m_txBodyFilter;
+  std::atomic<bool> m_txBodyFilterReady{false};
 
   BlockStorage()
-      : m_metadataDB(std::make_shared<LevelDB>("metadata")),
-        m_dsBlockchainDB(std::make_shared<LevelDB>("dsBlocks")),
-        m_txBlockchainDB(std::make_shared<LevelDB>("txBlocks")),
-        m_microBlockDB(std::make_shared<LevelDB>("microBlocks")),
-        m_dsCommitteeDB(std::make_shared<LevelDB>("dsCommittee")),
-        m_VCBlockDB(std::make_shared<LevelDB>("VCBlocks")),
-        m_fallbackBlockDB(std::make_shared<LevelDB>("fallbackBlocks")),
-        m_blockLinkDB(std::make_shared<LevelDB>("blockLinks")),
-        m_shardStructureDB(std::make_shared<LevelDB>("shardStructure")),
-        m_stateDeltaDB(std::make_shared<LevelDB>("stateDelta")) {
+      : m_sharedDB(UNIFIED_BLOCK_STORAGE ? LevelDB::OpenSharedDB(SHARED_DB_NAME)
+                                         : nullptr),
+        m_metadataDB(MakeDB("metadata")),
+        m_dsBlockchainDB(MakeDB("dsBlocks")),
+        m_txBlockchainDB(MakeDB("txBlocks")),
+        m_microBlockDB(MakeDB("microBlocks")),
+        m_dsCommitteeDB(MakeDB("dsCommittee")),
+        m_VCBlockDB(MakeDB("VCBlocks")),
+        m_fallbackBlockDB(MakeDB("fallbackBlocks")),
+        m_blockLinkDB(MakeDB("blockLinks")),
+        m_shardStructureDB(MakeDB("shardStructure")),
+        m_stateDeltaDB(MakeDB("stateDelta")),
+        m_dsBlockArchive(std::make_shared<BlockArchive>("dsBlocksArchive")),
+        m_txBlockArchive(std::make_shared<BlockArchive>("txBlocksArchive")) {
+    // Transaction bodies stay in their own databases, as lookups rsync them
     if (LOOKUP_NODE_MODE) {
       m_txBodyDB = std::make_shared<LevelDB>("txBodies");
       m_txBodyTmpDB = std::make_shared<LevelDB>("txBodiesTmp");
+      InitTxBodyFilter();
     }
   };
-  ~BlockStorage() = default;
+  ~BlockStorage();
+  void InitTxBodyFilter();
+  std::shared_ptr<LevelDB> MakeDB(const std::string& name);
   bool PutBlock(const uint64_t& blockNum,
                 const std::vector<unsigned char>& body,
                 const BlockType& blockType);
+  bool ImportBlockArchive(const std::shared_ptr<LevelDB>& db,
+                          const std::shared_ptr<BlockArchive>& archive);
+  bool ReconcileBlockArchive(const std::shared_ptr<LevelDB>& db,
+                             const std::shared_ptr<BlockArchive>& archive);
 
  public:
   enum DBTYPE {
@@ -92,6 +113,22 @@ class BlockStorage : public Singleton<BlockStorage> {
     STATE_DELTA
   };
 
+  /// Name of the database holding all the block storage columns when
+  /// UNIFIED_BLOCK_STORAGE is enabled.
+  static const std::string SHARED_DB_NAME;
+
+  /// Writes that are committed together by CommitBatch. Writes to columns of
+  /// the shared database are applied in a single atomic LevelDB write.
+  class Batch {
+    friend class BlockStorage;
+    std::map<std::shared_ptr<leveldb::DB>, leveldb::WriteBatch> m_writes;
+    std::vector<std::pair<uint64_t, std::vector<unsigned char>>> m_txBlocks;
+
+    leveldb::WriteBatch& For(const std::shared_ptr<LevelDB>& db) {
+      return m_writes[db->GetDB()];
+    }
+  };
+
   /// Returns the singleton BlockStorage instance.
   static BlockStorage& GetBlockStorage();
 
@@ -119,6 +156,29 @@ class BlockStorage : public Singleton<BlockStorage> {
   /// Adds a transaction body to storage.
   bool PutTxBody(const dev::h256& key, const std::vector<unsigned char>& body);
 
+  /// Adds a Tx block to the batch.
+  void PutTxBlock(Batch& batch, const uint64_t& blockNum,
+                  const std::vector<unsigned char>& body);
+
+  /// Adds a micro block to the batch.
+  void PutMicroBlock(Batch& batch, const BlockHash& blockHash,
+                     const std::vector<unsigned char>& body);
+
+  /// Adds a transaction body to the batch.
+  void PutTxBody(Batch& batch, const dev::h256& key,
+                 const std::vector<unsigned char>& body);
+
+  /// Adds a state delta to the batch.
+  void PutStateDelta(Batch& batch, const uint64_t& finalBlockNum,
+                     const std::vector<unsigned char>& stateDelta);
+
+  /// Adds metadata to the batch.
+  void PutMetadata(Batch& batch, MetaType type,
+                   const std::vector<unsigned char>& data);
+
+  /// Commits all writes in the batch.
+  bool CommitBatch(Batch& batch);
+
   /// Retrieves the requested DS block.
   bool GetDSBlock(const uint64_t& blockNum, DSBlockSharedPtr& block);
 
@@ -143,6 +203,11 @@ class BlockStorage : public Singleton<BlockStorage> {
   /// Retrieves the requested transaction body.
   bool GetTxBody(const dev::h256& key, TxBodySharedPtr& body);
 
+  /// Retrieves the requested transaction bodies in one pass over the database.
+  /// Bodies that are not present are left as nullptr.
+  bool GetTxBodies(const std::vector<dev::h256>& keys,
+                   std::vector<TxBodySharedPtr>& bodies);
+
   /// Deletes the requested DS block
   bool DeleteDSBlock(const uint64_t& blocknum);
 
@@ -172,6 +237,16 @@ class BlockStorage : public Singleton<BlockStorage> {
   /// Retrieves all the TxBlocks
   bool GetAllTxBlocks(std::list<TxBlockSharedPtr>& blocks);
 
+  /// Returns one past the highest DS block number stored
+  uint64_t GetDSBlockCount();
+
+  /// Returns one past the highest Tx block number stored
+  uint64_t GetTxBlockCount();
+
+  /// Rebuilds the txn body filter from the txBodies database, e.g., after
+  /// the database files were replaced underneath it
+  void RebuildTxBodyFilter();
+
   /// Retrieves all the TxBodiesTmp
   bool GetAllTxBodiesTmp(std::list<TxnHash>& txnHashes);
 
@@ -194,6 +269,17 @@ class BlockStorage : public Singleton<BlockStorage> {
       std::shared_ptr<std::deque<std::pair<PubKey, Peer>>>& dsCommittee,
       uint16_t& consensusLeaderID);
 
+  /// Save the DS committee built by replaying the block links up to and
+  /// including the link with the index and hash
+  bool PutDSCommitteeCheckpoint(
+      const uint64_t& linkIndex, const BlockHash& linkHash,
+      const std::deque<std::pair<PubKey, Peer>>& dsCommittee);
+
+  /// Retrieve the DS committee saved by PutDSCommitteeCheckpoint
+  bool GetDSCommitteeCheckpoint(
+      uint64_t& linkIndex, BlockHash& linkHash,
+      std::deque<std::pair<PubKey, Peer>>& dsCommittee);
+
   /// Save shard structure
   bool PutShardStructure(const DequeOfShard& shards, const uint32_t myshardId);
 
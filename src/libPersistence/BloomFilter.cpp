@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#include <cstring>
+#include <fstream>
+#include <mutex>
+
+#include "BloomFilter.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+namespace {
+const uint32_t FILE_MAGIC = 0x5a424631;  // "ZBF1"
+
+struct FileHeader {
+  uint32_t magic;
+  uint32_t numHashes;
+  uint64_t numBlocks;
+  uint64_t numInserted;
+};
+
+inline uint64_t Word(const dev::h256& hash, unsigned int index) {
+  uint64_t word;
+  memcpy(&word, hash.data() + index * sizeof(uint64_t), sizeof(uint64_t));
+  return word;
+}
+}  // namespace
+
+BloomFilter::BloomFilter(size_t sizeInBytes, unsigned int numHashes)
+    : m_numBlocks(max(sizeInBytes / (BITS_PER_BLOCK / 8), (size_t)1)),
+      m_numHashes(numHashes),
+      m_numInserted(0) {
+  m_words.resize(m_numBlocks * WORDS_PER_BLOCK, 0);
+}
+
+void BloomFilter::Insert(const dev::h256& hash) {
+  // Double hashing within the block picked by the first word
+  uint64_t* block = &m_words[(Word(hash, 0) % m_numBlocks) * WORDS_PER_BLOCK];
+  const uint64_t h1 = Word(hash, 1);
+  const uint64_t h2 = Word(hash, 2) | 1;
+
+  unique_lock<shared_timed_mutex> g(m_mutex);
+  for (unsigned int i = 0; i < m_numHashes; i++) {
+    const unsigned int bit = (h1 + i * h2) % BITS_PER_BLOCK;
+    block[bit / 64] |= (uint64_t)1 << (bit % 64);
+  }
+  m_numInserted++;
+}
+
+bool BloomFilter::MayContain(const dev::h256& hash) const {
+  const uint64_t* block =
+      &m_words[(Word(hash, 0) % m_numBlocks) * WORDS_PER_BLOCK];
+  const uint64_t h1 = Word(hash, 1);
+  const uint64_t h2 = Word(hash, 2) | 1;
+
+  shared_lock<shared_timed_mutex> g(m_mutex);
+  for (unsigned int i = 0; i < m_numHashes; i++) {
+    const unsigned int bit = (h1 + i * h2) % BITS_PER_BLOCK;
+    if (!(block[bit / 64] & ((uint64_t)1 << (bit % 64)))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void BloomFilter::Clear() {
+  unique_lock<shared_timed_mutex> g(m_mutex);
+  fill(m_words.begin(), m_words.end(), 0);
+  m_numInserted = 0;
+}
+
+uint64_t BloomFilter::GetNumInserted() const {
+  shared_lock<shared_timed_mutex> g(m_mutex);
+  return m_numInserted;
+}
+
+bool BloomFilter::Save(const string& path) const {
+  shared_lock<shared_timed_mutex> g(m_mutex);
+
+  ofstream file(path, ios::binary | ios::trunc);
+  FileHeader header{FILE_MAGIC, m_numHashes, m_numBlocks, m_numInserted};
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char*>(m_words.data()),
+             m_words.size() * sizeof(uint64_t));
+
+  if (!file) {
+    LOG_GENERAL(WARNING, "Failed to save bloom filter to " << path);
+    return false;
+  }
+  return true;
+}
+
+bool BloomFilter::Load(const string& path) {
+  ifstream file(path, ios::binary);
+  if (!file) {
+    return false;
+  }
+
+  FileHeader header;
+  file.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if (!file || header.magic != FILE_MAGIC ||
+      header.numHashes != m_numHashes || header.numBlocks != m_numBlocks) {
+    LOG_GENERAL(INFO, "Bloom filter in " << path << " does not match");
+    return false;
+  }
+
+  unique_lock<shared_timed_mutex> g(m_mutex);
+  file.read(reinterpret_cast<char*>(m_words.data()),
+            m_words.size() * sizeof(uint64_t));
+  if (!file) {
+    LOG_GENERAL(WARNING, "Bloom filter in " << path << " is truncated");
+    fill(m_words.begin(), m_words.end(), 0);
+    m_numInserted = 0;
+    return false;
+  }
+  m_numInserted = header.numInserted;
+  return true;
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#ifndef __BLOOMFILTER_H__
+#define __BLOOMFILTER_H__
+
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include "depends/common/FixedHash.h"
+
+/// Blocked bloom filter over 256-bit hashes (e.g., transaction IDs).
+/// All the bits for one hash fall in the same 512-bit block, so a lookup
+/// touches a single cache line. The hashes are assumed to be uniformly
+/// distributed already, so their bytes are used directly as bit positions.
+class BloomFilter {
+  static const unsigned int WORDS_PER_BLOCK = 8;
+  static const unsigned int BITS_PER_BLOCK = WORDS_PER_BLOCK * 64;
+
+  std::vector<uint64_t> m_words;
+  uint64_t m_numBlocks;
+  unsigned int m_numHashes;
+  uint64_t m_numInserted;
+  mutable std::shared_timed_mutex m_mutex;
+
+ public:
+  /// Constructor for an empty filter of the given size and number of bits
+  /// set per hash.
+  explicit BloomFilter(size_t sizeInBytes, unsigned int numHashes = 8);
+
+  /// Adds the hash to the filter.
+  void Insert(const dev::h256& hash);
+
+  /// Returns false if the hash was definitely never inserted.
+  bool MayContain(const dev::h256& hash) const;
+
+  /// Removes all hashes.
+  void Clear();
+
+  /// Returns the number of insertions since the filter was created or
+  /// cleared.
+  uint64_t GetNumInserted() const;
+
+  /// Writes the filter to the file.
+  bool Save(const std::string& path) const;
+
+  /// Replaces the filter with the one in the file. Fails if the file is
+  /// missing or was saved with different parameters.
+  bool Load(const std::string& path);
+};
+
+#endif  // __BLOOMFILTER_H__
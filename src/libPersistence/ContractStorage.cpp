@@ -17,9 +17,14 @@
  * program files.
  */
 
+#include <iomanip>
+#include <memory>
+#include <sstream>
+
 #include "ContractStorage.h"
 
 #include "libUtils/DataConversion.h"
+#include "libUtils/Logger.h"
 
 using namespace dev;
 
@@ -32,3 +37,62 @@ const std::vector<unsigned char> ContractStorage::GetContractCode(
     const h160& address) {
   return DataConversion::StringToCharArray(m_codeDB.Lookup(address.hex()));
 }
+
+std::string ContractStorage::GetCreatorKey(const h160& creator,
+                                           uint64_t nonce) {
+  // Fixed-width nonce so that keys of one creator sort in nonce order
+  std::ostringstream oss;
+  oss << creator.hex() << std::hex << std::setw(16) << std::setfill('0')
+      << nonce;
+  return oss.str();
+}
+
+bool ContractStorage::PutContractCreation(const h160& creator, uint64_t nonce,
+                                          const h160& contract) {
+  return m_creatorDB.Insert(leveldb::Slice(GetCreatorKey(creator, nonce)),
+                            leveldb::Slice(contract.hex())) == 0;
+}
+
+std::vector<std::pair<uint64_t, h160>> ContractStorage::GetContractsByCreator(
+    const h160& creator, uint64_t startNonce, unsigned int maxCount) {
+  std::vector<std::pair<uint64_t, h160>> contracts;
+  const std::string prefix = creator.hex();
+
+  std::unique_ptr<leveldb::Iterator> it(m_creatorDB.NewIterator());
+  for (it->Seek(GetCreatorKey(creator, startNonce));
+       it->Valid() && contracts.size() < maxCount; it->Next()) {
+    const std::string key = it->key().ToString();
+    if (key.compare(0, prefix.size(), prefix) != 0) {
+      break;
+    }
+    contracts.emplace_back(
+        std::stoull(key.substr(prefix.size()), nullptr, 16),
+        h160(it->value().ToString()));
+  }
+
+  return contracts;
+}
+
+uint64_t ContractStorage::GetCreatorScanNonce(const h160& creator) {
+  // Stored under the bare creator prefix, which sorts before every entry of
+  // the creator and so is never visited by GetContractsByCreator
+  const std::string nonce = m_creatorDB.Lookup(creator.hex());
+  if (nonce.empty()) {
+    return 0;
+  }
+
+  try {
+    return std::stoull(nonce, nullptr, 16);
+  } catch (const std::exception&) {
+    LOG_GENERAL(WARNING, "Invalid scan nonce for creator " << creator.hex());
+    return 0;
+  }
+}
+
+bool ContractStorage::PutCreatorScanNonce(const h160& creator,
+                                          uint64_t nonce) {
+  std::ostringstream oss;
+  oss << std::hex << nonce;
+  return m_creatorDB.Insert(leveldb::Slice(creator.hex()),
+                            leveldb::Slice(oss.str())) == 0;
+}
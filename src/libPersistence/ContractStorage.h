@@ -35,8 +35,14 @@
 class ContractStorage : public Singleton<ContractStorage> {
   dev::OverlayDB m_stateDB;
   LevelDB m_codeDB;
+  LevelDB m_creatorDB;
 
-  ContractStorage() : m_stateDB("contractState"), m_codeDB("contractCode"){};
+  ContractStorage()
+      : m_stateDB("contractState"),
+        m_codeDB("contractCode"),
+        m_creatorDB("contractCreators"){};
+
+  static std::string GetCreatorKey(const dev::h160& creator, uint64_t nonce);
 
   ~ContractStorage() = default;
 
@@ -55,6 +61,21 @@ class ContractStorage : public Singleton<ContractStorage> {
 
   /// Get the desired code from persistence
   const std::vector<unsigned char> GetContractCode(const dev::h160& address);
+
+  /// Records that the creator deployed the contract at the specified nonce
+  bool PutContractCreation(const dev::h160& creator, uint64_t nonce,
+                           const dev::h160& contract);
+
+  /// Gets up to maxCount contracts deployed by the creator at nonces not
+  /// lower than startNonce, in nonce order
+  std::vector<std::pair<uint64_t, dev::h160>> GetContractsByCreator(
+      const dev::h160& creator, uint64_t startNonce, unsigned int maxCount);
+
+  /// Gets the nonce below which every deployment of the creator is indexed
+  uint64_t GetCreatorScanNonce(const dev::h160& creator);
+
+  /// Records that every deployment of the creator below nonce is indexed
+  bool PutCreatorScanNonce(const dev::h160& creator, uint64_t nonce);
 };
 
 #endif  // CONTRACTSTORAGE_H
@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstring>
+
+#include <boost/filesystem.hpp>
+
+#include "ProcessedTxnHistory.h"
+#include "common/Constants.h"
+#include "libUtils/Logger.h"
+#include "libUtils/Metrics.h"
+
+using namespace std;
+
+namespace {
+bool WriteAll(int fd, const unsigned char* data, size_t size) {
+  while (size > 0) {
+    ssize_t written = write(fd, data, size);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    data += written;
+    size -= written;
+  }
+  return true;
+}
+
+bool ReadAll(int fd, unsigned char* data, size_t size, off_t offset) {
+  while (size > 0) {
+    ssize_t bytesRead = pread(fd, data, size, offset);
+    if (bytesRead < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    if (bytesRead == 0) {
+      return false;
+    }
+    data += bytesRead;
+    size -= bytesRead;
+    offset += bytesRead;
+  }
+  return true;
+}
+
+// Rough footprint of a map entry; the protobuf-encoded size would need a
+// serialization per transaction just for accounting
+uint64_t EstimateSize(const TransactionWithReceipt& txn) {
+  return sizeof(TxnHash) + sizeof(TransactionWithReceipt) +
+         txn.GetTransaction().GetCode().size() +
+         txn.GetTransaction().GetData().size() +
+         txn.GetTransactionReceipt().GetString().size();
+}
+}  // namespace
+
+ProcessedTxnHistory::ProcessedTxnHistory(const string& name,
+                                         unsigned int memoryEpochs,
+                                         unsigned int diskEpochs)
+    : m_dirPath("./" + PERSISTENCE_PATH + "/" + name),
+      m_memoryEpochs(memoryEpochs),
+      m_diskEpochs(diskEpochs),
+      m_memoryUsage(0),
+      m_diskUsage(0) {
+  // The index only lives in memory, so files from an earlier run are useless
+  boost::system::error_code ec;
+  boost::filesystem::remove_all(m_dirPath, ec);
+  boost::filesystem::create_directories(m_dirPath, ec);
+  if (ec) {
+    LOG_GENERAL(WARNING,
+                "Failed to create " << m_dirPath << ": " << ec.message());
+  }
+}
+
+string ProcessedTxnHistory::GetEpochPath(uint64_t epoch) const {
+  return m_dirPath + "/" + to_string(epoch) + ".dat";
+}
+
+bool ProcessedTxnHistory::Spill(uint64_t epoch, const TxnMap& txns) {
+  vector<unsigned char> data;
+  EpochIndex index;
+  for (const auto& txn : txns) {
+    const uint64_t offset = data.size();
+    if (!txn.second.Serialize(data, offset)) {
+      return false;
+    }
+    index.emplace(txn.first,
+                  IndexEntry{offset, (uint32_t)(data.size() - offset)});
+  }
+
+  const string path = GetEpochPath(epoch);
+  int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    LOG_GENERAL(WARNING, "Failed to open " << path << ": " << strerror(errno));
+    return false;
+  }
+  const bool written = WriteAll(fd, data.data(), data.size());
+  close(fd);
+  if (!written) {
+    LOG_GENERAL(WARNING, "Failed to write " << path << ": " << strerror(errno));
+    unlink(path.c_str());
+    return false;
+  }
+
+  m_memoryUsage += index.size() * (sizeof(TxnHash) + sizeof(IndexEntry));
+  m_diskUsage += data.size();
+  m_diskSizes[epoch] = data.size();
+  m_disk[epoch] = move(index);
+  return true;
+}
+
+void ProcessedTxnHistory::Remove(uint64_t epoch) {
+  const auto& memoryIt = m_memory.find(epoch);
+  if (memoryIt != m_memory.end()) {
+    m_memoryUsage -= m_memorySizes[epoch];
+    m_memorySizes.erase(epoch);
+    m_memory.erase(memoryIt);
+  }
+
+  const auto& diskIt = m_disk.find(epoch);
+  if (diskIt != m_disk.end()) {
+    m_memoryUsage -=
+        diskIt->second.size() * (sizeof(TxnHash) + sizeof(IndexEntry));
+    m_diskUsage -= m_diskSizes[epoch];
+    m_diskSizes.erase(epoch);
+    m_disk.erase(diskIt);
+    unlink(GetEpochPath(epoch).c_str());
+  }
+}
+
+void ProcessedTxnHistory::ApplyRetention() {
+  while (m_memory.size() > m_memoryEpochs) {
+    const auto oldest = m_memory.begin();
+    const uint64_t epoch = oldest->first;
+    if (m_diskEpochs > 0 && !Spill(epoch, oldest->second)) {
+      LOG_GENERAL(WARNING,
+                  "Failed to spill processed txns of epoch " << epoch);
+    }
+    m_memoryUsage -= m_memorySizes[epoch];
+    m_memorySizes.erase(epoch);
+    m_memory.erase(oldest);
+  }
+
+  while (m_disk.size() > m_diskEpochs) {
+    Remove(m_disk.begin()->first);
+  }
+}
+
+void ProcessedTxnHistory::UpdateMetrics() const {
+  static MetricGauge& memoryGauge = Metrics::GetInstance().GetGauge(
+      "zilliqa_processed_txn_memory_bytes",
+      "Estimated bytes of processed transactions held in memory");
+  static MetricGauge& diskGauge = Metrics::GetInstance().GetGauge(
+      "zilliqa_processed_txn_disk_bytes",
+      "Bytes of processed transactions spilled to disk");
+  memoryGauge.Set(m_memoryUsage);
+  diskGauge.Set(m_diskUsage);
+}
+
+void ProcessedTxnHistory::Put(uint64_t epoch, TxnMap&& txns) {
+  lock_guard<mutex> g(m_mutex);
+
+  Remove(epoch);
+
+  uint64_t size = 0;
+  for (const auto& txn : txns) {
+    size += EstimateSize(txn.second);
+  }
+  m_memory[epoch] = move(txns);
+  m_memorySizes[epoch] = size;
+  m_memoryUsage += size;
+
+  ApplyRetention();
+  UpdateMetrics();
+
+  LOG_GENERAL(INFO, "Processed txns: " << m_memory.size() << " epochs ("
+                                       << m_memoryUsage << " bytes) in memory, "
+                                       << m_disk.size() << " epochs ("
+                                       << m_diskUsage << " bytes) on disk");
+}
+
+bool ProcessedTxnHistory::Find(uint64_t epoch, const TxnHash& txnHash,
+                               TransactionWithReceipt& txn) {
+  lock_guard<mutex> g(m_mutex);
+
+  const auto& memoryIt = m_memory.find(epoch);
+  if (memoryIt != m_memory.end()) {
+    const auto& txnIt = memoryIt->second.find(txnHash);
+    if (txnIt == memoryIt->second.end()) {
+      return false;
+    }
+    txn = txnIt->second;
+    return true;
+  }
+
+  const auto& diskIt = m_disk.find(epoch);
+  if (diskIt == m_disk.end()) {
+    return false;
+  }
+  const auto& entryIt = diskIt->second.find(txnHash);
+  if (entryIt == diskIt->second.end()) {
+    return false;
+  }
+
+  const string path = GetEpochPath(epoch);
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    LOG_GENERAL(WARNING, "Failed to open " << path << ": " << strerror(errno));
+    return false;
+  }
+  vector<unsigned char> body(entryIt->second.size);
+  const bool read =
+      ReadAll(fd, body.data(), body.size(), entryIt->second.offset);
+  close(fd);
+  if (!read || !txn.Deserialize(body, 0)) {
+    LOG_GENERAL(WARNING, "Failed to read txn " << txnHash << " from " << path);
+    return false;
+  }
+  return true;
+}
+
+void ProcessedTxnHistory::Erase(uint64_t epoch) {
+  lock_guard<mutex> g(m_mutex);
+  Remove(epoch);
+  UpdateMetrics();
+}
+
+void ProcessedTxnHistory::Clear() {
+  lock_guard<mutex> g(m_mutex);
+  while (!m_disk.empty()) {
+    Remove(m_disk.begin()->first);
+  }
+  m_memory.clear();
+  m_memorySizes.clear();
+  m_memoryUsage = 0;
+  UpdateMetrics();
+}
+
+uint64_t ProcessedTxnHistory::GetMemoryUsage() {
+  lock_guard<mutex> g(m_mutex);
+  return m_memoryUsage;
+}
+
+uint64_t ProcessedTxnHistory::GetDiskUsage() {
+  lock_guard<mutex> g(m_mutex);
+  return m_diskUsage;
+}
+
+size_t ProcessedTxnHistory::GetNumEpochs() {
+  lock_guard<mutex> g(m_mutex);
+  return m_memory.size() + m_disk.size();
+}
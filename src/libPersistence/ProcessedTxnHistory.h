@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#ifndef __PROCESSEDTXNHISTORY_H__
+#define __PROCESSEDTXNHISTORY_H__
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "libData/AccountData/Transaction.h"
+#include "libData/AccountData/TransactionReceipt.h"
+
+/// Transactions processed by this node, grouped by epoch.
+/// The newest epochs are kept in memory. Older epochs are written to one
+/// append-only file per epoch (<name>/<epoch>.dat under the persistence
+/// directory), and an in-memory index maps every transaction hash to its
+/// {offset, size} record. The files of the oldest epochs are deleted once
+/// there are more than the configured number on disk.
+class ProcessedTxnHistory {
+ public:
+  using TxnMap = std::unordered_map<TxnHash, TransactionWithReceipt>;
+
+ private:
+  struct IndexEntry {
+    uint64_t offset;
+    uint32_t size;
+  };
+  using EpochIndex = std::unordered_map<TxnHash, IndexEntry>;
+
+  const std::string m_dirPath;
+  const unsigned int m_memoryEpochs;
+  const unsigned int m_diskEpochs;
+
+  std::map<uint64_t, TxnMap> m_memory;
+  std::map<uint64_t, uint64_t> m_memorySizes;
+  std::map<uint64_t, EpochIndex> m_disk;
+  std::map<uint64_t, uint64_t> m_diskSizes;
+  uint64_t m_memoryUsage;
+  uint64_t m_diskUsage;
+
+  std::mutex m_mutex;
+
+  std::string GetEpochPath(uint64_t epoch) const;
+  bool Spill(uint64_t epoch, const TxnMap& txns);
+  void Remove(uint64_t epoch);
+  void ApplyRetention();
+  void UpdateMetrics() const;
+
+ public:
+  /// Constructor. Keeps the newest memoryEpochs epochs in memory and the next
+  /// diskEpochs epochs on disk. Anything left on disk by an earlier run is
+  /// removed.
+  ProcessedTxnHistory(const std::string& name, unsigned int memoryEpochs,
+                      unsigned int diskEpochs);
+
+  ProcessedTxnHistory(const ProcessedTxnHistory&) = delete;
+  ProcessedTxnHistory& operator=(const ProcessedTxnHistory&) = delete;
+
+  /// Stores the transactions of the epoch, replacing any stored earlier.
+  void Put(uint64_t epoch, TxnMap&& txns);
+
+  /// Retrieves a transaction processed in the epoch.
+  bool Find(uint64_t epoch, const TxnHash& txnHash,
+            TransactionWithReceipt& txn);
+
+  /// Removes the transactions of the epoch.
+  void Erase(uint64_t epoch);
+
+  /// Removes all epochs.
+  void Clear();
+
+  /// Returns the estimated bytes held in memory, including the disk index.
+  uint64_t GetMemoryUsage();
+
+  /// Returns the bytes held in the epoch files.
+  uint64_t GetDiskUsage();
+
+  /// Returns the number of epochs held in memory and on disk.
+  size_t GetNumEpochs();
+};
+
+#endif  // __PROCESSEDTXNHISTORY_H__
@@ -36,110 +36,60 @@ namespace filesys = boost::filesystem;
 
 Retriever::Retriever(Mediator& mediator) : m_mediator(mediator) {}
 
-bool Retriever::RetrieveDSBlocks(bool wakeupForUpgrade) {
-  LOG_MARKER();
-
-  std::list<DSBlockSharedPtr> blocks;
-  if (!BlockStorage::GetBlockStorage().GetAllDSBlocks(blocks)) {
-    LOG_GENERAL(WARNING, "RetrieveDSBlocks skipped or incompleted");
-    return false;
-  }
-
-  blocks.sort([](const DSBlockSharedPtr& a, const DSBlockSharedPtr& b) {
-    return a->GetHeader().GetBlockNum() < b->GetHeader().GetBlockNum();
-  });
-
-  if (!blocks.empty()) {
-    if (m_mediator.m_ds->m_latestActiveDSBlockNum == 0) {
-      std::vector<unsigned char> latestActiveDSBlockNumVec;
-      if (!BlockStorage::GetBlockStorage().GetMetadata(
-              MetaType::LATESTACTIVEDSBLOCKNUM, latestActiveDSBlockNumVec)) {
-        LOG_GENERAL(WARNING, "Get LatestActiveDSBlockNum failed");
-        return false;
-      }
-      m_mediator.m_ds->m_latestActiveDSBlockNum = std::stoull(
-          DataConversion::CharArrayToString(latestActiveDSBlockNumVec));
-    }
-  }
-
-  /// Check whether the termination of last running happens before the last
-  /// DSEpoch properly ended.
-  std::vector<unsigned char> isDSIncompleted;
-  if (!BlockStorage::GetBlockStorage().GetMetadata(MetaType::DSINCOMPLETED,
-                                                   isDSIncompleted)) {
-    LOG_GENERAL(WARNING, "No GetMetadata or failed");
-    return false;
-  }
-
-  if (isDSIncompleted[0] == '1') {
-    /// Removing incompleted DS for upgrading protocol
-    /// Keeping incompleted DS for node recovery
-    if (wakeupForUpgrade) {
-      LOG_GENERAL(INFO, "Has incompleted DS Block, remove it");
-      if (BlockStorage::GetBlockStorage().DeleteDSBlock(blocks.size() - 1)) {
-        BlockStorage::GetBlockStorage().PutMetadata(MetaType::DSINCOMPLETED,
-                                                    {'0'});
-      }
-      blocks.pop_back();
-    } else {
-      LOG_GENERAL(INFO, "Has incompleted DS Block, keep it");
-    }
-  }
-
-  m_mediator.m_blocklinkchain.Reset();
-  uint64_t index = 0;
-
-  for (const auto& block : blocks) {
-    m_mediator.m_dsBlockChain.AddBlock(*block);
-    m_mediator.m_blocklinkchain.AddBlockLink(
-        index++, block->GetHeader().GetBlockNum(), BlockType::DS,
-        block->GetBlockHash());
-  }
-
-  return true;
-}
-
 bool Retriever::RetrieveTxBlocks(bool wakeupForUpgrade) {
   LOG_MARKER();
-  std::list<TxBlockSharedPtr> blocks;
-  if (!BlockStorage::GetBlockStorage().GetAllTxBlocks(blocks)) {
+
+  uint64_t totalSize = BlockStorage::GetBlockStorage().GetTxBlockCount();
+  if (totalSize == 0) {
     LOG_GENERAL(WARNING, "RetrieveTxBlocks skipped or incompleted");
     return false;
   }
 
-  blocks.sort([](const TxBlockSharedPtr& a, const TxBlockSharedPtr& b) {
-    return a->GetHeader().GetBlockNum() < b->GetHeader().GetBlockNum();
-  });
-
-  unsigned int totalSize = blocks.size();
   unsigned int extra_txblocks = totalSize % NUM_FINAL_BLOCK_PER_POW;
+  uint64_t firstDeltaBlockNum = totalSize - extra_txblocks;
 
-  if (wakeupForUpgrade || m_mediator.GetIsVacuousEpoch(
-                              (blocks.back()->GetHeader().GetBlockNum()))) {
+  if (wakeupForUpgrade || m_mediator.GetIsVacuousEpoch(totalSize - 1)) {
     // truncate the extra final blocks at last
     for (unsigned int i = 0; i < extra_txblocks; ++i) {
       BlockStorage::GetBlockStorage().DeleteTxBlock(totalSize - 1 - i);
-      blocks.pop_back();
+    }
+    totalSize -= extra_txblocks;
+    firstDeltaBlockNum = totalSize;
+    if (totalSize == 0) {
+      LOG_GENERAL(WARNING, "RetrieveTxBlocks skipped or incompleted");
+      return false;
     }
   }
 
-  for (const auto& block : blocks) {
+  // Only the blocks that fit in the in-memory chain are decoded now; older
+  // ones are read from the archive when requested
+  const uint64_t firstBlockNum =
+      (totalSize > BLOCKCHAIN_SIZE) ? totalSize - BLOCKCHAIN_SIZE : 0;
+  for (uint64_t blockNum = firstBlockNum; blockNum < totalSize; ++blockNum) {
+    TxBlockSharedPtr block;
+    if (!BlockStorage::GetBlockStorage().GetTxBlock(blockNum, block)) {
+      LOG_GENERAL(WARNING, "Lost TxBlock " << blockNum << " in the chain");
+      return false;
+    }
     m_mediator.m_node->AddBlock(*block);
   }
+  m_mediator.m_txBlockChain.SetBlockCount(totalSize);
+
+  LOG_GENERAL(INFO, "Retrieved TxBlocks " << firstBlockNum << " to "
+                                          << totalSize - 1 << " of "
+                                          << totalSize);
 
   /// Retrieve final block state delta from last DS epoch to
   /// current TX epoch
-  for (const auto& block : blocks) {
-    if (block->GetHeader().GetBlockNum() >= totalSize - extra_txblocks) {
-      std::vector<unsigned char> stateDelta;
-      BlockStorage::GetBlockStorage().GetStateDelta(
-          block->GetHeader().GetBlockNum(), stateDelta);
-
-      if (!AccountStore::GetInstance().DeserializeDelta(stateDelta, 0)) {
-        LOG_GENERAL(WARNING,
-                    "AccountStore::GetInstance().DeserializeDelta failed");
-        return false;
-      }
+  for (uint64_t blockNum = firstDeltaBlockNum; blockNum < totalSize;
+       ++blockNum) {
+    std::vector<unsigned char> stateDelta;
+    BlockStorage::GetBlockStorage().GetStateDelta(blockNum, stateDelta);
+
+    if (!AccountStore::GetInstance().DeserializeDelta(stateDelta, 0)) {
+      LOG_GENERAL(WARNING,
+                  "AccountStore::GetInstance().DeserializeDelta failed");
+      return false;
     }
   }
 
@@ -207,6 +157,55 @@ bool Retriever::RetrieveBlockLink(bool wakeupForUpgrade) {
     lastDsIndex--;
   }
 
+  // The DS committee is rebuilt by replaying the links after the last
+  // checkpoint, and only the DS blocks that fit in the in-memory chain are
+  // added to it; older ones are read from storage when requested
+  uint64_t numDSBlocks = 0;
+  for (const auto& blocklink : blocklinks) {
+    if (std::get<BlockLinkIndex::BLOCKTYPE>(blocklink) == BlockType::DS) {
+      numDSBlocks = std::max(numDSBlocks,
+                             std::get<BlockLinkIndex::DSINDEX>(blocklink) + 1);
+    }
+  }
+  // Counting also brings the DS block archive in line with LevelDB
+  if (BlockStorage::GetBlockStorage().GetDSBlockCount() < numDSBlocks) {
+    LOG_GENERAL(WARNING, "Fewer DS blocks stored than linked");
+  }
+  const uint64_t firstDSBlockNum =
+      (!toDelete && numDSBlocks > BLOCKCHAIN_SIZE)
+          ? numDSBlocks - BLOCKCHAIN_SIZE
+          : 0;
+
+  bool hasCheckpoint = false;
+  uint64_t checkpointIndex = 0;
+  if (!toDelete) {
+    BlockHash checkpointHash;
+    std::deque<std::pair<PubKey, Peer>> checkpointComm;
+    if (BlockStorage::GetBlockStorage().GetDSCommitteeCheckpoint(
+            checkpointIndex, checkpointHash, checkpointComm)) {
+      // The checkpoint is only valid for the chain it was taken on
+      hasCheckpoint = std::any_of(
+          blocklinks.begin(), blocklinks.end(),
+          [checkpointIndex, &checkpointHash](const BlockLink& blocklink) {
+            return std::get<BlockLinkIndex::INDEX>(blocklink) ==
+                       checkpointIndex &&
+                   std::get<BlockLinkIndex::BLOCKTYPE>(blocklink) ==
+                       BlockType::DS &&
+                   std::get<BlockLinkIndex::BLOCKHASH>(blocklink) ==
+                       checkpointHash;
+          });
+    }
+    if (hasCheckpoint) {
+      LOG_GENERAL(INFO, "Replaying block links after " << checkpointIndex);
+      dsComm = checkpointComm;
+      m_mediator.m_blocklinkchain.SetBuiltDSComm(dsComm);
+    }
+  }
+
+  bool hasDSLink = false;
+  uint64_t lastDSLinkIndex = 0;
+  BlockHash lastDSLinkHash;
+
   std::list<BlockLink>::iterator blocklinkItr;
   for (blocklinkItr = blocklinks.begin(); blocklinkItr != blocklinks.end();
        blocklinkItr++) {
@@ -220,21 +219,32 @@ bool Retriever::RetrieveBlockLink(bool wakeupForUpgrade) {
       }
     }
 
+    const bool replay = !hasCheckpoint ||
+                        std::get<BlockLinkIndex::INDEX>(blocklink) >
+                            checkpointIndex;
+
     if (std::get<BlockLinkIndex::BLOCKTYPE>(blocklink) == BlockType::DS) {
-      DSBlockSharedPtr dsblock;
-      if (!BlockStorage::GetBlockStorage().GetDSBlock(
-              std::get<BlockLinkIndex::DSINDEX>(blocklink), dsblock)) {
-        LOG_GENERAL(WARNING,
-                    "Could not find ds block num "
-                        << std::get<BlockLinkIndex::DSINDEX>(blocklink));
-        return false;
+      const uint64_t dsIndex = std::get<BlockLinkIndex::DSINDEX>(blocklink);
+      if (replay || dsIndex >= firstDSBlockNum) {
+        DSBlockSharedPtr dsblock;
+        if (!BlockStorage::GetBlockStorage().GetDSBlock(dsIndex, dsblock)) {
+          LOG_GENERAL(WARNING, "Could not find ds block num " << dsIndex);
+          return false;
+        }
+        if (replay) {
+          m_mediator.m_node->UpdateDSCommiteeComposition(dsComm, *dsblock);
+          m_mediator.m_blocklinkchain.SetBuiltDSComm(dsComm);
+        }
+        if (dsIndex >= firstDSBlockNum) {
+          m_mediator.m_dsBlockChain.AddBlock(*dsblock);
+        }
       }
-      m_mediator.m_node->UpdateDSCommiteeComposition(dsComm, *dsblock);
-      m_mediator.m_blocklinkchain.SetBuiltDSComm(dsComm);
-      m_mediator.m_dsBlockChain.AddBlock(*dsblock);
+      hasDSLink = true;
+      lastDSLinkIndex = std::get<BlockLinkIndex::INDEX>(blocklink);
+      lastDSLinkHash = std::get<BlockLinkIndex::BLOCKHASH>(blocklink);
 
-    } else if (std::get<BlockLinkIndex::BLOCKTYPE>(blocklink) ==
-               BlockType::VC) {
+    } else if (replay && std::get<BlockLinkIndex::BLOCKTYPE>(blocklink) ==
+                             BlockType::VC) {
       VCBlockSharedPtr vcblock;
 
       if (!BlockStorage::GetBlockStorage().GetVCBlock(
@@ -247,8 +257,8 @@ bool Retriever::RetrieveBlockLink(bool wakeupForUpgrade) {
       m_mediator.m_node->UpdateRetrieveDSCommiteeCompositionAfterVC(*vcblock,
                                                                     dsComm);
 
-    } else if (std::get<BlockLinkIndex::BLOCKTYPE>(blocklink) ==
-               BlockType::FB) {
+    } else if (replay && std::get<BlockLinkIndex::BLOCKTYPE>(blocklink) ==
+                             BlockType::FB) {
       FallbackBlockSharedPtr fallbackwshardingstruct;
       if (!BlockStorage::GetBlockStorage().GetFallbackBlock(
               std::get<BlockLinkIndex::BLOCKHASH>(blocklink),
@@ -278,6 +288,18 @@ bool Retriever::RetrieveBlockLink(bool wakeupForUpgrade) {
         std::get<BlockLinkIndex::BLOCKHASH>(blocklink));
   }
 
+  if (firstDSBlockNum > 0) {
+    m_mediator.m_dsBlockChain.SetBlockCount(numDSBlocks);
+  }
+
+  // The next restart only replays the links after this one
+  if (!toDelete && hasDSLink &&
+      !BlockStorage::GetBlockStorage().PutDSCommitteeCheckpoint(
+          lastDSLinkIndex, lastDSLinkHash,
+          m_mediator.m_blocklinkchain.GetBuiltDSComm())) {
+    LOG_GENERAL(WARNING, "Failed to save DS committee checkpoint");
+  }
+
   if (!toDelete) {
     return true;
   }
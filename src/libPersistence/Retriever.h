@@ -32,7 +32,6 @@ class Retriever {
  public:
   Retriever(Mediator& mediator);
 
-  bool RetrieveDSBlocks(bool wakeupForUpgrade);
   bool RetrieveTxBlocks(bool wakeupForUpgrade);
   bool RetrieveBlockLink(bool wakeupForUpgrade);
   bool RetrieveStates();
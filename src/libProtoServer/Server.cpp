@@ -37,6 +37,7 @@
 #include "libNetwork/P2PComm.h"
 #include "libNetwork/Peer.h"
 #include "libPersistence/BlockStorage.h"
+#include "libPersistence/ContractStorage.h"
 #include "libUtils/Logger.h"
 #include "libUtils/TimeUtils.h"
 
@@ -49,6 +50,7 @@ std::mutex Server::m_mutexRecentTxns;
 const unsigned int PAGE_SIZE = 10;
 const unsigned int NUM_PAGES_CACHE = 2;
 const unsigned int TXN_PAGE_SIZE = 100;
+const unsigned int CONTRACT_INDEX_PAGE_SIZE = 100;
 
 //[warning] do not make this constant too big as it loops over blockchain
 const unsigned int REF_BLOCK_DIFF = 5;
@@ -204,18 +206,15 @@ CreateTransactionResponse Server::CreateTransaction(
 
       if (tx.GetData().empty() || tx.GetToAddr() == NullAddress) {
         if (tx.GetData().empty() && tx.GetCode().empty()) {
-          m_mediator.m_lookup->AddToTxnShardMap(tx, shard);
           ret.set_info("Non-contract txn, sent to shard");
-          ret.set_tranid(tx.GetTranID().hex());
         } else if (!tx.GetCode().empty() && tx.GetToAddr() == NullAddress) {
-          m_mediator.m_lookup->AddToTxnShardMap(tx, shard);
           ret.set_info("Contract Creation txn, sent to shard");
-          ret.set_tranid(tx.GetTranID().hex());
           ret.set_contractaddress(
               Account::GetAddressForContract(fromAddr, sender->GetNonce())
                   .hex());
         } else {
           ret.set_error("Code is empty and To addr is null");
+          return ret;
         }
 
       } else {
@@ -234,15 +233,31 @@ CreateTransactionResponse Server::CreateTransaction(
             Transaction::GetShardIndex(tx.GetToAddr(), num_shards);
 
         if (to_shard == shard) {
-          m_mediator.m_lookup->AddToTxnShardMap(tx, shard);
           ret.set_info("Contract Txn, Shards Match of the sender and reciever");
         } else {
-          m_mediator.m_lookup->AddToTxnShardMap(tx, num_shards);
+          shard = num_shards;
           ret.set_info("Contract Txn, Sent To Ds");
         }
-        ret.set_tranid(tx.GetTranID().hex());
       }
 
+      switch (m_mediator.m_lookup->AddToTxnShardMap(tx, shard)) {
+        case TxnIngressQueue::ADDED:
+          break;
+        case TxnIngressQueue::DUPLICATE:
+          ret.Clear();
+          ret.set_error("Txn already submitted");
+          return ret;
+        case TxnIngressQueue::SENDER_LIMIT:
+          ret.Clear();
+          ret.set_error("Sender reached its txn limit, retry next epoch");
+          return ret;
+        case TxnIngressQueue::QUEUE_FULL:
+          ret.Clear();
+          ret.set_error("Txn queue is full, retry later");
+          return ret;
+      }
+      ret.set_tranid(tx.GetTranID().hex());
+
     } else {
       LOG_GENERAL(INFO, "No shards yet");
       ret.set_error("Could not create Transaction");
@@ -621,22 +636,36 @@ GetSmartContractResponse Server::GetSmartContracts(ProtoAddress& protoAddress) {
       return ret;
     }
 
-    uint64_t nonce = account->GetNonce();
-    //[TODO] find out a more efficient way (using storage)
+    // Catch the index up on nonces it has not covered, then page through it
+    // rather than probing every nonce
+    if (!AccountStore::GetInstance().IndexContractsByCreator(addr)) {
+      LOG_GENERAL(WARNING, "Failed to index contracts of " << addr.hex());
+    }
+
+    uint64_t startNonce = 0;
+    while (true) {
+      auto contracts =
+          ContractStorage::GetContractStorage().GetContractsByCreator(
+              addr, startNonce, CONTRACT_INDEX_PAGE_SIZE);
 
-    for (uint64_t i = 0; i < nonce; i++) {
-      Address contractAddr = Account::GetAddressForContract(addr, i);
-      const Account* contractAccount =
-          AccountStore::GetInstance().GetAccount(contractAddr);
+      for (const auto& contract : contracts) {
+        const Account* contractAccount =
+            AccountStore::GetInstance().GetAccount(contract.second);
 
-      if (contractAccount == nullptr || !contractAccount->isContract()) {
-        continue;
+        if (contractAccount == nullptr || !contractAccount->isContract()) {
+          continue;
+        }
+
+        auto protoContractAccount = ret.add_address();
+        protoContractAccount->set_address(contract.second.hex());
+        protoContractAccount->set_state(
+            contractAccount->GetStorageJson().toStyledString());
       }
 
-      auto protoContractAccount = ret.add_address();
-      protoContractAccount->set_address(contractAddr.hex());
-      protoContractAccount->set_state(
-          contractAccount->GetStorageJson().toStyledString());
+      if (contracts.size() < CONTRACT_INDEX_PAGE_SIZE) {
+        break;
+      }
+      startNonce = contracts.back().first + 1;
     }
 
   } catch (exception& e) {
@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#include <algorithm>
+
+#include "ChainStats.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+using namespace boost::multiprecision;
+
+ChainStats::ChainStats(unsigned int windowSize)
+    : m_windowSize(windowSize),
+      m_lastDSBlockNum(0),
+      m_lastDSTimestamp(0),
+      m_dsStartTime(0),
+      m_hasDSBlock(false),
+      m_backfillFailed(false) {}
+
+void ChainStats::Apply(TxSegment& segment, const TxBlockInfo& info) const {
+  segment.lastBlockNum = info.blockNum;
+  segment.lastTimestamp = info.timestamp;
+  segment.lastNumTxs = info.numTxs;
+
+  // Like the rates, the counters start from block 1
+  if (info.blockNum == 0) {
+    segment.dsBlockNum = info.dsBlockNum;
+    return;
+  }
+
+  if (info.blockNum == 1) {
+    segment.startTime = info.timestamp;
+  }
+
+  segment.numTxns += info.numTxs;
+
+  segment.window.push_back({info.timestamp, segment.numTxns});
+  if (segment.window.size() > m_windowSize + 1) {
+    segment.window.pop_front();
+  }
+
+  if (info.dsBlockNum != segment.dsBlockNum) {
+    segment.dsBlockNum = info.dsBlockNum;
+    segment.dsEpochTxns = 0;
+    segment.dsEpochFromFirst = false;
+  }
+  segment.dsEpochTxns += info.numTxs;
+}
+
+ChainStats::TxSegment ChainStats::Merge(const TxSegment& front,
+                                        const TxSegment& back) const {
+  TxSegment result = back;
+
+  result.firstBlockNum = front.firstBlockNum;
+  result.numTxns = front.numTxns + back.numTxns;
+  if (front.startTime != 0) {
+    result.startTime = front.startTime;
+  }
+
+  for (auto& entry : result.window) {
+    entry.cumTxns += front.numTxns;
+  }
+  for (auto it = front.window.rbegin();
+       it != front.window.rend() && result.window.size() < m_windowSize + 1;
+       it++) {
+    result.window.push_front(*it);
+  }
+
+  if (back.dsEpochFromFirst && front.dsBlockNum == back.dsBlockNum) {
+    result.dsEpochTxns += front.dsEpochTxns;
+    result.dsEpochFromFirst = front.dsEpochFromFirst;
+  } else {
+    result.dsEpochFromFirst = false;
+  }
+
+  return result;
+}
+
+void ChainStats::AddTxBlock(const TxBlockInfo& info) {
+  lock_guard<mutex> g(m_mutex);
+
+  if (m_txSegments.empty() ||
+      info.blockNum > m_txSegments.back().lastBlockNum + 1) {
+    TxSegment segment;
+    segment.firstBlockNum = info.blockNum;
+    segment.dsBlockNum = info.dsBlockNum;
+    Apply(segment, info);
+    m_txSegments.emplace_back(move(segment));
+  } else if (info.blockNum == m_txSegments.back().lastBlockNum + 1) {
+    Apply(m_txSegments.back(), info);
+  }
+  m_backfillFailed = false;
+}
+
+void ChainStats::AddDSBlock(const uint64_t& blockNum,
+                            const uint64_t& timestamp) {
+  lock_guard<mutex> g(m_mutex);
+
+  if (blockNum == 1) {
+    m_dsStartTime = timestamp;
+  }
+  if (!m_hasDSBlock || blockNum > m_lastDSBlockNum) {
+    m_lastDSBlockNum = blockNum;
+    m_lastDSTimestamp = timestamp;
+    m_hasDSBlock = true;
+  }
+  m_backfillFailed = false;
+}
+
+bool ChainStats::NeedsBackfillLocked() const {
+  if (m_backfillFailed) {
+    return false;
+  }
+
+  bool txComplete = m_txSegments.size() == 1 &&
+                    m_txSegments.front().firstBlockNum <= 1;
+  bool dsComplete =
+      m_hasDSBlock && (m_dsStartTime != 0 || m_lastDSBlockNum < 1);
+  return !txComplete || !dsComplete;
+}
+
+bool ChainStats::NeedsBackfill() const {
+  lock_guard<mutex> g(m_mutex);
+  return NeedsBackfillLocked();
+}
+
+void ChainStats::Backfill(const uint64_t& latestTxBlockNum,
+                          const uint64_t& latestDSBlockNum,
+                          const TxBlockLoader& loadTxBlock,
+                          const DSBlockLoader& loadDSBlock) {
+  lock_guard<mutex> backfillGuard(m_mutexBackfill);
+
+  // Collect the missing ranges, then load them without blocking the commit
+  // path
+  vector<pair<uint64_t, uint64_t>> gaps;
+  bool needDSStart = false, needDSLast = false;
+  {
+    lock_guard<mutex> g(m_mutex);
+    if (!NeedsBackfillLocked()) {
+      return;
+    }
+
+    if (m_txSegments.empty()) {
+      if (latestTxBlockNum >= 1) {
+        gaps.emplace_back(1, latestTxBlockNum);
+      }
+    } else {
+      if (m_txSegments.front().firstBlockNum > 1) {
+        gaps.emplace_back(1, m_txSegments.front().firstBlockNum - 1);
+      }
+      for (unsigned int i = 1; i < m_txSegments.size(); i++) {
+        gaps.emplace_back(m_txSegments[i - 1].lastBlockNum + 1,
+                          m_txSegments[i].firstBlockNum - 1);
+      }
+    }
+
+    needDSLast = !m_hasDSBlock && latestDSBlockNum >= 1;
+    needDSStart = m_dsStartTime == 0 &&
+                  (m_hasDSBlock ? m_lastDSBlockNum >= 1 : needDSLast);
+  }
+
+  LOG_GENERAL(INFO, "Backfilling chain statistics over " << gaps.size()
+                                                         << " ranges");
+
+  bool failed = false;
+  vector<TxSegment> loaded;
+  for (const auto& gap : gaps) {
+    TxSegment segment;
+    segment.firstBlockNum = gap.first;
+    bool empty = true;
+
+    for (uint64_t blockNum = gap.first; blockNum <= gap.second; blockNum++) {
+      TxBlockInfo info;
+      if (!loadTxBlock(blockNum, info)) {
+        LOG_GENERAL(WARNING, "Failed to load Tx block " << blockNum);
+        failed = true;
+        break;
+      }
+      if (empty) {
+        segment.dsBlockNum = info.dsBlockNum;
+        empty = false;
+      }
+      Apply(segment, info);
+    }
+
+    if (!empty) {
+      loaded.emplace_back(move(segment));
+    }
+  }
+
+  uint64_t dsStartTime = 0, dsLastTimestamp = 0;
+  if (needDSStart && !loadDSBlock(1, dsStartTime)) {
+    LOG_GENERAL(WARNING, "Failed to load DS block 1");
+    failed = true;
+  }
+  if (needDSLast && !loadDSBlock(latestDSBlockNum, dsLastTimestamp)) {
+    LOG_GENERAL(WARNING, "Failed to load DS block " << latestDSBlockNum);
+    needDSLast = false;
+    failed = true;
+  }
+
+  lock_guard<mutex> g(m_mutex);
+
+  // Blocks committed while loading may overlap the range read from the
+  // latest block number; those are dropped and loaded again next time
+  for (auto& segment : loaded) {
+    auto it = upper_bound(m_txSegments.begin(), m_txSegments.end(),
+                          segment.firstBlockNum,
+                          [](const uint64_t& blockNum, const TxSegment& s) {
+                            return blockNum < s.firstBlockNum;
+                          });
+    if ((it != m_txSegments.end() &&
+         it->firstBlockNum <= segment.lastBlockNum) ||
+        (it != m_txSegments.begin() &&
+         prev(it)->lastBlockNum >= segment.firstBlockNum)) {
+      continue;
+    }
+    m_txSegments.insert(it, move(segment));
+  }
+
+  vector<TxSegment> merged;
+  for (auto& segment : m_txSegments) {
+    if (!merged.empty() &&
+        merged.back().lastBlockNum + 1 == segment.firstBlockNum) {
+      merged.back() = Merge(merged.back(), segment);
+    } else {
+      merged.emplace_back(move(segment));
+    }
+  }
+  m_txSegments = move(merged);
+
+  if (needDSStart && dsStartTime != 0) {
+    m_dsStartTime = dsStartTime;
+  }
+  if (needDSLast && !m_hasDSBlock) {
+    m_lastDSBlockNum = latestDSBlockNum;
+    m_lastDSTimestamp = dsLastTimestamp;
+    m_hasDSBlock = true;
+  }
+
+  // Do not retry a failed load until the next block is committed
+  m_backfillFailed = failed;
+}
+
+uint128_t ChainStats::GetNumTransactions() const {
+  lock_guard<mutex> g(m_mutex);
+
+  uint128_t numTxns = 0;
+  for (const auto& segment : m_txSegments) {
+    numTxns += segment.numTxns;
+  }
+  return numTxns;
+}
+
+double ChainStats::GetTransactionRate(unsigned int refBlockDiff) const {
+  lock_guard<mutex> g(m_mutex);
+
+  if (m_txSegments.empty() || m_txSegments.back().window.size() < 2) {
+    return 0;
+  }
+
+  const auto& window = m_txSegments.back().window;
+  size_t diff = min((size_t)refBlockDiff, window.size() - 1);
+  const WindowEntry& ref = window[window.size() - 1 - diff];
+  const WindowEntry& last = window.back();
+
+  if (ref.timestamp == 0 || last.timestamp <= ref.timestamp) {
+    return 0;
+  }
+
+  // Timestamps are in microseconds
+  return (last.cumTxns - ref.cumTxns).convert_to<double>() * 1000000 /
+         (last.timestamp - ref.timestamp);
+}
+
+double ChainStats::GetTxBlockRate() const {
+  lock_guard<mutex> g(m_mutex);
+
+  if (m_txSegments.empty()) {
+    return 0;
+  }
+
+  uint64_t startTime = m_txSegments.front().startTime;
+  const TxSegment& last = m_txSegments.back();
+  if (startTime == 0 || last.lastTimestamp <= startTime) {
+    return 0;
+  }
+
+  return (double)(last.lastBlockNum + 1) * 1000000 /
+         (last.lastTimestamp - startTime);
+}
+
+double ChainStats::GetDSBlockRate() const {
+  lock_guard<mutex> g(m_mutex);
+
+  if (m_dsStartTime == 0 || m_lastDSTimestamp <= m_dsStartTime) {
+    return 0;
+  }
+
+  return (double)(m_lastDSBlockNum + 1) * 1000000 /
+         (m_lastDSTimestamp - m_dsStartTime);
+}
+
+uint128_t ChainStats::GetNumTxnsDSEpoch() const {
+  lock_guard<mutex> g(m_mutex);
+  return m_txSegments.empty() ? 0 : m_txSegments.back().dsEpochTxns;
+}
+
+uint32_t ChainStats::GetNumTxnsTxEpoch() const {
+  lock_guard<mutex> g(m_mutex);
+  return m_txSegments.empty() ? 0 : m_txSegments.back().lastNumTxs;
+}
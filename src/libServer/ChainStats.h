@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#ifndef __CHAINSTATS_H__
+#define __CHAINSTATS_H__
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#include <boost/multiprecision/cpp_int.hpp>
+#pragma GCC diagnostic pop
+
+/// Rolling statistics over the committed Tx and DS blocks. The counters are
+/// updated in O(1) as each block is committed, so that the RPC server never
+/// has to walk the blockchain to answer rate and count queries.
+class ChainStats {
+ public:
+  struct TxBlockInfo {
+    uint64_t blockNum;
+    uint64_t dsBlockNum;
+    uint64_t timestamp;
+    uint32_t numTxs;
+  };
+
+  using TxBlockLoader =
+      std::function<bool(const uint64_t& blockNum, TxBlockInfo& info)>;
+  using DSBlockLoader =
+      std::function<bool(const uint64_t& blockNum, uint64_t& timestamp)>;
+
+ private:
+  struct WindowEntry {
+    uint64_t timestamp;
+    boost::multiprecision::uint128_t cumTxns;  // running total incl. block
+  };
+
+  /// Statistics over a contiguous range of Tx blocks.
+  struct TxSegment {
+    uint64_t firstBlockNum = 0;
+    uint64_t lastBlockNum = 0;
+    uint64_t lastTimestamp = 0;
+    uint32_t lastNumTxs = 0;
+    uint64_t startTime = 0;  // timestamp of block 1, if in the segment
+    boost::multiprecision::uint128_t numTxns = 0;
+    std::deque<WindowEntry> window;
+    uint64_t dsBlockNum = 0;
+    boost::multiprecision::uint128_t dsEpochTxns = 0;
+    bool dsEpochFromFirst = true;  // DS epoch unchanged since firstBlockNum
+  };
+
+  const unsigned int m_windowSize;
+
+  // Blocks the commit path did not report (e.g., those committed before a
+  // restart or during sync) leave gaps between segments until backfilled
+  std::vector<TxSegment> m_txSegments;
+  uint64_t m_lastDSBlockNum;
+  uint64_t m_lastDSTimestamp;
+  uint64_t m_dsStartTime;
+  bool m_hasDSBlock;
+  bool m_backfillFailed;
+  mutable std::mutex m_mutex;
+  std::mutex m_mutexBackfill;
+
+  void Apply(TxSegment& segment, const TxBlockInfo& info) const;
+  TxSegment Merge(const TxSegment& front, const TxSegment& back) const;
+  bool NeedsBackfillLocked() const;
+
+ public:
+  /// Constructor. The window holds the most recent blocks used for the
+  /// transaction rate.
+  explicit ChainStats(unsigned int windowSize);
+
+  ChainStats(const ChainStats&) = delete;
+  ChainStats& operator=(const ChainStats&) = delete;
+
+  /// Records a committed Tx block.
+  void AddTxBlock(const TxBlockInfo& info);
+
+  /// Records a committed DS block.
+  void AddDSBlock(const uint64_t& blockNum, const uint64_t& timestamp);
+
+  /// Checks if some blocks are missing from the statistics.
+  bool NeedsBackfill() const;
+
+  /// Loads the blocks missing from the statistics using the loaders. The
+  /// latest block numbers are only consulted if no block was recorded yet.
+  void Backfill(const uint64_t& latestTxBlockNum,
+                const uint64_t& latestDSBlockNum,
+                const TxBlockLoader& loadTxBlock,
+                const DSBlockLoader& loadDSBlock);
+
+  /// Returns the number of transactions in all Tx blocks.
+  boost::multiprecision::uint128_t GetNumTransactions() const;
+
+  /// Returns the transactions per second over the last refBlockDiff blocks
+  /// (capped at the window size).
+  double GetTransactionRate(unsigned int refBlockDiff) const;
+
+  /// Returns the Tx blocks per second since Tx block 1.
+  double GetTxBlockRate() const;
+
+  /// Returns the DS blocks per second since DS block 1.
+  double GetDSBlockRate() const;
+
+  /// Returns the number of transactions in the current DS epoch.
+  boost::multiprecision::uint128_t GetNumTxnsDSEpoch() const;
+
+  /// Returns the number of transactions in the latest Tx block.
+  uint32_t GetNumTxnsTxEpoch() const;
+};
+
+#endif  // __CHAINSTATS_H__
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+#include "MetricsServer.h"
+#include "libUtils/Logger.h"
+#include "libUtils/Metrics.h"
+
+using namespace std;
+
+namespace {
+const unsigned int MAX_REQUEST_SIZE = 8192;
+const int POLL_TIMEOUT_MS = 1000;
+const int RECV_TIMEOUT_SEC = 1;
+
+const string BAD_REQUEST =
+    "HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\n"
+    "Connection: close\r\n\r\n";
+const string NOT_FOUND =
+    "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+
+void SendAll(int fd, const string& data) {
+  size_t sent = 0;
+  while (sent < data.size()) {
+    ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+    if (n <= 0) {
+      return;
+    }
+    sent += n;
+  }
+}
+}  // namespace
+
+MetricsServer::MetricsServer() : m_listenFd(-1), m_running(false) {}
+
+MetricsServer::~MetricsServer() { Stop(); }
+
+bool MetricsServer::Start(unsigned int port) {
+  if (m_running) {
+    LOG_GENERAL(WARNING, "Metrics server already running");
+    return false;
+  }
+
+  m_listenFd = socket(AF_INET, SOCK_STREAM, 0);
+  if (m_listenFd < 0) {
+    LOG_GENERAL(WARNING, "Socket creation failed: " << strerror(errno));
+    return false;
+  }
+
+  int enable = 1;
+  setsockopt(m_listenFd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(port);
+
+  if (bind(m_listenFd, (struct sockaddr*)&addr, sizeof(addr)) < 0 ||
+      listen(m_listenFd, SOMAXCONN) < 0) {
+    LOG_GENERAL(WARNING, "Failed to listen on port " << port << ": "
+                                                     << strerror(errno));
+    close(m_listenFd);
+    m_listenFd = -1;
+    return false;
+  }
+
+  m_running = true;
+  m_thread = thread([this]() -> void { Run(); });
+
+  LOG_GENERAL(INFO, "Metrics server listening on port " << port);
+  return true;
+}
+
+void MetricsServer::Stop() {
+  if (!m_running.exchange(false)) {
+    return;
+  }
+
+  m_thread.join();
+  close(m_listenFd);
+  m_listenFd = -1;
+}
+
+void MetricsServer::Run() {
+  while (m_running) {
+    struct pollfd fd = {m_listenFd, POLLIN, 0};
+    int ret = poll(&fd, 1, POLL_TIMEOUT_MS);
+    if (ret < 0 && errno != EINTR) {
+      LOG_GENERAL(WARNING, "poll failed: " << strerror(errno));
+    }
+    if (ret <= 0 || !(fd.revents & POLLIN)) {
+      continue;
+    }
+
+    int clientFd = accept(m_listenFd, nullptr, nullptr);
+    if (clientFd < 0) {
+      LOG_GENERAL(WARNING, "accept failed: " << strerror(errno));
+      continue;
+    }
+    ServeClient(clientFd);
+    close(clientFd);
+  }
+}
+
+void MetricsServer::ServeClient(int fd) {
+  // A stalled scraper must not hold up the next one for long
+  struct timeval timeout = {RECV_TIMEOUT_SEC, 0};
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+  string request;
+  char buf[1024];
+  while (request.find("\r\n\r\n") == string::npos) {
+    ssize_t n = recv(fd, buf, sizeof(buf), 0);
+    if (n <= 0) {
+      return;
+    }
+    request.append(buf, n);
+    if (request.size() > MAX_REQUEST_SIZE) {
+      SendAll(fd, BAD_REQUEST);
+      return;
+    }
+  }
+
+  // Request line: GET /metrics HTTP/1.1
+  string requestLine = request.substr(0, request.find("\r\n"));
+  if (requestLine.compare(0, 4, "GET ") != 0) {
+    SendAll(fd, BAD_REQUEST);
+    return;
+  }
+  string target = requestLine.substr(4, requestLine.find(' ', 4) - 4);
+  if (target.substr(0, target.find('?')) != "/metrics") {
+    SendAll(fd, NOT_FOUND);
+    return;
+  }
+
+  string body = Metrics::GetInstance().ExportPrometheus();
+  SendAll(fd,
+          "HTTP/1.1 200 OK\r\n"
+          "Content-Type: text/plain; version=0.0.4\r\n"
+          "Content-Length: " +
+              to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body);
+}
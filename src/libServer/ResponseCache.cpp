@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#include <sstream>
+
+#include "ResponseCache.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+namespace {
+// Number of requests per method between two statistics log lines
+const uint64_t STATS_LOG_INTERVAL = 10000;
+}  // namespace
+
+ResponseCache::ResponseCache(size_t capacityBytes)
+    : m_capacity(capacityBytes), m_size(0) {}
+
+string ResponseCache::MakeKey(const string& method, const string& params) {
+  return method + '\0' + params;
+}
+
+ResponseCache::ResponsePtr ResponseCache::Get(const string& method,
+                                              const string& params) {
+  lock_guard<mutex> g(m_mutex);
+
+  auto it = m_index.find(MakeKey(method, params));
+  if (it == m_index.end()) {
+    return nullptr;
+  }
+
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+  return it->second->response;
+}
+
+void ResponseCache::Put(const string& method, const string& params,
+                        const Json::Value& response) {
+  if (m_capacity == 0) {
+    return;
+  }
+
+  // Size the entry by its wire format
+  Json::StreamWriterBuilder writeBuilder;
+  writeBuilder["indentation"] = "";
+  unique_ptr<Json::StreamWriter> writer(writeBuilder.newStreamWriter());
+  ostringstream oss;
+  writer->write(response, &oss);
+  const size_t size = oss.tellp();
+  if (size > m_capacity) {
+    return;
+  }
+
+  auto ptr = make_shared<const Json::Value>(response);
+  const string key = MakeKey(method, params);
+
+  lock_guard<mutex> g(m_mutex);
+
+  auto it = m_index.find(key);
+  if (it != m_index.end()) {
+    m_size -= it->second->size;
+    m_entries.erase(it->second);
+    m_index.erase(it);
+  }
+
+  while (!m_entries.empty() && m_size + size > m_capacity) {
+    m_size -= m_entries.back().size;
+    m_index.erase(m_entries.back().key);
+    m_entries.pop_back();
+  }
+
+  m_entries.push_front({key, ptr, size});
+  m_index.emplace(key, m_entries.begin());
+  m_size += size;
+}
+
+void ResponseCache::RecordRequest(const string& method, bool hit,
+                                  double latencyUs) {
+  lock_guard<mutex> g(m_mutex);
+
+  MethodStats& stats = m_stats[method];
+  if (hit) {
+    stats.hits++;
+    stats.hitLatencyUs += latencyUs;
+  } else {
+    stats.misses++;
+    stats.missLatencyUs += latencyUs;
+  }
+
+  const uint64_t total = stats.hits + stats.misses;
+  if (total % STATS_LOG_INTERVAL == 0) {
+    LOG_GENERAL(INFO,
+                method << " hit rate " << stats.hits * 100 / total
+                       << "% avg hit latency "
+                       << (stats.hits ? stats.hitLatencyUs / stats.hits : 0)
+                       << " us avg miss latency "
+                       << (stats.misses ? stats.missLatencyUs / stats.misses
+                                        : 0)
+                       << " us (" << m_entries.size() << " entries, "
+                       << m_size << " bytes cached)");
+  }
+}
+
+map<string, ResponseCache::MethodStats> ResponseCache::GetStats() {
+  lock_guard<mutex> g(m_mutex);
+  return m_stats;
+}
+
+size_t ResponseCache::GetSize() {
+  lock_guard<mutex> g(m_mutex);
+  return m_size;
+}
+
+size_t ResponseCache::GetNumEntries() {
+  lock_guard<mutex> g(m_mutex);
+  return m_entries.size();
+}
+
+void ResponseCache::Clear() {
+  lock_guard<mutex> g(m_mutex);
+  m_entries.clear();
+  m_index.clear();
+  m_size = 0;
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#ifndef __RESPONSECACHE_H__
+#define __RESPONSECACHE_H__
+
+#include <json/json.h>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/// Size-bounded LRU cache of JSON-RPC responses for immutable objects (e.g.,
+/// blocks and transactions), keyed by method name and canonical parameters.
+/// Also keeps per-method hit counts and latencies.
+class ResponseCache {
+ public:
+  using ResponsePtr = std::shared_ptr<const Json::Value>;
+
+  struct MethodStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    double hitLatencyUs = 0;   // total over all hits
+    double missLatencyUs = 0;  // total over all misses
+  };
+
+ private:
+  struct Entry {
+    std::string key;
+    ResponsePtr response;
+    size_t size;
+  };
+
+  const size_t m_capacity;
+  size_t m_size;
+  std::list<Entry> m_entries;  // most recently used first
+  std::unordered_map<std::string, std::list<Entry>::iterator> m_index;
+  std::map<std::string, MethodStats> m_stats;
+  std::mutex m_mutex;
+
+  static std::string MakeKey(const std::string& method,
+                             const std::string& params);
+
+ public:
+  /// Constructor. A capacity of zero disables caching.
+  explicit ResponseCache(size_t capacityBytes);
+
+  ResponseCache(const ResponseCache&) = delete;
+  ResponseCache& operator=(const ResponseCache&) = delete;
+
+  /// Returns the cached response, or nullptr if there is none.
+  ResponsePtr Get(const std::string& method, const std::string& params);
+
+  /// Stores the response, evicting the least recently used entries as needed.
+  void Put(const std::string& method, const std::string& params,
+           const Json::Value& response);
+
+  /// Records the outcome and serving time of one request.
+  void RecordRequest(const std::string& method, bool hit, double latencyUs);
+
+  /// Returns a copy of the per-method statistics.
+  std::map<std::string, MethodStats> GetStats();
+
+  /// Returns the approximate serialized size of all cached responses.
+  size_t GetSize();
+
+  /// Returns the number of cached responses.
+  size_t GetNumEntries();
+
+  /// Removes all cached responses.
+  void Clear();
+};
+
+#endif  // __RESPONSECACHE_H__
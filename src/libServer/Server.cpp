@@ -20,7 +20,6 @@
 #include "JSONConversion.h"
 
 #include <jsonrpccpp/server.h>
-#include <boost/multiprecision/cpp_dec_float.hpp>
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-parameter"
 #include <boost/multiprecision/cpp_int.hpp>
@@ -39,6 +38,7 @@
 #include "libNetwork/P2PComm.h"
 #include "libNetwork/Peer.h"
 #include "libPersistence/BlockStorage.h"
+#include "libPersistence/ContractStorage.h"
 #include "libUtils/Logger.h"
 #include "libUtils/TimeUtils.h"
 
@@ -51,21 +51,19 @@ std::mutex Server::m_mutexRecentTxns;
 const unsigned int PAGE_SIZE = 10;
 const unsigned int NUM_PAGES_CACHE = 2;
 const unsigned int TXN_PAGE_SIZE = 100;
+const unsigned int CONTRACT_INDEX_PAGE_SIZE = 100;
 
-//[warning] do not make this constant too big as it loops over blockchain
 const unsigned int REF_BLOCK_DIFF = 1;
 
 Server::Server(Mediator& mediator, HttpServer& httpserver)
-    : AbstractZServer(httpserver), m_mediator(mediator) {
-  m_StartTimeTx = 0;
-  m_StartTimeDs = 0;
+    : AbstractZServer(httpserver),
+      m_mediator(mediator),
+      m_batchPool(RPC_BATCH_THREADS, "RPCBatchPool") {
   m_DSBlockCache.first = 0;
   m_DSBlockCache.second.resize(NUM_PAGES_CACHE * PAGE_SIZE);
   m_TxBlockCache.first = 0;
   m_TxBlockCache.second.resize(NUM_PAGES_CACHE * PAGE_SIZE);
   m_RecentTransactions.resize(TXN_PAGE_SIZE);
-  m_TxBlockCountSumPair.first = 0;
-  m_TxBlockCountSumPair.second = 0;
 }
 
 Server::~Server() {
@@ -113,20 +111,16 @@ Json::Value Server::CreateTransaction(const Json::Value& _json) {
       unsigned int shard = Transaction::GetShardIndex(fromAddr, num_shards);
       if (tx.GetData().empty() || tx.GetToAddr() == NullAddress) {
         if (tx.GetData().empty() && tx.GetCode().empty()) {
-          m_mediator.m_lookup->AddToTxnShardMap(tx, shard);
           ret["Info"] = "Non-contract txn, sent to shard";
-          ret["TranID"] = tx.GetTranID().hex();
         } else if (!tx.GetCode().empty() && tx.GetToAddr() == NullAddress) {
-          m_mediator.m_lookup->AddToTxnShardMap(tx, shard);
           ret["Info"] = "Contract Creation txn, sent to shard";
-          ret["TranID"] = tx.GetTranID().hex();
           ret["ContractAddress"] =
               Account::GetAddressForContract(fromAddr, sender->GetNonce())
                   .hex();
         } else {
           ret["Error"] = "Code is empty and To addr is null";
+          return ret;
         }
-        return ret;
       } else {
         const Account* account =
             AccountStore::GetInstance().GetAccount(tx.GetToAddr());
@@ -144,19 +138,33 @@ Json::Value Server::CreateTransaction(const Json::Value& _json) {
         unsigned int to_shard =
             Transaction::GetShardIndex(tx.GetToAddr(), num_shards);
         if (to_shard == shard) {
-          m_mediator.m_lookup->AddToTxnShardMap(tx, shard);
           ret["Info"] =
               "Contract Txn, Shards Match of the sender "
               "and reciever";
-          ret["TranID"] = tx.GetTranID().hex();
-          return ret;
         } else {
-          m_mediator.m_lookup->AddToTxnShardMap(tx, num_shards);
+          shard = num_shards;
           ret["Info"] = "Contract Txn, Sent To Ds";
-          ret["TranID"] = tx.GetTranID().hex();
-          return ret;
         }
       }
+
+      switch (m_mediator.m_lookup->AddToTxnShardMap(tx, shard)) {
+        case TxnIngressQueue::ADDED:
+          break;
+        case TxnIngressQueue::DUPLICATE:
+          ret.clear();
+          ret["Error"] = "Txn already submitted";
+          return ret;
+        case TxnIngressQueue::SENDER_LIMIT:
+          ret.clear();
+          ret["Error"] = "Sender reached its txn limit, retry next epoch";
+          return ret;
+        case TxnIngressQueue::QUEUE_FULL:
+          ret.clear();
+          ret["Error"] = "Txn queue is full, retry later";
+          return ret;
+      }
+      ret["TranID"] = tx.GetTranID().hex();
+      return ret;
     } else {
       LOG_GENERAL(INFO, "No shards yet");
       ret["Error"] = "Could not create Transaction";
@@ -170,6 +178,85 @@ Json::Value Server::CreateTransaction(const Json::Value& _json) {
   }
 }
 
+ResponseCache& Server::GetResponseCache() {
+  static ResponseCache responseCache((size_t)RPC_RESPONSE_CACHE_SIZE_MB * 1024 *
+                                     1024);
+  return responseCache;
+}
+
+void Server::CacheDSBlock(const DSBlock& dsblock) {
+  GetResponseCache().Put("GetDsBlock",
+                         to_string(dsblock.GetHeader().GetBlockNum()),
+                         JSONConversion::convertDSblocktoJson(dsblock));
+}
+
+void Server::CacheTxBlock(const TxBlock& txblock) {
+  GetResponseCache().Put("GetTxBlock",
+                         to_string(txblock.GetHeader().GetBlockNum()),
+                         JSONConversion::convertTxBlocktoJson(txblock));
+}
+
+void Server::CacheTransaction(const TransactionWithReceipt& twr) {
+  GetResponseCache().Put("GetTransaction",
+                         twr.GetTransaction().GetTranID().hex(),
+                         JSONConversion::convertTxtoJson(twr));
+}
+
+ChainStats& Server::GetChainStats() {
+  static ChainStats chainStats(REF_BLOCK_DIFF);
+  return chainStats;
+}
+
+void Server::AddToChainStats(const DSBlock& dsblock) {
+  GetChainStats().AddDSBlock(dsblock.GetHeader().GetBlockNum(),
+                             dsblock.GetTimestamp());
+}
+
+void Server::AddToChainStats(const TxBlock& txblock) {
+  const TxBlockHeader& header = txblock.GetHeader();
+  GetChainStats().AddTxBlock({header.GetBlockNum(), header.GetDSBlockNum(),
+                              txblock.GetTimestamp(), header.GetNumTxs()});
+}
+
+SubscriptionServer& Server::GetSubscriptionServer() {
+  static SubscriptionServer subscriptionServer(
+      SUBSCRIPTION_QUEUE_SIZE, SUBSCRIPTION_MAX_CLIENTS,
+      SUBSCRIPTION_REQUEST_TIMEOUT_IN_SECONDS);
+  return subscriptionServer;
+}
+
+ChainStats& Server::GetBackfilledChainStats() {
+  ChainStats& chainStats = GetChainStats();
+  if (!chainStats.NeedsBackfill()) {
+    return chainStats;
+  }
+
+  // Blocks committed before a restart or during sync are read back from disk
+  chainStats.Backfill(
+      m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum(),
+      m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum(),
+      [](const uint64_t& blockNum, ChainStats::TxBlockInfo& info) -> bool {
+        TxBlockSharedPtr txblock;
+        if (!BlockStorage::GetBlockStorage().GetTxBlock(blockNum, txblock)) {
+          return false;
+        }
+        const TxBlockHeader& header = txblock->GetHeader();
+        info = {header.GetBlockNum(), header.GetDSBlockNum(),
+                txblock->GetTimestamp(), header.GetNumTxs()};
+        return true;
+      },
+      [](const uint64_t& blockNum, uint64_t& timestamp) -> bool {
+        DSBlockSharedPtr dsblock;
+        if (!BlockStorage::GetBlockStorage().GetDSBlock(blockNum, dsblock)) {
+          return false;
+        }
+        timestamp = dsblock->GetTimestamp();
+        return true;
+      });
+
+  return chainStats;
+}
+
 Json::Value Server::GetTransaction(const string& transactionHash) {
   LOG_MARKER();
   try {
@@ -181,13 +268,24 @@ Json::Value Server::GetTransaction(const string& transactionHash) {
 
       return _json;
     }
+
+    auto startTime = r_timer_start();
+    ResponseCache& cache = GetResponseCache();
+    if (auto cached = cache.Get("GetTransaction", tranHash.hex())) {
+      cache.RecordRequest("GetTransaction", true, r_timer_end(startTime));
+      return *cached;
+    }
+
     bool isPresent = BlockStorage::GetBlockStorage().GetTxBody(tranHash, tptr);
     if (!isPresent) {
       Json::Value _json;
       _json["error"] = "Txn Hash not Present";
       return _json;
     }
-    return JSONConversion::convertTxtoJson(*tptr);
+    Json::Value _json = JSONConversion::convertTxtoJson(*tptr);
+    cache.Put("GetTransaction", tranHash.hex(), _json);
+    cache.RecordRequest("GetTransaction", false, r_timer_end(startTime));
+    return _json;
   } catch (exception& e) {
     Json::Value _json;
     LOG_GENERAL(INFO, "[Error]" << e.what() << " Input: " << transactionHash);
@@ -196,11 +294,116 @@ Json::Value Server::GetTransaction(const string& transactionHash) {
   }
 }
 
+Json::Value Server::GetTransactions(const Json::Value& _json) {
+  LOG_MARKER();
+
+  if (_json.size() > RPC_BATCH_MAX_SIZE) {
+    Json::Value ret;
+    ret["Error"] = "Too many transaction hashes";
+    return ret;
+  }
+
+  Json::Value ret(Json::arrayValue);
+  ret.resize(_json.size());
+
+  // Serve what we can from the cache and collect the rest
+  ResponseCache& cache = GetResponseCache();
+  vector<TxnHash> missingHashes;
+  vector<Json::ArrayIndex> missingIndexes;
+  for (Json::ArrayIndex i = 0; i < _json.size(); i++) {
+    if (!_json[i].isString() ||
+        _json[i].asString().size() != TRAN_HASH_SIZE * 2) {
+      ret[i]["error"] = "Size not appropriate";
+      continue;
+    }
+
+    try {
+      TxnHash tranHash(_json[i].asString());
+      if (auto cached = cache.Get("GetTransaction", tranHash.hex())) {
+        ret[i] = *cached;
+        continue;
+      }
+      missingHashes.emplace_back(tranHash);
+      missingIndexes.emplace_back(i);
+    } catch (exception& e) {
+      LOG_GENERAL(INFO, "[Error]" << e.what() << " Input: " << _json[i]);
+      ret[i]["Error"] = "Unable to Process";
+    }
+  }
+
+  // Each job reads its share of the bodies in one pass over the database and
+  // converts them to JSON
+  vector<TxBodySharedPtr> bodies(missingHashes.size());
+  vector<Json::Value> results(missingHashes.size());
+  auto fetch = [&missingHashes, &bodies, &results](size_t job,
+                                                   size_t numJobs) -> void {
+    vector<TxnHash> hashes;
+    for (size_t i = job; i < missingHashes.size(); i += numJobs) {
+      hashes.emplace_back(missingHashes[i]);
+    }
+
+    vector<TxBodySharedPtr> jobBodies;
+    if (!BlockStorage::GetBlockStorage().GetTxBodies(hashes, jobBodies)) {
+      jobBodies.assign(hashes.size(), nullptr);
+    }
+
+    for (size_t k = 0, i = job; k < jobBodies.size(); k++, i += numJobs) {
+      if (jobBodies[k] == nullptr) {
+        results[i]["error"] = "Txn Hash not Present";
+        continue;
+      }
+      try {
+        bodies[i] = jobBodies[k];
+        results[i] = JSONConversion::convertTxtoJson(*jobBodies[k]);
+      } catch (exception& e) {
+        LOG_GENERAL(WARNING, "[Error]" << e.what());
+        bodies[i] = nullptr;
+        results[i]["Error"] = "Unable to Process";
+      }
+    }
+  };
+
+  const size_t numJobs = min(missingHashes.size(), (size_t)RPC_BATCH_THREADS);
+  if (numJobs < 2) {
+    fetch(0, 1);
+  } else {
+    lock_guard<mutex> g(m_mutexBatchPool);
+    for (size_t job = 0; job < numJobs; job++) {
+      m_batchPool.AddJob(
+          [&fetch, job, numJobs]() -> void { fetch(job, numJobs); });
+    }
+    m_batchPool.WaitAll();
+  }
+
+  for (size_t i = 0; i < missingHashes.size(); i++) {
+    if (bodies[i] != nullptr) {
+      cache.Put("GetTransaction", missingHashes[i].hex(), results[i]);
+    }
+    ret[missingIndexes[i]] = move(results[i]);
+  }
+
+  return ret;
+}
+
 Json::Value Server::GetDsBlock(const string& blockNum) {
   try {
     uint64_t BlockNum = stoull(blockNum);
-    return JSONConversion::convertDSblocktoJson(
-        m_mediator.m_dsBlockChain.GetBlock(BlockNum));
+
+    auto startTime = r_timer_start();
+    ResponseCache& cache = GetResponseCache();
+    if (auto cached = cache.Get("GetDsBlock", to_string(BlockNum))) {
+      cache.RecordRequest("GetDsBlock", true, r_timer_end(startTime));
+      return *cached;
+    }
+
+    auto block = m_mediator.m_dsBlockChain.GetBlock(BlockNum);
+    Json::Value _json = JSONConversion::convertDSblocktoJson(block);
+    // Dummy blocks are returned for numbers not (yet) in the chain
+    if (block.GetHeader().GetBlockNum() == BlockNum) {
+      cache.Put("GetDsBlock", to_string(BlockNum), _json);
+    }
+    cache.RecordRequest("GetDsBlock", false, r_timer_end(startTime));
+    return _json;
   } catch (const char* msg) {
     Json::Value _json;
     _json["Error"] = msg;
@@ -231,8 +434,22 @@ Json::Value Server::GetDsBlock(const string& blockNum) {
 Json::Value Server::GetTxBlock(const string& blockNum) {
   try {
     uint64_t BlockNum = stoull(blockNum);
-    return JSONConversion::convertTxBlocktoJson(
-        m_mediator.m_txBlockChain.GetBlock(BlockNum));
+
+    auto startTime = r_timer_start();
+    ResponseCache& cache = GetResponseCache();
+    if (auto cached = cache.Get("GetTxBlock", to_string(BlockNum))) {
+      cache.RecordRequest("GetTxBlock", true, r_timer_end(startTime));
+      return *cached;
+    }
+
+    auto block = m_mediator.m_txBlockChain.GetBlock(BlockNum);
+    Json::Value _json = JSONConversion::convertTxBlocktoJson(block);
+    // Dummy blocks are returned for numbers not (yet) in the chain
+    if (block.GetHeader().GetBlockNum() == BlockNum) {
+      cache.Put("GetTxBlock", to_string(BlockNum), _json);
+    }
+    cache.RecordRequest("GetTxBlock", false, r_timer_end(startTime));
+    return _json;
   } catch (const char* msg) {
     Json::Value _json;
     _json["Error"] = msg;
@@ -292,6 +509,34 @@ Json::Value Server::GetLatestTxBlock() {
 Json::Value Server::GetBalance(const string& address) {
   LOG_MARKER();
 
+  return GetBalanceJson(address);
+}
+
+Json::Value Server::GetBalances(const Json::Value& _json) {
+  LOG_MARKER();
+
+  if (_json.size() > RPC_BATCH_MAX_SIZE) {
+    Json::Value ret;
+    ret["Error"] = "Too many addresses";
+    return ret;
+  }
+
+  // Accounts are served from memory, so one pass is cheaper than a fan-out
+  Json::Value ret(Json::arrayValue);
+  for (const auto& address : _json) {
+    if (!address.isString()) {
+      Json::Value error;
+      error["Error"] = "Address size not appropriate";
+      ret.append(error);
+      continue;
+    }
+    ret.append(GetBalanceJson(address.asString()));
+  }
+
+  return ret;
+}
+
+Json::Value Server::GetBalanceJson(const string& address) {
   try {
     if (address.size() != ACC_ADDR_SIZE * 2) {
       Json::Value _json;
@@ -310,7 +555,6 @@ Json::Value Server::GetBalance(const string& address) {
       ret["balance"] = balance.str();
       // FIXME: a workaround, 256-bit unsigned int being truncated
       ret["nonce"] = static_cast<unsigned int>(nonce);
-      LOG_GENERAL(INFO, "balance " << balance.str() << " nonce: " << nonce);
     } else if (account == nullptr) {
       ret["balance"] = "0";
       ret["nonce"] = 0;
@@ -397,6 +641,16 @@ Json::Value Server::GetSmartContractCode(const string& address) {
     }
     vector<unsigned char> tmpaddr = DataConversion::HexStrToUint8Vec(address);
     Address addr(tmpaddr);
+
+    // The code of a deployed contract never changes
+    auto startTime = r_timer_start();
+    ResponseCache& cache = GetResponseCache();
+    if (auto cached = cache.Get("GetSmartContractCode", addr.hex())) {
+      cache.RecordRequest("GetSmartContractCode", true,
+                          r_timer_end(startTime));
+      return *cached;
+    }
+
     const Account* account = AccountStore::GetInstance().GetAccount(addr);
 
     if (account == nullptr) {
@@ -410,6 +664,8 @@ Json::Value Server::GetSmartContractCode(const string& address) {
     }
 
     _json["code"] = DataConversion::CharArrayToString(account->GetCode());
+    cache.Put("GetSmartContractCode", addr.hex(), _json);
+    cache.RecordRequest("GetSmartContractCode", false, r_timer_end(startTime));
     return _json;
   } catch (exception& e) {
     LOG_GENERAL(INFO, "[Error]" << e.what() << " Input: " << address);
@@ -441,23 +697,39 @@ Json::Value Server::GetSmartContracts(const string& address) {
       _json["Error"] = "A contract account queried";
       return _json;
     }
-    uint64_t nonce = account->GetNonce();
-    //[TODO] find out a more efficient way (using storage)
 
-    for (uint64_t i = 0; i < nonce; i++) {
-      Address contractAddr = Account::GetAddressForContract(addr, i);
-      const Account* contractAccount =
-          AccountStore::GetInstance().GetAccount(contractAddr);
+    // Catch the index up on nonces it has not covered, then page through it
+    // rather than probing every nonce
+    if (!AccountStore::GetInstance().IndexContractsByCreator(addr)) {
+      LOG_GENERAL(WARNING, "Failed to index contracts of " << addr.hex());
+    }
 
-      if (contractAccount == nullptr || !contractAccount->isContract()) {
-        continue;
-      }
+    uint64_t startNonce = 0;
+    while (true) {
+      auto contracts =
+          ContractStorage::GetContractStorage().GetContractsByCreator(
+              addr, startNonce, CONTRACT_INDEX_PAGE_SIZE);
+
+      for (const auto& contract : contracts) {
+        const Account* contractAccount =
+            AccountStore::GetInstance().GetAccount(contract.second);
+
+        // Deployments that failed leave no contract account behind
+        if (contractAccount == nullptr || !contractAccount->isContract()) {
+          continue;
+        }
+
+        Json::Value tmpJson;
+        tmpJson["address"] = contract.second.hex();
+        tmpJson["state"] = contractAccount->GetStorageJson();
 
-      Json::Value tmpJson;
-      tmpJson["address"] = contractAddr.hex();
-      tmpJson["state"] = contractAccount->GetStorageJson();
+        _json.append(tmpJson);
+      }
 
-      _json.append(tmpJson);
+      if (contracts.size() < CONTRACT_INDEX_PAGE_SIZE) {
+        break;
+      }
+      startNonce = contracts.back().first + 1;
     }
     return _json;
   } catch (exception& e) {
@@ -536,151 +808,25 @@ uint8_t Server::GetPrevDifficulty() {
 string Server::GetNumTransactions() {
   LOG_MARKER();
 
-  uint64_t currBlock =
-      m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum();
-  if (m_BlockTxPair.first < currBlock) {
-    for (uint64_t i = m_BlockTxPair.first + 1; i <= currBlock; i++) {
-      m_BlockTxPair.second +=
-          m_mediator.m_txBlockChain.GetBlock(i).GetHeader().GetNumTxs();
-    }
-  }
-  m_BlockTxPair.first = currBlock;
-
-  return m_BlockTxPair.second.str();
+  return GetBackfilledChainStats().GetNumTransactions().str();
 }
 
-size_t Server::GetNumTransactions(uint64_t blockNum) {
-  uint64_t currBlockNum =
-      m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum();
-
-  if (blockNum >= currBlockNum) {
-    return 0;
-  }
-
-  size_t i, res = 0;
-
-  for (i = blockNum + 1; i <= currBlockNum; i++) {
-    res += m_mediator.m_txBlockChain.GetBlock(i).GetHeader().GetNumTxs();
-  }
-
-  return res;
-}
 double Server::GetTransactionRate() {
   LOG_MARKER();
 
-  uint64_t refBlockNum =
-      m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum();
-
-  uint64_t refTimeTx = 0;
-
-  if (refBlockNum <= REF_BLOCK_DIFF) {
-    if (refBlockNum <= 1) {
-      LOG_GENERAL(INFO, "Not enough blocks for information");
-      return 0;
-    } else {
-      refBlockNum = 1;
-      // In case there are less than REF_DIFF_BLOCKS blocks in blockchain,
-      // blocknum 1 can be ref block;
-    }
-  } else {
-    refBlockNum = refBlockNum - REF_BLOCK_DIFF;
-  }
-
-  boost::multiprecision::cpp_dec_float_50 numTxns(
-      Server::GetNumTransactions(refBlockNum));
-  LOG_GENERAL(INFO, "Num Txns: " << numTxns);
-
-  try {
-    TxBlock tx = m_mediator.m_txBlockChain.GetBlock(refBlockNum);
-    refTimeTx = tx.GetTimestamp();
-  } catch (const char* msg) {
-    if (string(msg) == "Blocknumber Absent") {
-      LOG_GENERAL(INFO, "Error in fetching ref block");
-    }
-    return 0;
-  }
-
-  uint64_t TimeDiff =
-      m_mediator.m_txBlockChain.GetLastBlock().GetTimestamp() - refTimeTx;
-
-  if (TimeDiff == 0 || refTimeTx == 0) {
-    // something went wrong
-    LOG_GENERAL(INFO, "TimeDiff or refTimeTx = 0 \n TimeDiff:"
-                          << TimeDiff << " refTimeTx:" << refTimeTx);
-    return 0;
-  }
-  numTxns = numTxns * 1000000;  // conversion from microseconds to seconds
-  boost::multiprecision::cpp_dec_float_50 TimeDiffFloat =
-      static_cast<boost::multiprecision::cpp_dec_float_50>(TimeDiff);
-  boost::multiprecision::cpp_dec_float_50 ans = numTxns / TimeDiffFloat;
-
-  return ans.convert_to<double>();
+  return GetBackfilledChainStats().GetTransactionRate(REF_BLOCK_DIFF);
 }
 
 double Server::GetDSBlockRate() {
   LOG_MARKER();
 
-  string numDSblockStr = to_string(m_mediator.m_dsBlockChain.GetBlockCount());
-  boost::multiprecision::cpp_dec_float_50 numDs(numDSblockStr);
-
-  if (m_StartTimeDs == 0)  // case when m_StartTime has not been set
-  {
-    try {
-      // Refernce time chosen to be the first block's timestamp
-      DSBlock dsb = m_mediator.m_dsBlockChain.GetBlock(1);
-      m_StartTimeDs = dsb.GetTimestamp();
-    } catch (const char* msg) {
-      if (string(msg) == "Blocknumber Absent") {
-        LOG_GENERAL(INFO, "No DSBlock has been mined yet");
-      }
-      return 0;
-    }
-  }
-  uint64_t TimeDiff =
-      m_mediator.m_dsBlockChain.GetLastBlock().GetTimestamp() - m_StartTimeDs;
-
-  if (TimeDiff == 0) {
-    LOG_GENERAL(INFO, "Wait till the second block");
-    return 0;
-  }
-  // To convert from microSeconds to seconds
-  numDs = numDs * 1000000;
-  boost::multiprecision::cpp_dec_float_50 TimeDiffFloat =
-      static_cast<boost::multiprecision::cpp_dec_float_50>(TimeDiff);
-  boost::multiprecision::cpp_dec_float_50 ans = numDs / TimeDiffFloat;
-  return ans.convert_to<double>();
+  return GetBackfilledChainStats().GetDSBlockRate();
 }
 
 double Server::GetTxBlockRate() {
   LOG_MARKER();
 
-  string numTxblockStr = to_string(m_mediator.m_txBlockChain.GetBlockCount());
-  boost::multiprecision::cpp_dec_float_50 numTx(numTxblockStr);
-
-  if (m_StartTimeTx == 0) {
-    try {
-      // Reference Time chosen to be first block's timestamp
-      TxBlock txb = m_mediator.m_txBlockChain.GetBlock(1);
-      m_StartTimeTx = txb.GetTimestamp();
-    } catch (const char* msg) {
-      if (string(msg) == "Blocknumber Absent") {
-        LOG_GENERAL(INFO, "No TxBlock has been mined yet");
-      }
-      return 0;
-    }
-  }
-  uint64_t TimeDiff =
-      m_mediator.m_txBlockChain.GetLastBlock().GetTimestamp() - m_StartTimeTx;
-
-  if (TimeDiff == 0) {
-    LOG_GENERAL(INFO, "Wait till the second block");
-    return 0;
-  }
-  // To convert from microSeconds to seconds
-  numTx = numTx * 1000000;
-  boost::multiprecision::cpp_dec_float_50 TimeDiffFloat(to_string(TimeDiff));
-  boost::multiprecision::cpp_dec_float_50 ans = numTx / TimeDiffFloat;
-  return ans.convert_to<double>();
+  return GetBackfilledChainStats().GetTxBlockRate();
 }
 
 string Server::GetCurrentMiniEpoch() {
@@ -951,55 +1097,11 @@ Json::Value Server::GetShardingStructure() {
 uint32_t Server::GetNumTxnsTxEpoch() {
   LOG_MARKER();
 
-  try {
-    return m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetNumTxs();
-  } catch (exception& e) {
-    LOG_GENERAL(WARNING, e.what());
-    return 0;
-  }
+  return GetBackfilledChainStats().GetNumTxnsTxEpoch();
 }
 
 string Server::GetNumTxnsDSEpoch() {
   LOG_MARKER();
 
-  try {
-    auto latestTxBlock = m_mediator.m_txBlockChain.GetLastBlock().GetHeader();
-    auto latestTxBlockNum = latestTxBlock.GetBlockNum();
-    auto latestDSBlockNum = latestTxBlock.GetDSBlockNum();
-
-    if (latestTxBlockNum > m_TxBlockCountSumPair.first) {
-      // Case where the DS Epoch is same
-      if (m_mediator.m_txBlockChain.GetBlock(m_TxBlockCountSumPair.first)
-              .GetHeader()
-              .GetDSBlockNum() == latestDSBlockNum) {
-        for (auto i = latestTxBlockNum; i > m_TxBlockCountSumPair.first; i--) {
-          m_TxBlockCountSumPair.second +=
-              m_mediator.m_txBlockChain.GetBlock(i).GetHeader().GetNumTxs();
-        }
-      }
-      // Case if DS Epoch Changed
-      else {
-        m_TxBlockCountSumPair.second = 0;
-
-        for (auto i = latestTxBlockNum; i > m_TxBlockCountSumPair.first; i--) {
-          if (m_mediator.m_txBlockChain.GetBlock(i)
-                  .GetHeader()
-                  .GetDSBlockNum() < latestDSBlockNum) {
-            break;
-          }
-          m_TxBlockCountSumPair.second +=
-              m_mediator.m_txBlockChain.GetBlock(i).GetHeader().GetNumTxs();
-        }
-      }
-
-      m_TxBlockCountSumPair.first = latestTxBlockNum;
-    }
-
-    return m_TxBlockCountSumPair.second.str();
-  }
-
-  catch (exception& e) {
-    LOG_GENERAL(WARNING, e.what());
-    return "0";
-  }
+  return GetBackfilledChainStats().GetNumTxnsDSEpoch().str();
 }
@@ -24,10 +24,18 @@
 #include <boost/multiprecision/cpp_int.hpp>
 #pragma GCC diagnostic pop
 #include <mutex>
+#include "ChainStats.h"
+#include "ResponseCache.h"
+#include "SubscriptionServer.h"
 #include "libData/BlockData/BlockHeader/BlockHeaderBase.h"
 #include "libData/DataStructures/CircularArray.h"
+#include "libUtils/Logger.h"
+#include "libUtils/ThreadPool.h"
 
 class Mediator;
+class DSBlock;
+class TxBlock;
+class TransactionWithReceipt;
 
 class AbstractZServer : public jsonrpc::AbstractServer<AbstractZServer> {
  public:
@@ -71,6 +79,16 @@ class AbstractZServer : public jsonrpc::AbstractServer<AbstractZServer> {
                            jsonrpc::JSON_OBJECT, "param01",
                            jsonrpc::JSON_STRING, NULL),
         &AbstractZServer::GetBalanceI);
+    this->bindAndAddMethod(
+        jsonrpc::Procedure("GetBalances", jsonrpc::PARAMS_BY_POSITION,
+                           jsonrpc::JSON_ARRAY, "param01", jsonrpc::JSON_ARRAY,
+                           NULL),
+        &AbstractZServer::GetBalancesI);
+    this->bindAndAddMethod(
+        jsonrpc::Procedure("GetTransactions", jsonrpc::PARAMS_BY_POSITION,
+                           jsonrpc::JSON_ARRAY, "param01", jsonrpc::JSON_ARRAY,
+                           NULL),
+        &AbstractZServer::GetTransactionsI);
     this->bindAndAddMethod(
         jsonrpc::Procedure("GetMinimumGasPrice", jsonrpc::PARAMS_BY_POSITION,
                            jsonrpc::JSON_STRING, NULL),
@@ -226,6 +244,14 @@ class AbstractZServer : public jsonrpc::AbstractServer<AbstractZServer> {
                                   Json::Value& response) {
     response = this->GetBalance(request[0u].asString());
   }
+  inline virtual void GetBalancesI(const Json::Value& request,
+                                   Json::Value& response) {
+    response = this->GetBalances(request[0u]);
+  }
+  inline virtual void GetTransactionsI(const Json::Value& request,
+                                       Json::Value& response) {
+    response = this->GetTransactions(request[0u]);
+  }
   inline virtual void GetMinimumGasPriceI(const Json::Value& request,
                                           Json::Value& response) {
     (void)request;
@@ -362,6 +388,8 @@ class AbstractZServer : public jsonrpc::AbstractServer<AbstractZServer> {
   virtual Json::Value GetLatestDsBlock() = 0;
   virtual Json::Value GetLatestTxBlock() = 0;
   virtual Json::Value GetBalance(const std::string& param01) = 0;
+  virtual Json::Value GetBalances(const Json::Value& param01) = 0;
+  virtual Json::Value GetTransactions(const Json::Value& param01) = 0;
   virtual std::string GetMinimumGasPrice() = 0;
   virtual Json::Value GetSmartContracts(const std::string& param01) = 0;
   virtual std::string GetContractAddressFromTransactionID(
@@ -394,14 +422,19 @@ class AbstractZServer : public jsonrpc::AbstractServer<AbstractZServer> {
 
 class Server : public AbstractZServer {
   Mediator& m_mediator;
-  std::pair<uint64_t, boost::multiprecision::uint128_t> m_BlockTxPair;
-  std::pair<uint64_t, boost::multiprecision::uint128_t> m_TxBlockCountSumPair;
-  uint64_t m_StartTimeTx;
-  uint64_t m_StartTimeDs;
   std::pair<uint64_t, CircularArray<std::string>> m_DSBlockCache;
   std::pair<uint64_t, CircularArray<std::string>> m_TxBlockCache;
   static CircularArray<std::string> m_RecentTransactions;
   static std::mutex m_mutexRecentTxns;
+  std::mutex m_mutexBatchPool;
+  ThreadPool m_batchPool;
+
+  /// Returns the chain statistics after loading any blocks missing from them.
+  ChainStats& GetBackfilledChainStats();
+
+  /// Returns the balance and nonce of the account (used by the single and
+  /// bulk balance queries).
+  static Json::Value GetBalanceJson(const std::string& address);
 
  public:
   Server(Mediator& mediator, jsonrpc::HttpServer& httpserver);
@@ -415,6 +448,8 @@ class Server : public AbstractZServer {
   virtual Json::Value GetLatestDsBlock();
   virtual Json::Value GetLatestTxBlock();
   virtual Json::Value GetBalance(const std::string& address);
+  virtual Json::Value GetBalances(const Json::Value& _json);
+  virtual Json::Value GetTransactions(const Json::Value& _json);
   virtual std::string GetMinimumGasPrice();
   virtual Json::Value GetSmartContracts(const std::string& address);
   virtual std::string GetContractAddressFromTransactionID(
@@ -442,9 +477,24 @@ class Server : public AbstractZServer {
   virtual uint32_t GetNumTxnsTxEpoch();
   static void AddToRecentTransactions(const dev::h256& txhash);
 
-  // gets the number of transaction starting from block blockNum to most recent
-  // block
-  size_t GetNumTransactions(uint64_t blockNum);
+  /// Returns the cache of responses for immutable objects.
+  static ResponseCache& GetResponseCache();
+
+  // Populate the response cache as soon as an object is committed
+  static void CacheDSBlock(const DSBlock& dsblock);
+  static void CacheTxBlock(const TxBlock& txblock);
+  static void CacheTransaction(const TransactionWithReceipt& twr);
+
+  /// Returns the rolling statistics over the committed blocks.
+  static ChainStats& GetChainStats();
+
+  // Update the chain statistics as soon as a block is committed
+  static void AddToChainStats(const DSBlock& dsblock);
+  static void AddToChainStats(const TxBlock& txblock);
+
+  /// Returns the server pushing committed blocks and transactions to
+  /// subscribed clients.
+  static SubscriptionServer& GetSubscriptionServer();
 
   Json::Value GetSmartContractState(const std::string& address);
   Json::Value GetSmartContractInit(const std::string& address);
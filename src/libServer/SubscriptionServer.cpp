@@ -0,0 +1,447 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+
+#include "JSONConversion.h"
+#include "SubscriptionServer.h"
+#include "libData/AccountData/Transaction.h"
+#include "libData/AccountData/TransactionReceipt.h"
+#include "libData/BlockData/Block.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+namespace {
+const unsigned int MAX_REQUEST_SIZE = 8192;
+const int POLL_TIMEOUT_MS = 1000;
+
+const string STREAM_HEADER =
+    "HTTP/1.1 200 OK\r\n"
+    "Content-Type: application/x-ndjson\r\n"
+    "Transfer-Encoding: chunked\r\n"
+    "Cache-Control: no-cache\r\n"
+    "\r\n";
+const string BAD_REQUEST =
+    "HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\n"
+    "Connection: close\r\n\r\n";
+const string NOT_FOUND =
+    "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+const string UNAVAILABLE =
+    "HTTP/1.1 503 Service Unavailable\r\nContent-Length: 0\r\n"
+    "Connection: close\r\n\r\n";
+
+bool SetNonBlocking(int fd) {
+  int flags = fcntl(fd, F_GETFL, 0);
+  return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+vector<string> Split(const string& str, char delimiter) {
+  vector<string> parts;
+  istringstream iss(str);
+  string part;
+  while (getline(iss, part, delimiter)) {
+    parts.emplace_back(part);
+  }
+  return parts;
+}
+}  // namespace
+
+SubscriptionServer::SubscriptionServer(unsigned int queueSize,
+                                       unsigned int maxClients,
+                                       unsigned int requestTimeoutInSeconds)
+    : m_queueSize(queueSize),
+      m_maxClients(maxClients),
+      m_requestTimeout(requestTimeoutInSeconds),
+      m_listenFd(-1),
+      m_wakeupFds{-1, -1},
+      m_running(false),
+      m_numSubscribed(0) {}
+
+SubscriptionServer::~SubscriptionServer() { Stop(); }
+
+bool SubscriptionServer::Start(unsigned int port) {
+  if (m_running) {
+    LOG_GENERAL(WARNING, "Subscription server already running");
+    return false;
+  }
+
+  m_listenFd = socket(AF_INET, SOCK_STREAM, 0);
+  if (m_listenFd < 0) {
+    LOG_GENERAL(WARNING, "Socket creation failed: " << strerror(errno));
+    return false;
+  }
+
+  int enable = 1;
+  setsockopt(m_listenFd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons(port);
+
+  if (bind(m_listenFd, (struct sockaddr*)&addr, sizeof(addr)) < 0 ||
+      listen(m_listenFd, SOMAXCONN) < 0 || !SetNonBlocking(m_listenFd) ||
+      pipe(m_wakeupFds) < 0 || !SetNonBlocking(m_wakeupFds[0]) ||
+      !SetNonBlocking(m_wakeupFds[1])) {
+    LOG_GENERAL(WARNING, "Failed to listen on port " << port << ": "
+                                                     << strerror(errno));
+    close(m_listenFd);
+    m_listenFd = -1;
+    for (int& fd : m_wakeupFds) {
+      if (fd >= 0) {
+        close(fd);
+        fd = -1;
+      }
+    }
+    return false;
+  }
+
+  m_running = true;
+  m_thread = thread([this]() -> void { Run(); });
+
+  LOG_GENERAL(INFO, "Subscription server listening on port " << port);
+  return true;
+}
+
+void SubscriptionServer::Stop() {
+  if (!m_running.exchange(false)) {
+    return;
+  }
+
+  Wakeup();
+  m_thread.join();
+
+  lock_guard<mutex> g(m_mutex);
+  while (!m_clients.empty()) {
+    CloseClient(m_clients.begin());
+  }
+  close(m_listenFd);
+  close(m_wakeupFds[0]);
+  close(m_wakeupFds[1]);
+  m_listenFd = m_wakeupFds[0] = m_wakeupFds[1] = -1;
+}
+
+void SubscriptionServer::Wakeup() {
+  char signal = 0;
+  if (write(m_wakeupFds[1], &signal, 1) < 0 && errno != EAGAIN) {
+    LOG_GENERAL(WARNING, "Failed to wake up subscription server");
+  }
+}
+
+void SubscriptionServer::Run() {
+  vector<struct pollfd> fds;
+
+  while (m_running) {
+    fds.clear();
+    fds.push_back({m_listenFd, POLLIN, 0});
+    fds.push_back({m_wakeupFds[0], POLLIN, 0});
+    {
+      lock_guard<mutex> g(m_mutex);
+      for (const auto& client : m_clients) {
+        short events = client.second.queue.empty() ? POLLIN : POLLIN | POLLOUT;
+        fds.push_back({client.first, events, 0});
+      }
+    }
+
+    if (poll(fds.data(), fds.size(), POLL_TIMEOUT_MS) < 0) {
+      if (errno != EINTR) {
+        LOG_GENERAL(WARNING, "poll failed: " << strerror(errno));
+      }
+      continue;
+    }
+
+    if (fds[1].revents & POLLIN) {
+      char buf[256];
+      while (read(m_wakeupFds[0], buf, sizeof(buf)) > 0) {
+      }
+    }
+
+    if (fds[0].revents & POLLIN) {
+      AcceptClients();
+    }
+
+    lock_guard<mutex> g(m_mutex);
+    for (size_t i = 2; i < fds.size(); i++) {
+      auto it = m_clients.find(fds[i].fd);
+      if (it == m_clients.end()) {
+        continue;
+      }
+      if (fds[i].revents & (POLLERR | POLLHUP | POLLNVAL)) {
+        it->second.closing = true;
+        continue;
+      }
+      if (fds[i].revents & POLLIN) {
+        ReadFromClient(it->first, it->second);
+      }
+      if ((fds[i].revents & POLLOUT) && !it->second.closing) {
+        WriteToClient(it->first, it->second);
+      }
+    }
+
+    // Closing is deferred to here, as publishers only flag the clients
+    const auto now = chrono::steady_clock::now();
+    for (auto it = m_clients.begin(); it != m_clients.end();) {
+      if (!it->second.subscribed && now >= it->second.requestDeadline) {
+        LOG_GENERAL(INFO, "Disconnecting idle client " << it->first);
+        it->second.closing = true;
+      }
+      if (it->second.closing) {
+        CloseClient(it++);
+      } else {
+        it++;
+      }
+    }
+  }
+}
+
+void SubscriptionServer::AcceptClients() {
+  while (true) {
+    int fd = accept(m_listenFd, nullptr, nullptr);
+    if (fd < 0) {
+      if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        LOG_GENERAL(WARNING, "accept failed: " << strerror(errno));
+      }
+      return;
+    }
+
+    lock_guard<mutex> g(m_mutex);
+    if (m_clients.size() >= m_maxClients || !SetNonBlocking(fd)) {
+      send(fd, UNAVAILABLE.data(), UNAVAILABLE.size(), MSG_NOSIGNAL);
+      close(fd);
+      continue;
+    }
+    m_clients[fd].requestDeadline =
+        chrono::steady_clock::now() + m_requestTimeout;
+  }
+}
+
+void SubscriptionServer::ReadFromClient(int fd, Client& client) {
+  char buf[4096];
+  ssize_t n = recv(fd, buf, sizeof(buf), 0);
+  if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+    client.closing = true;
+    return;
+  }
+  if (n < 0 || client.subscribed) {
+    // Anything sent after the subscription request is ignored
+    return;
+  }
+
+  client.request.append(buf, n);
+  if (client.request.find("\r\n\r\n") == string::npos) {
+    if (client.request.size() > MAX_REQUEST_SIZE) {
+      send(fd, BAD_REQUEST.data(), BAD_REQUEST.size(), MSG_NOSIGNAL);
+      client.closing = true;
+    }
+    return;
+  }
+
+  string response;
+  if (!ParseRequest(client, response)) {
+    send(fd, response.data(), response.size(), MSG_NOSIGNAL);
+    client.closing = true;
+    return;
+  }
+
+  client.request.clear();
+  client.subscribed = true;
+  client.queue.emplace_back(make_shared<const string>(STREAM_HEADER));
+  m_numSubscribed++;
+  WriteToClient(fd, client);
+}
+
+bool SubscriptionServer::ParseRequest(Client& client, string& response) {
+  response = BAD_REQUEST;
+
+  // Request line: GET /subscribe?<query> HTTP/1.1
+  vector<string> requestLine =
+      Split(client.request.substr(0, client.request.find("\r\n")), ' ');
+  if (requestLine.size() != 3 || requestLine[0] != "GET") {
+    return false;
+  }
+
+  const string& target = requestLine[1];
+  size_t queryPos = target.find('?');
+  if (target.substr(0, queryPos) != "/subscribe") {
+    response = NOT_FOUND;
+    return false;
+  }
+
+  client.events = 0;
+  client.addresses.clear();
+  if (queryPos != string::npos) {
+    for (const auto& param : Split(target.substr(queryPos + 1), '&')) {
+      size_t eqPos = param.find('=');
+      string key = param.substr(0, eqPos);
+      string value = eqPos == string::npos ? "" : param.substr(eqPos + 1);
+
+      if (key == "events") {
+        for (const auto& name : Split(value, ',')) {
+          if (name == "TxBlock") {
+            client.events |= TX_BLOCK;
+          } else if (name == "DSBlock") {
+            client.events |= DS_BLOCK;
+          } else if (name == "Txn") {
+            client.events |= TXN;
+          } else {
+            return false;
+          }
+        }
+      } else if (key == "address") {
+        if (value.compare(0, 2, "0x") == 0) {
+          value = value.substr(2);
+        }
+        if (value.size() != ACC_ADDR_SIZE * 2 ||
+            !all_of(value.begin(), value.end(),
+                    [](char c) { return isxdigit(c); })) {
+          return false;
+        }
+        client.addresses.emplace(value);
+      } else {
+        return false;
+      }
+    }
+  }
+
+  if (client.events == 0) {
+    client.events = ALL_EVENTS;
+  }
+  return true;
+}
+
+void SubscriptionServer::WriteToClient(int fd, Client& client) {
+  while (!client.queue.empty()) {
+    const string& chunk = *client.queue.front();
+    ssize_t n = send(fd, chunk.data() + client.offset,
+                     chunk.size() - client.offset, MSG_NOSIGNAL);
+    if (n < 0) {
+      if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        client.closing = true;
+      }
+      return;
+    }
+
+    client.offset += n;
+    if (client.offset == chunk.size()) {
+      client.queue.pop_front();
+      client.offset = 0;
+    }
+  }
+}
+
+void SubscriptionServer::CloseClient(map<int, Client>::iterator it) {
+  close(it->first);
+  if (it->second.subscribed) {
+    m_numSubscribed--;
+  }
+  m_clients.erase(it);
+}
+
+void SubscriptionServer::Publish(EventType type, const Json::Value& event,
+                                 const vector<Address>& addresses) {
+  if (m_numSubscribed == 0) {
+    return;
+  }
+
+  // Serialize once for all clients: one line per event, one chunk per line
+  Json::StreamWriterBuilder writer;
+  writer["indentation"] = "";
+  string line = Json::writeString(writer, event) + "\n";
+  ostringstream oss;
+  oss << hex << line.size() << "\r\n" << line << "\r\n";
+  Chunk chunk = make_shared<const string>(oss.str());
+
+  {
+    lock_guard<mutex> g(m_mutex);
+    for (auto& entry : m_clients) {
+      Client& client = entry.second;
+      if (!client.subscribed || client.closing || !(client.events & type)) {
+        continue;
+      }
+      if (type == TXN && !client.addresses.empty() &&
+          none_of(addresses.begin(), addresses.end(),
+                  [&client](const Address& address) {
+                    return client.addresses.count(address) > 0;
+                  })) {
+        continue;
+      }
+
+      if (client.queue.size() >= m_queueSize) {
+        LOG_GENERAL(INFO, "Disconnecting slow subscriber " << entry.first);
+        client.queue.clear();
+        client.closing = true;
+        continue;
+      }
+      client.queue.emplace_back(chunk);
+    }
+  }
+
+  Wakeup();
+}
+
+void SubscriptionServer::PublishTxBlock(const TxBlock& txblock) {
+  if (m_numSubscribed == 0) {
+    return;
+  }
+
+  Json::Value event;
+  event["type"] = "TxBlock";
+  event["data"] = JSONConversion::convertTxBlocktoJson(txblock);
+  Publish(TX_BLOCK, event);
+}
+
+void SubscriptionServer::PublishDSBlock(const DSBlock& dsblock) {
+  if (m_numSubscribed == 0) {
+    return;
+  }
+
+  Json::Value event;
+  event["type"] = "DSBlock";
+  event["data"] = JSONConversion::convertDSblocktoJson(dsblock);
+  Publish(DS_BLOCK, event);
+}
+
+void SubscriptionServer::PublishTransaction(const TransactionWithReceipt& twr) {
+  if (m_numSubscribed == 0) {
+    return;
+  }
+
+  const Transaction& tx = twr.GetTransaction();
+  const Address from = tx.GetSenderAddr();
+
+  Json::Value event;
+  event["type"] = "Txn";
+  event["hash"] = tx.GetTranID().hex();
+  event["from"] = from.hex();
+  event["to"] = tx.GetToAddr().hex();
+  event["receipt"] = twr.GetTransactionReceipt().GetJsonValue();
+  Publish(TXN, event, {from, tx.GetToAddr()});
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#ifndef __SUBSCRIPTIONSERVER_H__
+#define __SUBSCRIPTIONSERVER_H__
+
+#include <json/json.h>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "libData/AccountData/Address.h"
+
+class DSBlock;
+class TxBlock;
+class TransactionWithReceipt;
+
+/// Pushes newly committed Tx blocks, DS blocks and transactions to clients
+/// over long-lived HTTP connections, as a chunked stream with one JSON object
+/// per line. A client subscribes with
+///
+///   GET /subscribe?events=TxBlock,DSBlock,Txn&address=<hex>&address=<hex>
+///
+/// where omitting events subscribes to all of them, and the addresses (if
+/// any) restrict the Txn events to those sent from or to them.
+/// Each client has a bounded queue; a client that falls behind by more than
+/// the queue size is disconnected rather than slowing down the others. A
+/// client that does not complete its request in time is disconnected too, so
+/// idle connections cannot hold the client slots.
+class SubscriptionServer {
+ public:
+  enum EventType : unsigned char {
+    TX_BLOCK = 0x01,
+    DS_BLOCK = 0x02,
+    TXN = 0x04,
+    ALL_EVENTS = TX_BLOCK | DS_BLOCK | TXN
+  };
+
+ private:
+  using Chunk = std::shared_ptr<const std::string>;
+
+  struct Client {
+    std::string request;  // until the subscription request is complete
+    std::chrono::steady_clock::time_point requestDeadline;
+    bool subscribed = false;
+    bool closing = false;
+    unsigned char events = 0;
+    AddressHashSet addresses;
+    std::deque<Chunk> queue;
+    size_t offset = 0;  // bytes of the front chunk already sent
+  };
+
+  const unsigned int m_queueSize;
+  const unsigned int m_maxClients;
+  const std::chrono::seconds m_requestTimeout;
+  int m_listenFd;
+  int m_wakeupFds[2];
+  std::atomic<bool> m_running;
+  std::atomic<unsigned int> m_numSubscribed;
+  std::thread m_thread;
+  std::map<int, Client> m_clients;
+  mutable std::mutex m_mutex;
+
+  void Run();
+  void Wakeup();
+  void AcceptClients();
+  void ReadFromClient(int fd, Client& client);
+  void WriteToClient(int fd, Client& client);
+  bool ParseRequest(Client& client, std::string& response);
+  void CloseClient(std::map<int, Client>::iterator it);
+
+ public:
+  /// Constructor.
+  SubscriptionServer(unsigned int queueSize, unsigned int maxClients,
+                     unsigned int requestTimeoutInSeconds);
+
+  /// Destructor. Stops the server.
+  ~SubscriptionServer();
+
+  SubscriptionServer(const SubscriptionServer&) = delete;
+  SubscriptionServer& operator=(const SubscriptionServer&) = delete;
+
+  /// Starts accepting subscriptions on the port.
+  bool Start(unsigned int port);
+
+  /// Disconnects all clients and stops the server.
+  void Stop();
+
+  /// Returns the number of clients with an active subscription.
+  unsigned int GetNumSubscribers() const { return m_numSubscribed; }
+
+  /// Queues the event for every client subscribed to its type (and, for
+  /// transactions, to one of the addresses).
+  void Publish(EventType type, const Json::Value& event,
+               const std::vector<Address>& addresses = {});
+
+  void PublishTxBlock(const TxBlock& txblock);
+  void PublishDSBlock(const DSBlock& dsblock);
+  void PublishTransaction(const TransactionWithReceipt& twr);
+};
+
+#endif  // __SUBSCRIPTIONSERVER_H__
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#include <zstd.h>
+
+#include "Compression.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+bool Compression::Compress(const unsigned char* src, size_t size, int level,
+                           vector<unsigned char>& dst) {
+  const size_t offset = dst.size();
+  dst.resize(offset + ZSTD_compressBound(size));
+
+  const size_t result =
+      ZSTD_compress(dst.data() + offset, dst.size() - offset, src, size, level);
+  if (ZSTD_isError(result)) {
+    LOG_GENERAL(WARNING,
+                "ZSTD_compress failed: " << ZSTD_getErrorName(result));
+    dst.resize(offset);
+    return false;
+  }
+
+  dst.resize(offset + result);
+  return true;
+}
+
+bool Compression::Decompress(const unsigned char* src, size_t size,
+                             size_t maxSize, vector<unsigned char>& dst) {
+  StreamDecompressor decompressor(maxSize);
+  return decompressor.Update(src, size, dst) && decompressor.Finished();
+}
+
+StreamDecompressor::StreamDecompressor(size_t maxSize)
+    : m_stream(ZSTD_createDStream()),
+      m_maxSize(maxSize),
+      m_outputSize(0),
+      m_finished(false),
+      m_failed(m_stream == nullptr) {
+  if (m_failed) {
+    LOG_GENERAL(WARNING, "ZSTD_createDStream failed");
+    return;
+  }
+
+  // The window is allocated from the frame header, before any output is
+  // produced, so it is capped by the output limit too
+  const ZSTD_bounds bounds = ZSTD_dParam_getBounds(ZSTD_d_windowLogMax);
+  int windowLog = bounds.lowerBound;
+  while ((windowLog < bounds.upperBound) &&
+         (windowLog < (int)(sizeof(size_t) * 8) - 1) &&
+         (((size_t)1 << windowLog) < maxSize)) {
+    windowLog++;
+  }
+
+  const size_t result =
+      ZSTD_DCtx_setParameter(m_stream, ZSTD_d_windowLogMax, windowLog);
+  if (ZSTD_isError(result)) {
+    LOG_GENERAL(WARNING,
+                "ZSTD_DCtx_setParameter failed: " << ZSTD_getErrorName(result));
+    m_failed = true;
+  }
+}
+
+StreamDecompressor::~StreamDecompressor() { ZSTD_freeDStream(m_stream); }
+
+bool StreamDecompressor::Update(const unsigned char* src, size_t size,
+                                vector<unsigned char>& dst) {
+  if (m_failed) {
+    return false;
+  }
+
+  ZSTD_inBuffer input = {src, size, 0};
+  bool outputFull = true;
+
+  // Keep going while there is input left, or while the decoder may still hold
+  // buffered output (i.e., it filled the whole output window last time)
+  while ((input.pos < input.size) || (outputFull && !m_finished)) {
+    if (m_finished) {
+      LOG_GENERAL(WARNING, "Trailing data after compressed frame");
+      m_failed = true;
+      return false;
+    }
+
+    if (m_outputSize >= m_maxSize) {
+      LOG_GENERAL(WARNING, "Decompressed size exceeds " << m_maxSize);
+      m_failed = true;
+      return false;
+    }
+    const size_t offset = dst.size();
+    dst.resize(offset + min(ZSTD_DStreamOutSize(), m_maxSize - m_outputSize));
+
+    ZSTD_outBuffer output = {dst.data() + offset, dst.size() - offset, 0};
+    const size_t result = ZSTD_decompressStream(m_stream, &output, &input);
+    dst.resize(offset + output.pos);
+    m_outputSize += output.pos;
+
+    if (ZSTD_isError(result)) {
+      LOG_GENERAL(WARNING, "ZSTD_decompressStream failed: "
+                               << ZSTD_getErrorName(result));
+      m_failed = true;
+      return false;
+    }
+
+    outputFull = (output.pos == output.size);
+    m_finished = (result == 0);
+  }
+
+  return true;
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#ifndef __COMPRESSION_H__
+#define __COMPRESSION_H__
+
+#include <cstddef>
+#include <vector>
+
+struct ZSTD_DCtx_s;
+
+/// Utility class for zstd compression of network payloads.
+class Compression {
+ public:
+  /// Appends the compressed form of the input to the destination.
+  static bool Compress(const unsigned char* src, size_t size, int level,
+                       std::vector<unsigned char>& dst);
+
+  /// Decompresses one complete frame, refusing to produce more than maxSize
+  /// bytes of output.
+  static bool Decompress(const unsigned char* src, size_t size,
+                         size_t maxSize, std::vector<unsigned char>& dst);
+};
+
+/// Decompresses one frame fed in arbitrary pieces, so that input held in
+/// several buffers (e.g., an evbuffer chain) never has to be made contiguous.
+class StreamDecompressor {
+  ZSTD_DCtx_s* m_stream;
+  size_t m_maxSize;
+  size_t m_outputSize;
+  bool m_finished;
+  bool m_failed;
+
+ public:
+  /// Constructor. Output beyond maxSize bytes is treated as an error, and so
+  /// is a frame whose window would be larger than maxSize.
+  explicit StreamDecompressor(size_t maxSize);
+
+  /// Destructor.
+  ~StreamDecompressor();
+
+  StreamDecompressor(const StreamDecompressor&) = delete;
+  StreamDecompressor& operator=(const StreamDecompressor&) = delete;
+
+  /// Decompresses the next piece of input, appending output to the
+  /// destination.
+  bool Update(const unsigned char* src, size_t size,
+              std::vector<unsigned char>& dst);
+
+  /// Checks whether the whole frame has been decompressed.
+  bool Finished() const { return m_finished && !m_failed; }
+};
+
+#endif  // __COMPRESSION_H__
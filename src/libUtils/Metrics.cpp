@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+#include "Metrics.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+namespace {
+const string PHASE_METRIC = "zilliqa_epoch_phase_duration_seconds";
+const array<const char*, (size_t)EpochPhase::NUM_PHASES> PHASE_NAMES = {
+    {"pow", "dsblock_consensus", "txn_ingestion", "microblock_composition",
+     "microblock_consensus", "finalblock_composition", "finalblock_consensus",
+     "state_commit"}};
+const array<double, 5> EXPORTED_QUANTILES = {{0.5, 0.9, 0.99, 0.999, 1.0}};
+
+unsigned int GetShardIndex() {
+  static atomic<unsigned int> nextShard{0};
+  thread_local unsigned int shard = nextShard++ % METRICS_NUM_SHARDS;
+  return shard;
+}
+
+int64_t GetSteadyTimeInMicroseconds() {
+  return chrono::duration_cast<chrono::microseconds>(
+             chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+string JoinLabels(const string& labels, const string& extra) {
+  if (labels.empty() && extra.empty()) {
+    return "";
+  }
+  if (labels.empty() || extra.empty()) {
+    return "{" + labels + extra + "}";
+  }
+  return "{" + labels + "," + extra + "}";
+}
+}  // namespace
+
+void MetricCounter::Increment(uint64_t delta) {
+  m_shards[GetShardIndex()].value.fetch_add(delta, memory_order_relaxed);
+}
+
+uint64_t MetricCounter::Get() const {
+  uint64_t total = 0;
+  for (const auto& shard : m_shards) {
+    total += shard.value.load(memory_order_relaxed);
+  }
+  return total;
+}
+
+MetricHistogram::Shard::Shard() {
+  for (auto& bucket : buckets) {
+    bucket.store(0, memory_order_relaxed);
+  }
+}
+
+unsigned int MetricHistogram::GetBucketIndex(uint64_t value) {
+  if (value < (1ULL << SUB_BUCKET_BITS)) {
+    return value;
+  }
+  if (value >= (1ULL << MAX_VALUE_BITS)) {
+    return NUM_BUCKETS - 1;
+  }
+
+  // Keep the SUB_BUCKET_BITS most significant bits of the value
+  unsigned int shift = 63 - __builtin_clzll(value) - (SUB_BUCKET_BITS - 1);
+  return (shift << (SUB_BUCKET_BITS - 1)) + (value >> shift);
+}
+
+uint64_t MetricHistogram::GetBucketUpperBound(unsigned int index) {
+  if (index < (1U << SUB_BUCKET_BITS)) {
+    return index;
+  }
+
+  unsigned int shift = (index >> (SUB_BUCKET_BITS - 1)) - 1;
+  uint64_t subBucket = index - (shift << (SUB_BUCKET_BITS - 1));
+  return ((subBucket + 1) << shift) - 1;
+}
+
+void MetricHistogram::Record(uint64_t value) {
+  Shard& shard = m_shards[GetShardIndex()];
+  shard.buckets[GetBucketIndex(value)].fetch_add(1, memory_order_relaxed);
+  shard.count.fetch_add(1, memory_order_relaxed);
+  shard.sum.fetch_add(value, memory_order_relaxed);
+
+  uint64_t max = shard.max.load(memory_order_relaxed);
+  while (value > max &&
+         !shard.max.compare_exchange_weak(max, value, memory_order_relaxed)) {
+  }
+}
+
+MetricHistogram::Snapshot MetricHistogram::GetSnapshot() const {
+  Snapshot snapshot;
+  snapshot.buckets.assign(NUM_BUCKETS, 0);
+
+  for (const auto& shard : m_shards) {
+    for (unsigned int i = 0; i < NUM_BUCKETS; i++) {
+      uint64_t count = shard.buckets[i].load(memory_order_relaxed);
+      snapshot.buckets[i] += count;
+      snapshot.count += count;
+    }
+    snapshot.sum += shard.sum.load(memory_order_relaxed);
+    snapshot.max = max(snapshot.max, shard.max.load(memory_order_relaxed));
+  }
+
+  return snapshot;
+}
+
+uint64_t MetricHistogram::Snapshot::GetQuantile(double quantile) const {
+  if (count == 0) {
+    return 0;
+  }
+
+  uint64_t rank = std::max<uint64_t>(1, ceil(quantile * count));
+  uint64_t seen = 0;
+  for (unsigned int i = 0; i < buckets.size(); i++) {
+    seen += buckets[i];
+    if (seen >= rank) {
+      return min(GetBucketUpperBound(i), max);
+    }
+  }
+
+  return max;
+}
+
+Metrics::Metrics() {
+  for (size_t i = 0; i < m_phases.size(); i++) {
+    m_phases[i] = &GetHistogram(PHASE_METRIC, "Duration of the epoch phases",
+                                string("phase=\"") + PHASE_NAMES[i] + "\"");
+    m_phaseStarts[i] = 0;
+  }
+}
+
+Metrics& Metrics::GetInstance() {
+  static Metrics metrics;
+  return metrics;
+}
+
+Metrics::Family& Metrics::GetFamily(const string& name, const string& help,
+                                    const string& type) {
+  Family& family = m_families[name];
+  if (family.type.empty()) {
+    family.help = help;
+    family.type = type;
+  } else if (family.type != type) {
+    LOG_GENERAL(WARNING, "Metric " << name << " is a " << family.type
+                                   << ", not a " << type);
+  }
+  return family;
+}
+
+MetricCounter& Metrics::GetCounter(const string& name, const string& help,
+                                   const string& labels) {
+  lock_guard<mutex> g(m_mutexFamilies);
+  auto& counter = GetFamily(name, help, "counter").counters[labels];
+  if (!counter) {
+    counter.reset(new MetricCounter());
+  }
+  return *counter;
+}
+
+MetricGauge& Metrics::GetGauge(const string& name, const string& help,
+                               const string& labels) {
+  lock_guard<mutex> g(m_mutexFamilies);
+  auto& gauge = GetFamily(name, help, "gauge").gauges[labels];
+  if (!gauge) {
+    gauge.reset(new MetricGauge());
+  }
+  return *gauge;
+}
+
+MetricHistogram& Metrics::GetHistogram(const string& name, const string& help,
+                                       const string& labels) {
+  lock_guard<mutex> g(m_mutexFamilies);
+  auto& histogram = GetFamily(name, help, "summary").histograms[labels];
+  if (!histogram) {
+    histogram.reset(new MetricHistogram());
+  }
+  return *histogram;
+}
+
+void Metrics::StartPhase(EpochPhase phase) {
+  m_phaseStarts[(size_t)phase] = GetSteadyTimeInMicroseconds();
+}
+
+void Metrics::EndPhase(EpochPhase phase) {
+  int64_t start = m_phaseStarts[(size_t)phase].exchange(0);
+  if (start == 0) {
+    return;
+  }
+  int64_t elapsed = GetSteadyTimeInMicroseconds() - start;
+  RecordPhase(phase, chrono::microseconds(max<int64_t>(0, elapsed)));
+}
+
+void Metrics::RecordPhase(EpochPhase phase, chrono::microseconds duration) {
+  m_phases[(size_t)phase]->Record(duration.count());
+}
+
+string Metrics::ExportPrometheus() const {
+  ostringstream oss;
+  oss << fixed;
+
+  lock_guard<mutex> g(m_mutexFamilies);
+  for (const auto& entry : m_families) {
+    const string& name = entry.first;
+    const Family& family = entry.second;
+    oss << "# HELP " << name << " " << family.help << "\n"
+        << "# TYPE " << name << " " << family.type << "\n";
+
+    for (const auto& counter : family.counters) {
+      oss << name << JoinLabels(counter.first, "") << " "
+          << counter.second->Get() << "\n";
+    }
+    for (const auto& gauge : family.gauges) {
+      oss << name << JoinLabels(gauge.first, "") << " " << gauge.second->Get()
+          << "\n";
+    }
+    for (const auto& histogram : family.histograms) {
+      const string& labels = histogram.first;
+      MetricHistogram::Snapshot snapshot = histogram.second->GetSnapshot();
+      oss << setprecision(6);
+      for (double quantile : EXPORTED_QUANTILES) {
+        ostringstream q;
+        q << "quantile=\"" << quantile << "\"";
+        oss << name << JoinLabels(labels, q.str()) << " "
+            << snapshot.GetQuantile(quantile) / 1e6 << "\n";
+      }
+      oss << name << "_sum" << JoinLabels(labels, "") << " "
+          << snapshot.sum / 1e6 << "\n"
+          << name << "_count" << JoinLabels(labels, "") << " " << snapshot.count
+          << "\n";
+    }
+  }
+
+  return oss.str();
+}
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#ifndef __METRICS_H__
+#define __METRICS_H__
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/// Number of shards behind each counter and histogram. Every thread writes to
+/// the shard it was assigned on first use, so concurrent updates rarely touch
+/// the same cache line and never take a lock.
+const unsigned int METRICS_NUM_SHARDS = 8;
+
+/// Monotonically increasing count (e.g., number of transactions received).
+class MetricCounter {
+  struct Shard {
+    std::atomic<uint64_t> value{0};
+    char padding[64 - sizeof(std::atomic<uint64_t>)];
+  };
+  std::array<Shard, METRICS_NUM_SHARDS> m_shards;
+
+ public:
+  void Increment(uint64_t delta = 1);
+  uint64_t Get() const;
+};
+
+/// Value that can go up and down (e.g., the depth of a queue).
+class MetricGauge {
+  std::atomic<int64_t> m_value{0};
+
+ public:
+  void Set(int64_t value) { m_value.store(value, std::memory_order_relaxed); }
+  void Increment(int64_t delta = 1) {
+    m_value.fetch_add(delta, std::memory_order_relaxed);
+  }
+  void Decrement(int64_t delta = 1) {
+    m_value.fetch_sub(delta, std::memory_order_relaxed);
+  }
+  int64_t Get() const { return m_value.load(std::memory_order_relaxed); }
+};
+
+/// Distribution of non-negative integer values (latencies in microseconds),
+/// bucketed like an HDR histogram: values below 2^SUB_BUCKET_BITS are exact,
+/// larger ones keep SUB_BUCKET_BITS significant bits (i.e., within ~3%).
+class MetricHistogram {
+ public:
+  static const unsigned int SUB_BUCKET_BITS = 5;
+  static const unsigned int MAX_VALUE_BITS = 40;  // ~12 days in microseconds
+  static const unsigned int NUM_BUCKETS =
+      (MAX_VALUE_BITS - SUB_BUCKET_BITS + 2) << (SUB_BUCKET_BITS - 1);
+
+  /// Point-in-time copy of the histogram, merged over all shards.
+  struct Snapshot {
+    std::vector<uint64_t> buckets;
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    uint64_t max = 0;
+
+    /// Returns the value at the quantile (0.0 - 1.0), as the highest value
+    /// equivalent to the bucket it falls into.
+    uint64_t GetQuantile(double quantile) const;
+  };
+
+  static unsigned int GetBucketIndex(uint64_t value);
+  static uint64_t GetBucketUpperBound(unsigned int index);
+
+  void Record(uint64_t value);
+  Snapshot GetSnapshot() const;
+
+ private:
+  struct Shard {
+    std::array<std::atomic<uint64_t>, NUM_BUCKETS> buckets;
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> sum{0};
+    std::atomic<uint64_t> max{0};
+
+    Shard();
+  };
+  std::array<Shard, METRICS_NUM_SHARDS> m_shards;
+};
+
+/// Phases of an epoch whose latencies are tracked by Metrics.
+enum class EpochPhase : unsigned char {
+  POW = 0,
+  DSBLOCK_CONSENSUS,
+  TXN_INGESTION,
+  MICROBLOCK_COMPOSITION,
+  MICROBLOCK_CONSENSUS,
+  FINALBLOCK_COMPOSITION,
+  FINALBLOCK_CONSENSUS,
+  STATE_COMMIT,
+  NUM_PHASES
+};
+
+/// Process-wide registry of metrics, exported in the Prometheus text format.
+/// Metrics are created on first lookup and live until the process exits, so
+/// callers can keep the returned references (usually in a function-local
+/// static) and update them without going through the registry again.
+class Metrics {
+  struct Family {
+    std::string help;
+    std::string type;
+    std::map<std::string, std::unique_ptr<MetricCounter>> counters;
+    std::map<std::string, std::unique_ptr<MetricGauge>> gauges;
+    std::map<std::string, std::unique_ptr<MetricHistogram>> histograms;
+  };
+
+  std::map<std::string, Family> m_families;
+  mutable std::mutex m_mutexFamilies;
+
+  std::array<MetricHistogram*, (size_t)EpochPhase::NUM_PHASES> m_phases;
+  std::array<std::atomic<int64_t>, (size_t)EpochPhase::NUM_PHASES>
+      m_phaseStarts;
+
+  Metrics();
+
+  Family& GetFamily(const std::string& name, const std::string& help,
+                    const std::string& type);
+
+ public:
+  static Metrics& GetInstance();
+
+  Metrics(const Metrics&) = delete;
+  Metrics& operator=(const Metrics&) = delete;
+
+  /// Returns the counter with the name and labels (e.g., "shard=\"1\"").
+  MetricCounter& GetCounter(const std::string& name, const std::string& help,
+                            const std::string& labels = "");
+
+  /// Returns the gauge with the name and labels.
+  MetricGauge& GetGauge(const std::string& name, const std::string& help,
+                        const std::string& labels = "");
+
+  /// Returns the histogram with the name and labels. Values are recorded in
+  /// microseconds and exported in seconds.
+  MetricHistogram& GetHistogram(const std::string& name,
+                                const std::string& help,
+                                const std::string& labels = "");
+
+  /// Marks the start of a phase that ends in another function or thread
+  /// (e.g., a consensus round). A pending start is overwritten.
+  void StartPhase(EpochPhase phase);
+
+  /// Records the time since the matching StartPhase, if there was one.
+  void EndPhase(EpochPhase phase);
+
+  /// Records a phase duration measured by the caller.
+  void RecordPhase(EpochPhase phase, std::chrono::microseconds duration);
+
+  /// Returns all metrics in the Prometheus text exposition format.
+  std::string ExportPrometheus() const;
+};
+
+/// Records the lifetime of the object as one occurrence of the phase.
+class ScopedPhaseTimer {
+  EpochPhase m_phase;
+  std::chrono::steady_clock::time_point m_start;
+
+ public:
+  explicit ScopedPhaseTimer(EpochPhase phase)
+      : m_phase(phase), m_start(std::chrono::steady_clock::now()) {}
+
+  ~ScopedPhaseTimer() {
+    Metrics::GetInstance().RecordPhase(
+        m_phase, std::chrono::duration_cast<std::chrono::microseconds>(
+                     std::chrono::steady_clock::now() - m_start));
+  }
+
+  ScopedPhaseTimer(const ScopedPhaseTimer&) = delete;
+  ScopedPhaseTimer& operator=(const ScopedPhaseTimer&) = delete;
+};
+
+#endif  // __METRICS_H__
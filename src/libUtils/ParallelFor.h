@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#ifndef __PARALLELFOR_H__
+#define __PARALLELFOR_H__
+
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "libUtils/Logger.h"
+#include "libUtils/ThreadPool.h"
+
+/// Calls func(i) for every i in [0, count) as one strided job per pool thread
+/// and waits for all of them to finish, or runs them serially if the pool has
+/// fewer than two threads. The mutex keeps the callers sharing the pool from
+/// waiting on each other's jobs.
+inline void ParallelFor(ThreadPool& pool, std::mutex& poolMutex, size_t count,
+                        const std::function<void(size_t)>& func) {
+  const size_t numThreads = pool.GetThreads().size();
+  if (count < 2 || numThreads < 2) {
+    for (size_t i = 0; i < count; i++) {
+      func(i);
+    }
+    return;
+  }
+
+  std::lock_guard<std::mutex> g(poolMutex);
+
+  const size_t numJobs = std::min(count, numThreads);
+  for (size_t job = 0; job < numJobs; job++) {
+    pool.AddJob([job, numJobs, count, &func]() -> void {
+      for (size_t i = job; i < count; i += numJobs) {
+        func(i);
+      }
+    });
+  }
+  pool.WaitAll();
+}
+
+/// Verifies the items [0, count) in parallel, then merges the verified ones
+/// serially in their original order. As long as verify does not depend on the
+/// merged items, this has the same outcome as verifying and merging each item
+/// in turn. Returns the number of items merged.
+inline size_t ParallelVerifyThenMerge(
+    ThreadPool& pool, std::mutex& poolMutex, size_t count,
+    const std::function<bool(size_t)>& verify,
+    const std::function<bool(size_t)>& merge) {
+  std::vector<unsigned char> verified(count, false);
+  ParallelFor(pool, poolMutex, count,
+              [&verified, &verify](size_t i) { verified[i] = verify(i); });
+
+  size_t numMerged = 0;
+  for (size_t i = 0; i < count; i++) {
+    if (verified[i] && merge(i)) {
+      numMerged++;
+    }
+  }
+  return numMerged;
+}
+
+#endif  // __PARALLELFOR_H__
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#include <array>
+
+#include "ReedSolomon.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+namespace {
+// GF(2^8) with the primitive polynomial x^8 + x^4 + x^3 + x^2 + 1
+class GaloisField {
+  array<unsigned char, 512> m_exp;
+  array<unsigned int, 256> m_log;
+  vector<array<unsigned char, 256>> m_mul;
+
+  GaloisField() : m_mul(256) {
+    unsigned int x = 1;
+    for (unsigned int i = 0; i < 255; i++) {
+      m_exp[i] = m_exp[i + 255] = x;
+      m_log[x] = i;
+      x <<= 1;
+      if (x & 0x100) {
+        x ^= 0x11D;
+      }
+    }
+    m_exp[510] = m_exp[511] = m_exp[0];
+    m_log[0] = 0;
+
+    for (unsigned int a = 0; a < 256; a++) {
+      for (unsigned int b = 0; b < 256; b++) {
+        m_mul[a][b] = (a == 0 || b == 0) ? 0 : m_exp[m_log[a] + m_log[b]];
+      }
+    }
+  }
+
+ public:
+  static const GaloisField& GetInstance() {
+    static GaloisField field;
+    return field;
+  }
+
+  unsigned char Mul(unsigned char a, unsigned char b) const {
+    return m_mul[a][b];
+  }
+
+  unsigned char Inv(unsigned char a) const { return m_exp[255 - m_log[a]]; }
+
+  /// dst ^= coefficient * src, over size bytes
+  void MulAdd(unsigned char coefficient, const unsigned char* src,
+              unsigned char* dst, size_t size) const {
+    if (coefficient == 0) {
+      return;
+    }
+    const array<unsigned char, 256>& row = m_mul[coefficient];
+    for (size_t i = 0; i < size; i++) {
+      dst[i] ^= row[src[i]];
+    }
+  }
+};
+
+// Row of the generator matrix for a shard. Data shards are identity rows and
+// parity shards are rows of a Cauchy matrix, so every square submatrix of the
+// generator is invertible.
+vector<unsigned char> GeneratorRow(unsigned int index,
+                                   unsigned int dataShards) {
+  const GaloisField& gf = GaloisField::GetInstance();
+  vector<unsigned char> row(dataShards, 0);
+
+  if (index < dataShards) {
+    row[index] = 1;
+  } else {
+    for (unsigned int j = 0; j < dataShards; j++) {
+      row[j] = gf.Inv(index ^ j);
+    }
+  }
+  return row;
+}
+
+// Inverts the square matrix in place by Gauss-Jordan elimination
+bool Invert(vector<vector<unsigned char>>& matrix) {
+  const GaloisField& gf = GaloisField::GetInstance();
+  const unsigned int size = matrix.size();
+
+  vector<vector<unsigned char>> inverse(size, vector<unsigned char>(size, 0));
+  for (unsigned int i = 0; i < size; i++) {
+    inverse[i][i] = 1;
+  }
+
+  for (unsigned int col = 0; col < size; col++) {
+    unsigned int pivot = col;
+    while (pivot < size && matrix[pivot][col] == 0) {
+      pivot++;
+    }
+    if (pivot == size) {
+      return false;
+    }
+    swap(matrix[pivot], matrix[col]);
+    swap(inverse[pivot], inverse[col]);
+
+    const unsigned char scale = gf.Inv(matrix[col][col]);
+    for (unsigned int j = 0; j < size; j++) {
+      matrix[col][j] = gf.Mul(matrix[col][j], scale);
+      inverse[col][j] = gf.Mul(inverse[col][j], scale);
+    }
+
+    for (unsigned int row = 0; row < size; row++) {
+      const unsigned char factor = matrix[row][col];
+      if (row == col || factor == 0) {
+        continue;
+      }
+      gf.MulAdd(factor, matrix[col].data(), matrix[row].data(), size);
+      gf.MulAdd(factor, inverse[col].data(), inverse[row].data(), size);
+    }
+  }
+
+  matrix = move(inverse);
+  return true;
+}
+}  // namespace
+
+bool ReedSolomon::Encode(const vector<unsigned char>& data,
+                         unsigned int dataShards, unsigned int parityShards,
+                         vector<vector<unsigned char>>& shards) {
+  if (dataShards == 0 || dataShards + parityShards > MAX_SHARDS) {
+    LOG_GENERAL(WARNING, "Invalid shard counts " << dataShards << " + "
+                                                 << parityShards);
+    return false;
+  }
+
+  const GaloisField& gf = GaloisField::GetInstance();
+  const size_t shardSize =
+      max<size_t>(1, (data.size() + dataShards - 1) / dataShards);
+
+  shards.assign(dataShards + parityShards, vector<unsigned char>(shardSize, 0));
+
+  for (unsigned int i = 0; i < dataShards; i++) {
+    const size_t begin = min(data.size(), i * shardSize);
+    const size_t end = min(data.size(), begin + shardSize);
+    copy(data.begin() + begin, data.begin() + end, shards[i].begin());
+  }
+
+  for (unsigned int i = dataShards; i < dataShards + parityShards; i++) {
+    const vector<unsigned char> row = GeneratorRow(i, dataShards);
+    for (unsigned int j = 0; j < dataShards; j++) {
+      gf.MulAdd(row[j], shards[j].data(), shards[i].data(), shardSize);
+    }
+  }
+
+  return true;
+}
+
+bool ReedSolomon::Decode(const vector<vector<unsigned char>>& shards,
+                         unsigned int dataShards, size_t dataSize,
+                         vector<unsigned char>& data) {
+  if (dataShards == 0 || shards.size() < dataShards ||
+      shards.size() > MAX_SHARDS) {
+    LOG_GENERAL(WARNING, "Invalid shard counts " << dataShards << " of "
+                                                 << shards.size());
+    return false;
+  }
+
+  // Pick the first dataShards shards that were received
+  vector<unsigned int> present;
+  size_t shardSize = 0;
+  for (unsigned int i = 0; i < shards.size() && present.size() < dataShards;
+       i++) {
+    if (shards[i].empty()) {
+      continue;
+    }
+    if (shardSize == 0) {
+      shardSize = shards[i].size();
+    } else if (shards[i].size() != shardSize) {
+      LOG_GENERAL(WARNING, "Shard " << i << " has size " << shards[i].size()
+                                    << ", expected " << shardSize);
+      return false;
+    }
+    present.emplace_back(i);
+  }
+
+  if (present.size() < dataShards) {
+    LOG_GENERAL(WARNING, "Only " << present.size() << " of " << dataShards
+                                 << " shards needed are present");
+    return false;
+  }
+  if (dataSize > shardSize * dataShards) {
+    LOG_GENERAL(WARNING, "Data size " << dataSize << " exceeds the shards");
+    return false;
+  }
+
+  const GaloisField& gf = GaloisField::GetInstance();
+  data.assign(shardSize * dataShards, 0);
+
+  // Data shards that arrived are copied through; the rest are rebuilt from
+  // the inverse of the generator rows of the shards at hand
+  vector<vector<unsigned char>> matrix;
+  bool missing = false;
+  for (const auto& i : present) {
+    matrix.emplace_back(GeneratorRow(i, dataShards));
+    missing = missing || (i >= dataShards);
+  }
+
+  if (!missing) {
+    for (unsigned int i = 0; i < dataShards; i++) {
+      copy(shards[i].begin(), shards[i].end(), data.begin() + i * shardSize);
+    }
+  } else {
+    if (!Invert(matrix)) {
+      LOG_GENERAL(WARNING, "Shard matrix is singular");
+      return false;
+    }
+    for (unsigned int i = 0; i < dataShards; i++) {
+      unsigned char* dst = data.data() + i * shardSize;
+      if (!shards[i].empty()) {
+        copy(shards[i].begin(), shards[i].end(), dst);
+        continue;
+      }
+      for (unsigned int j = 0; j < dataShards; j++) {
+        gf.MulAdd(matrix[i][j], shards[present[j]].data(), dst, shardSize);
+      }
+    }
+  }
+
+  data.resize(dataSize);
+  return true;
+}
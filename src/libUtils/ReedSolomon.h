@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#ifndef __REEDSOLOMON_H__
+#define __REEDSOLOMON_H__
+
+#include <cstddef>
+#include <vector>
+
+/// Systematic Reed-Solomon erasure code over GF(2^8).
+/// The data is split into dataShards equally sized shards followed by
+/// parityShards parity shards, and any dataShards of them rebuild the data.
+class ReedSolomon {
+ public:
+  /// Upper bound on dataShards + parityShards.
+  static const unsigned int MAX_SHARDS = 256;
+
+  /// Splits the data (zero-padded to a multiple of dataShards) into the
+  /// shards, followed by the parity shards.
+  static bool Encode(const std::vector<unsigned char>& data,
+                     unsigned int dataShards, unsigned int parityShards,
+                     std::vector<std::vector<unsigned char>>& shards);
+
+  /// Rebuilds dataSize bytes of data from the shards. Shards that were not
+  /// received are left empty, and at least dataShards must be present.
+  static bool Decode(const std::vector<std::vector<unsigned char>>& shards,
+                     unsigned int dataShards, size_t dataSize,
+                     std::vector<unsigned char>& data);
+};
+
+#endif  // __REEDSOLOMON_H__
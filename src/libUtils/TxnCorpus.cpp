@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstring>
+
+#include "TxnCorpus.h"
+#include "common/Constants.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+namespace {
+const char CORPUS_MAGIC[8] = {'Z', 'I', 'L', 'T', 'X', 'N', 'S', '1'};
+const uint64_t CORPUS_PAGE_SIZE = 4096;
+
+inline uint64_t AlignUp(uint64_t n, uint64_t alignment) {
+  return (n + alignment - 1) / alignment * alignment;
+}
+}  // namespace
+
+TxnCorpus::TxnCorpus()
+    : m_fd(-1),
+      m_writable(false),
+      m_map(nullptr),
+      m_mapSize(0),
+      m_stride(0),
+      m_dataOffset(0),
+      m_numTxns(0) {}
+
+TxnCorpus::~TxnCorpus() { Close(); }
+
+string TxnCorpus::GetDefaultPath() { return TXN_PATH + "/txns.corpus"; }
+
+bool TxnCorpus::Create(const string& path, uint32_t maxTxnSize,
+                       const vector<Range>& ranges) {
+  Close();
+
+  m_stride = AlignUp(sizeof(uint32_t) + maxTxnSize, 8);
+  m_dataOffset = AlignUp(sizeof(Header) + ranges.size() * sizeof(IndexEntry),
+                         CORPUS_PAGE_SIZE);
+
+  vector<IndexEntry> entries;
+  for (const auto& range : ranges) {
+    IndexEntry entry{};
+    copy(range.addr.begin(), range.addr.end(), entry.addr);
+    entry.firstNonce = range.firstNonce;
+    entry.numTxns = range.numTxns;
+    entry.firstSlot = m_numTxns;
+    if (!m_index.emplace(range.addr, entry).second) {
+      LOG_GENERAL(WARNING, "Duplicate corpus range for " << range.addr.hex());
+      Close();
+      return false;
+    }
+    entries.emplace_back(entry);
+    m_numTxns += range.numTxns;
+  }
+
+  m_fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (m_fd < 0) {
+    LOG_GENERAL(WARNING,
+                "Failed to create " << path << ": " << strerror(errno));
+    Close();
+    return false;
+  }
+
+  // Slots are left as holes until written, so they read back as empty
+  m_mapSize = m_dataOffset + m_numTxns * m_stride;
+  if (ftruncate(m_fd, m_mapSize) != 0) {
+    LOG_GENERAL(WARNING, "Failed to size " << path << ": " << strerror(errno));
+    Close();
+    return false;
+  }
+
+  void* map =
+      mmap(nullptr, m_mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+  if (map == MAP_FAILED) {
+    LOG_GENERAL(WARNING, "Failed to map " << path << ": " << strerror(errno));
+    m_mapSize = 0;
+    Close();
+    return false;
+  }
+  m_map = static_cast<unsigned char*>(map);
+  m_writable = true;
+
+  Header header{};
+  memcpy(header.magic, CORPUS_MAGIC, sizeof(CORPUS_MAGIC));
+  header.stride = m_stride;
+  header.numAccounts = entries.size();
+  header.dataOffset = m_dataOffset;
+  memcpy(m_map, &header, sizeof(Header));
+  if (!entries.empty()) {
+    memcpy(m_map + sizeof(Header), entries.data(),
+           entries.size() * sizeof(IndexEntry));
+  }
+
+  LOG_GENERAL(INFO, "Created txn corpus " << path << " with " << m_numTxns
+                                          << " slots of " << m_stride
+                                          << " bytes");
+  return true;
+}
+
+bool TxnCorpus::Open(const string& path) {
+  Close();
+
+  m_fd = open(path.c_str(), O_RDONLY);
+  if (m_fd < 0) {
+    LOG_GENERAL(WARNING, "Failed to open " << path << ": " << strerror(errno));
+    return false;
+  }
+
+  struct stat st;
+  if (fstat(m_fd, &st) != 0 || (size_t)st.st_size < sizeof(Header)) {
+    LOG_GENERAL(WARNING, "Txn corpus " << path << " is truncated");
+    Close();
+    return false;
+  }
+
+  void* map = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, m_fd, 0);
+  if (map == MAP_FAILED) {
+    LOG_GENERAL(WARNING, "Failed to map " << path << ": " << strerror(errno));
+    Close();
+    return false;
+  }
+  m_map = static_cast<unsigned char*>(map);
+  m_mapSize = st.st_size;
+
+  Header header;
+  memcpy(&header, m_map, sizeof(Header));
+  if (memcmp(header.magic, CORPUS_MAGIC, sizeof(CORPUS_MAGIC)) != 0 ||
+      header.stride <= sizeof(uint32_t) ||
+      header.dataOffset <
+          sizeof(Header) + (uint64_t)header.numAccounts * sizeof(IndexEntry) ||
+      header.dataOffset > m_mapSize) {
+    LOG_GENERAL(WARNING, path << " is not a valid txn corpus");
+    Close();
+    return false;
+  }
+  m_stride = header.stride;
+  m_dataOffset = header.dataOffset;
+
+  const uint64_t numSlots = (m_mapSize - m_dataOffset) / m_stride;
+  for (uint32_t i = 0; i < header.numAccounts; i++) {
+    IndexEntry entry;
+    memcpy(&entry, m_map + sizeof(Header) + i * sizeof(IndexEntry),
+           sizeof(IndexEntry));
+    if (entry.firstSlot > numSlots ||
+        entry.numTxns > numSlots - entry.firstSlot) {
+      LOG_GENERAL(WARNING, "Txn corpus index entry " << i << " out of range");
+      Close();
+      return false;
+    }
+    Address addr;
+    copy(entry.addr, entry.addr + ACC_ADDR_SIZE, addr.asArray().begin());
+    m_index[addr] = entry;
+    m_numTxns += entry.numTxns;
+  }
+
+  LOG_GENERAL(INFO, "Opened txn corpus " << path << " with " << m_numTxns
+                                         << " txns of " << m_index.size()
+                                         << " accounts");
+  return true;
+}
+
+void TxnCorpus::Close() {
+  if (m_map != nullptr) {
+    if (m_writable) {
+      msync(m_map, m_mapSize, MS_SYNC);
+    }
+    munmap(m_map, m_mapSize);
+    m_map = nullptr;
+  }
+  if (m_fd >= 0) {
+    close(m_fd);
+    m_fd = -1;
+  }
+  m_writable = false;
+  m_mapSize = 0;
+  m_stride = 0;
+  m_dataOffset = 0;
+  m_numTxns = 0;
+  m_index.clear();
+}
+
+unsigned char* TxnCorpus::GetSlot(const Address& addr, uint64_t nonce) const {
+  auto it = m_index.find(addr);
+  if (it == m_index.end() || nonce < it->second.firstNonce ||
+      nonce - it->second.firstNonce >= it->second.numTxns) {
+    return nullptr;
+  }
+  const uint64_t slot = it->second.firstSlot + nonce - it->second.firstNonce;
+  return m_map + m_dataOffset + slot * m_stride;
+}
+
+bool TxnCorpus::Put(const Address& addr, uint64_t nonce,
+                    const unsigned char* txn, uint32_t size) {
+  if (!m_writable) {
+    LOG_GENERAL(WARNING, "Txn corpus is not open for writing");
+    return false;
+  }
+
+  if (size == 0 || size > m_stride - sizeof(uint32_t)) {
+    LOG_GENERAL(WARNING, "Txn size " << size << " does not fit the stride "
+                                     << m_stride);
+    return false;
+  }
+
+  unsigned char* slot = GetSlot(addr, nonce);
+  if (slot == nullptr) {
+    LOG_GENERAL(WARNING, "No corpus slot for " << addr.hex() << " nonce "
+                                               << nonce);
+    return false;
+  }
+
+  memcpy(slot, &size, sizeof(uint32_t));
+  memcpy(slot + sizeof(uint32_t), txn, size);
+  return true;
+}
+
+bool TxnCorpus::Get(const Address& addr, uint64_t startNonce, uint64_t count,
+                    vector<Span>& txns) const {
+  if (count == 0) {
+    return true;
+  }
+
+  const unsigned char* first = GetSlot(addr, startNonce);
+  if (first == nullptr || GetSlot(addr, startNonce + count - 1) == nullptr) {
+    LOG_GENERAL(WARNING, "Txn corpus lacks nonces " << startNonce << " to "
+                                                    << startNonce + count - 1
+                                                    << " of " << addr.hex());
+    return false;
+  }
+
+  const size_t origSize = txns.size();
+  txns.reserve(origSize + count);
+  for (uint64_t i = 0; i < count; i++) {
+    const unsigned char* slot = first + i * m_stride;
+    uint32_t size;
+    memcpy(&size, slot, sizeof(uint32_t));
+    if (size == 0 || size > m_stride - sizeof(uint32_t)) {
+      LOG_GENERAL(WARNING, "Txn corpus slot for nonce "
+                               << startNonce + i << " of " << addr.hex()
+                               << " is empty or corrupt");
+      txns.resize(origSize);
+      return false;
+    }
+    txns.emplace_back(slot + sizeof(uint32_t), size);
+  }
+
+  return true;
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#ifndef __TXNCORPUS_H__
+#define __TXNCORPUS_H__
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "libData/AccountData/Address.h"
+
+/// Memory-mapped file of pregenerated, serialized transactions for load
+/// testing, replacing the per-address .zil files.
+/// The file starts with a header and a global index holding one entry per
+/// sender account, followed by fixed-stride slots. Each account owns a
+/// contiguous run of slots, one per nonce, so the slot of any (address, nonce)
+/// is found by arithmetic alone. A slot holds the size of the serialized
+/// transaction followed by its bytes, padded to the stride.
+class TxnCorpus {
+ public:
+  /// Nonce range of one sender account.
+  struct Range {
+    Address addr;
+    uint64_t firstNonce;
+    uint64_t numTxns;
+  };
+
+  /// Serialized transaction (ProtoTransaction) inside the mapping.
+  using Span = std::pair<const unsigned char*, uint32_t>;
+
+ private:
+  struct Header {
+    char magic[8];
+    uint32_t stride;
+    uint32_t numAccounts;
+    uint64_t dataOffset;
+  };
+
+  struct IndexEntry {
+    unsigned char addr[ACC_ADDR_SIZE];
+    uint32_t reserved;
+    uint64_t firstNonce;
+    uint64_t numTxns;
+    uint64_t firstSlot;
+  };
+
+  int m_fd;
+  bool m_writable;
+  unsigned char* m_map;
+  size_t m_mapSize;
+
+  uint32_t m_stride;
+  uint64_t m_dataOffset;
+  uint64_t m_numTxns;
+  std::unordered_map<Address, IndexEntry> m_index;
+
+  unsigned char* GetSlot(const Address& addr, uint64_t nonce) const;
+
+ public:
+  /// Constructor for a closed corpus.
+  TxnCorpus();
+
+  /// Destructor. Unmaps the file.
+  ~TxnCorpus();
+
+  TxnCorpus(const TxnCorpus&) = delete;
+  TxnCorpus& operator=(const TxnCorpus&) = delete;
+
+  /// Returns the corpus file location under TXN_PATH.
+  static std::string GetDefaultPath();
+
+  /// Creates (or overwrites) the file with empty slots for every nonce of the
+  /// ranges, each large enough for a serialized txn of up to maxTxnSize bytes,
+  /// and maps it for writing.
+  bool Create(const std::string& path, uint32_t maxTxnSize,
+              const std::vector<Range>& ranges);
+
+  /// Maps an existing corpus file for reading.
+  bool Open(const std::string& path);
+
+  /// Unmaps the file. Spans handed out earlier are no longer valid.
+  void Close();
+
+  bool IsOpen() const { return m_map != nullptr; }
+
+  uint32_t GetStride() const { return m_stride; }
+
+  uint64_t GetNumTxns() const { return m_numTxns; }
+
+  /// Stores the serialized txn in the slot of the sender and nonce.
+  /// Calls for different slots may run concurrently.
+  bool Put(const Address& addr, uint64_t nonce, const unsigned char* txn,
+           uint32_t size);
+
+  /// Appends the serialized txns of count consecutive nonces of the sender,
+  /// starting at startNonce. The spans point into the mapping and stay valid
+  /// until the corpus is closed. Nothing is appended unless the whole range
+  /// is present.
+  bool Get(const Address& addr, uint64_t startNonce, uint64_t count,
+           std::vector<Span>& txns) const;
+};
+
+#endif  // __TXNCORPUS_H__
@@ -219,11 +219,36 @@ bool Validator::CheckBlockCosignature(const DirectoryBlock& block,
   return true;
 }
 
+void Validator::ParallelFor(size_t count,
+                            const function<void(size_t)>& func) {
+  if (count < 2 || SYNC_VERIFY_THREADS < 2) {
+    for (size_t i = 0; i < count; i++) {
+      func(i);
+    }
+    return;
+  }
+
+  lock_guard<mutex> g(m_mutexVerifyPool);
+
+  const size_t numJobs = min(count, (size_t)SYNC_VERIFY_THREADS);
+  for (size_t job = 0; job < numJobs; job++) {
+    m_verifyPool.AddJob([job, numJobs, count, &func]() -> void {
+      for (size_t i = job; i < count; i += numJobs) {
+        func(i);
+      }
+    });
+  }
+  m_verifyPool.WaitAll();
+}
+
 bool Validator::CheckDirBlocks(
     const vector<boost::variant<DSBlock, VCBlock,
                                 FallbackBlockWShardingStructure>>& dirBlocks,
     const deque<pair<PubKey, Peer>>& initDsComm, const uint64_t& index_num,
     deque<pair<PubKey, Peer>>& newDSComm) {
+  // Number of blocks whose committees are held in memory at once
+  const size_t BATCH_SIZE = 64;
+
   deque<pair<PubKey, Peer>> mutable_ds_comm = initDsComm;
 
   bool ret = true;
@@ -234,125 +259,193 @@ bool Validator::CheckDirBlocks(
   ShardingHash prevShardingHash =
       m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetShardingHash();
 
-  for (const auto& dirBlock : dirBlocks) {
-    if (typeid(DSBlock) == dirBlock.type()) {
-      const auto& dsblock = get<DSBlock>(dirBlock);
-      if (dsblock.GetHeader().GetBlockNum() != prevdsblocknum + 1) {
-        LOG_GENERAL(WARNING, "DSblocks not in sequence "
-                                 << dsblock.GetHeader().GetBlockNum() << " "
-                                 << prevdsblocknum);
-        ret = false;
-        break;
-      }
-
-      if (!CheckBlockCosignature(dsblock, mutable_ds_comm)) {
-        LOG_GENERAL(WARNING, "Co-sig verification of ds block "
-                                 << prevdsblocknum + 1 << " failed");
-        ret = false;
-        break;
-      }
-      prevdsblocknum++;
-      prevShardingHash = dsblock.GetHeader().GetShardingHash();
-      m_mediator.m_blocklinkchain.AddBlockLink(
-          totalIndex, prevdsblocknum, BlockType::DS, dsblock.GetBlockHash());
-      m_mediator.m_dsBlockChain.AddBlock(dsblock);
-      // Store DS Block to disk
-      if (!ARCHIVAL_NODE) {
-        vector<unsigned char> serializedDSBlock;
-        dsblock.Serialize(serializedDSBlock, 0);
-        BlockStorage::GetBlockStorage().PutDSBlock(
-            dsblock.GetHeader().GetBlockNum(), serializedDSBlock);
+  // Each batch is processed in three steps:
+  // 1. Walk the blocks in order, checking their sequence and recording the DS
+  //    committee expected to have co-signed each of them
+  // 2. Verify the co-signatures in parallel
+  // 3. Commit the blocks in order up to the first failure
+  for (size_t batchStart = 0; ret && batchStart < dirBlocks.size();
+       batchStart += BATCH_SIZE) {
+    const size_t batchEnd = min(dirBlocks.size(), batchStart + BATCH_SIZE);
+
+    // DS committee in force at each block of the batch
+    vector<deque<pair<PubKey, Peer>>> committees;
+    deque<pair<PubKey, Peer>> nextDsComm = mutable_ds_comm;
+    uint64_t dsblocknum = prevdsblocknum;
+    ShardingHash shardingHash = prevShardingHash;
+
+    size_t checkedEnd = batchStart;
+    for (; checkedEnd < batchEnd; checkedEnd++) {
+      const auto& dirBlock = dirBlocks.at(checkedEnd);
+
+      if (typeid(DSBlock) == dirBlock.type()) {
+        const auto& dsblock = get<DSBlock>(dirBlock);
+        if (dsblock.GetHeader().GetBlockNum() != dsblocknum + 1) {
+          LOG_GENERAL(WARNING, "DSblocks not in sequence "
+                                   << dsblock.GetHeader().GetBlockNum() << " "
+                                   << dsblocknum);
+          ret = false;
+          break;
+        }
+        committees.emplace_back(nextDsComm);
+        dsblocknum++;
+        shardingHash = dsblock.GetHeader().GetShardingHash();
+        m_mediator.m_node->UpdateDSCommiteeComposition(nextDsComm, dsblock);
+      } else if (typeid(VCBlock) == dirBlock.type()) {
+        const auto& vcblock = get<VCBlock>(dirBlock);
+        if (vcblock.GetHeader().GetVieWChangeDSEpochNo() != dsblocknum + 1) {
+          LOG_GENERAL(
+              WARNING,
+              "VC block ds epoch number does not match the number being "
+              "processed "
+                  << dsblocknum << " "
+                  << vcblock.GetHeader().GetVieWChangeDSEpochNo());
+          ret = false;
+          break;
+        }
+        committees.emplace_back(nextDsComm);
+        m_mediator.m_node->UpdateRetrieveDSCommiteeCompositionAfterVC(
+            vcblock, nextDsComm);
+      } else if (typeid(FallbackBlockWShardingStructure) == dirBlock.type()) {
+        const auto& fallbackwshardingstructure =
+            get<FallbackBlockWShardingStructure>(dirBlock);
+        const auto& fallbackblock = fallbackwshardingstructure.m_fallbackblock;
+        const DequeOfShard& shards = fallbackwshardingstructure.m_shards;
+
+        if (fallbackblock.GetHeader().GetFallbackDSEpochNo() !=
+            dsblocknum + 1) {
+          LOG_GENERAL(
+              WARNING,
+              "Fallback block ds epoch number does not match the number "
+              "being processed "
+                  << dsblocknum << " "
+                  << fallbackblock.GetHeader().GetFallbackDSEpochNo());
+          ret = false;
+          break;
+        }
+
+        ShardingHash shardinghash;
+        if (!Messenger::GetShardingStructureHash(shards, shardinghash)) {
+          LOG_GENERAL(WARNING, "GetShardingStructureHash failed");
+          ret = false;
+          break;
+        }
+
+        if (shardinghash != shardingHash) {
+          LOG_GENERAL(WARNING, "ShardingHash does not match ");
+          ret = false;
+          break;
+        }
+
+        uint32_t shard_id = fallbackblock.GetHeader().GetShardId();
+        if (shard_id >= shards.size()) {
+          LOG_GENERAL(WARNING, "Fallback block shard id " << shard_id
+                                                          << " out of range");
+          ret = false;
+          break;
+        }
+
+        committees.emplace_back(nextDsComm);
+        m_mediator.m_node->UpdateDSCommitteeAfterFallback(
+            shard_id, fallbackblock.GetHeader().GetLeaderPubKey(),
+            fallbackblock.GetHeader().GetLeaderNetworkInfo(), nextDsComm,
+            shards);
       } else {
-        m_mediator.m_archDB->InsertDSBlock(dsblock);
-      }
-      m_mediator.m_node->UpdateDSCommiteeComposition(mutable_ds_comm, dsblock);
-      totalIndex++;
-
-    } else if (typeid(VCBlock) == dirBlock.type()) {
-      const auto& vcblock = get<VCBlock>(dirBlock);
-
-      if (vcblock.GetHeader().GetVieWChangeDSEpochNo() != prevdsblocknum + 1) {
-        LOG_GENERAL(WARNING,
-                    "VC block ds epoch number does not match the number being "
-                    "processed "
-                        << prevdsblocknum << " "
-                        << vcblock.GetHeader().GetVieWChangeDSEpochNo());
-        ret = false;
-        break;
-      }
-      if (!CheckBlockCosignature(vcblock, mutable_ds_comm)) {
-        LOG_GENERAL(WARNING, "Co-sig verification of vc block in "
-                                 << prevdsblocknum << " failed"
-                                 << totalIndex + 1);
-        ret = false;
-        break;
-      }
-
-      m_mediator.m_node->UpdateRetrieveDSCommiteeCompositionAfterVC(
-          vcblock, mutable_ds_comm);
-      m_mediator.m_blocklinkchain.AddBlockLink(totalIndex, prevdsblocknum + 1,
-                                               BlockType::VC,
-                                               vcblock.GetBlockHash());
-      vector<unsigned char> vcblockserialized;
-      vcblock.Serialize(vcblockserialized, 0);
-      BlockStorage::GetBlockStorage().PutVCBlock(vcblock.GetBlockHash(),
-                                                 vcblockserialized);
-      totalIndex++;
-    } else if (typeid(FallbackBlockWShardingStructure) == dirBlock.type()) {
-      const auto& fallbackwshardingstructure =
-          get<FallbackBlockWShardingStructure>(dirBlock);
-
-      const auto& fallbackblock = fallbackwshardingstructure.m_fallbackblock;
-      const DequeOfShard& shards = fallbackwshardingstructure.m_shards;
-
-      if (fallbackblock.GetHeader().GetFallbackDSEpochNo() !=
-          prevdsblocknum + 1) {
-        LOG_GENERAL(WARNING,
-                    "Fallback block ds epoch number does not match the number "
-                    "being processed "
-                        << prevdsblocknum << " "
-                        << fallbackblock.GetHeader().GetFallbackDSEpochNo());
-        ret = false;
-        break;
+        LOG_GENERAL(WARNING, "dirBlock type unexpected ");
+        committees.emplace_back(nextDsComm);
       }
+    }
 
-      ShardingHash shardinghash;
-      if (!Messenger::GetShardingStructureHash(shards, shardinghash)) {
-        LOG_GENERAL(WARNING, "GetShardingStructureHash failed");
-        ret = false;
-        break;
+    vector<unsigned char> verified(checkedEnd - batchStart, false);
+    ParallelFor(verified.size(), [&](size_t i) -> void {
+      const auto& dirBlock = dirBlocks.at(batchStart + i);
+      if (typeid(DSBlock) == dirBlock.type()) {
+        verified[i] =
+            CheckBlockCosignature(get<DSBlock>(dirBlock), committees.at(i));
+      } else if (typeid(VCBlock) == dirBlock.type()) {
+        verified[i] =
+            CheckBlockCosignature(get<VCBlock>(dirBlock), committees.at(i));
+      } else if (typeid(FallbackBlockWShardingStructure) == dirBlock.type()) {
+        const auto& fallbackwshardingstructure =
+            get<FallbackBlockWShardingStructure>(dirBlock);
+        const auto& fallbackblock = fallbackwshardingstructure.m_fallbackblock;
+        // Fallback blocks are co-signed by the shard, not the DS committee
+        verified[i] = CheckBlockCosignature(
+            fallbackblock, fallbackwshardingstructure.m_shards.at(
+                               fallbackblock.GetHeader().GetShardId()));
+      } else {
+        verified[i] = true;
       }
-
-      if (shardinghash != prevShardingHash) {
-        LOG_GENERAL(WARNING, "ShardingHash does not match ");
-        ret = false;
-        break;
+    });
+
+    for (size_t i = 0; i < verified.size(); i++) {
+      const auto& dirBlock = dirBlocks.at(batchStart + i);
+
+      if (typeid(DSBlock) == dirBlock.type()) {
+        const auto& dsblock = get<DSBlock>(dirBlock);
+        if (!verified[i]) {
+          LOG_GENERAL(WARNING, "Co-sig verification of ds block "
+                                   << prevdsblocknum + 1 << " failed");
+          ret = false;
+          break;
+        }
+        prevdsblocknum++;
+        prevShardingHash = dsblock.GetHeader().GetShardingHash();
+        m_mediator.m_blocklinkchain.AddBlockLink(
+            totalIndex, prevdsblocknum, BlockType::DS, dsblock.GetBlockHash());
+        m_mediator.m_dsBlockChain.AddBlock(dsblock);
+        // Store DS Block to disk
+        if (!ARCHIVAL_NODE) {
+          vector<unsigned char> serializedDSBlock;
+          dsblock.Serialize(serializedDSBlock, 0);
+          BlockStorage::GetBlockStorage().PutDSBlock(
+              dsblock.GetHeader().GetBlockNum(), serializedDSBlock);
+        } else {
+          m_mediator.m_archDB->InsertDSBlock(dsblock);
+        }
+        totalIndex++;
+      } else if (typeid(VCBlock) == dirBlock.type()) {
+        const auto& vcblock = get<VCBlock>(dirBlock);
+        if (!verified[i]) {
+          LOG_GENERAL(WARNING, "Co-sig verification of vc block in "
+                                   << prevdsblocknum << " failed"
+                                   << totalIndex + 1);
+          ret = false;
+          break;
+        }
+        m_mediator.m_blocklinkchain.AddBlockLink(totalIndex, prevdsblocknum + 1,
+                                                 BlockType::VC,
+                                                 vcblock.GetBlockHash());
+        vector<unsigned char> vcblockserialized;
+        vcblock.Serialize(vcblockserialized, 0);
+        BlockStorage::GetBlockStorage().PutVCBlock(vcblock.GetBlockHash(),
+                                                   vcblockserialized);
+        totalIndex++;
+      } else if (typeid(FallbackBlockWShardingStructure) == dirBlock.type()) {
+        const auto& fallbackwshardingstructure =
+            get<FallbackBlockWShardingStructure>(dirBlock);
+        const auto& fallbackblock = fallbackwshardingstructure.m_fallbackblock;
+        if (!verified[i]) {
+          LOG_GENERAL(WARNING, "Co-sig verification of fallbackblock in "
+                                   << prevdsblocknum << " failed"
+                                   << totalIndex + 1);
+          ret = false;
+          break;
+        }
+        m_mediator.m_blocklinkchain.AddBlockLink(totalIndex, prevdsblocknum + 1,
+                                                 BlockType::FB,
+                                                 fallbackblock.GetBlockHash());
+        vector<unsigned char> fallbackblockser;
+        fallbackwshardingstructure.Serialize(fallbackblockser, 0);
+        BlockStorage::GetBlockStorage().PutFallbackBlock(
+            fallbackblock.GetBlockHash(), fallbackblockser);
+        totalIndex++;
       }
 
-      uint32_t shard_id = fallbackblock.GetHeader().GetShardId();
-
-      if (!CheckBlockCosignature(fallbackblock, shards.at(shard_id))) {
-        LOG_GENERAL(WARNING, "Co-sig verification of fallbackblock in "
-                                 << prevdsblocknum << " failed"
-                                 << totalIndex + 1);
-        ret = false;
-        break;
-      }
-      const PubKey& leaderPubKey = fallbackblock.GetHeader().GetLeaderPubKey();
-      const Peer& leaderNetworkInfo =
-          fallbackblock.GetHeader().GetLeaderNetworkInfo();
-      m_mediator.m_node->UpdateDSCommitteeAfterFallback(
-          shard_id, leaderPubKey, leaderNetworkInfo, mutable_ds_comm, shards);
-      m_mediator.m_blocklinkchain.AddBlockLink(totalIndex, prevdsblocknum + 1,
-                                               BlockType::FB,
-                                               fallbackblock.GetBlockHash());
-      vector<unsigned char> fallbackblockser;
-      fallbackwshardingstructure.Serialize(fallbackblockser, 0);
-      BlockStorage::GetBlockStorage().PutFallbackBlock(
-          fallbackblock.GetBlockHash(), fallbackblockser);
-      totalIndex++;
-    } else {
-      LOG_GENERAL(WARNING, "dirBlock type unexpected ");
+      // The committee after this block is the one expected for the next
+      mutable_ds_comm = (i + 1 < committees.size())
+                            ? move(committees.at(i + 1))
+                            : move(nextDsComm);
     }
   }
 
@@ -398,11 +491,17 @@ ValidatorBase::TxBlockValidationMsg Validator::CheckTxBlocks(
     return TxBlockValidationMsg::VALID;
   }
 
+  // Hash the headers in parallel, then walk the chain back from the latest
+  vector<BlockHash> blockHashes(txBlocks.size() - 1);
+  ParallelFor(blockHashes.size(), [&](size_t i) -> void {
+    blockHashes[i] = txBlocks.at(i).GetHeader().GetMyHash();
+  });
+
   BlockHash prevBlockHash = latestTxBlock.GetHeader().GetPrevHash();
   unsigned int sIndex = txBlocks.size() - 2;
 
   for (unsigned int i = 0; i < txBlocks.size() - 1; i++) {
-    if (prevBlockHash != txBlocks.at(sIndex).GetHeader().GetMyHash()) {
+    if (prevBlockHash != blockHashes.at(sIndex)) {
       LOG_GENERAL(WARNING,
                   "Prev hash "
                       << prevBlockHash << " and hash of blocknum "
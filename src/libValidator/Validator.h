@@ -21,13 +21,18 @@
 #define __VALIDATOR_H__
 
 #include <boost/variant.hpp>
+#include <functional>
+#include <mutex>
 #include <string>
+#include "common/Constants.h"
 #include "libData/AccountData/Transaction.h"
 #include "libData/AccountData/TransactionReceipt.h"
 #include "libData/BlockChainData/BlockLinkChain.h"
 #include "libData/BlockData/Block.h"
 #include "libData/BlockData/Block/FallbackBlockWShardingStructure.h"
 #include "libNetwork/Peer.h"
+#include "libUtils/Logger.h"
+#include "libUtils/ThreadPool.h"
 
 class Mediator;
 
@@ -85,6 +90,14 @@ class Validator : public ValidatorBase {
       const std::deque<std::pair<PubKey, Peer>>& dsComm,
       const BlockLink& latestBlockLink) override;
   Mediator& m_mediator;
+
+ private:
+  std::mutex m_mutexVerifyPool;
+  ThreadPool m_verifyPool{SYNC_VERIFY_THREADS, "SyncVerifyPool"};
+
+  /// Calls func(i) for every i in [0, count) on the verification threads and
+  /// waits for all of them to finish.
+  void ParallelFor(size_t count, const std::function<void(size_t)>& func);
 };
 
 #endif  // __VALIDATOR_H__
\ No newline at end of file
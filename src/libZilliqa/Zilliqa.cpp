@@ -32,11 +32,27 @@
 #include "libUtils/DataConversion.h"
 #include "libUtils/DetachedFunction.h"
 #include "libUtils/Logger.h"
+#include "libUtils/Metrics.h"
 #include "libUtils/UpgradeManager.h"
 
 using namespace std;
 using namespace jsonrpc;
 
+namespace {
+MetricGauge& GetMsgQueueDepth() {
+  static MetricGauge& gauge = Metrics::GetInstance().GetGauge(
+      "zilliqa_msg_queue_depth", "Messages waiting in the input queue");
+  return gauge;
+}
+
+MetricGauge& GetMsgPoolDepth() {
+  static MetricGauge& gauge = Metrics::GetInstance().GetGauge(
+      "zilliqa_msg_pool_depth",
+      "Messages dispatched to the processing pool but not yet processed");
+  return gauge;
+}
+}  // namespace
+
 void Zilliqa::LogSelfNodeInfo(const std::pair<PrivKey, PubKey>& key,
                               const Peer& peer) {
   vector<unsigned char> tmp1;
@@ -104,7 +120,7 @@ Zilliqa::Zilliqa(const std::pair<PrivKey, PubKey>& key, const Peer& peer,
       //    , m_cu(key, peer)
       ,
       m_msgQueue(MSGQUEUE_SIZE),
-      m_httpserver(SERVER_PORT),
+      m_httpserver(SERVER_PORT, "", "", RPC_HTTP_THREADS),
       m_server(m_mediator, m_httpserver)
 
 {
@@ -115,16 +131,24 @@ Zilliqa::Zilliqa(const std::pair<PrivKey, PubKey>& key, const Peer& peer,
     pair<vector<unsigned char>, Peer>* message = NULL;
     while (true) {
       while (m_msgQueue.pop(message)) {
+        GetMsgQueueDepth().Decrement();
+        GetMsgPoolDepth().Increment();
         // For now, we use a thread pool to handle this message
         // Eventually processing will be single-threaded
-        m_queuePool.AddJob(
-            [this, message]() mutable -> void { ProcessMessage(message); });
+        m_queuePool.AddJob([this, message]() mutable -> void {
+          ProcessMessage(message);
+          GetMsgPoolDepth().Decrement();
+        });
       }
       std::this_thread::sleep_for(std::chrono::microseconds(1));
     }
   };
   DetachedFunction(1, funcCheckMsgQueue);
 
+  if (METRICS_PORT != 0 && !m_metricsServer.Start(METRICS_PORT)) {
+    LOG_GENERAL(WARNING, "Metrics server couldn't start");
+  }
+
   m_validator = make_shared<Validator>(m_mediator);
   if (ARCHIVAL_NODE) {
     m_db.Init();
@@ -145,6 +169,7 @@ Zilliqa::Zilliqa(const std::pair<PrivKey, PubKey>& key, const Peer& peer,
   }
 
   P2PComm::GetInstance().SetSelfPeer(peer);
+  P2PComm::GetInstance().SetSelfKey(key);
 
   if (GUARD_MODE) {
     // Setting the guard upon process launch
@@ -229,6 +254,9 @@ Zilliqa::Zilliqa(const std::pair<PrivKey, PubKey>& key, const Peer& peer,
       } else {
         LOG_GENERAL(WARNING, "API Server couldn't start");
       }
+      if (!Server::GetSubscriptionServer().Start(SUBSCRIPTION_PORT)) {
+        LOG_GENERAL(WARNING, "Subscription server couldn't start");
+      }
     }
   };
   DetachedFunction(1, func);
@@ -245,7 +273,11 @@ void Zilliqa::Dispatch(pair<vector<unsigned char>, Peer>* message) {
   // LOG_MARKER();
 
   // Queue message
+  // The message thread may take it as soon as it is pushed, so it is counted
+  // first
+  GetMsgQueueDepth().Increment();
   if (!m_msgQueue.bounded_push(message)) {
+    GetMsgQueueDepth().Decrement();
     LOG_GENERAL(WARNING, "Input MsgQueue is full");
   }
 }
@@ -275,3 +307,22 @@ vector<Peer> Zilliqa::RetrieveBroadcastList(unsigned char msg_type,
 
   return vector<Peer>();
 }
+
+vector<PubKey> Zilliqa::RetrieveBroadcastOriginators() {
+  // LOG_MARKER();
+
+  // To-do: Remove consensus user placeholder
+  Broadcastable* msg_handlers[] = {&m_pm, &m_ds, &m_n, NULL, &m_lookup};
+
+  // The signed tree layout does not depend on the message type, and chunks of
+  // a coded broadcast do not even carry it, so any handler may vouch
+  vector<PubKey> keys;
+  for (const auto& msg_handler : msg_handlers) {
+    if (msg_handler != NULL) {
+      const vector<PubKey> originators = msg_handler->GetBroadcastOriginators();
+      keys.insert(keys.end(), originators.begin(), originators.end());
+    }
+  }
+
+  return keys;
+}
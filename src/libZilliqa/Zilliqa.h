@@ -33,6 +33,7 @@
 #include "libNetwork/PeerManager.h"
 #include "libNetwork/PeerStore.h"
 #include "libNode/Node.h"
+#include "libServer/MetricsServer.h"
 #include "libServer/Server.h"
 #include "libUtils/ThreadPool.h"
 
@@ -53,6 +54,7 @@ class Zilliqa {
 
   jsonrpc::HttpServer m_httpserver;
   Server m_server;
+  MetricsServer m_metricsServer;
 
   ThreadPool m_queuePool{MAXMESSAGE, "QueuePool"};
 
@@ -77,6 +79,9 @@ class Zilliqa {
   std::vector<Peer> RetrieveBroadcastList(unsigned char msg_type,
                                           unsigned char ins_type,
                                           const Peer& from);
+
+  /// Returns the keys of the nodes whose tree broadcasts are relayed.
+  std::vector<PubKey> RetrieveBroadcastOriginators();
 };
 
 #endif  // __ZILLIQA_H__
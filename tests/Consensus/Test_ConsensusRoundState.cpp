@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include "libConsensus/ConsensusRoundState.h"
+#include "libCrypto/MultiSig.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE consensusroundstate
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace {
+atomic<size_t> g_numAllocations(0);
+
+double ElapsedMs(const chrono::high_resolution_clock::time_point& start,
+                 const chrono::high_resolution_clock::time_point& end) {
+  return chrono::duration<double, milli>(end - start).count();
+}
+}  // namespace
+
+// Count every C++ heap allocation made by this binary
+void* operator new(size_t size) {
+  g_numAllocations++;
+  void* p = malloc(size == 0 ? 1 : size);
+  if (p == nullptr) {
+    throw bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void* p) noexcept { free(p); }
+
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+BOOST_AUTO_TEST_SUITE(consensusroundstate)
+
+BOOST_AUTO_TEST_CASE(test_bitmap) {
+  INIT_STDOUT_LOGGER();
+
+  ConsensusArena arena(CommitteeBitmap::GetArenaSize(130));
+  CommitteeBitmap bitmap(arena, 130);
+
+  BOOST_CHECK_EQUAL(bitmap.size(), 130);
+  BOOST_CHECK_EQUAL(bitmap.count(), 0);
+
+  bitmap.set(0);
+  bitmap.set(64);
+  bitmap.set(129);
+  bitmap.set(129);
+
+  BOOST_CHECK_EQUAL(bitmap.count(), 3);
+  BOOST_CHECK(bitmap.test(64));
+  BOOST_CHECK(!bitmap.test(63));
+  BOOST_CHECK_THROW(bitmap.test(130), out_of_range);
+
+  vector<bool> expected(130, false);
+  expected.at(0) = expected.at(64) = expected.at(129) = true;
+  BOOST_CHECK(bitmap.ToVector() == expected);
+
+  bitmap.reset();
+  BOOST_CHECK_EQUAL(bitmap.count(), 0);
+  BOOST_CHECK(!bitmap.test(0));
+  BOOST_CHECK_EQUAL(arena.GetNumBlocks(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_entry_array) {
+  INIT_STDOUT_LOGGER();
+
+  const unsigned int committeeSize = 10;
+  ConsensusArena arena;
+  CommitPointArray points(arena, committeeSize);
+  CommitPointArray subset(arena, committeeSize);
+
+  vector<CommitSecret> secrets(3);
+  vector<CommitPoint> expected;
+  const unsigned int indices[] = {7, 2, 5};
+  for (unsigned int i = 0; i < 3; i++) {
+    expected.emplace_back(secrets.at(i));
+    BOOST_CHECK(points.Put(indices[i], expected.back()));
+  }
+
+  BOOST_CHECK_MESSAGE(!points.Put(7, expected.at(0)),
+                      "Duplicate entry accepted");
+  BOOST_CHECK_MESSAGE(!points.Put(1, CommitPoint()),
+                      "Uninitialized entry accepted");
+  BOOST_CHECK_EQUAL(points.count(), 3);
+  BOOST_CHECK(points.Get(2) == expected.at(1));
+  BOOST_CHECK(!points.Get(3).Initialized());
+
+  // Entries come back in order of insertion
+  vector<CommitPoint> all = points.GetAll();
+  BOOST_CHECK(all == expected);
+
+  BOOST_CHECK(subset.CopyFrom(points, 5));
+  BOOST_CHECK(!subset.CopyFrom(points, 4));
+  BOOST_CHECK(subset.Get(5) == expected.at(2));
+  BOOST_CHECK_EQUAL(subset.GetMap().count(), 1);
+}
+
+/// Allocation count and time for bookkeeping one round of a DS committee,
+/// comparing the compact representation with per-entry OpenSSL objects
+BOOST_AUTO_TEST_CASE(benchmark_round_state) {
+  INIT_STDOUT_LOGGER();
+
+  const unsigned int committeeSize = 600;
+  const unsigned int numSubsets = 4;
+  const unsigned int numCommits = committeeSize * 2 / 3 + 1;
+
+  vector<CommitSecret> secrets(numCommits);
+  vector<CommitPoint> commits;
+  for (const auto& secret : secrets) {
+    commits.emplace_back(secret);
+  }
+
+  // Legacy layout: vector<bool> maps and committee-sized vectors of objects
+  size_t before = g_numAllocations;
+  auto t_start = chrono::high_resolution_clock::now();
+  {
+    vector<bool> commitMap(committeeSize, false);
+    vector<CommitPoint> commitPointMap(committeeSize, CommitPoint());
+    vector<CommitPoint> commitPoints;
+    for (unsigned int i = 0; i < numCommits; i++) {
+      commitPoints.emplace_back(commits.at(i));
+      commitPointMap.at(i) = commits.at(i);
+      commitMap.at(i) = true;
+    }
+    for (unsigned int s = 0; s < numSubsets; s++) {
+      vector<bool> subsetCommitMap(committeeSize, false);
+      vector<CommitPoint> subsetCommitPointMap(committeeSize);
+      vector<CommitPoint> subsetCommitPoints;
+      vector<bool> responseMap(committeeSize, false);
+      vector<Response> responseDataMap(committeeSize);
+      for (unsigned int i = 0; i < numCommits; i++) {
+        subsetCommitPointMap.at(i) = commitPointMap.at(i);
+        subsetCommitPoints.emplace_back(commitPointMap.at(i));
+        subsetCommitMap.at(i) = true;
+      }
+    }
+  }
+  auto t_end = chrono::high_resolution_clock::now();
+  const size_t legacyAllocations = g_numAllocations - before;
+  LOG_GENERAL(INFO, "Legacy round state: " << legacyAllocations
+                                              << " allocations, "
+                                              << ElapsedMs(t_start, t_end)
+                                              << " ms");
+
+  // Compact layout: everything lives in one arena
+  before = g_numAllocations;
+  t_start = chrono::high_resolution_clock::now();
+  {
+    ConsensusArena arena(
+        CommitPointArray::GetArenaSize(committeeSize) +
+        numSubsets * (CommitPointArray::GetArenaSize(committeeSize) +
+                      ResponseArray::GetArenaSize(committeeSize)));
+    CommitPointArray commitPoints(arena, committeeSize);
+    for (unsigned int i = 0; i < numCommits; i++) {
+      commitPoints.Put(i, commits.at(i));
+    }
+    for (unsigned int s = 0; s < numSubsets; s++) {
+      CommitPointArray subsetCommitPoints(arena, committeeSize);
+      ResponseArray responses(arena, committeeSize);
+      for (unsigned int i = 0; i < numCommits; i++) {
+        subsetCommitPoints.CopyFrom(commitPoints, i);
+      }
+    }
+    BOOST_CHECK_EQUAL(arena.GetNumBlocks(), 1);
+  }
+  t_end = chrono::high_resolution_clock::now();
+  const size_t compactAllocations = g_numAllocations - before;
+  LOG_GENERAL(INFO, "Compact round state: " << compactAllocations
+                                              << " allocations, "
+                                              << ElapsedMs(t_start, t_end)
+                                              << " ms");
+
+  // Serializing an incoming commit into the arena still costs one temporary
+  BOOST_CHECK_MESSAGE(compactAllocations * 10 < legacyAllocations,
+                      "Compact round state should allocate far less");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
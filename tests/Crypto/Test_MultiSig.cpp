@@ -168,7 +168,7 @@ BOOST_AUTO_TEST_CASE(test_serialization) {
   }
 
   /// Check PrintPoint function
-  schnorr.PrintPoint(aggregatedPubkey->m_P.get());
+  schnorr.PrintPoint(aggregatedPubkey->GetPoint().get());
 
   /// Check CommitSecret operator =
   CommitSecret dummy_secret;
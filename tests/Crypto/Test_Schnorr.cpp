@@ -119,8 +119,8 @@ BOOST_AUTO_TEST_CASE(test_keys) {
                    keypair.first.m_d.get(), NULL, NULL, NULL) != 0,
       "Key generation check #3 failed");
   BOOST_CHECK_MESSAGE(
-      EC_POINT_cmp(schnorr.GetCurve().m_group.get(), keypair.second.m_P.get(),
-                   P.get(), NULL) == 0,
+      EC_POINT_cmp(schnorr.GetCurve().m_group.get(),
+                   keypair.second.GetPoint().get(), P.get(), NULL) == 0,
       "Key generation check #4 failed");
 }
 
@@ -318,6 +318,64 @@ BOOST_AUTO_TEST_CASE(test_error_deserialization_pubkey) {
                       "Expected: -1 Obtained: " << returnValue);
 }
 
+/**
+ * \brief test_pubkey_canonical_bytes
+ *
+ * \details Test ordering, hashing and lazy decoding of public keys
+ */
+BOOST_AUTO_TEST_CASE(test_pubkey_canonical_bytes) {
+  INIT_STDOUT_LOGGER();
+
+  Schnorr& schnorr = Schnorr::GetInstance();
+
+  vector<PubKey> pubkeys;
+  vector<vector<unsigned char>> encodings;
+  for (unsigned int i = 0; i < 16; i++) {
+    pubkeys.emplace_back(schnorr.GenKeyPair().second);
+    encodings.emplace_back();
+    pubkeys.back().Serialize(encodings.back(), 0);
+  }
+
+  // Ordering follows the serialized bytes
+  for (unsigned int i = 0; i < pubkeys.size(); i++) {
+    for (unsigned int j = 0; j < pubkeys.size(); j++) {
+      BOOST_CHECK_EQUAL(pubkeys.at(i) < pubkeys.at(j),
+                        encodings.at(i) < encodings.at(j));
+      BOOST_CHECK_EQUAL(pubkeys.at(i) > pubkeys.at(j),
+                        encodings.at(i) > encodings.at(j));
+      BOOST_CHECK_EQUAL(pubkeys.at(i) == pubkeys.at(j), i == j);
+    }
+  }
+
+  // Decoded copies compare and hash like the original, and decode to the
+  // same point
+  PubKey decoded(encodings.front(), 0);
+  BOOST_CHECK(decoded == pubkeys.front());
+  BOOST_CHECK_EQUAL(hash<PubKey>()(decoded), hash<PubKey>()(pubkeys.front()));
+  BOOST_CHECK(EC_POINT_cmp(schnorr.GetCurve().m_group.get(),
+                           decoded.GetPoint().get(),
+                           pubkeys.front().GetPoint().get(), NULL) == 0);
+
+  PubKey copied;
+  copied = decoded;
+  BOOST_CHECK(copied == pubkeys.front());
+  BOOST_CHECK(copied.GetPoint() == decoded.GetPoint());
+
+  // Anything other than the compressed form is rejected
+  vector<unsigned char> bad = encodings.front();
+  bad.at(0) = 0x04;
+  PubKey badkey;
+  BOOST_CHECK_EQUAL(badkey.Deserialize(bad, 0), -1);
+  BOOST_CHECK(!badkey.Initialized());
+
+  // An x-coordinate off the curve is only caught when the point is needed
+  bad.at(0) = 0x02;
+  fill(bad.begin() + 1, bad.end(), 0x00);
+  bad.back() = 0x05;
+  BOOST_CHECK_EQUAL(badkey.Deserialize(bad, 0), 0);
+  BOOST_CHECK(badkey.GetPoint() == nullptr);
+}
+
 /**
  * \brief test_error_deserialization_privkey
  *
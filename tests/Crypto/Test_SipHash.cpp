@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#include <array>
+#include <set>
+#include <vector>
+
+#include "libCrypto/SipHash.h"
+#include "libData/AccountData/ShortTxnId.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE siphashtest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(siphashtest)
+
+/// Test vectors from the reference implementation (key = 00 01 .. 0f,
+/// message = 00 01 .. (n-1) for n = 0, 7, 8, 15)
+BOOST_AUTO_TEST_CASE(test_siphash24_vectors) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  array<unsigned char, SipHash::KEY_SIZE> key;
+  vector<unsigned char> message(15);
+  for (unsigned int i = 0; i < key.size(); i++) {
+    key[i] = i;
+  }
+  for (unsigned int i = 0; i < message.size(); i++) {
+    message[i] = i;
+  }
+
+  const SipHash sipHash(key);
+  BOOST_CHECK_EQUAL(sipHash.Hash(message.data(), 0), 0x726fdb47dd0e0e31ULL);
+  BOOST_CHECK_EQUAL(sipHash.Hash(message.data(), 7), 0xab0200f58b01d137ULL);
+  BOOST_CHECK_EQUAL(sipHash.Hash(message.data(), 8), 0x93f5f5799a932462ULL);
+  BOOST_CHECK_EQUAL(sipHash.Hash(message.data(), 15), 0xa129ca6149be45e5ULL);
+}
+
+BOOST_AUTO_TEST_CASE(test_short_txn_ids) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  BlockHash salt1, salt2;
+  salt1.asArray().fill(0x01);
+  salt2.asArray().fill(0x02);
+  const ShortTxnIdGenerator shortTxnId1(salt1);
+  const ShortTxnIdGenerator shortTxnId2(salt2);
+
+  set<uint64_t> ids;
+  for (unsigned int i = 0; i < 1000; i++) {
+    TxnHash tranHash;
+    tranHash.asArray()[0] = i & 0xFF;
+    tranHash.asArray()[1] = i >> 8;
+
+    uint64_t id = shortTxnId1(tranHash);
+    BOOST_CHECK_MESSAGE(id < (1ULL << (8 * SHORT_TXN_ID_SIZE)),
+                        "Short txn id wider than SHORT_TXN_ID_SIZE");
+    BOOST_CHECK_EQUAL(id, shortTxnId1(tranHash));
+    BOOST_CHECK_NE(id, shortTxnId2(tranHash));
+    ids.insert(id);
+  }
+
+  BOOST_CHECK_EQUAL(ids.size(), 1000U);
+}
+
+BOOST_AUTO_TEST_CASE(test_compact_txn_hash_collisions) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  // Force collisions by using the first byte of the hash as the short ID
+  auto shortTxnId = [](const TxnHash& tranHash) -> uint64_t {
+    return tranHash.asArray()[0];
+  };
+  auto makeHash = [](unsigned char id, unsigned char tag) {
+    TxnHash tranHash;
+    tranHash.asArray()[0] = id;
+    tranHash.asArray()[1] = tag;
+    return tranHash;
+  };
+
+  // The block proposes A, C, B and D. A and B share a short ID within the
+  // block, C shares one with the local txn X, and only D is unambiguous
+  const TxnHash a = makeHash(1, 'A'), b = makeHash(1, 'B'),
+                c = makeHash(2, 'C'), d = makeHash(3, 'D'),
+                x = makeHash(2, 'X');
+  const vector<uint64_t> shortTxnIds = {1, 2, 1, 3};
+  const vector<TxnHash> localHashes = {a, c, d, x};
+
+  CompactTxnHashResolver resolver(shortTxnId, shortTxnIds);
+  resolver.ResolveLocal(localHashes);
+  BOOST_CHECK(resolver.GetMissingIndexes() == vector<uint32_t>({0, 1, 2}));
+  BOOST_CHECK(resolver.GetTranHashes().at(3) == d);
+
+  // The leader leaves out A, so one index with its short ID stays missing and
+  // the block is still rejected
+  resolver.ResolveFetched({c, b});
+  BOOST_CHECK(resolver.GetMissingIndexes() == vector<uint32_t>({2}));
+  BOOST_CHECK(resolver.GetTranHashes().at(1) == c);
+
+  // The fetched txns fill the requested indexes in order, even though the
+  // local pool would still find their short IDs ambiguous
+  CompactTxnHashResolver refetched(shortTxnId, shortTxnIds);
+  refetched.ResolveLocal(localHashes);
+  refetched.ResolveFetched({a, c, makeHash(4, 'E'), b});
+  BOOST_CHECK(refetched.GetMissingIndexes().empty());
+  BOOST_CHECK(refetched.GetTranHashes() == vector<TxnHash>({a, c, b, d}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -19,6 +19,7 @@
 
 #include <array>
 #include <string>
+#include <vector>
 
 #define BOOST_TEST_MODULE accountstoretest
 #define BOOST_TEST_DYN_LINK
@@ -31,6 +32,8 @@
 #include "libUtils/DataConversion.h"
 #include "libUtils/Logger.h"
 
+using namespace std;
+
 BOOST_AUTO_TEST_SUITE(accountstoretest)
 
 BOOST_AUTO_TEST_CASE(commitAndRollback) {
@@ -405,4 +408,62 @@ BOOST_AUTO_TEST_CASE(commitAndRollback) {
   //     root!");
 }
 
+BOOST_AUTO_TEST_CASE(mergeShardDeltas) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  AccountStore::GetInstance().Init();
+
+  // Produce one state delta per shard, each creating a different account
+  vector<vector<unsigned char>> shardDeltas(2);
+  for (auto& shardDelta : shardDeltas) {
+    AccountStore::GetInstance().InitTemp();
+    Address address = Account::GetAddressFromPublicKey(
+        Schnorr::GetInstance().GenKeyPair().second);
+    AccountStore::GetInstance().AddAccountTemp(address, Account(10, 1));
+    BOOST_REQUIRE(AccountStore::GetInstance().SerializeDelta());
+    AccountStore::GetInstance().GetSerializedDelta(shardDelta);
+  }
+
+  // Expected result: the shard deltas applied one after the other
+  AccountStore::GetInstance().InitTemp();
+  for (const auto& shardDelta : shardDeltas) {
+    BOOST_REQUIRE(
+        AccountStore::GetInstance().DeserializeDeltaTemp(shardDelta, 0));
+  }
+  BOOST_REQUIRE(AccountStore::GetInstance().SerializeDelta());
+  vector<unsigned char> expected;
+  AccountStore::GetInstance().GetSerializedDelta(expected);
+
+  AccountStore::GetInstance().InitTemp();
+  AccountStore::GetInstance().ClearShardDeltas();
+  for (const auto& shardDelta : shardDeltas) {
+    BOOST_REQUIRE(
+        AccountStore::GetInstance().MergeShardDeltaTemp(shardDelta, 0));
+  }
+  BOOST_REQUIRE(AccountStore::GetInstance().SerializeDelta());
+  vector<unsigned char> merged;
+  AccountStore::GetInstance().GetSerializedDelta(merged);
+  BOOST_CHECK(merged == expected);
+
+  // Changes made on top of the shard deltas (i.e., by the DS microblock) are
+  // dropped by the revert
+  Address dsAddress = Account::GetAddressFromPublicKey(
+      Schnorr::GetInstance().GenKeyPair().second);
+  AccountStore::GetInstance().AddAccountTemp(dsAddress, Account(5, 0));
+  AccountStore::GetInstance().RevertTempToShardDeltas();
+  BOOST_REQUIRE(AccountStore::GetInstance().SerializeDelta());
+  vector<unsigned char> reverted;
+  AccountStore::GetInstance().GetSerializedDelta(reverted);
+  BOOST_CHECK(reverted == expected);
+
+  AccountStore::GetInstance().ClearShardDeltas();
+  AccountStore::GetInstance().RevertTempToShardDeltas();
+  BOOST_REQUIRE(AccountStore::GetInstance().SerializeDelta());
+  vector<unsigned char> cleared;
+  AccountStore::GetInstance().GetSerializedDelta(cleared);
+  BOOST_CHECK(cleared != expected);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -18,8 +18,9 @@
  */
 
 #include "libData/AccountData/Account.h"
-#include "libUtils/GetTxnFromFile.h"
+#include "libMessage/Messenger.h"
 #include "libUtils/Logger.h"
+#include "libUtils/TxnCorpus.h"
 
 #define BOOST_TEST_MODULE DispacthTxnTest
 #define BOOST_TEST_DYN_LINK
@@ -34,7 +35,8 @@ BOOST_AUTO_TEST_CASE(test1) {
 
   LOG_MARKER();
 
-  vector<unsigned char> vec;
+  TxnCorpus corpus;
+  BOOST_REQUIRE(corpus.Open(TxnCorpus::GetDefaultPath()));
 
   for (auto& i : GENESIS_KEYS) {
     auto privKeyBytes{DataConversion::HexStrToUint8Vec(i)};
@@ -42,13 +44,16 @@ BOOST_AUTO_TEST_CASE(test1) {
     auto pubKey = PubKey{privKey};
     auto addr = Account::GetAddressFromPublicKey(pubKey);
 
-    std::vector<Transaction> txns;
-    bool b = GetTxnFromFile::GetFromFile(addr, 1, 9, txns);
+    std::vector<TxnCorpus::Span> txns;
+    bool b = corpus.Get(addr, 1, 9, txns);
 
     LOG_GENERAL(INFO, "Size: " << txns.size());
     BOOST_CHECK_MESSAGE(b, "Failed");
 
-    for (const auto& tx : txns) {
+    for (const auto& span : txns) {
+      Transaction tx;
+      vector<unsigned char> buf(span.first, span.first + span.second);
+      BOOST_CHECK(Messenger::GetTransaction(buf, 0, tx));
       LOG_GENERAL(INFO, "Nonce of " << i << " " << tx.GetNonce());
     }
   }
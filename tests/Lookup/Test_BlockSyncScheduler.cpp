@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#include <chrono>
+#include <vector>
+
+#include "libCrypto/Schnorr.h"
+#include "libData/BlockData/Block.h"
+#include "libLookup/BlockSyncScheduler.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE blocksyncschedulertest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(blocksyncschedulertest)
+
+vector<TxBlock> MakeTxBlocks(uint64_t lowBlockNum, uint64_t highBlockNum) {
+  static const PubKey minerPubKey = Schnorr::GetInstance().GenKeyPair().second;
+
+  vector<TxBlock> txBlocks;
+  for (uint64_t blockNum = lowBlockNum; blockNum <= highBlockNum; blockNum++) {
+    txBlocks.emplace_back(
+        TxBlockHeader(TXBLOCKTYPE::FINAL, BLOCKVERSION::VERSION1, 1, 1, 1,
+                      BlockHash(), blockNum, TxBlockHashSet(), 0, minerPubKey,
+                      0, CommitteeHash()),
+        vector<MicroBlockInfo>(), CoSignatures());
+  }
+  return txBlocks;
+}
+
+vector<PubKey> MakeLookups(unsigned int count) {
+  vector<PubKey> lookups;
+  for (unsigned int i = 0; i < count; i++) {
+    lookups.emplace_back(Schnorr::GetInstance().GenKeyPair().second);
+  }
+  return lookups;
+}
+
+BOOST_AUTO_TEST_CASE(test_windows_spread_over_lookups) {
+  INIT_STDOUT_LOGGER();
+
+  const vector<PubKey> lookups = MakeLookups(3);
+  BlockSyncScheduler scheduler(10, 3, chrono::seconds(5));
+
+  scheduler.Start(101, 135, lookups);
+  BOOST_CHECK(scheduler.IsActive());
+  BOOST_CHECK_EQUAL(scheduler.GetNumWindows(), 5);  // 4 windows + open tail
+
+  auto requests = scheduler.Schedule();
+  BOOST_REQUIRE_EQUAL(requests.size(), 3);
+  BOOST_CHECK_EQUAL(requests.at(0).lowBlockNum, 101);
+  BOOST_CHECK_EQUAL(requests.at(0).highBlockNum, 110);
+  BOOST_CHECK_EQUAL(requests.at(2).lowBlockNum, 121);
+  BOOST_CHECK_EQUAL(requests.at(2).highBlockNum, 130);
+  BOOST_CHECK(!(requests.at(0).lookup == requests.at(1).lookup));
+  BOOST_CHECK(!(requests.at(1).lookup == requests.at(2).lookup));
+  BOOST_CHECK(!(requests.at(0).lookup == requests.at(2).lookup));
+
+  // Nothing more until a window comes back
+  BOOST_CHECK(scheduler.Schedule().empty());
+
+  BOOST_CHECK(scheduler.OnResponse(requests.at(1).lookup, 111, 120,
+                                   MakeTxBlocks(111, 120)));
+  BOOST_CHECK(scheduler.TakeBlocks().empty());  // waits for 101 to 110
+  auto more = scheduler.Schedule();
+  BOOST_REQUIRE_EQUAL(more.size(), 1);
+  BOOST_CHECK_EQUAL(more.at(0).lowBlockNum, 131);
+  BOOST_CHECK_EQUAL(more.at(0).highBlockNum, 135);
+
+  BOOST_CHECK(scheduler.OnResponse(requests.at(0).lookup, 101, 110,
+                                   MakeTxBlocks(101, 110)));
+
+  // The contiguous prefix is handed out without waiting for the rest
+  vector<TxBlock> prefix = scheduler.TakeBlocks();
+  BOOST_REQUIRE_EQUAL(prefix.size(), 20);
+  for (unsigned int i = 0; i < prefix.size(); i++) {
+    BOOST_CHECK_EQUAL(prefix.at(i).GetHeader().GetBlockNum(), 101 + i);
+  }
+  BOOST_CHECK_EQUAL(scheduler.GetLowBlockNum(), 121);
+  BOOST_CHECK(scheduler.TakeBlocks().empty());
+  scheduler.ScoreTakenBlocks(true);
+  BOOST_CHECK_GT(scheduler.GetScore(requests.at(0).lookup), 0);
+  BOOST_CHECK_GT(scheduler.GetScore(requests.at(1).lookup), 0);
+  BOOST_CHECK_EQUAL(scheduler.GetScore(requests.at(2).lookup), 0);
+
+  BOOST_CHECK(scheduler.OnResponse(requests.at(2).lookup, 121, 130,
+                                   MakeTxBlocks(121, 130)));
+  BOOST_CHECK(scheduler.OnResponse(more.at(0).lookup, 131, 135,
+                                   MakeTxBlocks(131, 135)));
+  BOOST_CHECK(!scheduler.IsComplete());
+
+  auto tail = scheduler.Schedule();
+  BOOST_REQUIRE_EQUAL(tail.size(), 1);
+  BOOST_CHECK_EQUAL(tail.at(0).lowBlockNum, 136);
+  BOOST_CHECK_EQUAL(tail.at(0).highBlockNum, 0);
+
+  // The open-ended window takes whatever the lookup has
+  BOOST_CHECK(scheduler.OnResponse(tail.at(0).lookup, 136, 142,
+                                   MakeTxBlocks(136, 142)));
+  BOOST_CHECK(scheduler.IsComplete());
+
+  vector<TxBlock> txBlocks = scheduler.TakeBlocks();
+  BOOST_REQUIRE_EQUAL(txBlocks.size(), 22);
+  for (unsigned int i = 0; i < txBlocks.size(); i++) {
+    BOOST_CHECK_EQUAL(txBlocks.at(i).GetHeader().GetBlockNum(), 121 + i);
+  }
+  BOOST_CHECK_EQUAL(scheduler.GetLowBlockNum(), 143);
+
+  scheduler.Finish(true);
+  BOOST_CHECK(!scheduler.IsActive());
+  for (const auto& lookup : lookups) {
+    BOOST_CHECK_GT(scheduler.GetScore(lookup), 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_timed_out_window_goes_elsewhere) {
+  INIT_STDOUT_LOGGER();
+
+  const vector<PubKey> lookups = MakeLookups(2);
+  BlockSyncScheduler scheduler(10, 1, chrono::seconds(5));
+
+  auto now = BlockSyncScheduler::Clock::now();
+  scheduler.Start(11, 20, lookups);
+
+  auto requests = scheduler.Schedule(now);
+  BOOST_REQUIRE_EQUAL(requests.size(), 1);
+  const PubKey slowLookup = requests.at(0).lookup;
+
+  BOOST_CHECK(scheduler.Schedule(now + chrono::seconds(4)).empty());
+
+  auto retries = scheduler.Schedule(now + chrono::seconds(6));
+  BOOST_REQUIRE_EQUAL(retries.size(), 1);
+  BOOST_CHECK_EQUAL(retries.at(0).lowBlockNum, 11);
+  BOOST_CHECK(!(retries.at(0).lookup == slowLookup));
+  BOOST_CHECK_LT(scheduler.GetScore(slowLookup), 0);
+  BOOST_CHECK_EQUAL(scheduler.GetScore(retries.at(0).lookup), 0);
+
+  // A late answer from the slow lookup still counts
+  BOOST_CHECK(scheduler.OnResponse(slowLookup, 11, 20, MakeTxBlocks(11, 20)));
+  BOOST_CHECK(!scheduler.OnResponse(retries.at(0).lookup, 11, 20,
+                                    MakeTxBlocks(11, 20)));
+}
+
+BOOST_AUTO_TEST_CASE(test_malformed_window_is_rejected) {
+  INIT_STDOUT_LOGGER();
+
+  const vector<PubKey> lookups = MakeLookups(2);
+  BlockSyncScheduler scheduler(10, 2, chrono::seconds(5));
+
+  scheduler.Start(11, 20, lookups);
+  auto requests = scheduler.Schedule();
+  BOOST_REQUIRE_EQUAL(requests.size(), 2);
+  const PubKey badLookup = requests.at(0).lookup;
+
+  // Short range, wrong block numbers, unknown window
+  BOOST_CHECK(!scheduler.OnResponse(badLookup, 11, 18, MakeTxBlocks(11, 18)));
+  BOOST_CHECK(!scheduler.OnResponse(badLookup, 11, 20, MakeTxBlocks(12, 21)));
+  BOOST_CHECK(!scheduler.OnResponse(badLookup, 15, 24, MakeTxBlocks(15, 24)));
+  BOOST_CHECK_LT(scheduler.GetScore(badLookup), 0);
+
+  auto retries = scheduler.Schedule();
+  BOOST_REQUIRE_EQUAL(retries.size(), 1);
+  BOOST_CHECK_EQUAL(retries.at(0).lowBlockNum, 11);
+  BOOST_CHECK(!(retries.at(0).lookup == badLookup));
+
+  // An empty tail is fine: the lookup has nothing past the known range
+  BOOST_CHECK(
+      scheduler.OnResponse(requests.at(1).lookup, 21, 20, vector<TxBlock>()));
+  BOOST_CHECK(scheduler.OnResponse(retries.at(0).lookup, 11, 20,
+                                   MakeTxBlocks(11, 20)));
+  BOOST_CHECK(scheduler.IsComplete());
+  BOOST_CHECK_EQUAL(scheduler.TakeBlocks().size(), 10);
+
+  scheduler.Finish(false);
+  BOOST_CHECK_LT(scheduler.GetScore(retries.at(0).lookup), 0);
+
+  scheduler.Stop();
+  BOOST_CHECK(scheduler.Schedule().empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
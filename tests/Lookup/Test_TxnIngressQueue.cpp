@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#include <thread>
+#include <vector>
+
+#include "libCrypto/Schnorr.h"
+#include "libLookup/TxnIngressQueue.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE txningressqueuetest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(txningressqueuetest)
+
+Transaction MakeTxn(const PubKey& sender, uint32_t id, size_t dataSize = 0) {
+  TxnHash tranID;
+  for (unsigned int i = 0; i < sizeof(id); i++) {
+    tranID.asArray().at(i) = (id >> (8 * i)) & 0xFF;
+  }
+  return Transaction(tranID, 0, id, Address(), sender, 0, 1, 1, {},
+                     vector<unsigned char>(dataSize), Signature());
+}
+
+BOOST_AUTO_TEST_CASE(test_dedup_across_rounds) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  TxnIngressQueue queue(100, 100, 1024 * 1024);
+  const PubKey sender = Schnorr::GetInstance().GenKeyPair().second;
+
+  BOOST_CHECK_EQUAL(queue.Add(MakeTxn(sender, 1), 0), TxnIngressQueue::ADDED);
+  BOOST_CHECK_EQUAL(queue.Add(MakeTxn(sender, 2), 0), TxnIngressQueue::ADDED);
+  BOOST_CHECK_EQUAL(queue.Add(MakeTxn(sender, 1), 0),
+                    TxnIngressQueue::DUPLICATE);
+  // Dedup does not depend on the target shard
+  BOOST_CHECK_EQUAL(queue.Add(MakeTxn(sender, 2), 1),
+                    TxnIngressQueue::DUPLICATE);
+  BOOST_CHECK_EQUAL(queue.GetSize(0), 2);
+  BOOST_CHECK_EQUAL(queue.GetSize(1), 0);
+
+  vector<Transaction> txns;
+  queue.Drain(0, txns);
+  BOOST_REQUIRE_EQUAL(txns.size(), 2);
+  BOOST_CHECK_EQUAL(txns[0].GetTranID(), MakeTxn(sender, 1).GetTranID());
+  BOOST_CHECK_EQUAL(txns[1].GetTranID(), MakeTxn(sender, 2).GetTranID());
+  BOOST_CHECK_EQUAL(queue.GetSize(0), 0);
+
+  // Hashes are remembered for the next round and dropped after that
+  queue.NextRound();
+  BOOST_CHECK_EQUAL(queue.Add(MakeTxn(sender, 1), 0),
+                    TxnIngressQueue::DUPLICATE);
+  queue.NextRound();
+  BOOST_CHECK_EQUAL(queue.Add(MakeTxn(sender, 1), 0), TxnIngressQueue::ADDED);
+}
+
+BOOST_AUTO_TEST_CASE(test_limits) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  TxnIngressQueue queue(5, 3, 1000);
+  const PubKey sender1 = Schnorr::GetInstance().GenKeyPair().second;
+  const PubKey sender2 = Schnorr::GetInstance().GenKeyPair().second;
+  const PubKey sender3 = Schnorr::GetInstance().GenKeyPair().second;
+
+  // Count limit per sender
+  for (uint32_t i = 0; i < 3; i++) {
+    BOOST_CHECK_EQUAL(queue.Add(MakeTxn(sender1, i), 0),
+                      TxnIngressQueue::ADDED);
+  }
+  BOOST_CHECK_EQUAL(queue.Add(MakeTxn(sender1, 3), 0),
+                    TxnIngressQueue::SENDER_LIMIT);
+
+  // Byte limit per sender
+  BOOST_CHECK_EQUAL(queue.Add(MakeTxn(sender2, 10, 600), 0),
+                    TxnIngressQueue::ADDED);
+  BOOST_CHECK_EQUAL(queue.Add(MakeTxn(sender2, 11, 600), 0),
+                    TxnIngressQueue::SENDER_LIMIT);
+
+  // Queue size limit
+  BOOST_CHECK_EQUAL(queue.Add(MakeTxn(sender3, 20), 0), TxnIngressQueue::ADDED);
+  BOOST_CHECK_EQUAL(queue.Add(MakeTxn(sender3, 21), 0),
+                    TxnIngressQueue::QUEUE_FULL);
+  BOOST_CHECK_EQUAL(queue.Add(MakeTxn(sender3, 21), 1), TxnIngressQueue::ADDED);
+
+  // A rejected txn can be submitted again once there is room
+  queue.NextRound();
+  vector<Transaction> txns;
+  queue.Drain(0, txns);
+  BOOST_CHECK_EQUAL(txns.size(), 5);
+  BOOST_CHECK_EQUAL(queue.Add(MakeTxn(sender1, 3), 0), TxnIngressQueue::ADDED);
+
+  // Restored txns go back into the queue, ahead of the ones added since
+  const vector<Transaction> restored = txns;
+  queue.Restore(0, move(txns));
+  BOOST_CHECK_EQUAL(queue.GetSize(0), 6);
+
+  txns.clear();
+  queue.Drain(0, txns);
+  BOOST_REQUIRE_EQUAL(txns.size(), 6);
+  for (unsigned int i = 0; i < restored.size(); i++) {
+    BOOST_CHECK_EQUAL(txns[i].GetTranID(), restored[i].GetTranID());
+  }
+  BOOST_CHECK_EQUAL(txns[5].GetTranID(), MakeTxn(sender1, 3).GetTranID());
+  BOOST_CHECK_EQUAL(queue.GetSize(0), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_concurrent_add_and_drain) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  const unsigned int numThreads = 4;
+  const uint32_t numTxnsPerThread = 2000;
+
+  TxnIngressQueue queue(numThreads * numTxnsPerThread, numTxnsPerThread,
+                        1024 * 1024);
+
+  vector<PubKey> senders;
+  for (unsigned int i = 0; i < numThreads; i++) {
+    senders.emplace_back(Schnorr::GetInstance().GenKeyPair().second);
+  }
+
+  vector<thread> producers;
+  for (unsigned int t = 0; t < numThreads; t++) {
+    producers.emplace_back([&queue, &senders, t, numTxnsPerThread]() {
+      for (uint32_t i = 0; i < numTxnsPerThread; i++) {
+        // Every txn is submitted twice; only the first one is queued
+        const Transaction tx = MakeTxn(senders[t], t * numTxnsPerThread + i);
+        queue.Add(tx, t % 2);
+        queue.Add(tx, t % 2);
+      }
+    });
+  }
+
+  size_t numDrained = 0;
+  vector<Transaction> txns;
+  while (numDrained < numThreads * numTxnsPerThread) {
+    txns.clear();
+    queue.Drain(0, txns);
+    numDrained += txns.size();
+    txns.clear();
+    queue.Drain(1, txns);
+    numDrained += txns.size();
+  }
+
+  for (auto& producer : producers) {
+    producer.join();
+  }
+
+  BOOST_CHECK_EQUAL(numDrained, numThreads * numTxnsPerThread);
+  BOOST_CHECK_EQUAL(queue.GetSize(0), 0);
+  BOOST_CHECK_EQUAL(queue.GetSize(1), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+// Measures encode and decode throughput of the Messenger for the payloads that
+// dominate an epoch: microblocks, transaction packets and state deltas.
+// Usage: Bench_Serialization [iterations] [transactions] [accounts]
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "libMessage/Messenger.h"
+#include "libMessage/MessengerAccountStoreBase.h"
+#include "libTestUtils/BenchPayloads.h"
+#include "libTestUtils/TestUtils.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+namespace {
+void Run(const string& name, size_t iterations,
+         const function<bool(vector<unsigned char>&)>& encode,
+         const function<bool(const vector<unsigned char>&)>& decode) {
+  vector<unsigned char> buffer;
+  if (!encode(buffer) || !decode(buffer)) {
+    cout << name << ": failed" << endl;
+    return;
+  }
+
+  auto measure = [iterations](const function<bool()>& op) -> double {
+    auto startTime = chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+      op();
+    }
+    return chrono::duration_cast<chrono::duration<double, micro>>(
+               chrono::steady_clock::now() - startTime)
+               .count() /
+           iterations;
+  };
+
+  double encodeUs = measure([&]() -> bool { return encode(buffer); });
+  double decodeUs = measure([&]() -> bool { return decode(buffer); });
+
+  cout << name << " (" << buffer.size() << " bytes): encode " << encodeUs
+       << " us (" << buffer.size() / encodeUs << " MB/s), decode " << decodeUs
+       << " us (" << buffer.size() / decodeUs << " MB/s)" << endl;
+}
+}  // namespace
+
+int main(int argc, const char* argv[]) {
+  INIT_STDOUT_LOGGER();
+  TestUtils::Initialize();
+
+  const size_t iterations = (argc > 1) ? stoul(argv[1]) : 100;
+  const size_t numTxns = (argc > 2) ? stoul(argv[2]) : 1000;
+  const size_t numAccounts = (argc > 3) ? stoul(argv[3]) : 1000;
+
+  // Microblock with one hash per transaction
+  const MicroBlock microBlock = TestUtils::GenerateBenchMicroBlock(numTxns);
+  Run("MicroBlock", iterations,
+      [&microBlock](vector<unsigned char>& dst) -> bool {
+        return Messenger::SetMicroBlock(dst, 0, microBlock);
+      },
+      [](const vector<unsigned char>& src) -> bool {
+        MicroBlock result;
+        return Messenger::GetMicroBlock(src, 0, result);
+      });
+
+  // Transaction packet forwarded from a lookup to a shard. Decoding verifies
+  // every transaction signature, as the shard nodes do.
+  const vector<Transaction> txns =
+      TestUtils::GenerateBenchTransactions(numTxns, 1);
+  KeyPair lookupKey = TestUtils::GenerateRandomKeyPair();
+  Run("TxnPacket", iterations,
+      [&lookupKey, &txns](vector<unsigned char>& dst) -> bool {
+        return Messenger::SetNodeForwardTxnBlock(dst, 0, 1, 0, lookupKey, txns,
+                                                 vector<Transaction>());
+      },
+      [](const vector<unsigned char>& src) -> bool {
+        uint64_t epochNumber;
+        uint32_t shardId;
+        PubKey lookupPubKey;
+        vector<Transaction> result;
+        return Messenger::GetNodeForwardTxnBlock(src, 0, epochNumber, shardId,
+                                                 lookupPubKey, result);
+      });
+
+  // Same packet built from pregenerated txns that are already serialized, as
+  // the lookup sends them out of the txn corpus
+  vector<vector<unsigned char>> serializedTxns(numTxns);
+  vector<TxnCorpus::Span> spans;
+  for (size_t i = 0; i < numTxns; i++) {
+    Messenger::SetTransaction(serializedTxns[i], 0, txns[i]);
+    spans.emplace_back(serializedTxns[i].data(), serializedTxns[i].size());
+  }
+  Run("TxnPacketSerialized", iterations,
+      [&lookupKey, &spans](vector<unsigned char>& dst) -> bool {
+        return Messenger::SetNodeForwardTxnBlock(dst, 0, 1, 0, lookupKey,
+                                                 vector<Transaction>(), spans);
+      },
+      [](const vector<unsigned char>& src) -> bool {
+        uint64_t epochNumber;
+        uint32_t shardId;
+        PubKey lookupPubKey;
+        vector<Transaction> result;
+        return Messenger::GetNodeForwardTxnBlock(src, 0, epochNumber, shardId,
+                                                 lookupPubKey, result);
+      });
+
+  // State delta, which uses the account store encoding
+  const map<Address, Account> accounts =
+      TestUtils::GenerateBenchAccounts(numAccounts);
+  Run("StateDelta", iterations,
+      [&accounts](vector<unsigned char>& dst) -> bool {
+        return MessengerAccountStoreBase::SetAccountStore(dst, 0, accounts);
+      },
+      [](const vector<unsigned char>& src) -> bool {
+        map<Address, Account> result;
+        return MessengerAccountStoreBase::GetAccountStore(src, 0, result);
+      });
+
+  return 0;
+}
@@ -270,4 +270,47 @@ BOOST_AUTO_TEST_CASE(test_SetAndGetFallbackBlock) {
   BOOST_CHECK(fallbackBlock == fallbackBlockDeserialized);
 }
 
+BOOST_AUTO_TEST_CASE(test_SetAndGetNodeForwardTxnBlockSerialized) {
+  vector<unsigned char> dst = {0x01, 0x02};
+  unsigned int offset = dst.size();
+  KeyPair sender = TestUtils::GenerateRandomKeyPair();
+  KeyPair lookupKey = TestUtils::GenerateRandomKeyPair();
+
+  vector<Transaction> txnsCurrent;
+  vector<Transaction> txnsGenerated;
+  for (unsigned int i = 0; i < 10; i++) {
+    auto& txns = (i < 3) ? txnsCurrent : txnsGenerated;
+    txns.emplace_back(0, i + 1, Address::random(), sender, i, 1, 1,
+                      vector<unsigned char>(), vector<unsigned char>());
+  }
+
+  vector<vector<unsigned char>> serialized(txnsGenerated.size());
+  vector<TxnCorpus::Span> spans;
+  for (unsigned int i = 0; i < txnsGenerated.size(); i++) {
+    BOOST_REQUIRE(
+        Messenger::SetTransaction(serialized[i], 0, txnsGenerated[i]));
+    spans.emplace_back(serialized[i].data(), serialized[i].size());
+  }
+
+  BOOST_CHECK(Messenger::SetNodeForwardTxnBlock(dst, offset, 5, 2, lookupKey,
+                                                txnsCurrent, spans));
+  BOOST_CHECK_EQUAL(dst[0], 0x01);
+
+  uint64_t epochNumber = 0;
+  uint32_t shardId = 0;
+  PubKey lookupPubKey;
+  vector<Transaction> txns;
+
+  BOOST_REQUIRE(Messenger::GetNodeForwardTxnBlock(
+      dst, offset, epochNumber, shardId, lookupPubKey, txns));
+
+  BOOST_CHECK_EQUAL(epochNumber, 5);
+  BOOST_CHECK_EQUAL(shardId, 2);
+  BOOST_CHECK(lookupPubKey == lookupKey.second);
+  BOOST_REQUIRE_EQUAL(txns.size(), 10);
+  for (unsigned int i = 0; i < txns.size(); i++) {
+    BOOST_CHECK(txns[i] == ((i < 3) ? txnsCurrent[i] : txnsGenerated[i - 3]));
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
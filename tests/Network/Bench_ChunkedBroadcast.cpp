@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+// Simulates the time until every node of a committee holds a block sent by
+// flat broadcast, tree broadcast and chunked (erasure-coded) broadcast, with
+// each node limited by its uplink bandwidth. The Reed-Solomon coding cost is
+// measured for real.
+// Usage: Bench_ChunkedBroadcast [block KB] [uplink MB/s] [latency ms]
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "libNetwork/P2PComm.h"
+#include "libUtils/Logger.h"
+#include "libUtils/ReedSolomon.h"
+
+using namespace std;
+
+namespace {
+const unsigned int FANOUT = 8;
+const unsigned int DATA_SHARDS = 16;
+const unsigned int PARITY_SHARDS = 8;
+
+struct Arrival {
+  double time;
+  unsigned int node;
+  vector<Peer> subtree;
+
+  bool operator>(const Arrival& other) const { return time > other.time; }
+};
+
+// Returns the time at which each node of the committee (node 0 being the
+// sender) holds enough pieces to have the block. Each piece goes down its
+// own tree, and a node only forwards a piece once it has all of it.
+vector<double> Simulate(unsigned int committeeSize, unsigned int fanout,
+                        unsigned int numPieces, unsigned int piecesNeeded,
+                        double pieceSize, double uplink, double latency) {
+  vector<double> uplinkFree(committeeSize, 0);
+  vector<unsigned int> received(committeeSize, 0);
+  vector<double> done(committeeSize, 0);
+
+  vector<Peer> peers;
+  for (unsigned int i = 1; i < committeeSize; i++) {
+    peers.emplace_back(i, i);
+  }
+
+  priority_queue<Arrival, vector<Arrival>, greater<Arrival>> arrivals;
+  auto forward = [&](unsigned int node, double now,
+                     const vector<Peer>& subtree) {
+    deque<vector<Peer>> groups;
+    SendJobTree::SplitTree(subtree, fanout, groups);
+    for (const auto& group : groups) {
+      uplinkFree[node] = max(uplinkFree[node], now) + pieceSize / uplink;
+      arrivals.push({uplinkFree[node] + latency,
+                     group.front().m_listenPortHost,
+                     vector<Peer>(group.begin() + 1, group.end())});
+    }
+  };
+
+  for (unsigned int piece = 0; piece < numPieces; piece++) {
+    mt19937_64 rng(piece);
+    shuffle(peers.begin(), peers.end(), rng);
+    forward(0, 0, peers);
+  }
+
+  while (!arrivals.empty()) {
+    Arrival arrival = arrivals.top();
+    arrivals.pop();
+    if (++received[arrival.node] == piecesNeeded) {
+      done[arrival.node] = arrival.time;
+    }
+    forward(arrival.node, arrival.time, arrival.subtree);
+  }
+
+  return vector<double>(done.begin() + 1, done.end());
+}
+
+void Report(const string& name, vector<double> times) {
+  sort(times.begin(), times.end());
+  cout << "  " << left << setw(10) << name << right << fixed
+       << setprecision(1) << " median " << setw(8)
+       << times[times.size() / 2] * 1000 << " ms, max " << setw(8)
+       << times.back() * 1000 << " ms" << endl;
+}
+
+double MeasureMs(const function<void()>& op, unsigned int iterations = 10) {
+  auto startTime = chrono::steady_clock::now();
+  for (unsigned int i = 0; i < iterations; i++) {
+    op();
+  }
+  return chrono::duration_cast<chrono::duration<double, milli>>(
+             chrono::steady_clock::now() - startTime)
+             .count() /
+         iterations;
+}
+}  // namespace
+
+int main(int argc, const char* argv[]) {
+  INIT_STDOUT_LOGGER();
+
+  const double blockSize = ((argc > 1) ? stod(argv[1]) : 2048) * 1024;
+  const double uplink = ((argc > 2) ? stod(argv[2]) : 12.5) * 1024 * 1024;
+  const double latency = ((argc > 3) ? stod(argv[3]) : 50) / 1000;
+
+  cout << "Block " << blockSize / 1024 << " KB, uplink "
+       << uplink / (1024 * 1024) << " MB/s, latency " << latency * 1000
+       << " ms, fanout " << FANOUT << ", chunks " << DATA_SHARDS << "+"
+       << PARITY_SHARDS << endl;
+
+  for (unsigned int committeeSize : {50, 200, 600}) {
+    cout << "Committee of " << committeeSize << ":" << endl;
+    Report("flat", Simulate(committeeSize, committeeSize, 1, 1, blockSize,
+                            uplink, latency));
+    Report("tree", Simulate(committeeSize, FANOUT, 1, 1, blockSize, uplink,
+                            latency));
+    Report("chunked",
+           Simulate(committeeSize, FANOUT, DATA_SHARDS + PARITY_SHARDS,
+                    DATA_SHARDS, blockSize / DATA_SHARDS, uplink, latency));
+  }
+
+  // Coding cost on a block of the same size, with the parity shards in use
+  mt19937 rng(0);
+  vector<unsigned char> block(blockSize);
+  for (auto& byte : block) {
+    byte = rng() & 0xFF;
+  }
+  vector<vector<unsigned char>> shards;
+  vector<unsigned char> decoded;
+
+  const double encodeMs = MeasureMs([&]() {
+    ReedSolomon::Encode(block, DATA_SHARDS, PARITY_SHARDS, shards);
+  });
+  for (unsigned int i = 0; i < PARITY_SHARDS; i++) {
+    shards[i].clear();
+  }
+  const double decodeMs = MeasureMs([&]() {
+    ReedSolomon::Decode(shards, DATA_SHARDS, block.size(), decoded);
+  });
+  cout << "Reed-Solomon encode " << encodeMs << " ms, decode without "
+       << PARITY_SHARDS << " data shards " << decodeMs << " ms" << endl;
+
+  return 0;
+}
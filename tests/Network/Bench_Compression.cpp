@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+// Measures the wire bytes saved and the CPU spent by P2P frame compression on
+// the payloads that dominate an epoch, or on captured messages.
+// Usage: Bench_Compression [iterations] [captured message files...]
+
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "libMessage/Messenger.h"
+#include "libMessage/MessengerAccountStoreBase.h"
+#include "libTestUtils/BenchPayloads.h"
+#include "libTestUtils/TestUtils.h"
+#include "libUtils/Compression.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+namespace {
+// Roughly what a socket read leaves in each evbuffer chain element
+const size_t CHUNK_SIZE = 16 * 1024;
+
+double Measure(size_t iterations, const function<bool()>& op) {
+  auto startTime = chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; i++) {
+    op();
+  }
+  return chrono::duration_cast<chrono::duration<double, micro>>(
+             chrono::steady_clock::now() - startTime)
+             .count() /
+         iterations;
+}
+
+bool StreamDecompress(const vector<unsigned char>& src,
+                      vector<unsigned char>& dst) {
+  StreamDecompressor decompressor(src.size() * 1024);
+  dst.clear();
+  for (size_t offset = 0; offset < src.size(); offset += CHUNK_SIZE) {
+    if (!decompressor.Update(src.data() + offset,
+                             min(CHUNK_SIZE, src.size() - offset), dst)) {
+      return false;
+    }
+  }
+  return decompressor.Finished();
+}
+
+void Run(const string& name, size_t iterations,
+         const vector<unsigned char>& message) {
+  for (int level : {1, 3, 9}) {
+    vector<unsigned char> compressed;
+    vector<unsigned char> decompressed;
+    if (!Compression::Compress(message.data(), message.size(), level,
+                               compressed) ||
+        !StreamDecompress(compressed, decompressed) ||
+        (decompressed != message)) {
+      cout << name << ": failed" << endl;
+      return;
+    }
+
+    double compressUs = Measure(iterations, [&]() -> bool {
+      compressed.clear();
+      return Compression::Compress(message.data(), message.size(), level,
+                                   compressed);
+    });
+    double decompressUs = Measure(iterations, [&]() -> bool {
+      return StreamDecompress(compressed, decompressed);
+    });
+
+    cout << name << " level " << level << ": " << message.size() << " -> "
+         << compressed.size() << " bytes (ratio "
+         << (double)message.size() / compressed.size() << "), compress "
+         << compressUs << " us (" << message.size() / compressUs
+         << " MB/s), decompress " << decompressUs << " us ("
+         << message.size() / decompressUs << " MB/s)" << endl;
+  }
+}
+}  // namespace
+
+int main(int argc, const char* argv[]) {
+  INIT_STDOUT_LOGGER();
+  TestUtils::Initialize();
+
+  const size_t iterations = (argc > 1) ? stoul(argv[1]) : 100;
+
+  if (argc > 2) {
+    for (int i = 2; i < argc; i++) {
+      ifstream file(argv[i], ios::binary);
+      if (!file) {
+        cout << argv[i] << ": cannot open" << endl;
+        continue;
+      }
+      vector<unsigned char> message((istreambuf_iterator<char>(file)),
+                                    istreambuf_iterator<char>());
+      Run(argv[i], iterations, message);
+    }
+    return 0;
+  }
+
+  const size_t numTxns = 1000;
+  const size_t numAccounts = 1000;
+  vector<unsigned char> message;
+
+  // Microblock with one hash per transaction
+  if (Messenger::SetMicroBlock(message, 0,
+                               TestUtils::GenerateBenchMicroBlock(numTxns))) {
+    Run("MicroBlock", iterations, message);
+  }
+
+  // Transaction packet of plain transfers from a handful of senders
+  KeyPair lookupKey = TestUtils::GenerateRandomKeyPair();
+  message.clear();
+  if (Messenger::SetNodeForwardTxnBlock(
+          message, 0, 1, 0, lookupKey,
+          TestUtils::GenerateBenchTransactions(numTxns, 8),
+          vector<Transaction>())) {
+    Run("TxnPacket", iterations, message);
+  }
+
+  // State delta, which uses the account store encoding
+  message.clear();
+  if (MessengerAccountStoreBase::SetAccountStore(
+          message, 0, TestUtils::GenerateBenchAccounts(numAccounts))) {
+    Run("StateDelta", iterations, message);
+  }
+
+  return 0;
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#include <vector>
+
+#include "libNetwork/ChunkedBroadcast.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE chunkedbroadcast
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace {
+const unsigned int DATA_SHARDS = 4;
+const unsigned int PARITY_SHARDS = 2;
+
+vector<unsigned char> GetMessage(size_t size, unsigned int seed) {
+  vector<unsigned char> message(size);
+  for (unsigned int i = 0; i < message.size(); i++) {
+    message.at(i) = (i * 7 + seed) % 251;
+  }
+  return message;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(chunkedbroadcast)
+
+BOOST_AUTO_TEST_CASE(test_rebuild_from_any_data_shards) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  const vector<unsigned char> message = GetMessage(10000, 0);
+  vector<vector<unsigned char>> chunks;
+  BOOST_REQUIRE(ChunkedBroadcast::MakeChunks(message, DATA_SHARDS,
+                                             PARITY_SHARDS, chunks));
+  BOOST_REQUIRE_EQUAL(chunks.size(), DATA_SHARDS + PARITY_SHARDS);
+
+  // The parity chunks stand in for the first data chunks
+  ChunkedBroadcast chunkedBroadcast;
+  vector<unsigned char> rebuilt;
+  unsigned int numRebuilt = 0;
+  for (unsigned int i = PARITY_SHARDS; i < chunks.size(); i++) {
+    numRebuilt += chunkedBroadcast.AddChunk(chunks.at(i), rebuilt);
+  }
+  BOOST_CHECK_EQUAL(numRebuilt, 1);
+  BOOST_CHECK(rebuilt == message);
+
+  // Late chunks are not handed up again
+  BOOST_CHECK(!chunkedBroadcast.AddChunk(chunks.front(), rebuilt));
+}
+
+BOOST_AUTO_TEST_CASE(test_forged_chunks) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  const vector<unsigned char> message = GetMessage(10000, 0);
+  vector<vector<unsigned char>> chunks;
+  BOOST_REQUIRE(ChunkedBroadcast::MakeChunks(message, DATA_SHARDS,
+                                             PARITY_SHARDS, chunks));
+
+  ChunkedBroadcast chunkedBroadcast;
+  vector<unsigned char> rebuilt;
+
+  // A chunk with a tampered shard, or with a tampered header under the same
+  // set ID, is turned away before it reaches the set
+  vector<unsigned char> badShard(chunks.at(0));
+  badShard.back() ^= 0xFF;
+  BOOST_CHECK(!chunkedBroadcast.AddChunk(badShard, rebuilt));
+
+  vector<unsigned char> badHeader(chunks.at(1));
+  badHeader.at(ChunkedBroadcast::FIXED_HEADER_LEN - 1) ^= 0xFF;
+  BOOST_CHECK(!chunkedBroadcast.AddChunk(badHeader, rebuilt));
+
+  // Chunks of another message go into their own set
+  vector<vector<unsigned char>> otherChunks;
+  BOOST_REQUIRE(ChunkedBroadcast::MakeChunks(GetMessage(10000, 1), DATA_SHARDS,
+                                             PARITY_SHARDS, otherChunks));
+  for (unsigned int i = 0; i < DATA_SHARDS - 1; i++) {
+    BOOST_CHECK(!chunkedBroadcast.AddChunk(otherChunks.at(i), rebuilt));
+  }
+
+  // None of it stops the genuine chunks from rebuilding the message
+  unsigned int numRebuilt = 0;
+  for (unsigned int i = 0; i < DATA_SHARDS; i++) {
+    numRebuilt += chunkedBroadcast.AddChunk(chunks.at(i), rebuilt);
+  }
+  BOOST_CHECK_EQUAL(numRebuilt, 1);
+  BOOST_CHECK(rebuilt == message);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
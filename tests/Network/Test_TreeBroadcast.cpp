@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#include <arpa/inet.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "libCrypto/Schnorr.h"
+#include "libNetwork/P2PComm.h"
+#include "libUtils/DetachedFunction.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE treebroadcast
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace {
+const uint32_t TREE_BASE_PORT = 30400;
+const uint32_t CHUNK_BASE_PORT = 30500;
+const uint32_t UNTRUSTED_BASE_PORT = 30600;
+const unsigned int NUM_RECEIVERS = 24;
+const unsigned int NUM_DEAD_PEERS = 4;
+const unsigned char FANOUT = 3;
+const unsigned int RECEIVE_WINDOW_IN_SECONDS = 8;
+
+Peer LocalPeer(uint32_t port) {
+  struct in_addr ip_addr;
+  inet_pton(AF_INET, "127.0.0.1", &ip_addr);
+  return Peer(ip_addr.s_addr, port);
+}
+
+// The first numPeers peers after the base port
+vector<Peer> LocalPeers(uint32_t basePort, unsigned int numPeers) {
+  vector<Peer> peers;
+  for (unsigned int i = 1; i <= numPeers; i++) {
+    peers.emplace_back(LocalPeer(basePort + i));
+  }
+  return peers;
+}
+
+// Runs in a child process, which exits with 0 if the expected message arrived
+// exactly once within the receive window
+[[noreturn]] void RunReceiver(uint32_t port,
+                              const vector<unsigned char>& expected,
+                              const PubKey& originator) {
+  static atomic<unsigned int> received(0);
+  static atomic<bool> correct(true);
+
+  P2PComm::Dispatcher dispatcher =
+      [expected](pair<vector<unsigned char>, Peer>* message) {
+        if (message->first != expected) {
+          correct = false;
+        }
+        received++;
+        delete message;
+      };
+
+  P2PComm::OriginatorListFunc originatorListRetriever = [originator]() {
+    return vector<PubKey>{originator};
+  };
+
+  auto func = [port, dispatcher, originatorListRetriever]() mutable -> void {
+    P2PComm::GetInstance().StartMessagePump(port, dispatcher, nullptr,
+                                            originatorListRetriever);
+  };
+  DetachedFunction(1, func);
+
+  // Stay up for the whole window, as this node may have to relay
+  this_thread::sleep_for(chrono::seconds(RECEIVE_WINDOW_IN_SECONDS));
+  _exit(((received == 1) && correct) ? 0 : 1);
+}
+
+// Runs in a child process that sends the message to the receivers (and to a
+// few peers that are down) with the given function
+[[noreturn]] void RunSender(uint32_t basePort, const pair<PrivKey, PubKey>& key,
+                            const function<void(const vector<Peer>&)>& send) {
+  P2PComm::GetInstance().SetSelfKey(key);
+
+  auto func = [basePort]() mutable -> void {
+    P2PComm::GetInstance().StartMessagePump(basePort, nullptr, nullptr);
+  };
+  DetachedFunction(1, func);
+  this_thread::sleep_for(chrono::seconds(1));  // let every socket listen
+
+  send(LocalPeers(basePort, NUM_RECEIVERS + NUM_DEAD_PEERS));
+
+  this_thread::sleep_for(chrono::seconds(RECEIVE_WINDOW_IN_SECONDS));
+  _exit(0);
+}
+
+// Every node, including the sender, is its own process, so the test process
+// never starts P2PComm itself. The receivers only relay tree layouts signed by
+// the sender, unless trustSender is false.
+unsigned int Broadcast(uint32_t basePort, const vector<unsigned char>& message,
+                       const function<void(const vector<Peer>&)>& send,
+                       bool trustSender = true) {
+  const pair<PrivKey, PubKey> senderKey = Schnorr::GetInstance().GenKeyPair();
+  const PubKey originator = trustSender
+                                ? senderKey.second
+                                : Schnorr::GetInstance().GenKeyPair().second;
+
+  vector<pid_t> receivers;
+  for (unsigned int i = 1; i <= NUM_RECEIVERS; i++) {
+    pid_t pid = fork();
+    BOOST_REQUIRE_MESSAGE(pid >= 0, "fork failed");
+    if (pid == 0) {
+      RunReceiver(basePort + i, message, originator);
+    }
+    receivers.emplace_back(pid);
+  }
+
+  pid_t sender = fork();
+  BOOST_REQUIRE_MESSAGE(sender >= 0, "fork failed");
+  if (sender == 0) {
+    RunSender(basePort, senderKey, send);
+  }
+
+  unsigned int numReceived = 0;
+  for (const auto& pid : receivers) {
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (WIFEXITED(status) && (WEXITSTATUS(status) == 0)) {
+      numReceived++;
+    }
+  }
+  waitpid(sender, nullptr, 0);
+
+  return numReceived;
+}
+
+vector<unsigned char> GetMessage(size_t size) {
+  vector<unsigned char> message(size);
+  for (unsigned int i = 0; i < message.size(); i++) {
+    message.at(i) = (i * 7) % 251;
+  }
+  return message;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(treebroadcast)
+
+BOOST_AUTO_TEST_CASE(test_tree_broadcast) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  // Large enough to also go out compressed
+  const vector<unsigned char> message = GetMessage(64 * 1024);
+
+  // Some peers are down, so their subtrees have to be taken over
+  const unsigned int numReceived =
+      Broadcast(TREE_BASE_PORT, message, [&message](const vector<Peer>& peers) {
+        P2PComm::GetInstance().SendTreeBroadcastMessage(peers, message,
+                                                        FANOUT);
+      });
+
+  BOOST_CHECK_MESSAGE(numReceived == NUM_RECEIVERS,
+                      "Only " << numReceived << " of " << NUM_RECEIVERS
+                              << " receivers got the broadcast");
+}
+
+BOOST_AUTO_TEST_CASE(test_tree_broadcast_untrusted_originator) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  const vector<unsigned char> message = GetMessage(1024);
+
+  // The receivers do not know the sender's key, so the peers it sends to get
+  // the message but do not relay it to their subtrees
+  const unsigned int numReceived = Broadcast(
+      UNTRUSTED_BASE_PORT, message,
+      [&message](const vector<Peer>& peers) {
+        P2PComm::GetInstance().SendTreeBroadcastMessage(peers, message,
+                                                        FANOUT);
+      },
+      false);
+
+  BOOST_CHECK_MESSAGE((numReceived > 0) && (numReceived < NUM_RECEIVERS),
+                      numReceived << " of " << NUM_RECEIVERS
+                                  << " receivers got the broadcast");
+}
+
+BOOST_AUTO_TEST_CASE(test_chunked_broadcast) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  const vector<unsigned char> message = GetMessage(300 * 1024 + 7);
+
+  const unsigned int numReceived = Broadcast(
+      CHUNK_BASE_PORT, message, [&message](const vector<Peer>& peers) {
+        P2PComm::GetInstance().SendChunkedBroadcastMessage(peers, message,
+                                                           FANOUT, 4, 2);
+      });
+
+  BOOST_CHECK_MESSAGE(numReceived == NUM_RECEIVERS,
+                      "Only " << numReceived << " of " << NUM_RECEIVERS
+                              << " receivers rebuilt the broadcast");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
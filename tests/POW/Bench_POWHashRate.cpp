@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+// Measures the CPU mining hash rate for increasing numbers of threads.
+// Usage: Bench_POWHashRate [seconds per run] [full]
+
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "libCrypto/Schnorr.h"
+#include "libPOW/pow.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+int main(int argc, const char* argv[]) {
+  INIT_STDOUT_LOGGER();
+
+  const unsigned int seconds = (argc > 1) ? stoul(argv[1]) : 10;
+  const bool fullDataset = (argc > 2) && (string(argv[2]) == "full");
+
+  POW& pow = POW::GetInstance();
+  array<unsigned char, 32> rand1 = {{'0', '1'}};
+  array<unsigned char, 32> rand2 = {{'0', '2'}};
+  boost::multiprecision::uint128_t ipAddr = 2307193356;
+  PubKey pubKey = Schnorr::GetInstance().GenKeyPair().second;
+
+  // Build the epoch context up front so it is not part of the measurement
+  pow.EthashConfigureClient(0, fullDataset);
+
+  const unsigned int maxThreads = max(thread::hardware_concurrency(), 1U);
+  uint64_t baseRate = 0;
+  unsigned int numThreads = 1;
+  while (true) {
+    pow.SetNumMiningThreads(numThreads);
+
+    // The maximum difficulty is never met, so mining runs until stopped
+    thread stopper([&pow, seconds]() {
+      this_thread::sleep_for(chrono::seconds(seconds));
+      pow.StopMining();
+    });
+    pow.PoWMine(0, 255, rand1, rand2, ipAddr, pubKey, 0, 0, fullDataset);
+    stopper.join();
+
+    const uint64_t rate = pow.GetHashRate();
+    if (numThreads == 1) {
+      baseRate = max<uint64_t>(rate, 1);
+    }
+    cout << "threads=" << numThreads << " hashrate=" << rate
+         << " H/s speedup=" << (double)rate / baseRate << endl;
+
+    if (numThreads == maxThreads) {
+      break;
+    }
+    numThreads = min(numThreads * 2, maxThreads);
+  }
+
+  return 0;
+}
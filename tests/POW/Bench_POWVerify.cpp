@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+// Measures PoW verification throughput for a burst of submissions, first one
+// at a time and then through the parallel batch verifier.
+// Usage: Bench_POWVerify [submissions]
+
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "libCrypto/Schnorr.h"
+#include "libPOW/pow.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+int main(int argc, const char* argv[]) {
+  INIT_STDOUT_LOGGER();
+
+  const size_t numSubmissions = (argc > 1) ? stoul(argv[1]) : 10000;
+  const uint64_t blockNum = 0;
+  const uint8_t difficulty = 10;
+
+  POW& pow = POW::GetInstance();
+  array<unsigned char, 32> rand1 = {{'0', '1'}};
+  array<unsigned char, 32> rand2 = {{'0', '2'}};
+  boost::multiprecision::uint128_t ipAddr = 2307193356;
+  PubKey pubKey = Schnorr::GetInstance().GenKeyPair().second;
+
+  ethash_mining_result_t winning_result = pow.PoWMine(
+      blockNum, difficulty, rand1, rand2, ipAddr, pubKey, 0, 0, false);
+  if (!winning_result.success) {
+    cout << "Mining failed" << endl;
+    return 1;
+  }
+
+  // Every submission costs the same to verify, so one solution is replicated
+  const PoWVerifyRequest request = {
+      blockNum,
+      difficulty,
+      pow.GetHeaderHash(rand1, rand2, ipAddr, pubKey, 0, 0),
+      winning_result.winning_nonce,
+      POW::StringToBlockhash(winning_result.result),
+      POW::StringToBlockhash(winning_result.mix_hash)};
+  const vector<PoWVerifyRequest> requests(numSubmissions, request);
+
+  auto report = [numSubmissions](const string& name,
+                                 chrono::steady_clock::time_point startTime,
+                                 size_t numValid) -> double {
+    auto elapsedMs = chrono::duration_cast<chrono::milliseconds>(
+                         chrono::steady_clock::now() - startTime)
+                         .count();
+    double rate = numSubmissions * 1000.0 / max<int64_t>(elapsedMs, 1);
+    cout << name << ": " << numValid << "/" << numSubmissions << " valid in "
+         << elapsedMs << " ms (" << rate << " submissions/s)" << endl;
+    return rate;
+  };
+
+  auto startTime = chrono::steady_clock::now();
+  size_t numValid = 0;
+  for (const auto& r : requests) {
+    numValid += pow.PoWVerify(r) ? 1 : 0;
+  }
+  double sequentialRate = report("sequential", startTime, numValid);
+
+  startTime = chrono::steady_clock::now();
+  vector<unsigned char> results = pow.PoWVerifyBatch(requests);
+  numValid = 0;
+  for (const auto& result : results) {
+    numValid += result ? 1 : 0;
+  }
+  double batchRate = report(
+      "batch (" + to_string(POW_VERIFY_THREADS) + " threads)", startTime,
+      numValid);
+
+  cout << "speedup=" << batchRate / sequentialRate << endl;
+
+  return 0;
+}
@@ -395,6 +395,112 @@ BOOST_AUTO_TEST_CASE(mining_and_verification_full) {
   BOOST_REQUIRE(!verifyWinningNonce);
 }
 
+BOOST_AUTO_TEST_CASE(mining_and_verification_multithreaded) {
+  POW& POWClient = POW::GetInstance();
+  std::array<unsigned char, 32> rand1 = {{'0', '4'}};
+  std::array<unsigned char, 32> rand2 = {{'0', '5'}};
+  boost::multiprecision::uint128_t ipAddr = 2307193356;
+  PubKey pubKey = Schnorr::GetInstance().GenKeyPair().second;
+
+  uint8_t difficultyToUse = 12;
+  uint64_t blockToUse = 0;
+  for (unsigned int numThreads : {1, 4}) {
+    POWClient.SetNumMiningThreads(numThreads);
+    ethash_mining_result_t winning_result = POWClient.PoWMine(
+        blockToUse, difficultyToUse, rand1, rand2, ipAddr, pubKey, 0, 0, false);
+    BOOST_REQUIRE(winning_result.success);
+    BOOST_REQUIRE(POWClient.GetHashRate() > 0);
+
+    bool verifyLight =
+        POWClient.PoWVerify(blockToUse, difficultyToUse, rand1, rand2, ipAddr,
+                            pubKey, 0, 0, winning_result.winning_nonce,
+                            winning_result.result, winning_result.mix_hash);
+    BOOST_REQUIRE(verifyLight);
+  }
+  POWClient.SetNumMiningThreads(POW_CPU_MINING_THREADS);
+}
+
+BOOST_AUTO_TEST_CASE(batch_verification) {
+  POW& POWClient = POW::GetInstance();
+  std::array<unsigned char, 32> rand1 = {{'0', '6'}};
+  std::array<unsigned char, 32> rand2 = {{'0', '7'}};
+  boost::multiprecision::uint128_t ipAddr = 2307193356;
+  PubKey pubKey = Schnorr::GetInstance().GenKeyPair().second;
+
+  uint8_t difficultyToUse = 10;
+  uint64_t blockToUse = 0;
+  ethash_mining_result_t winning_result = POWClient.PoWMine(
+      blockToUse, difficultyToUse, rand1, rand2, ipAddr, pubKey, 0, 0, false);
+  BOOST_REQUIRE(winning_result.success);
+
+  PoWVerifyRequest valid = {
+      blockToUse,
+      difficultyToUse,
+      POWClient.GetHeaderHash(rand1, rand2, ipAddr, pubKey, 0, 0),
+      winning_result.winning_nonce,
+      POW::StringToBlockhash(winning_result.result),
+      POW::StringToBlockhash(winning_result.mix_hash)};
+  PoWVerifyRequest wrongNonce = valid;
+  wrongNonce.nonce++;
+
+  std::vector<PoWVerifyRequest> requests;
+  for (unsigned int i = 0; i < 16; i++) {
+    requests.emplace_back(i % 3 == 0 ? wrongNonce : valid);
+  }
+
+  std::vector<unsigned char> results = POWClient.PoWVerifyBatch(requests);
+  BOOST_REQUIRE(results.size() == requests.size());
+  for (unsigned int i = 0; i < results.size(); i++) {
+    BOOST_CHECK_MESSAGE((bool)results[i] == (i % 3 != 0),
+                        "Unexpected verification result for request " << i);
+  }
+
+  // The binary and hex entry points must agree
+  BOOST_REQUIRE(POWClient.PoWVerify(valid));
+  BOOST_REQUIRE(POWClient.PoWVerify(
+      blockToUse, difficultyToUse, rand1, rand2, ipAddr, pubKey, 0, 0,
+      winning_result.winning_nonce, winning_result.result,
+      winning_result.mix_hash));
+}
+
+BOOST_AUTO_TEST_CASE(epoch_context_cache) {
+  if (!POW_EPOCH_CONTEXT_CACHE) {
+    std::cout << "POW_EPOCH_CONTEXT_CACHE option is not enabled, skip test "
+                 "case epoch_context_cache"
+              << std::endl;
+    return;
+  }
+
+  const int epochNumber = 1;
+  const ethash_hash256 headerHash = POW::StringToBlockhash(string(64, '1'));
+
+  std::shared_ptr<ethash::epoch_context> built;
+  {
+    EpochContextCache cache;
+    fs::remove(ETHASH_CACHE_PATH + "/light_1.cache");
+    built = cache.GetLightContext(epochNumber);
+    BOOST_REQUIRE(built != nullptr);
+  }
+  BOOST_REQUIRE(fs::exists(ETHASH_CACHE_PATH + "/light_1.cache"));
+
+  // A fresh cache maps the file instead of rebuilding it
+  EpochContextCache cache;
+  auto loaded = cache.GetLightContext(epochNumber);
+  BOOST_REQUIRE(loaded != nullptr);
+  BOOST_REQUIRE(loaded != built);
+  BOOST_REQUIRE(loaded->light_cache_num_items == built->light_cache_num_items);
+  BOOST_REQUIRE(memcmp(loaded->light_cache, built->light_cache,
+                       ethash::get_light_cache_size(
+                           built->light_cache_num_items)) == 0);
+
+  auto builtResult = ethash::hash(*built, headerHash, 42);
+  auto loadedResult = ethash::hash(*loaded, headerHash, 42);
+  BOOST_REQUIRE(memcmp(builtResult.final_hash.bytes,
+                       loadedResult.final_hash.bytes, 32) == 0);
+
+  BOOST_REQUIRE(cache.GetLightContext(epochNumber) == loaded);
+}
+
 // Please enable the OPENCL_GPU_MINE option in constants.xml to run this test
 // case
 BOOST_AUTO_TEST_CASE(gpu_mining_and_verification_1) {
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "common/Constants.h"
+#include "libPersistence/BlockArchive.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE blockarchivetest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+vector<unsigned char> dummyBody(uint64_t blockNum, size_t size) {
+  vector<unsigned char> body(size);
+  for (size_t i = 0; i < size; i++) {
+    body[i] = (unsigned char)(blockNum + i);
+  }
+  return body;
+}
+
+BOOST_AUTO_TEST_SUITE(blockarchivetest)
+
+BOOST_AUTO_TEST_CASE(testPutGetReopen) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  {
+    BlockArchive archive("testArchive");
+    BOOST_CHECK(archive.Reset());
+
+    for (uint64_t i = 0; i < 10; i++) {
+      BOOST_CHECK(archive.Put(i, dummyBody(i, 100 + i)));
+    }
+    BOOST_CHECK_EQUAL(archive.GetBlockCount(), 10);
+
+    vector<unsigned char> body;
+    BOOST_CHECK(archive.Get(3, body));
+    BOOST_CHECK(body == dummyBody(3, 103));
+    BOOST_CHECK(!archive.Get(10, body));
+
+    // Rewriting a block replaces it
+    BOOST_CHECK(archive.Put(3, dummyBody(30, 50)));
+    BOOST_CHECK(archive.Get(3, body));
+    BOOST_CHECK(body == dummyBody(30, 50));
+  }
+
+  BlockArchive archive("testArchive");
+  BOOST_CHECK_EQUAL(archive.GetBlockCount(), 10);
+
+  vector<unsigned char> body;
+  BOOST_CHECK(archive.Get(3, body));
+  BOOST_CHECK(body == dummyBody(30, 50));
+  BOOST_CHECK(archive.Get(9, body));
+  BOOST_CHECK(body == dummyBody(9, 109));
+}
+
+BOOST_AUTO_TEST_CASE(testDelete) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  BlockArchive archive("testArchive");
+  BOOST_CHECK(archive.Reset());
+
+  for (uint64_t i = 0; i < 5; i++) {
+    BOOST_CHECK(archive.Put(i, dummyBody(i, 10)));
+  }
+
+  vector<unsigned char> body;
+  BOOST_CHECK(archive.Delete(2));
+  BOOST_CHECK(!archive.Get(2, body));
+  BOOST_CHECK_EQUAL(archive.GetBlockCount(), 5);
+
+  // Deleting from the end shrinks the count past any earlier gaps
+  BOOST_CHECK(archive.Delete(4));
+  BOOST_CHECK(archive.Delete(3));
+  BOOST_CHECK_EQUAL(archive.GetBlockCount(), 2);
+  BOOST_CHECK(archive.Get(1, body));
+  BOOST_CHECK(body == dummyBody(1, 10));
+
+  BOOST_CHECK(archive.Reset());
+  BOOST_CHECK_EQUAL(archive.GetBlockCount(), 0);
+  BOOST_CHECK(!archive.Get(0, body));
+}
+
+BOOST_AUTO_TEST_CASE(testReadWhileGrowing) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  BlockArchive archive("testArchive");
+  BOOST_CHECK(archive.Reset());
+
+  // Interleaved reads force the data file to be remapped as it grows
+  vector<unsigned char> body;
+  for (uint64_t i = 0; i < 200; i++) {
+    BOOST_CHECK(archive.Put(i, dummyBody(i, 4096)));
+    BOOST_CHECK(archive.Get(i, body));
+    BOOST_CHECK(body == dummyBody(i, 4096));
+  }
+  BOOST_CHECK(archive.Get(0, body));
+  BOOST_CHECK(body == dummyBody(0, 4096));
+}
+
+BOOST_AUTO_TEST_CASE(testStoreAgainAppends) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  const string dataPath = "./" + PERSISTENCE_PATH + "/testArchive.dat";
+
+  BlockArchive archive("testArchive");
+  BOOST_CHECK(archive.Reset());
+
+  for (uint64_t i = 0; i < 5; i++) {
+    BOOST_CHECK(archive.Put(i, dummyBody(i, 100)));
+  }
+  BOOST_CHECK_EQUAL(boost::filesystem::file_size(dataPath), 500);
+
+  // Storing a block again appends a new record and leaves the old ones alone
+  BOOST_CHECK(archive.Put(1, dummyBody(10, 60)));
+  BOOST_CHECK(archive.Put(4, dummyBody(40, 200)));
+  BOOST_CHECK_EQUAL(boost::filesystem::file_size(dataPath), 760);
+
+  vector<unsigned char> body;
+  BOOST_CHECK(archive.Get(1, body));
+  BOOST_CHECK(body == dummyBody(10, 60));
+  BOOST_CHECK(archive.Get(2, body));
+  BOOST_CHECK(body == dummyBody(2, 100));
+  BOOST_CHECK(archive.Get(4, body));
+  BOOST_CHECK(body == dummyBody(40, 200));
+}
+
+BOOST_AUTO_TEST_CASE(testCorruptRecordRejected) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  const string dataPath = "./" + PERSISTENCE_PATH + "/testArchive.dat";
+
+  {
+    BlockArchive archive("testArchive");
+    BOOST_CHECK(archive.Reset());
+    for (uint64_t i = 0; i < 3; i++) {
+      BOOST_CHECK(archive.Put(i, dummyBody(i, 100)));
+    }
+  }
+
+  // Flip a byte inside the record of block 1
+  {
+    fstream file(dataPath, ios::in | ios::out | ios::binary);
+    file.seekp(150);
+    file.put((char)0xFF);
+  }
+
+  BlockArchive archive("testArchive");
+  vector<unsigned char> body;
+  BOOST_CHECK(!archive.Get(1, body));
+  BOOST_CHECK(archive.Get(0, body));
+  BOOST_CHECK(body == dummyBody(0, 100));
+  BOOST_CHECK(archive.Get(2, body));
+  BOOST_CHECK(body == dummyBody(2, 100));
+
+  // Storing the block again makes it readable
+  BOOST_CHECK(archive.Put(1, dummyBody(1, 100)));
+  BOOST_CHECK(archive.Get(1, body));
+  BOOST_CHECK(body == dummyBody(1, 100));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#include <vector>
+
+#include "depends/common/FixedHash.h"
+#include "libCrypto/Sha2.h"
+#include "libPersistence/BloomFilter.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE bloomfiltertest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+dev::h256 hashOf(unsigned int i) {
+  SHA2<HASH_TYPE::HASH_VARIANT_256> sha2;
+  sha2.Update(vector<unsigned char>{(unsigned char)(i >> 24),
+                                    (unsigned char)(i >> 16),
+                                    (unsigned char)(i >> 8), (unsigned char)i});
+  return dev::h256(sha2.Finalize());
+}
+
+BOOST_AUTO_TEST_SUITE(bloomfiltertest)
+
+BOOST_AUTO_TEST_CASE(testNoFalseNegatives) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  BloomFilter filter(1 << 16);
+  for (unsigned int i = 0; i < 10000; i++) {
+    filter.Insert(hashOf(i));
+  }
+  BOOST_CHECK_EQUAL(filter.GetNumInserted(), 10000);
+
+  for (unsigned int i = 0; i < 10000; i++) {
+    BOOST_CHECK(filter.MayContain(hashOf(i)));
+  }
+
+  // 52 bits per entry should keep false positives well under 1%
+  unsigned int falsePositives = 0;
+  for (unsigned int i = 10000; i < 20000; i++) {
+    falsePositives += filter.MayContain(hashOf(i));
+  }
+  BOOST_CHECK_LT(falsePositives, 100);
+
+  filter.Clear();
+  BOOST_CHECK(!filter.MayContain(hashOf(0)));
+}
+
+BOOST_AUTO_TEST_CASE(testSaveLoad) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  BloomFilter filter(1 << 12);
+  for (unsigned int i = 0; i < 100; i++) {
+    filter.Insert(hashOf(i));
+  }
+  BOOST_CHECK(filter.Save("test.bloom"));
+
+  BloomFilter loaded(1 << 12);
+  BOOST_CHECK(loaded.Load("test.bloom"));
+  BOOST_CHECK_EQUAL(loaded.GetNumInserted(), 100);
+  for (unsigned int i = 0; i < 100; i++) {
+    BOOST_CHECK(loaded.MayContain(hashOf(i)));
+  }
+
+  // A filter of a different size cannot be reused
+  BloomFilter other(1 << 13);
+  BOOST_CHECK(!other.Load("test.bloom"));
+  BOOST_CHECK(!other.Load("missing.bloom"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
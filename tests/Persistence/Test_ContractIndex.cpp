@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#include "depends/common/FixedHash.h"
+#include "libPersistence/ContractStorage.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE contractindextest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(contractindextest)
+
+BOOST_AUTO_TEST_CASE(testPagingByCreator) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  ContractStorage& storage = ContractStorage::GetContractStorage();
+  dev::h160 creator = dev::h160::random();
+  dev::h160 other = dev::h160::random();
+
+  // Insert out of order, with nonces wide enough to exercise key ordering
+  vector<uint64_t> nonces = {300, 2, 0x100, 17, 0, 0x1000000000};
+  for (auto nonce : nonces) {
+    BOOST_CHECK(storage.PutContractCreation(creator, nonce,
+                                            dev::h160::random()));
+  }
+  BOOST_CHECK(storage.PutContractCreation(other, 1, dev::h160::random()));
+
+  auto page = storage.GetContractsByCreator(creator, 0, 4);
+  BOOST_REQUIRE_EQUAL(page.size(), 4);
+  BOOST_CHECK_EQUAL(page[0].first, 0);
+  BOOST_CHECK_EQUAL(page[1].first, 2);
+  BOOST_CHECK_EQUAL(page[2].first, 17);
+  BOOST_CHECK_EQUAL(page[3].first, 0x100);
+
+  page = storage.GetContractsByCreator(creator, page.back().first + 1, 4);
+  BOOST_REQUIRE_EQUAL(page.size(), 2);
+  BOOST_CHECK_EQUAL(page[0].first, 300);
+  BOOST_CHECK_EQUAL(page[1].first, 0x1000000000);
+
+  // Entries of another creator never leak into the page
+  BOOST_CHECK(storage.GetContractsByCreator(creator, 0x1000000001, 4).empty());
+  BOOST_CHECK_EQUAL(storage.GetContractsByCreator(other, 0, 4).size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(testCreatorScanNonce) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  ContractStorage& storage = ContractStorage::GetContractStorage();
+  dev::h160 creator = dev::h160::random();
+
+  BOOST_CHECK_EQUAL(storage.GetCreatorScanNonce(creator), 0);
+
+  BOOST_CHECK(storage.PutContractCreation(creator, 0, dev::h160::random()));
+  BOOST_CHECK(storage.PutCreatorScanNonce(creator, 0x1000000000));
+  BOOST_CHECK_EQUAL(storage.GetCreatorScanNonce(creator), 0x1000000000);
+
+  // The scan nonce is kept apart from the creator's entries
+  auto page = storage.GetContractsByCreator(creator, 0, 4);
+  BOOST_REQUIRE_EQUAL(page.size(), 1);
+  BOOST_CHECK_EQUAL(page[0].first, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#include <string>
+#include <vector>
+
+#include "depends/libDatabase/LevelDB.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE leveldbtest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(leveldbtest)
+
+BOOST_AUTO_TEST_CASE(testColumnsAreIsolated) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  auto sharedDB = LevelDB::OpenSharedDB("testShared");
+  LevelDB blocks(sharedDB, "testShared", "blocks");
+  LevelDB blocksTmp(sharedDB, "testShared", "blocksTmp");
+  BOOST_CHECK(blocks.ResetDB());
+  BOOST_CHECK(blocksTmp.ResetDB());
+
+  vector<unsigned char> body1 = {1, 2, 3};
+  vector<unsigned char> body2 = {4, 5};
+  BOOST_CHECK_EQUAL(blocks.Insert(1, body1), 0);
+  BOOST_CHECK_EQUAL(blocks.Insert(2, body2), 0);
+  BOOST_CHECK_EQUAL(blocksTmp.Insert(1, body2), 0);
+
+  BOOST_CHECK(blocks.Lookup(1) == string(body1.begin(), body1.end()));
+  BOOST_CHECK(blocksTmp.Lookup(1) == string(body2.begin(), body2.end()));
+  BOOST_CHECK(!blocksTmp.Exists(2));
+
+  // Iteration only sees the column's own keys, without the prefix
+  vector<string> keys;
+  unique_ptr<leveldb::Iterator> it(blocks.NewIterator());
+  for (it->SeekToFirst(); it->Valid(); it->Next()) {
+    keys.emplace_back(it->key().ToString());
+  }
+  BOOST_CHECK(keys == vector<string>({"1", "2"}));
+
+  it.reset(blocks.NewIterator());
+  it->SeekToLast();
+  BOOST_CHECK(it->Valid() && it->key().ToString() == "2");
+
+  // Resetting a column leaves the others untouched
+  BOOST_CHECK(blocks.ResetDB());
+  BOOST_CHECK(!blocks.Exists(1));
+  BOOST_CHECK(blocksTmp.Exists(1));
+}
+
+BOOST_AUTO_TEST_CASE(testBatchAcrossColumns) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  auto sharedDB = LevelDB::OpenSharedDB("testShared");
+  LevelDB blocks(sharedDB, "testShared", "blocks");
+  LevelDB metadata(sharedDB, "testShared", "metadata");
+  BOOST_CHECK(blocks.ResetDB());
+  BOOST_CHECK(metadata.ResetDB());
+
+  leveldb::WriteBatch batch;
+  blocks.BatchPut(batch, 7, {7, 7});
+  metadata.BatchPut(batch, "latest", {7});
+  BOOST_CHECK(!blocks.Exists(7));
+  BOOST_CHECK_EQUAL(blocks.CommitBatch(batch), 0);
+
+  BOOST_CHECK(blocks.Lookup(7) == string({7, 7}));
+  BOOST_CHECK(metadata.Lookup("latest") == string({7}));
+}
+
+BOOST_AUTO_TEST_CASE(testBatchLookup) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  auto sharedDB = LevelDB::OpenSharedDB("testShared");
+  LevelDB bodies(sharedDB, "testShared", "bodies");
+  BOOST_CHECK(bodies.ResetDB());
+
+  vector<dev::h256> keys;
+  for (unsigned char i = 0; i < 10; i++) {
+    keys.emplace_back(dev::h256::random());
+    if (i % 3 != 0) {
+      BOOST_CHECK_EQUAL(bodies.Insert(keys.back(), vector<unsigned char>{i}),
+                        0);
+    }
+  }
+
+  // Values come back in the order of the keys, empty where absent
+  vector<string> values = bodies.BatchLookup(keys);
+  BOOST_REQUIRE_EQUAL(values.size(), keys.size());
+  for (unsigned char i = 0; i < 10; i++) {
+    BOOST_CHECK(values[i] == (i % 3 != 0 ? string(1, i) : string()));
+    BOOST_CHECK(values[i] == bodies.Lookup(keys[i]));
+  }
+
+  BOOST_CHECK(bodies.BatchLookup({}).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
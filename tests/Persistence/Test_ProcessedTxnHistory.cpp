@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#include <string>
+#include <vector>
+
+#include "libCrypto/Schnorr.h"
+#include "libData/AccountData/Address.h"
+#include "libPersistence/ProcessedTxnHistory.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE processedtxnhistorytest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+ProcessedTxnHistory::TxnMap dummyTxns(uint64_t epoch, unsigned int count,
+                                      vector<TxnHash>& hashes) {
+  ProcessedTxnHistory::TxnMap txns;
+  Address addr;
+  for (unsigned int i = 0; i < count; i++) {
+    TransactionWithReceipt txn(
+        Transaction(0, epoch * 1000 + i, addr,
+                    Schnorr::GetInstance().GenKeyPair(), 0, 1, 2, {}, {}),
+        TransactionReceipt());
+    hashes.emplace_back(txn.GetTransaction().GetTranID());
+    txns.emplace(hashes.back(), move(txn));
+  }
+  return txns;
+}
+
+BOOST_AUTO_TEST_SUITE(processedtxnhistorytest)
+
+BOOST_AUTO_TEST_CASE(testSpillAndRetention) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  ProcessedTxnHistory history("testProcessedTxns", 2, 3);
+
+  vector<vector<TxnHash>> hashes(8);
+  for (uint64_t epoch = 1; epoch <= 3; epoch++) {
+    history.Put(epoch, dummyTxns(epoch, 10, hashes[epoch]));
+  }
+
+  // Epoch 1 went to disk, epochs 2 and 3 are still in memory
+  BOOST_CHECK_EQUAL(history.GetNumEpochs(), 3);
+  BOOST_CHECK_GT(history.GetDiskUsage(), 0);
+
+  TransactionWithReceipt txn;
+  for (uint64_t epoch = 1; epoch <= 3; epoch++) {
+    for (const auto& hash : hashes[epoch]) {
+      BOOST_CHECK(history.Find(epoch, hash, txn));
+      BOOST_CHECK_EQUAL(txn.GetTransaction().GetTranID(), hash);
+    }
+  }
+  BOOST_CHECK(!history.Find(2, hashes[1].front(), txn));
+  BOOST_CHECK(!history.Find(4, hashes[1].front(), txn));
+
+  for (uint64_t epoch = 4; epoch <= 7; epoch++) {
+    history.Put(epoch, dummyTxns(epoch, 10, hashes[epoch]));
+  }
+
+  // Epochs 1 and 2 fell out of the disk retention
+  BOOST_CHECK_EQUAL(history.GetNumEpochs(), 5);
+  BOOST_CHECK(!history.Find(1, hashes[1].front(), txn));
+  BOOST_CHECK(!history.Find(2, hashes[2].front(), txn));
+  BOOST_CHECK(history.Find(3, hashes[3].back(), txn));
+  BOOST_CHECK(history.Find(7, hashes[7].back(), txn));
+}
+
+BOOST_AUTO_TEST_CASE(testEraseAndClear) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  ProcessedTxnHistory history("testProcessedTxns", 1, 2);
+
+  vector<vector<TxnHash>> hashes(3);
+  for (uint64_t epoch = 0; epoch < 3; epoch++) {
+    history.Put(epoch, dummyTxns(epoch, 5, hashes[epoch]));
+  }
+  const uint64_t memoryUsage = history.GetMemoryUsage();
+  const uint64_t diskUsage = history.GetDiskUsage();
+
+  TransactionWithReceipt txn;
+  history.Erase(0);
+  BOOST_CHECK(!history.Find(0, hashes[0].front(), txn));
+  BOOST_CHECK_LT(history.GetDiskUsage(), diskUsage);
+  BOOST_CHECK_LT(history.GetMemoryUsage(), memoryUsage);
+
+  history.Erase(2);
+  BOOST_CHECK(!history.Find(2, hashes[2].front(), txn));
+  BOOST_CHECK(history.Find(1, hashes[1].front(), txn));
+
+  // Putting an epoch again replaces it
+  vector<TxnHash> newHashes;
+  history.Put(1, dummyTxns(10, 5, newHashes));
+  BOOST_CHECK(!history.Find(1, hashes[1].front(), txn));
+  BOOST_CHECK(history.Find(1, newHashes.front(), txn));
+
+  history.Clear();
+  BOOST_CHECK_EQUAL(history.GetNumEpochs(), 0);
+  BOOST_CHECK_EQUAL(history.GetMemoryUsage(), 0);
+  BOOST_CHECK_EQUAL(history.GetDiskUsage(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
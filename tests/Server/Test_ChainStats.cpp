@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#include "libServer/ChainStats.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE chainstatstest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+const uint64_t BLOCK_INTERVAL_US = 10000000;
+const uint64_t NUM_TX_BLOCKS = 11;
+const uint64_t NUM_DS_BLOCKS = 3;
+
+// Block i holds i transactions; a DS epoch spans 4 Tx blocks
+ChainStats::TxBlockInfo makeTxBlock(uint64_t blockNum) {
+  return {blockNum, blockNum / 4, blockNum * BLOCK_INTERVAL_US,
+          (uint32_t)blockNum};
+}
+
+bool loadTxBlock(const uint64_t& blockNum, ChainStats::TxBlockInfo& info) {
+  if (blockNum >= NUM_TX_BLOCKS) {
+    return false;
+  }
+  info = makeTxBlock(blockNum);
+  return true;
+}
+
+bool loadDSBlock(const uint64_t& blockNum, uint64_t& timestamp) {
+  if (blockNum >= NUM_DS_BLOCKS) {
+    return false;
+  }
+  timestamp = blockNum * 4 * BLOCK_INTERVAL_US;
+  return true;
+}
+
+void checkFullChain(const ChainStats& stats) {
+  BOOST_CHECK_EQUAL(stats.GetNumTransactions(), 55);
+  BOOST_CHECK_CLOSE(stats.GetTransactionRate(1), 1.0, 1e-9);
+  BOOST_CHECK_CLOSE(stats.GetTransactionRate(2), 0.95, 1e-9);
+  BOOST_CHECK_CLOSE(stats.GetTxBlockRate(), 11.0 / 90, 1e-9);
+  BOOST_CHECK_CLOSE(stats.GetDSBlockRate(), 3.0 / 40, 1e-9);
+  BOOST_CHECK_EQUAL(stats.GetNumTxnsDSEpoch(), 8 + 9 + 10);
+  BOOST_CHECK_EQUAL(stats.GetNumTxnsTxEpoch(), 10);
+}
+
+BOOST_AUTO_TEST_SUITE(chainstatstest)
+
+BOOST_AUTO_TEST_CASE(testIncremental) {
+  INIT_STDOUT_LOGGER();
+  LOG_MARKER();
+
+  ChainStats stats(2);
+  BOOST_CHECK_EQUAL(stats.GetTransactionRate(1), 0);
+  BOOST_CHECK_EQUAL(stats.GetTxBlockRate(), 0);
+
+  for (uint64_t i = 0; i < NUM_TX_BLOCKS; i++) {
+    stats.AddTxBlock(makeTxBlock(i));
+  }
+  for (uint64_t i = 0; i < NUM_DS_BLOCKS; i++) {
+    uint64_t timestamp = 0;
+    loadDSBlock(i, timestamp);
+    stats.AddDSBlock(i, timestamp);
+  }
+  BOOST_CHECK(!stats.NeedsBackfill());
+  checkFullChain(stats);
+
+  // Blocks reported twice are ignored
+  stats.AddTxBlock(makeTxBlock(NUM_TX_BLOCKS - 1));
+  checkFullChain(stats);
+}
+
+BOOST_AUTO_TEST_CASE(testBackfill) {
+  INIT_STDOUT_LOGGER();
+  LOG_MARKER();
+
+  // Nothing committed since start-up
+  ChainStats fromScratch(2);
+  BOOST_CHECK(fromScratch.NeedsBackfill());
+  fromScratch.Backfill(NUM_TX_BLOCKS - 1, NUM_DS_BLOCKS - 1, loadTxBlock,
+                       loadDSBlock);
+  BOOST_CHECK(!fromScratch.NeedsBackfill());
+  checkFullChain(fromScratch);
+
+  // Blocks missed before start-up and during a sync
+  ChainStats withGaps(2);
+  withGaps.AddTxBlock(makeTxBlock(5));
+  withGaps.AddTxBlock(makeTxBlock(6));
+  withGaps.AddTxBlock(makeTxBlock(9));
+  withGaps.AddTxBlock(makeTxBlock(10));
+  withGaps.AddDSBlock(2, 2 * 4 * BLOCK_INTERVAL_US);
+  BOOST_CHECK(withGaps.NeedsBackfill());
+  withGaps.Backfill(0, 0, loadTxBlock, loadDSBlock);
+  BOOST_CHECK(!withGaps.NeedsBackfill());
+  checkFullChain(withGaps);
+}
+
+BOOST_AUTO_TEST_CASE(testBackfillFailure) {
+  INIT_STDOUT_LOGGER();
+  LOG_MARKER();
+
+  ChainStats stats(2);
+  stats.AddTxBlock(makeTxBlock(NUM_TX_BLOCKS + 1));
+  stats.Backfill(0, 0, loadTxBlock, loadDSBlock);
+
+  // Not retried until another block is committed
+  BOOST_CHECK(!stats.NeedsBackfill());
+  BOOST_CHECK_EQUAL(stats.GetNumTransactions(), 55 + NUM_TX_BLOCKS + 1);
+  stats.AddTxBlock(makeTxBlock(NUM_TX_BLOCKS + 2));
+  BOOST_CHECK(stats.NeedsBackfill());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#include <string>
+
+#include "libServer/ResponseCache.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE responsecachetest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+Json::Value makeResponse(unsigned int i) {
+  Json::Value _json;
+  _json["BlockNum"] = to_string(i);
+  _json["Payload"] = string(100, 'a');
+  return _json;
+}
+
+BOOST_AUTO_TEST_SUITE(responsecachetest)
+
+BOOST_AUTO_TEST_CASE(testGetPut) {
+  INIT_STDOUT_LOGGER();
+  LOG_MARKER();
+
+  ResponseCache cache(1024 * 1024);
+  BOOST_CHECK(cache.Get("GetTxBlock", "1") == nullptr);
+
+  cache.Put("GetTxBlock", "1", makeResponse(1));
+  auto cached = cache.Get("GetTxBlock", "1");
+  BOOST_REQUIRE(cached != nullptr);
+  BOOST_CHECK(*cached == makeResponse(1));
+
+  // Keys are per method
+  BOOST_CHECK(cache.Get("GetDsBlock", "1") == nullptr);
+
+  // Replacing an entry does not grow the cache
+  const size_t size = cache.GetSize();
+  cache.Put("GetTxBlock", "1", makeResponse(1));
+  BOOST_CHECK_EQUAL(cache.GetSize(), size);
+  BOOST_CHECK_EQUAL(cache.GetNumEntries(), 1);
+
+  cache.Clear();
+  BOOST_CHECK(cache.Get("GetTxBlock", "1") == nullptr);
+  BOOST_CHECK_EQUAL(cache.GetSize(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(testEviction) {
+  INIT_STDOUT_LOGGER();
+  LOG_MARKER();
+
+  ResponseCache probe(1024 * 1024);
+  probe.Put("GetTxBlock", "0", makeResponse(0));
+  const size_t entrySize = probe.GetSize();
+
+  // Room for four entries
+  ResponseCache cache(entrySize * 4 + entrySize / 2);
+  for (unsigned int i = 0; i < 4; i++) {
+    cache.Put("GetTxBlock", to_string(i), makeResponse(i));
+  }
+
+  // Touch the oldest entry so that the second oldest is evicted next
+  BOOST_REQUIRE(cache.Get("GetTxBlock", "0") != nullptr);
+  cache.Put("GetTxBlock", "4", makeResponse(4));
+
+  BOOST_CHECK_EQUAL(cache.GetNumEntries(), 4);
+  BOOST_CHECK(cache.GetSize() <= entrySize * 4 + entrySize / 2);
+  BOOST_CHECK(cache.Get("GetTxBlock", "0") != nullptr);
+  BOOST_CHECK(cache.Get("GetTxBlock", "1") == nullptr);
+  BOOST_CHECK(cache.Get("GetTxBlock", "4") != nullptr);
+
+  // A disabled cache stores nothing
+  ResponseCache disabled(0);
+  disabled.Put("GetTxBlock", "0", makeResponse(0));
+  BOOST_CHECK(disabled.Get("GetTxBlock", "0") == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(testStats) {
+  INIT_STDOUT_LOGGER();
+  LOG_MARKER();
+
+  ResponseCache cache(1024 * 1024);
+  cache.RecordRequest("GetTransaction", false, 300);
+  cache.RecordRequest("GetTransaction", true, 10);
+  cache.RecordRequest("GetTransaction", true, 20);
+
+  auto stats = cache.GetStats();
+  BOOST_REQUIRE(stats.find("GetTransaction") != stats.end());
+  BOOST_CHECK_EQUAL(stats["GetTransaction"].hits, 2);
+  BOOST_CHECK_EQUAL(stats["GetTransaction"].misses, 1);
+  BOOST_CHECK_EQUAL(stats["GetTransaction"].hitLatencyUs, 30);
+  BOOST_CHECK_EQUAL(stats["GetTransaction"].missLatencyUs, 300);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "libServer/SubscriptionServer.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE subscriptionservertest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+const unsigned int TEST_PORT = 14202;
+
+/// Connects without sending anything; returns the socket.
+int connectToServer() {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  struct timeval timeout = {5, 0};
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+  struct sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(TEST_PORT);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  BOOST_REQUIRE(connect(fd, (struct sockaddr*)&addr, sizeof(addr)) == 0);
+  return fd;
+}
+
+/// Connects and sends the request; returns the socket.
+int subscribe(const string& target) {
+  int fd = connectToServer();
+  string request = "GET " + target + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+  BOOST_REQUIRE(send(fd, request.data(), request.size(), 0) ==
+                (ssize_t)request.size());
+  return fd;
+}
+
+/// Reads until the delimiter (inclusive) or the connection closes.
+string readUntil(int fd, const string& delimiter) {
+  string data;
+  char c;
+  while (data.size() < delimiter.size() ||
+         data.compare(data.size() - delimiter.size(), delimiter.size(),
+                      delimiter) != 0) {
+    if (recv(fd, &c, 1, 0) != 1) {
+      break;
+    }
+    data += c;
+  }
+  return data;
+}
+
+/// Reads one chunk of the stream and returns its payload.
+string readEvent(int fd) {
+  string size = readUntil(fd, "\r\n");
+  string payload = readUntil(fd, "\n");
+  readUntil(fd, "\r\n");
+  BOOST_CHECK_EQUAL(stoul(size, nullptr, 16), payload.size());
+  return payload;
+}
+
+void waitForSubscribers(const SubscriptionServer& server, unsigned int num) {
+  for (unsigned int i = 0; i < 500 && server.GetNumSubscribers() != num; i++) {
+    this_thread::sleep_for(chrono::milliseconds(10));
+  }
+  BOOST_REQUIRE_EQUAL(server.GetNumSubscribers(), num);
+}
+
+Json::Value makeEvent(const string& type, unsigned int i) {
+  Json::Value event;
+  event["type"] = type;
+  event["index"] = i;
+  return event;
+}
+
+BOOST_AUTO_TEST_SUITE(subscriptionservertest)
+
+BOOST_AUTO_TEST_CASE(testFilters) {
+  INIT_STDOUT_LOGGER();
+  LOG_MARKER();
+
+  SubscriptionServer server(100, 10, 10);
+  BOOST_REQUIRE(server.Start(TEST_PORT));
+
+  const Address watched = Address::random();
+  int all = subscribe("/subscribe");
+  int txns = subscribe("/subscribe?events=Txn&address=0x" + watched.hex());
+  BOOST_CHECK(readUntil(all, "\r\n\r\n").find("200 OK") != string::npos);
+  BOOST_CHECK(readUntil(txns, "\r\n\r\n").find("200 OK") != string::npos);
+  waitForSubscribers(server, 2);
+
+  server.Publish(SubscriptionServer::TX_BLOCK, makeEvent("TxBlock", 1));
+  server.Publish(SubscriptionServer::TXN, makeEvent("Txn", 2),
+                 {Address::random(), Address::random()});
+  server.Publish(SubscriptionServer::TXN, makeEvent("Txn", 3),
+                 {Address::random(), watched});
+
+  BOOST_CHECK(readEvent(all).find("\"index\":1") != string::npos);
+  BOOST_CHECK(readEvent(all).find("\"index\":2") != string::npos);
+  BOOST_CHECK(readEvent(all).find("\"index\":3") != string::npos);
+  BOOST_CHECK(readEvent(txns).find("\"index\":3") != string::npos);
+
+  close(all);
+  close(txns);
+  waitForSubscribers(server, 0);
+  server.Stop();
+}
+
+BOOST_AUTO_TEST_CASE(testBadRequests) {
+  INIT_STDOUT_LOGGER();
+  LOG_MARKER();
+
+  SubscriptionServer server(100, 10, 10);
+  BOOST_REQUIRE(server.Start(TEST_PORT));
+
+  int fd = subscribe("/other");
+  BOOST_CHECK(readUntil(fd, "\r\n\r\n").find("404") != string::npos);
+  close(fd);
+
+  fd = subscribe("/subscribe?events=Unknown");
+  BOOST_CHECK(readUntil(fd, "\r\n\r\n").find("400") != string::npos);
+  close(fd);
+
+  fd = subscribe("/subscribe?address=1234");
+  BOOST_CHECK(readUntil(fd, "\r\n\r\n").find("400") != string::npos);
+  close(fd);
+
+  BOOST_CHECK_EQUAL(server.GetNumSubscribers(), 0);
+  server.Stop();
+}
+
+BOOST_AUTO_TEST_CASE(testSlowConsumerDisconnected) {
+  INIT_STDOUT_LOGGER();
+  LOG_MARKER();
+
+  SubscriptionServer server(10, 10, 10);
+  BOOST_REQUIRE(server.Start(TEST_PORT));
+
+  int slow = subscribe("/subscribe?events=TxBlock");
+  BOOST_CHECK(readUntil(slow, "\r\n\r\n").find("200 OK") != string::npos);
+  waitForSubscribers(server, 1);
+
+  // Large events fill the socket buffers, then the queue, while the client
+  // reads nothing
+  Json::Value event = makeEvent("TxBlock", 0);
+  event["payload"] = string(1024 * 1024, 'a');
+  for (unsigned int i = 0; i < 100 && server.GetNumSubscribers() > 0; i++) {
+    server.Publish(SubscriptionServer::TX_BLOCK, event);
+    this_thread::sleep_for(chrono::milliseconds(10));
+  }
+  waitForSubscribers(server, 0);
+
+  close(slow);
+  server.Stop();
+}
+
+BOOST_AUTO_TEST_CASE(testIdleClientDisconnected) {
+  INIT_STDOUT_LOGGER();
+  LOG_MARKER();
+
+  SubscriptionServer server(100, 1, 1);
+  BOOST_REQUIRE(server.Start(TEST_PORT));
+
+  // A connection that never sends its request holds the only slot
+  int idle = connectToServer();
+  this_thread::sleep_for(chrono::milliseconds(100));
+  int rejected = subscribe("/subscribe");
+  BOOST_CHECK(readUntil(rejected, "\r\n\r\n").find("503") != string::npos);
+  close(rejected);
+
+  // until it misses the request deadline and is closed
+  BOOST_CHECK(readUntil(idle, "\r\n\r\n").empty());
+  close(idle);
+
+  int fd = subscribe("/subscribe");
+  BOOST_CHECK(readUntil(fd, "\r\n\r\n").find("200 OK") != string::npos);
+  waitForSubscribers(server, 1);
+
+  close(fd);
+  server.Stop();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#include <zstd.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "libUtils/Compression.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE compression
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace {
+/// Repetitive payload resembling a serialized batch of accounts
+vector<unsigned char> GetPayload(size_t size) {
+  vector<unsigned char> payload(size);
+  for (size_t i = 0; i < size; i++) {
+    payload[i] = (i % 97 < 20) ? (unsigned char)(i / 97) : (unsigned char)i;
+  }
+  return payload;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(compression)
+
+BOOST_AUTO_TEST_CASE(test_RoundTrip) {
+  INIT_STDOUT_LOGGER();
+  LOG_MARKER();
+
+  const vector<unsigned char> payload = GetPayload(1 << 20);
+
+  // Compressed output is appended after existing content
+  vector<unsigned char> compressed = {0xAB};
+  BOOST_REQUIRE(
+      Compression::Compress(payload.data(), payload.size(), 1, compressed));
+  BOOST_CHECK_EQUAL(compressed[0], 0xAB);
+  BOOST_CHECK_LT(compressed.size(), payload.size() / 2);
+
+  vector<unsigned char> decompressed;
+  BOOST_REQUIRE(Compression::Decompress(compressed.data() + 1,
+                                        compressed.size() - 1, payload.size(),
+                                        decompressed));
+  BOOST_CHECK(decompressed == payload);
+}
+
+BOOST_AUTO_TEST_CASE(test_StreamInPieces) {
+  INIT_STDOUT_LOGGER();
+  LOG_MARKER();
+
+  const vector<unsigned char> payload = GetPayload(3 << 20);
+  vector<unsigned char> compressed;
+  BOOST_REQUIRE(
+      Compression::Compress(payload.data(), payload.size(), 3, compressed));
+
+  for (size_t pieceSize : {1, 7, 4096, 65536}) {
+    StreamDecompressor decompressor(payload.size());
+    vector<unsigned char> decompressed;
+    for (size_t offset = 0; offset < compressed.size(); offset += pieceSize) {
+      BOOST_REQUIRE(decompressor.Update(
+          compressed.data() + offset,
+          min(pieceSize, compressed.size() - offset), decompressed));
+    }
+    BOOST_CHECK(decompressor.Finished());
+    BOOST_CHECK(decompressed == payload);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_Rejects) {
+  INIT_STDOUT_LOGGER();
+  LOG_MARKER();
+
+  const vector<unsigned char> payload = GetPayload(100000);
+  vector<unsigned char> compressed;
+  BOOST_REQUIRE(
+      Compression::Compress(payload.data(), payload.size(), 1, compressed));
+  vector<unsigned char> decompressed;
+
+  // Output larger than allowed
+  BOOST_CHECK(!Compression::Decompress(compressed.data(), compressed.size(),
+                                       payload.size() - 1, decompressed));
+
+  // Truncated frame
+  decompressed.clear();
+  BOOST_CHECK(!Compression::Decompress(compressed.data(),
+                                       compressed.size() - 1, payload.size(),
+                                       decompressed));
+
+  // Trailing bytes after the frame
+  vector<unsigned char> trailing(compressed);
+  trailing.push_back(0x00);
+  decompressed.clear();
+  BOOST_CHECK(!Compression::Decompress(trailing.data(), trailing.size(),
+                                       payload.size(), decompressed));
+
+  // Not a compressed frame
+  decompressed.clear();
+  BOOST_CHECK(!Compression::Decompress(payload.data(), payload.size(),
+                                       payload.size(), decompressed));
+}
+
+BOOST_AUTO_TEST_CASE(test_RejectsLargeWindow) {
+  INIT_STDOUT_LOGGER();
+  LOG_MARKER();
+
+  // A frame streamed without its size declares the whole window, however
+  // little it decompresses to
+  const vector<unsigned char> payload = GetPayload(1000);
+  vector<unsigned char> compressed(ZSTD_compressBound(payload.size()) + 64);
+  ZSTD_CCtx* cctx = ZSTD_createCCtx();
+  BOOST_REQUIRE(cctx != nullptr);
+  ZSTD_CCtx_setParameter(cctx, ZSTD_c_windowLog, 24);
+  ZSTD_outBuffer output = {compressed.data(), compressed.size(), 0};
+  ZSTD_inBuffer input = {payload.data(), payload.size(), 0};
+  BOOST_REQUIRE(
+      !ZSTD_isError(ZSTD_compressStream2(cctx, &output, &input,
+                                         ZSTD_e_continue)));
+  ZSTD_inBuffer end = {nullptr, 0, 0};
+  BOOST_REQUIRE_EQUAL(ZSTD_compressStream2(cctx, &output, &end, ZSTD_e_end),
+                      0);
+  ZSTD_freeCCtx(cctx);
+  compressed.resize(output.pos);
+
+  vector<unsigned char> decompressed;
+  BOOST_CHECK(!Compression::Decompress(compressed.data(), compressed.size(),
+                                       1 << 16, decompressed));
+
+  decompressed.clear();
+  BOOST_CHECK(Compression::Decompress(compressed.data(), compressed.size(),
+                                      1 << 24, decompressed));
+  BOOST_CHECK(decompressed == payload);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
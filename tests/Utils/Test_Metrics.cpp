@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#include <string>
+#include <thread>
+#include <vector>
+#include "libUtils/Logger.h"
+#include "libUtils/Metrics.h"
+
+#define BOOST_TEST_MODULE metrics
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(metrics)
+
+BOOST_AUTO_TEST_CASE(test_HistogramBuckets) {
+  INIT_STDOUT_LOGGER();
+  LOG_MARKER();
+
+  // Small values are exact
+  for (uint64_t value = 0; value < 32; value++) {
+    BOOST_CHECK_EQUAL(MetricHistogram::GetBucketUpperBound(
+                          MetricHistogram::GetBucketIndex(value)),
+                      value);
+  }
+
+  // Larger ones are within the bucket precision
+  for (uint64_t value = 32; value < 1000000; value += 7) {
+    uint64_t upper = MetricHistogram::GetBucketUpperBound(
+        MetricHistogram::GetBucketIndex(value));
+    BOOST_CHECK_GE(upper, value);
+    BOOST_CHECK_LE(upper - value, value / 16);
+  }
+
+  // Buckets are contiguous
+  for (unsigned int index = 0; index < MetricHistogram::NUM_BUCKETS - 1;
+       index++) {
+    BOOST_CHECK_EQUAL(MetricHistogram::GetBucketIndex(
+                          MetricHistogram::GetBucketUpperBound(index) + 1),
+                      index + 1);
+  }
+
+  BOOST_CHECK_EQUAL(MetricHistogram::GetBucketIndex(UINT64_MAX),
+                    MetricHistogram::NUM_BUCKETS - 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_HistogramQuantiles) {
+  INIT_STDOUT_LOGGER();
+  LOG_MARKER();
+
+  MetricHistogram histogram;
+  for (uint64_t value = 1; value <= 1000; value++) {
+    histogram.Record(value);
+  }
+
+  MetricHistogram::Snapshot snapshot = histogram.GetSnapshot();
+  BOOST_CHECK_EQUAL(snapshot.count, 1000);
+  BOOST_CHECK_EQUAL(snapshot.sum, 500500);
+  BOOST_CHECK_EQUAL(snapshot.max, 1000);
+  BOOST_CHECK_EQUAL(snapshot.GetQuantile(1.0), 1000);
+
+  uint64_t median = snapshot.GetQuantile(0.5);
+  BOOST_CHECK_GE(median, 500);
+  BOOST_CHECK_LE(median, 500 + 500 / 16);
+
+  uint64_t p99 = snapshot.GetQuantile(0.99);
+  BOOST_CHECK_GE(p99, 990);
+  BOOST_CHECK_LE(p99, 1000);
+}
+
+BOOST_AUTO_TEST_CASE(test_ConcurrentUpdates) {
+  INIT_STDOUT_LOGGER();
+  LOG_MARKER();
+
+  const unsigned int NUM_THREADS = 16;
+  const unsigned int NUM_UPDATES = 10000;
+
+  MetricCounter& counter =
+      Metrics::GetInstance().GetCounter("test_updates_total", "Test counter");
+  MetricHistogram& histogram =
+      Metrics::GetInstance().GetHistogram("test_latency_seconds", "Test");
+
+  vector<thread> threads;
+  for (unsigned int i = 0; i < NUM_THREADS; i++) {
+    threads.emplace_back([&counter, &histogram]() {
+      for (unsigned int j = 0; j < NUM_UPDATES; j++) {
+        counter.Increment();
+        histogram.Record(j);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  BOOST_CHECK_EQUAL(counter.Get(), NUM_THREADS * NUM_UPDATES);
+  BOOST_CHECK_EQUAL(histogram.GetSnapshot().count, NUM_THREADS * NUM_UPDATES);
+
+  // Looking the metric up again returns the same one
+  BOOST_CHECK_EQUAL(
+      &Metrics::GetInstance().GetCounter("test_updates_total", "Test counter"),
+      &counter);
+}
+
+BOOST_AUTO_TEST_CASE(test_ExportPrometheus) {
+  INIT_STDOUT_LOGGER();
+  LOG_MARKER();
+
+  Metrics::GetInstance()
+      .GetGauge("test_queue_depth", "Test gauge", "queue=\"send\"")
+      .Set(42);
+  Metrics::GetInstance().RecordPhase(EpochPhase::MICROBLOCK_COMPOSITION,
+                                     chrono::microseconds(1500000));
+  Metrics::GetInstance().StartPhase(EpochPhase::FINALBLOCK_CONSENSUS);
+  Metrics::GetInstance().EndPhase(EpochPhase::FINALBLOCK_CONSENSUS);
+  // Ending a phase that was not started is ignored
+  Metrics::GetInstance().EndPhase(EpochPhase::FINALBLOCK_CONSENSUS);
+
+  string output = Metrics::GetInstance().ExportPrometheus();
+
+  BOOST_CHECK(output.find("# TYPE test_queue_depth gauge\n") != string::npos);
+  BOOST_CHECK(output.find("test_queue_depth{queue=\"send\"} 42\n") !=
+              string::npos);
+  BOOST_CHECK(output.find("# TYPE zilliqa_epoch_phase_duration_seconds "
+                          "summary\n") != string::npos);
+  BOOST_CHECK(output.find("zilliqa_epoch_phase_duration_seconds{phase="
+                          "\"microblock_composition\",quantile=\"1\"} "
+                          "1.500000\n") != string::npos);
+  BOOST_CHECK(output.find("zilliqa_epoch_phase_duration_seconds_count{phase="
+                          "\"microblock_composition\"} 1\n") != string::npos);
+  BOOST_CHECK(output.find("zilliqa_epoch_phase_duration_seconds_count{phase="
+                          "\"finalblock_consensus\"} 1\n") != string::npos);
+  BOOST_CHECK(output.find("zilliqa_epoch_phase_duration_seconds_count{phase="
+                          "\"pow\"} 0\n") != string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "libUtils/Logger.h"
+#include "libUtils/ParallelFor.h"
+#include "libUtils/ThreadPool.h"
+
+#define BOOST_TEST_MODULE parallelfor
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace {
+const size_t NUM_THREADS = 4;
+const size_t NUM_SUBMISSIONS = 64;
+
+// Stands in for a microblock submission: verification is stateless, while
+// merging rejects a second submission from the same shard
+struct Submission {
+  uint32_t shardId;
+  bool valid;
+};
+
+vector<Submission> GetSubmissions() {
+  vector<Submission> submissions;
+  for (size_t i = 0; i < NUM_SUBMISSIONS; i++) {
+    submissions.push_back(
+        {(uint32_t)(i % (NUM_SUBMISSIONS - 4)), (i % 7) != 3});
+  }
+  return submissions;
+}
+
+bool Verify(const Submission& submission, size_t index) {
+  // Later submissions finish first, so the workers complete out of order
+  this_thread::sleep_for(
+      chrono::microseconds(100 * (NUM_SUBMISSIONS - index)));
+  return submission.valid;
+}
+
+// Merges through the given function and returns the merged indexes, in the
+// order they were merged
+vector<size_t> Merge(
+    const vector<Submission>& submissions,
+    const function<size_t(const function<bool(size_t)>&,
+                          const function<bool(size_t)>&)>& verifyThenMerge) {
+  set<uint32_t> shards;
+  vector<size_t> merged;
+  const size_t numMerged = verifyThenMerge(
+      [&submissions](size_t i) { return Verify(submissions.at(i), i); },
+      [&submissions, &shards, &merged](size_t i) {
+        if (!shards.insert(submissions.at(i).shardId).second) {
+          return false;
+        }
+        merged.emplace_back(i);
+        return true;
+      });
+  BOOST_CHECK_EQUAL(numMerged, merged.size());
+  return merged;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(parallelfor)
+
+BOOST_AUTO_TEST_CASE(test_parallel_for_covers_every_index) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  ThreadPool pool(NUM_THREADS, "TestPool");
+  mutex poolMutex;
+
+  // Each index is written by exactly one worker, so no locking is needed
+  vector<unsigned int> calls(1000, 0);
+  ParallelFor(pool, poolMutex, calls.size(),
+              [&calls](size_t i) { calls[i]++; });
+
+  BOOST_CHECK(all_of(calls.begin(), calls.end(),
+                     [](unsigned int count) { return count == 1; }));
+}
+
+BOOST_AUTO_TEST_CASE(test_verify_then_merge_keeps_order) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  ThreadPool pool(NUM_THREADS, "TestPool");
+  mutex poolMutex;
+
+  vector<Submission> submissions = GetSubmissions();
+  for (auto& submission : submissions) {
+    submission.valid = true;
+  }
+  submissions.resize(NUM_SUBMISSIONS - 4);
+
+  const vector<size_t> merged = Merge(
+      submissions, [&pool, &poolMutex, &submissions](
+                       const function<bool(size_t)>& verify,
+                       const function<bool(size_t)>& merge) {
+        return ParallelVerifyThenMerge(pool, poolMutex, submissions.size(),
+                                       verify, merge);
+      });
+
+  vector<size_t> expected(submissions.size());
+  iota(expected.begin(), expected.end(), 0);
+  BOOST_CHECK(merged == expected);
+}
+
+BOOST_AUTO_TEST_CASE(test_verify_then_merge_matches_serial_path) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  ThreadPool pool(NUM_THREADS, "TestPool");
+  mutex poolMutex;
+
+  // Some submissions fail verification, and the last few repeat a shard
+  const vector<Submission> submissions = GetSubmissions();
+
+  const vector<size_t> parallel = Merge(
+      submissions, [&pool, &poolMutex, &submissions](
+                       const function<bool(size_t)>& verify,
+                       const function<bool(size_t)>& merge) {
+        return ParallelVerifyThenMerge(pool, poolMutex, submissions.size(),
+                                       verify, merge);
+      });
+
+  // Verify and merge each submission as it arrives
+  const vector<size_t> serial = Merge(
+      submissions, [&submissions](const function<bool(size_t)>& verify,
+                                  const function<bool(size_t)>& merge) {
+        size_t numMerged = 0;
+        for (size_t i = 0; i < submissions.size(); i++) {
+          if (verify(i) && merge(i)) {
+            numMerged++;
+          }
+        }
+        return numMerged;
+      });
+
+  BOOST_CHECK(parallel == serial);
+  for (const auto& index : parallel) {
+    BOOST_CHECK_MESSAGE(submissions.at(index).valid,
+                        "Submission " << index << " merged but invalid");
+  }
+
+  // Submission 3 is rejected, so the later one from its shard still goes in,
+  // while the repeat of shard 0 does not
+  auto isMerged = [&parallel](size_t index) {
+    return find(parallel.begin(), parallel.end(), index) != parallel.end();
+  };
+  BOOST_CHECK(!isMerged(3));
+  BOOST_CHECK(isMerged(NUM_SUBMISSIONS - 1));
+  BOOST_CHECK(!isMerged(NUM_SUBMISSIONS - 4));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
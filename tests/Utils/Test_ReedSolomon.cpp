@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#include <random>
+#include <vector>
+#include "libUtils/Logger.h"
+#include "libUtils/ReedSolomon.h"
+
+#define BOOST_TEST_MODULE reedsolomon
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace {
+vector<unsigned char> GetData(size_t size, unsigned int seed) {
+  mt19937 rng(seed);
+  vector<unsigned char> data(size);
+  for (auto& byte : data) {
+    byte = rng() & 0xFF;
+  }
+  return data;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(reedsolomon)
+
+BOOST_AUTO_TEST_CASE(test_AnySubsetDecodes) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  const unsigned int dataShards = 6;
+  const unsigned int parityShards = 4;
+  const vector<unsigned char> data = GetData(1000, 1);
+
+  vector<vector<unsigned char>> shards;
+  BOOST_REQUIRE(ReedSolomon::Encode(data, dataShards, parityShards, shards));
+  BOOST_REQUIRE_EQUAL(shards.size(), dataShards + parityShards);
+
+  // Every way of losing parityShards shards still leaves enough to decode
+  const unsigned int total = dataShards + parityShards;
+  for (unsigned int lost = 0; lost < (1u << total); lost++) {
+    if (__builtin_popcount(lost) != (int)parityShards) {
+      continue;
+    }
+    vector<vector<unsigned char>> received(shards);
+    for (unsigned int i = 0; i < total; i++) {
+      if (lost & (1u << i)) {
+        received[i].clear();
+      }
+    }
+
+    vector<unsigned char> decoded;
+    BOOST_REQUIRE(
+        ReedSolomon::Decode(received, dataShards, data.size(), decoded));
+    BOOST_CHECK_MESSAGE(decoded == data, "Wrong data when losing " << lost);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_MaxShards) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  const unsigned int dataShards = 200;
+  const unsigned int parityShards = ReedSolomon::MAX_SHARDS - dataShards;
+  const vector<unsigned char> data = GetData(12345, 2);
+
+  vector<vector<unsigned char>> shards;
+  BOOST_REQUIRE(ReedSolomon::Encode(data, dataShards, parityShards, shards));
+
+  // Keep only the parity shards and the last data shards
+  for (unsigned int i = 0; i < parityShards; i++) {
+    shards[i].clear();
+  }
+
+  vector<unsigned char> decoded;
+  BOOST_REQUIRE(ReedSolomon::Decode(shards, dataShards, data.size(), decoded));
+  BOOST_CHECK(decoded == data);
+}
+
+BOOST_AUTO_TEST_CASE(test_Rejects) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  const vector<unsigned char> data = GetData(100, 3);
+  vector<vector<unsigned char>> shards;
+
+  BOOST_CHECK(!ReedSolomon::Encode(data, 0, 4, shards));
+  BOOST_CHECK(!ReedSolomon::Encode(data, 200, 57, shards));
+
+  BOOST_REQUIRE(ReedSolomon::Encode(data, 4, 2, shards));
+  vector<unsigned char> decoded;
+
+  // Too many shards missing
+  vector<vector<unsigned char>> received(shards);
+  received[0].clear();
+  received[2].clear();
+  received[5].clear();
+  BOOST_CHECK(!ReedSolomon::Decode(received, 4, data.size(), decoded));
+
+  // Mismatched shard sizes
+  received = shards;
+  received[1].pop_back();
+  BOOST_CHECK(!ReedSolomon::Decode(received, 4, data.size(), decoded));
+
+  // Size beyond what the shards hold
+  BOOST_CHECK(!ReedSolomon::Decode(shards, 4, 1000, decoded));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
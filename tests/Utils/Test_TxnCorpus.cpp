@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#include <fstream>
+#include <thread>
+#include <vector>
+#include "libUtils/Logger.h"
+#include "libUtils/TxnCorpus.h"
+
+#define BOOST_TEST_MODULE txncorpus
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace {
+const string CORPUS_PATH = "Test_TxnCorpus.corpus";
+
+// Stand-in for a serialized txn; its length and bytes depend on the nonce
+vector<unsigned char> GetTxn(const Address& addr, uint64_t nonce) {
+  vector<unsigned char> txn(50 + nonce % 50, (unsigned char)nonce);
+  txn[0] = addr.asArray()[0];
+  return txn;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(txncorpus)
+
+BOOST_AUTO_TEST_CASE(test_PutAndGet) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  const vector<TxnCorpus::Range> ranges = {{Address::random(), 1, 1000},
+                                           {Address::random(), 501, 300},
+                                           {Address::random(), 1, 0}};
+
+  {
+    TxnCorpus corpus;
+    BOOST_REQUIRE(corpus.Create(CORPUS_PATH, 100, ranges));
+    BOOST_CHECK_EQUAL(corpus.GetNumTxns(), 1300);
+    BOOST_CHECK(corpus.GetStride() >= 100 + sizeof(uint32_t));
+
+    // Each range is filled by its own thread
+    vector<thread> writers;
+    vector<char> written(ranges.size(), true);
+    for (unsigned int i = 0; i < ranges.size(); i++) {
+      writers.emplace_back([&corpus, &range = ranges[i], &ok = written[i]]() {
+        for (uint64_t n = range.firstNonce;
+             n < range.firstNonce + range.numTxns; n++) {
+          vector<unsigned char> txn = GetTxn(range.addr, n);
+          ok = ok && corpus.Put(range.addr, n, txn.data(), txn.size());
+        }
+      });
+    }
+    for (auto& writer : writers) {
+      writer.join();
+    }
+    for (const auto& ok : written) {
+      BOOST_CHECK(ok);
+    }
+
+    // Outside the ranges, or too large for the stride
+    vector<unsigned char> txn(100);
+    BOOST_CHECK(!corpus.Put(ranges[0].addr, 0, txn.data(), txn.size()));
+    BOOST_CHECK(!corpus.Put(ranges[1].addr, 801, txn.data(), txn.size()));
+    BOOST_CHECK(!corpus.Put(Address::random(), 1, txn.data(), txn.size()));
+    txn.resize(corpus.GetStride());
+    BOOST_CHECK(!corpus.Put(ranges[0].addr, 1, txn.data(), txn.size()));
+  }
+
+  TxnCorpus corpus;
+  BOOST_REQUIRE(corpus.Open(CORPUS_PATH));
+  BOOST_CHECK_EQUAL(corpus.GetNumTxns(), 1300);
+
+  vector<TxnCorpus::Span> spans;
+  BOOST_REQUIRE(corpus.Get(ranges[0].addr, 990, 11, spans));
+  BOOST_REQUIRE(corpus.Get(ranges[1].addr, 501, 300, spans));
+  BOOST_REQUIRE_EQUAL(spans.size(), 311);
+  for (unsigned int i = 0; i < spans.size(); i++) {
+    const auto& addr = (i < 11) ? ranges[0].addr : ranges[1].addr;
+    const uint64_t nonce = (i < 11) ? 990 + i : 501 + i - 11;
+    vector<unsigned char> txn = GetTxn(addr, nonce);
+    BOOST_CHECK_EQUAL_COLLECTIONS(spans[i].first,
+                                  spans[i].first + spans[i].second,
+                                  txn.begin(), txn.end());
+  }
+
+  // A range that is not entirely present appends nothing
+  BOOST_CHECK(!corpus.Get(ranges[0].addr, 995, 10, spans));
+  BOOST_CHECK(!corpus.Get(ranges[1].addr, 500, 2, spans));
+  BOOST_CHECK(!corpus.Get(ranges[2].addr, 1, 1, spans));
+  BOOST_CHECK(!corpus.Get(Address::random(), 1, 1, spans));
+  BOOST_CHECK_EQUAL(spans.size(), 311);
+
+  // Read-only
+  vector<unsigned char> txn(10);
+  BOOST_CHECK(!corpus.Put(ranges[0].addr, 1, txn.data(), txn.size()));
+}
+
+BOOST_AUTO_TEST_CASE(test_MissingSlots) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  const Address addr = Address::random();
+
+  {
+    TxnCorpus corpus;
+    BOOST_REQUIRE(corpus.Create(CORPUS_PATH, 100, {{addr, 1, 10}}));
+    for (uint64_t n = 1; n <= 10; n++) {
+      if (n != 7) {
+        vector<unsigned char> txn = GetTxn(addr, n);
+        BOOST_CHECK(corpus.Put(addr, n, txn.data(), txn.size()));
+      }
+    }
+  }
+
+  TxnCorpus corpus;
+  BOOST_REQUIRE(corpus.Open(CORPUS_PATH));
+
+  vector<TxnCorpus::Span> spans;
+  BOOST_CHECK(corpus.Get(addr, 1, 6, spans));
+  BOOST_CHECK(corpus.Get(addr, 8, 3, spans));
+  BOOST_CHECK_EQUAL(spans.size(), 9);
+  BOOST_CHECK(!corpus.Get(addr, 5, 4, spans));
+  BOOST_CHECK_EQUAL(spans.size(), 9);
+}
+
+BOOST_AUTO_TEST_CASE(test_InvalidFile) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  {
+    ofstream file(CORPUS_PATH, ios::binary | ios::trunc);
+    file << "not a txn corpus, just some text";
+  }
+
+  TxnCorpus corpus;
+  BOOST_CHECK(!corpus.Open(CORPUS_PATH));
+  BOOST_CHECK(!corpus.IsOpen());
+  BOOST_CHECK(!corpus.Open(CORPUS_PATH + ".missing"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,119 @@
+#!/usr/bin/env python
+# Copyright (c) 2018 Zilliqa
+# This source code is being disclosed to you solely for the purpose of your
+# participation in testing Zilliqa. You may view, compile and run the code for
+# that purpose and pursuant to the protocols and algorithms that are programmed
+# into, and intended by, the code. You may not do anything else with the code
+# without express permission from Zilliqa Research Pte. Ltd., including
+# modifying or publishing the code (or any part of it), and developing or
+# forming another public or private blockchain network. This source code is
+# provided 'as is' and no warranties are given as to title or non-infringement,
+# merchantability or fitness for purpose and, to the extent permitted by law,
+# all liability for your use of the code is disclaimed. Some programs in this
+# code are governed by the GNU General Public License v3.0 (available at
+# https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+# are governed by GPLv3.0 are those programs that are located in the folders
+# src/depends and tests/depends and which include a reference to GPLv3 in their
+# program files.
+import glob
+import os
+import re
+import shutil
+import stat
+import sys
+import time
+
+from subprocess import Popen, PIPE
+
+NODE_LISTEN_PORT = 7001
+LOCAL_RUN_FOLDER = './sync_local_run/'
+NODE_FOLDER = LOCAL_RUN_FOLDER + 'node_0001'
+
+# Printed by Lookup::CommitTxBlocks for every block it stores
+COMMITTED_BLOCK_PATTERN = re.compile(r'GetBlockNum\(\): (\d+)')
+# Printed by the windowed sync once a whole range is committed
+WINDOWED_SYNC_PATTERN = re.compile(r'\[TxBlockSync\] Synced blocks (\d+) to (\d+) in (\d+) ms')
+
+def print_usage():
+	print ("Measuring how long a fresh node takes to sync with a local cluster\n"
+		"===================================================================\n"
+		"Usage:\n\tpython " + sys.argv[0] + " [command] [command parameters]\n"
+		"Available commands:\n"
+		"\tTest Execution:\n"
+		"\t\tsetup                       - Set up the syncing node\n"
+		"\t\tstart [num-blocks] [secs]   - Start the node and time the sync of num-blocks Tx blocks\n"
+		"\t\t                              (gives up after secs seconds)\n")
+
+def main():
+	numargs = len(sys.argv)
+	if (numargs < 2):
+		print_usage()
+	else:
+		command = sys.argv[1]
+		if (command == 'setup'):
+			print_usage() if (numargs != 2) else run_setup()
+		elif (command == 'start'):
+			print_usage() if (numargs != 4) else sys.exit(run_start(numblocks=int(sys.argv[2]), timeout=int(sys.argv[3])))
+		else:
+			print_usage()
+
+# ================
+# Helper Functions
+# ================
+
+def get_synced_block_num():
+	synced = 0
+	windowed = []
+	for logfile in glob.glob(NODE_FOLDER + '/zilliqa-*log*'):
+		with open(logfile) as f:
+			for line in f:
+				match = COMMITTED_BLOCK_PATTERN.search(line)
+				if match:
+					synced = max(synced, int(match.group(1)))
+				match = WINDOWED_SYNC_PATTERN.search(line)
+				if match:
+					windowed.append(match.groups())
+	return synced, windowed
+
+# ========================
+# Test Execution Functions
+# ========================
+
+def run_setup():
+	if (os.path.exists(LOCAL_RUN_FOLDER)):
+		shutil.rmtree(LOCAL_RUN_FOLDER)
+	os.makedirs(NODE_FOLDER)
+	shutil.copyfile('./tests/Zilliqa/zilliqa', NODE_FOLDER + '/synczilliqa')
+
+	st = os.stat(NODE_FOLDER + '/synczilliqa')
+	os.chmod(NODE_FOLDER + '/synczilliqa', st.st_mode | stat.S_IEXEC)
+
+	print '[Node 1  ] [Port ' + str(NODE_LISTEN_PORT) + '] ' + NODE_FOLDER
+
+def run_start(numblocks, timeout):
+	process = Popen(["./tests/Zilliqa/genkeypair"], stdout=PIPE)
+	(output, err) = process.communicate()
+	process.wait()
+	keypair = output.split(" ")
+
+	shutil.copyfile('constants_local.xml', NODE_FOLDER + '/constants.xml')
+	shutil.copyfile('dsnodes.xml', NODE_FOLDER + '/dsnodes.xml')
+
+	start = time.time()
+	os.system('cd ' + NODE_FOLDER + '; echo \"' + keypair[0] + ' ' + keypair[1] + '\" > mykey.txt' + '; ulimit -n 65535; ulimit -Sc unlimited; ulimit -Hc unlimited; $(pwd)/synczilliqa ' + keypair[1] + ' ' + keypair[0] + ' ' + '127.0.0.1' +' ' + str(NODE_LISTEN_PORT) + ' 0 1 0 > ./error_log_zilliqa 2>&1 &')
+
+	synced = 0
+	while time.time() - start < timeout:
+		time.sleep(1)
+		synced, windowed = get_synced_block_num()
+		if synced >= numblocks:
+			print 'Synced ' + str(synced) + ' Tx blocks in ' + str(int(time.time() - start)) + ' s'
+			for (low, high, ms) in windowed:
+				print '  windowed sync of blocks ' + low + ' to ' + high + ' took ' + ms + ' ms'
+			return 0
+
+	print 'Only synced ' + str(synced) + '/' + str(numblocks) + ' Tx blocks in ' + str(timeout) + ' s'
+	return 1
+
+if __name__ == "__main__":
+	main()
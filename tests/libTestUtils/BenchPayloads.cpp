@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2018 Zilliqa
+ * This source code is being disclosed to you solely for the purpose of your
+ * participation in testing Zilliqa. You may view, compile and run the code for
+ * that purpose and pursuant to the protocols and algorithms that are programmed
+ * into, and intended by, the code. You may not do anything else with the code
+ * without express permission from Zilliqa Research Pte. Ltd., including
+ * modifying or publishing the code (or any part of it), and developing or
+ * forming another public or private blockchain network. This source code is
+ * provided 'as is' and no warranties are given as to title or non-infringement,
+ * merchantability or fitness for purpose and, to the extent permitted by law,
+ * all liability for your use of the code is disclaimed. Some programs in this
+ * code are governed by the GNU General Public License v3.0 (available at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html) ('GPLv3'). The programs that
+ * are governed by GPLv3.0 are those programs that are located in the folders
+ * src/depends and tests/depends and which include a reference to GPLv3 in their
+ * program files.
+ */
+
+#include "BenchPayloads.h"
+#include "TestUtils.h"
+
+using namespace std;
+
+namespace TestUtils {
+MicroBlock GenerateBenchMicroBlock(size_t numTxns) {
+  vector<TxnHash> tranHashes(numTxns);
+  for (auto& hash : tranHashes) {
+    hash = TxnHash::random();
+  }
+  MicroBlockHeader header(0, 0, 0, 0, 0, 0, BlockHash(), 0,
+                          MicroBlockHashSet(), numTxns, GenerateRandomPubKey(),
+                          0, CommitteeHash());
+  return MicroBlock(header, tranHashes, CoSignatures());
+}
+
+vector<Transaction> GenerateBenchTransactions(size_t numTxns,
+                                              size_t numSenders) {
+  vector<KeyPair> senders;
+  for (size_t i = 0; i < numSenders; i++) {
+    senders.emplace_back(GenerateRandomKeyPair());
+  }
+  vector<Transaction> txns;
+  txns.reserve(numTxns);
+  for (size_t i = 0; i < numTxns; i++) {
+    txns.emplace_back(0, i / numSenders, Address::random(),
+                      senders[i % numSenders], 1000, 1, 1);
+  }
+  return txns;
+}
+
+map<Address, Account> GenerateBenchAccounts(size_t numAccounts) {
+  map<Address, Account> accounts;
+  for (size_t i = 0; i < numAccounts; i++) {
+    accounts.emplace(Address::random(), Account(DistUint128(), i));
+  }
+  return accounts;
+}
+}  // namespace TestUtils